@@ -40,6 +40,10 @@
 
 #import "CUIdSYMBundlesManager.h"
 
+#import "CUISymbolicationMetrics.h"
+
+#import "CUILoadedSymbolsFilesRegistry.h"
+
 #import "CUIAboutBoxWindowController.h"
 
 #import "CUICrashReporterDefaults.h"
@@ -265,6 +269,13 @@ NSString * const CUIApplicationShowDebugDidChangeNotification=@"CUIApplicationSh
     tDefaults.reportUncaughtExceptions=!(tDefaults.reportUncaughtExceptions);
 }
 
+- (IBAction)dumpSymbolicationMetrics:(id)sender
+{
+    NSLog(@"Symbolication metrics:\n%@",[[CUISymbolicationMetrics sharedMetrics] report]);
+    
+    NSLog(@"%@",[[CUILoadedSymbolsFilesRegistry sharedRegistry] report]);
+}
+
 #pragma mark - NSApplicationDelegate
 
 - (void)application:(NSApplication *)sender openFiles:(NSArray<NSString *> *)inFilePaths
@@ -61,6 +61,18 @@ typedef NS_ENUM(NSUInteger, CUICrashLogsSortType)
 
     @property (nonatomic) BOOL searchForSymbolsFilesAutomatically;
 
+    // Directories paths or http(s) URLs of stores laid out by UUID (<location>/<UUID>/<name>.dSYM)
+
+    @property (nonatomic,copy) NSArray<NSString *> * symbolSourcesLocations;
+
+    // Folders crawled for dSYM bundles when Spotlight does not find them (e.g. not indexed volumes, network shares)
+
+    @property (nonatomic,copy) NSArray<NSString *> * symbolsSearchDirectoriesPaths;
+
+    // In MB. 0 means no limit
+
+    @property (nonatomic) NSUInteger symbolsCacheSizeLimit;
+
     // Crash Logs List
 
     @property (nonatomic) CUICrashLogsSortType crashLogsSortType;
@@ -56,6 +56,12 @@ NSString * const CUIPreferencesSymbolicationSearchSymbolsFilesKey=@"symbolicatio
 
 NSString * const CUIPreferencesSymbolicationSymbolicateAutomaticallyKey=@"symbolication.symbolicateAutomatically";
 
+NSString * const CUIPreferencesSymbolicationSymbolSourcesLocationsKey=@"symbolication.symbolSources.locations";
+
+NSString * const CUIPreferencesSymbolicationSymbolsCacheSizeLimitKey=@"symbolication.symbolsCache.sizeLimit";
+
+NSString * const CUIPreferencesSymbolicationSearchDirectoriesPathsKey=@"symbolication.searchDirectories.paths";
+
 
 // Crash Logs List
 
@@ -124,6 +130,12 @@ NSString * const CUIPreferencesCrashLogsShowFileNamesDidChangeNotification=@"CUI
                                       
                                       CUIPreferencesSymbolicationSymbolicateAutomaticallyKey:@(YES),
                                       
+                                      CUIPreferencesSymbolicationSymbolSourcesLocationsKey:@[],
+                                      
+                                      CUIPreferencesSymbolicationSymbolsCacheSizeLimitKey:@(2048),
+                                      
+                                      CUIPreferencesSymbolicationSearchDirectoriesPathsKey:@[],
+                                      
                                       // Text Mode
                                       
                                       CUIPreferencesTextModeShowsLineNumbersKey:@(NO),
@@ -173,6 +185,12 @@ NSString * const CUIPreferencesCrashLogsShowFileNamesDidChangeNotification=@"CUI
         }
         
         _symbolicateAutomatically=[_defaults integerForKey:CUIPreferencesSymbolicationSymbolicateAutomaticallyKey];
+        
+        _symbolSourcesLocations=[[_defaults stringArrayForKey:CUIPreferencesSymbolicationSymbolSourcesLocationsKey] copy];
+        
+        _symbolsCacheSizeLimit=[_defaults integerForKey:CUIPreferencesSymbolicationSymbolsCacheSizeLimitKey];
+        
+        _symbolsSearchDirectoriesPaths=[[_defaults stringArrayForKey:CUIPreferencesSymbolicationSearchDirectoriesPathsKey] copy];
 
         // Text Mode
         
@@ -234,6 +252,27 @@ NSString * const CUIPreferencesCrashLogsShowFileNamesDidChangeNotification=@"CUI
     [NSNotificationCenter.defaultCenter postNotificationName:CUIPreferencesSymbolicationSymbolicateAutomaticallyDidChangeNotification object:nil];
 }
 
+- (void)setSymbolSourcesLocations:(NSArray<NSString *> *)inSymbolSourcesLocations
+{
+    _symbolSourcesLocations=[inSymbolSourcesLocations copy];
+    
+    [_defaults setObject:_symbolSourcesLocations forKey:CUIPreferencesSymbolicationSymbolSourcesLocationsKey];
+}
+
+- (void)setSymbolsSearchDirectoriesPaths:(NSArray<NSString *> *)inSymbolsSearchDirectoriesPaths
+{
+    _symbolsSearchDirectoriesPaths=[inSymbolsSearchDirectoriesPaths copy];
+    
+    [_defaults setObject:_symbolsSearchDirectoriesPaths forKey:CUIPreferencesSymbolicationSearchDirectoriesPathsKey];
+}
+
+- (void)setSymbolsCacheSizeLimit:(NSUInteger)inSymbolsCacheSizeLimit
+{
+    _symbolsCacheSizeLimit=inSymbolsCacheSizeLimit;
+    
+    [_defaults setInteger:inSymbolsCacheSizeLimit forKey:CUIPreferencesSymbolicationSymbolsCacheSizeLimitKey];
+}
+
 - (void)setPreferedSourceCodeEditorURL:(NSURL *)inURL
 {
     if (inURL.isFileURL==NO)
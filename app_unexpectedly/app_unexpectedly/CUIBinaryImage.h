@@ -52,6 +52,10 @@
 
 - (instancetype)initWithString:(NSString *)inString reportVersion:(NSUInteger)inReportVersion error:(NSError **)outError;
 
+// The line must be valid UTF-8 (without its line terminator)
+
+- (instancetype)initWithUTF8Bytes:(const uint8_t *)inBytes length:(NSUInteger)inLength reportVersion:(NSUInteger)inReportVersion error:(NSError **)outError;
+
 - (instancetype)initWithImage:(IPSImage *)inImage error:(NSError **)outError;
 
 @end
@@ -13,6 +13,8 @@
 
 #import "CUIBinaryImage.h"
 
+#import "CUIUTF8Scanner.h"
+
 #import "NSString+CPU.h"
 
 #import "IPSImage+UserCode.h"
@@ -105,6 +107,8 @@
 
 @end
 
+#define CUIBinaryImageLineBufferSize    1024
+
 // Line example:
 // 0x7fff2d259000 -     0x7fff2d259fff  com.apple.Accelerate (1.11 - Accelerate 1.11) <B2A0C739-1D41-3452-9D00-8C01ADA5DD99> /System/Library/Frameworks/Accelerate.framework/Versions/A/Accelerate
 
@@ -120,38 +124,57 @@
         return nil;
     }
     
+    uint8_t tBuffer[CUIBinaryImageLineBufferSize];
+    NSUInteger tLength=0;
+    
+    const uint8_t * tBytes=CUIUTF8BytesOfString(inString,tBuffer,sizeof(tBuffer),&tLength);
+    
+    return [self initWithUTF8Bytes:tBytes length:tLength reportVersion:inReportVersion error:outError];
+}
+
+- (instancetype)initWithUTF8Bytes:(const uint8_t *)inBytes length:(NSUInteger)inLength reportVersion:(NSUInteger)inReportVersion error:(NSError **)outError
+{
+    if (inBytes==NULL)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
     self=[super init];
     
     if (self!=nil)
     {
-        NSCharacterSet * tWhitespaceCharacterSet=[NSCharacterSet whitespaceCharacterSet];
-        NSScanner * tScanner=[NSScanner scannerWithString:inString];
-        
-        tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+        CUIUTF8Scanner tScanner=CUIUTF8ScannerMake(inBytes,inLength);
         
         unsigned long long tAddressRangeStart=0;
         
-        if ([tScanner scanHexLongLong:&tAddressRangeStart]==NO)
+        if (CUIUTF8ScannerScanHexLongLong(&tScanner,&tAddressRangeStart)==NO)
             return nil;
         
-        if ([tScanner scanUpToString:@"0" intoString:NULL]==NO)
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
+        
+        if (CUIUTF8ScannerScanUpToString(&tScanner,"0",NULL)==NO)
             return nil;
         
         unsigned long long tAddressRangeEnd=0;
         
-        if ([tScanner scanHexLongLong:&tAddressRangeEnd]==NO)
+        if (CUIUTF8ScannerScanHexLongLong(&tScanner,&tAddressRangeEnd)==NO)
             return nil;
         
         _addressesRange=[CUIAddressesRange addressesRangeWithLocation:tAddressRangeStart length:tAddressRangeEnd-tAddressRangeStart+1];
         
-        NSString * tString;
-        NSString * tOriginalString;
+        NSRange tRange;
+        NSRange tOriginalRange;
         
         BOOL tIsMissingVersion=NO;
         
-        NSUInteger tSavedScannerScanLocation=tScanner.scanLocation;
+        NSUInteger tSavedScannerScanLocation=tScanner.location;
+        
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
         
-        if ([tScanner scanUpToString:@"(" intoString:&tOriginalString]==NO)
+        if (CUIUTF8ScannerScanUpToString(&tScanner,"(",&tOriginalRange)==NO)
         {
             return nil;
         }
@@ -159,95 +182,97 @@
         {
             // Maybe only the version is missing
             
-            if (tScanner.scanLocation==inString.length)
+            if (tScanner.location==inLength)
             {
-                tScanner.scanLocation=tSavedScannerScanLocation;
+                tScanner.location=tSavedScannerScanLocation;
                 
-                if ([tScanner scanUpToString:@"<" intoString:&tOriginalString]==NO)
+                CUIUTF8ScannerSkipWhitespaces(&tScanner);
+                
+                if (CUIUTF8ScannerScanUpToString(&tScanner,"<",&tOriginalRange)==NO)
                     return nil;
                 
                 tIsMissingVersion=YES;
             }
         }
         
+        NSUInteger tVersionLocation=NSNotFound;
+        
         if (inReportVersion==6)
         {
-            // Remove the version
+            // Remove the version (the last character is not a separator)
+            
+            NSRange tSearchRange=tOriginalRange;
             
-            NSUInteger tLength=tOriginalString.length;
+            tSearchRange.length-=NSMaxRange(tOriginalRange)-CUIUTF8LocationOfLastCharacter(inBytes,tOriginalRange);
             
-            NSRange tRange=[tOriginalString rangeOfCharacterFromSet:tWhitespaceCharacterSet options:NSBackwardsSearch range:NSMakeRange(0,tLength-1)];
+            tVersionLocation=CUIUTF8LocationOfLastWhitespace(inBytes,tSearchRange);
             
-            if (tRange.location==NSNotFound)
+            if (tVersionLocation==NSNotFound)
             {
                 NSLog(@"Unable to find version for binary image");
                 
                 return nil;
             }
             
-            tString=[tOriginalString substringToIndex:tRange.location];
+            tRange=NSMakeRange(tOriginalRange.location,tVersionLocation-tOriginalRange.location);
         }
         else
         {
-            tString=tOriginalString;
+            tRange=tOriginalRange;
         }
         
-        if ([tString hasPrefix:@"+"]==YES && tString.length>1)  // Cheap way to find that a binary image is user code.
+        if (tRange.length>1 && inBytes[tRange.location]=='+')  // Cheap way to find that a binary image is user code.
         {
             _userCode=YES;
             
-            tString=[tString substringFromIndex:1];
+            tRange.location+=1;
+            tRange.length-=1;
         }
         
-        _identifier=[[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet] copy];
+        _identifier=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,tRange));
         
         // Version
         
-        if (tScanner.scanLocation>=inString.length)
+        if (tScanner.location>=inLength)
             return nil;
         
         if (tIsMissingVersion==NO)
         {
-        
+            tScanner.location+=1;
+            
+            CUIUTF8ScannerSkipWhitespaces(&tScanner);
+            
+            if (CUIUTF8ScannerScanUpToString(&tScanner,")",&tRange)==NO)
+                return nil;
+            
             if (inReportVersion==6)
             {
-                NSUInteger tLength=tOriginalString.length;
-                
-                NSRange tRange=[tOriginalString rangeOfCharacterFromSet:tWhitespaceCharacterSet options:NSBackwardsSearch range:NSMakeRange(0,tLength-1)];
+                _version=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,NSMakeRange(tVersionLocation,NSMaxRange(tOriginalRange)-tVersionLocation)));
                 
-                _version=[[tOriginalString substringFromIndex:tRange.location] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
-                
-                tScanner.scanLocation+=1;
-                
-                if ([tScanner scanUpToString:@")" intoString:&tString]==NO)
-                    return nil;
-                
-                _buildNumber=[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+                _buildNumber=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,tRange));
             }
             else
             {
-                tScanner.scanLocation+=1;
+                // "version - build number"
                 
-                if ([tScanner scanUpToString:@")" intoString:&tString]==NO)
-                    return nil;
-                
-                NSArray * tVersions=[tString componentsSeparatedByString:@" - "];
+                NSUInteger tSeparatorLocation=CUIUTF8LocationOfString(inBytes,tRange," - ");
                 
-                switch(tVersions.count)
+                if (tSeparatorLocation==NSNotFound)
                 {
-                    case 2:
-                        
-                        _buildNumber=[tVersions[1] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
-                        
-                    case 1:
-                        
-                        _version=[tVersions.firstObject stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+                    _version=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,tRange));
+                }
+                else
+                {
+                    NSRange tBuildNumberRange=NSMakeRange(tSeparatorLocation+3,NSMaxRange(tRange)-tSeparatorLocation-3);
+                    
+                    if (CUIUTF8LocationOfString(inBytes,tBuildNumberRange," - ")==NSNotFound)
+                    {
+                        _buildNumber=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,tBuildNumberRange));
                         
-                        break;
+                        _version=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,NSMakeRange(tRange.location,tSeparatorLocation-tRange.location)));
+                    }
                 }
             }
-            
-            tScanner.scanLocation+=2;
         }
         else
         {
@@ -255,24 +280,42 @@
             _buildNumber=@"???";
         }
         
-        // UUID
+        // UUID (after ") " or at the '<')
+        
+        NSUInteger tUUIDLocation=tScanner.location;
         
-        if ([inString characterAtIndex:tScanner.scanLocation]=='<')
+        if (tIsMissingVersion==NO)
         {
-            if ([tScanner scanUpToString:@">" intoString:&tString]==NO)
+            if ((tUUIDLocation+1)>=inLength)
                 return nil;
-        
-            _UUID=[tString substringFromIndex:1];
+            
+            tUUIDLocation+=1;
+            
+            // A character outside of the BMP counts as 2 characters, the '<' can not be found after the first one
+            
+            if (inBytes[tUUIDLocation]<0xF0)
+                tUUIDLocation+=CUIUTF8CharacterLength(inBytes[tUUIDLocation]);
         }
-        else
+        
+        if (tUUIDLocation>=inLength)
+            return nil;
+        
+        if (inBytes[tUUIDLocation]=='<')
         {
-            tScanner.scanLocation-=2;
+            tScanner.location=tUUIDLocation;
+            
+            if (CUIUTF8ScannerScanUpToString(&tScanner,">",&tRange)==NO)
+                return nil;
+            
+            _UUID=CUIUTF8String(inBytes,NSMakeRange(tRange.location+1,tRange.length-1));
         }
         
-        if ([tScanner scanUpToString:@"/" intoString:NULL]==NO)
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
+        
+        if (CUIUTF8ScannerScanUpToString(&tScanner,"/",NULL)==NO)
             return nil;
         
-        _path=[[inString substringFromIndex:tScanner.scanLocation] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+        _path=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,NSMakeRange(tScanner.location,inLength-tScanner.location)));
         
         // User Code
         
@@ -13,6 +13,10 @@
 
 #import "CUICallStackBacktrace.h"
 
+#import "CUICrashLogTextLines.h"
+
+#import "CUIUTF8Scanner.h"
+
 #import "NSArray+WBExtensions.h"
 
 @interface CUICallStackBacktrace ()
@@ -39,19 +43,58 @@
 	{
 		__block NSError * tError=nil;
         
-        _stackFrames=[inLines WB_arrayByMappingObjectsUsingBlock:^id(NSString * bLine, NSUInteger bLineNumber) {
-			
-			CUIStackFrame * tCall=[[CUIStackFrame alloc] initWithString:bLine error:&tError];
-			
-			if (tCall==nil)
-			{
-                NSLog(@"Error parsing line: %@",bLine);
+        if ([inLines isKindOfClass:CUICrashLogTextLines.class]==YES)
+        {
+            // The lines are scanned from the bytes of the crash log (no string is created for them)
+            
+            CUICrashLogTextLines * tTextLines=(CUICrashLogTextLines *)inLines;
+            const uint8_t * tBytes=(const uint8_t *)tTextLines.data.bytes;
+            NSUInteger tCount=tTextLines.count;
+            
+            NSMutableArray * tStackFrames=[NSMutableArray arrayWithCapacity:tCount];
+            
+            for(NSUInteger tLineIndex=0;tLineIndex<tCount;tLineIndex++)
+            {
+                NSRange tRange=[tTextLines byteRangeOfLineAtIndex:tLineIndex];
+                const uint8_t * tLine=tBytes+tRange.location;
                 
-                return nil;
-			}
-			
-			return tCall;
-		}];
+                CUIStackFrame * tCall=nil;
+                
+                if (CUIUTF8BytesAreASCII(tLine,tRange.length)==YES)
+                    tCall=[[CUIStackFrame alloc] initWithUTF8Bytes:tLine length:tRange.length error:&tError];
+                else
+                    tCall=[[CUIStackFrame alloc] initWithString:tTextLines[tLineIndex] error:&tError];  // The bytes may not be valid UTF-8
+                
+                if (tCall==nil)
+                {
+                    NSLog(@"Error parsing line: %@",tTextLines[tLineIndex]);
+                    
+                    tStackFrames=nil;
+                    
+                    break;
+                }
+                
+                [tStackFrames addObject:tCall];
+            }
+            
+            _stackFrames=[tStackFrames copy];
+        }
+        else
+        {
+            _stackFrames=[inLines WB_arrayByMappingObjectsUsingBlock:^id(NSString * bLine, NSUInteger bLineNumber) {
+                
+                CUIStackFrame * tCall=[[CUIStackFrame alloc] initWithString:bLine error:&tError];
+                
+                if (tCall==nil)
+                {
+                    NSLog(@"Error parsing line: %@",bLine);
+                    
+                    return nil;
+                }
+                
+                return tCall;
+            }];
+        }
 		
 		if (_stackFrames==nil)
         {
@@ -15,6 +15,8 @@
 
 #import "CUIRegister.h"
 
+#import "CUIRegisterAnnotation.h"
+
 #import "CUIRegisterLabel.h"
 
 #define MACOS_BIGSUR_WIDTH_INSET   3.0
@@ -105,6 +107,7 @@ NSString * const CUIRegisterItemViewAsValueDidChangeNotification=@"CUIRegisterIt
     
     _registerValueLabel.delegate=self;
     _registerValueLabel.registerValue=tRegister.value;
+    _registerValueLabel.toolTip=[tRegister.annotation displayString];
     
     CUIRegisterViewValueAsType tType=CUIRegisterViewValueAsHex;
     
@@ -100,14 +100,31 @@
     
     self.processPath=tCrashLog.header.executablePath;
     
-    NSMutableArray * tLines=[NSMutableArray array];
+    CUICrashLogTextLines * tLines=tCrashLog.textLines;
     
-    [tCrashLog.rawText enumerateLinesUsingBlock:^(NSString * bLine, BOOL * bOutStop) {
+    // The lines of the sections are removed or replaced by their processed version below so their strings are not created
+    
+    NSMutableIndexSet * tSectionsLinesIndexes=[NSMutableIndexSet indexSet];
+    
+    for(NSValue * tRangeValue in @[[NSValue valueWithRange:tCrashLog.headerRange],
+                                   [NSValue valueWithRange:tCrashLog.exceptionInformationRange],
+                                   [NSValue valueWithRange:tCrashLog.diagnosticMessagesRange],
+                                   [NSValue valueWithRange:tCrashLog.backtracesRange],
+                                   [NSValue valueWithRange:tCrashLog.threadStateRange],
+                                   [NSValue valueWithRange:tCrashLog.binaryImagesRange]])
+    {
+        NSRange tRange=tRangeValue.rangeValue;
         
-        [tLines addObject:bLine];
-    }];
+        if (tRange.location!=NSNotFound)
+            [tSectionsLinesIndexes addIndexesInRange:tRange];
+    }
+    
+    NSUInteger tNumberOfLines=tLines.count;
+    
+    NSMutableArray * tMutableArray=[NSMutableArray arrayWithCapacity:tNumberOfLines];
     
-    NSMutableArray * tMutableArray=[tLines mutableCopy];
+    for(NSUInteger tIndex=0;tIndex<tNumberOfLines;tIndex++)
+        [tMutableArray addObject:([tSectionsLinesIndexes containsIndex:tIndex]==YES) ? @"" : tLines[tIndex]];
     
     
     if (tCrashLog.binaryImagesRange.location!=NSNotFound)
@@ -710,6 +727,10 @@
     
     __block NSUInteger tStackFrameIndex=0;
     
+#ifndef __DISABLE_SYMBOLICATION_
+    self.symbolicationPriority=(tCrashedThread==YES) ? CUISymbolicationPriorityCrashedThread : CUISymbolicationPriorityRestOfLog;
+#endif
+    
     [inLines enumerateObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:tOtherLinesRange]
                                options:0
                             usingBlock:^(NSString * bLine, NSUInteger bLineNumber, BOOL * bOutStop) {
@@ -737,6 +758,10 @@
                                 
                             }];
     
+#ifndef __DISABLE_SYMBOLICATION_
+    self.symbolicationPriority=CUISymbolicationPriorityRestOfLog;
+#endif
+    
     return tProcessedLines;
 }
 
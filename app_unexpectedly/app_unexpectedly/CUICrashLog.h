@@ -42,5 +42,8 @@
 
     @property (readonly) CUICrashLogBinaryImages * binaryImages;
 
+// Stack frames of all the threads located in the binary image with this UUID (main thread only)
+
+- (NSArray<CUIStackFrame *> *)stackFramesForBinaryUUID:(NSString *)inBinaryUUID;
 
 @end
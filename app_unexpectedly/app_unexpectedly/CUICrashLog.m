@@ -37,11 +37,11 @@
     @property BOOL fullyParsed;
 
 
-    @property CUICrashLogHeader * header;
+    @property (nonatomic) CUICrashLogHeader * header;
 
-    @property CUICrashLogExceptionInformation * exceptionInformation;
+    @property (nonatomic) CUICrashLogExceptionInformation * exceptionInformation;
 
-    @property CUICrashLogDianosticMessages * diagnosticMessages;
+    @property (nonatomic) CUICrashLogDianosticMessages * diagnosticMessages;
 
     @property CUICrashLogBacktraces * backtraces;
 
@@ -49,115 +49,125 @@
 
     @property CUICrashLogBinaryImages * binaryImages;
 
+    // Binary UUID -> Stack frames
+
+    @property NSDictionary<NSString *,NSArray<CUIStackFrame *> *> * stackFramesRegistry;
+
+
+- (void)_parseHeaderIfNeeded;
+
 @end
 
 @implementation CUICrashLog
 
-- (instancetype)initWithString:(NSString *)inString error:(NSError **)outError
+- (BOOL)parseContents
 {
-    if ([inString isKindOfClass:NSString.class]==NO)
-	{
-		if (outError!=NULL)
-			*outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
-		
-		return nil;
-	}
-	
-	self=[super initWithString:inString error:outError];
-	
-	if (self!=nil)
-	{
-        _headerRange.location=NSNotFound;
+    _headerRange.location=NSNotFound;
+    
+    _exceptionInformationRange.location=NSNotFound;
+    _diagnosticMessagesRange.location=NSNotFound;
+    
+    _backtracesRange.location=NSNotFound;
+    
+    _threadStateRange.location=NSNotFound;
+    
+    _binaryImagesRange.location=NSNotFound;
+    
+    NSError * tError=nil;
+    
+    if (self.ipsReport!=nil)
+    {
+        IPSIncident * tIncident=self.ipsReport.incident;
         
-        _exceptionInformationRange.location=NSNotFound;
-        _diagnosticMessagesRange.location=NSNotFound;
+        _header=[[CUICrashLogHeader alloc] initWithIPSIncident:tIncident error:&tError];
         
-        _backtracesRange.location=NSNotFound;
+        if (_header==nil)
+        {
+            // A COMPLETER
+            
+            return NO;
+        }
         
-        _threadStateRange.location=NSNotFound;
+        _exceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithIPSIncident:tIncident error:&tError];
         
-        _binaryImagesRange.location=NSNotFound;
+        if (_exceptionInformation==nil)
+        {
+            // A COMPLETER
+            
+            return NO;
+        }
         
-        NSError * tError=nil;
+        _diagnosticMessages=[[CUICrashLogDianosticMessages alloc] initWithIPSIncident:tIncident error:&tError];
         
-        if (self.ipsReport!=nil)
+        if (_diagnosticMessages==nil)
         {
-            IPSIncident * tIncident=self.ipsReport.incident;
+            // A COMPLETER
             
-            _header=[[CUICrashLogHeader alloc] initWithIPSIncident:tIncident error:&tError];
+            return NO;
+        }
+    }
+    else
+    {
+        CUICrashLogTextLines * tLines=self.textLines;
+
+        @try
+        {
+            BOOL tResult=[self detectSectionsOfTextualRepresentation:tLines error:&tError];
             
-            if (_header==nil)
+            if (tResult==NO)
             {
-                // A COMPLETER
+                NSLog(@"Error detecting section : %@",tError.userInfo[CUIParsingErrorSectionNameKey]);
                 
-                return nil;
-            }
-            
-            _exceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithIPSIncident:tIncident error:&tError];
-            
-            if (_exceptionInformation==nil)
-            {
-                // A COMPLETER
+                _parsingError=tError;
+                
+                // Raw Text Mode only
                 
-                return nil;
-            }
-            
-            _diagnosticMessages=[[CUICrashLogDianosticMessages alloc] initWithIPSIncident:tIncident error:&tError];
-            
-            if (_diagnosticMessages==nil)
-            {
                 // A COMPLETER
                 
-                return nil;
+                return NO;
             }
-        }
-        else
-        {
-            NSMutableArray * tLines=[NSMutableArray array];
             
-            [self.rawText enumerateLinesUsingBlock:^(NSString * bLine, BOOL * bOutStop) {
-                
-                [tLines addObject:bLine];
-            }];
-
-            @try
+            _header=[[CUICrashLogHeader alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_headerRange] error:&tError];
+            
+            if (_header==nil)
             {
-                BOOL tResult=[self detectSectionsOfTextualRepresentation:tLines error:&tError];
-                
-                if (tResult==NO)
+                if (tError!=nil)
                 {
-                    NSLog(@"Error detecting section : %@",tError.userInfo[CUIParsingErrorSectionNameKey]);
+                    NSUInteger tAbsoluteLineNumber=[tError.userInfo[CUIParsingErrorLineKey] unsignedIntegerValue]+_headerRange.location;
                     
-                    _parsingError=tError;
+                    NSLog(@"Error parsing line : %lu",tAbsoluteLineNumber);
                     
-                    // Raw Text Mode only
-                    
-                    // A COMPLETER
-                    
-                    return nil;
+                    _parsingError=[NSError errorWithDomain:CUIParsingErrorDomain code:tError.code userInfo:@{CUIParsingErrorLineKey:@(tAbsoluteLineNumber)}];
                 }
                 
-                _header=[[CUICrashLogHeader alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_headerRange] error:&tError];
+                // A COMPLETER
                 
-                if (_header==nil)
+                return NO;
+            }
+            
+            _exceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_exceptionInformationRange] reportVersion:_header.reportVersion error:&tError];
+            
+            if (_exceptionInformation==nil)
+            {
+                if (tError!=nil)
                 {
-                    if (tError!=nil)
-                    {
-                        NSUInteger tAbsoluteLineNumber=[tError.userInfo[CUIParsingErrorLineKey] unsignedIntegerValue]+_headerRange.location;
-                        
-                        NSLog(@"Error parsing line : %lu",tAbsoluteLineNumber);
-                        
-                        _parsingError=[NSError errorWithDomain:CUIParsingErrorDomain code:tError.code userInfo:@{CUIParsingErrorLineKey:@(tAbsoluteLineNumber)}];
-                    }
+                    NSUInteger tAbsoluteLineNumber=[tError.userInfo[CUIParsingErrorLineKey] unsignedIntegerValue]+_headerRange.location;
                     
-                    // A COMPLETER
+                    NSLog(@"Error parsing line : %lu",tAbsoluteLineNumber);
                     
-                    return nil;
+                    _parsingError=[NSError errorWithDomain:CUIParsingErrorDomain code:tError.code userInfo:@{CUIParsingErrorLineKey:@(tAbsoluteLineNumber)}];
                 }
                 
-                _exceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_exceptionInformationRange] reportVersion:_header.reportVersion error:&tError];
+                // A COMPLETER
+                
+                return NO;
+            }
+            
+            if (_diagnosticMessagesRange.location!=NSNotFound)
+            {
+                _diagnosticMessages=[[CUICrashLogDianosticMessages alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_diagnosticMessagesRange] reportVersion:_header.reportVersion error:&tError];
                 
-                if (_exceptionInformation==nil)
+                if (_diagnosticMessages==nil)
                 {
                     if (tError!=nil)
                     {
@@ -170,47 +180,142 @@
                     
                     // A COMPLETER
                     
-                    return nil;
+                    return NO;
                 }
-                
-                if (_diagnosticMessagesRange.location!=NSNotFound)
-                {
-                    _diagnosticMessages=[[CUICrashLogDianosticMessages alloc] initWithTextualRepresentation:[tLines subarrayWithRange:_diagnosticMessagesRange] reportVersion:_header.reportVersion error:&tError];
-                    
-                    if (_diagnosticMessages==nil)
-                    {
-                        if (tError!=nil)
-                        {
-                            NSUInteger tAbsoluteLineNumber=[tError.userInfo[CUIParsingErrorLineKey] unsignedIntegerValue]+_headerRange.location;
-                            
-                            NSLog(@"Error parsing line : %lu",tAbsoluteLineNumber);
-                            
-                            _parsingError=[NSError errorWithDomain:CUIParsingErrorDomain code:tError.code userInfo:@{CUIParsingErrorLineKey:@(tAbsoluteLineNumber)}];
-                        }
-                        
-                        // A COMPLETER
-                        
-                        return nil;
-                    }
-                }
-                
-                // The other sections will be parsed when the log is displayed for real
             }
             
-            @catch (NSException *exception)
-            {
-                NSLog(@"Exception raised while parsing \"%@\"",self.rawText);
-                
-                return nil;
-            }
+            // The other sections will be parsed when the log is displayed for real
+        }
+        
+        @catch (NSException *exception)
+        {
+            NSLog(@"Exception raised while parsing \"%@\"",self.rawText);
             
-            @finally
+            return NO;
+        }
+        
+        @finally
+        {
+        }
+    }
+    
+    return YES;
+}
+
+- (BOOL)parseHeaderOfTextLines:(CUICrashLogTextLines *)inLines
+{
+    _headerRange.location=NSNotFound;
+    
+    _exceptionInformationRange.location=NSNotFound;
+    _diagnosticMessagesRange.location=NSNotFound;
+    
+    _backtracesRange.location=NSNotFound;
+    
+    _threadStateRange.location=NSNotFound;
+    
+    _binaryImagesRange.location=NSNotFound;
+    
+    // Only what the crash logs list displays is parsed, the rest is parsed when the contents are read
+    
+    CUICrashLogSectionsDetector * tDetector=[[CUICrashLogSectionsDetector alloc] initWithLines:inLines];
+    
+    if (tDetector==nil || [tDetector detectSectionsThroughSection:CUICrashLogSectionTypeExceptionInformation error:NULL]==NO)
+        return NO;
+    
+    NSRange tHeaderRange=[tDetector rangeOfSection:CUICrashLogSectionTypeHeader].lineRange;
+    NSRange tExceptionInformationRange=[tDetector rangeOfSection:CUICrashLogSectionTypeExceptionInformation].lineRange;
+    
+    if (tHeaderRange.location==NSNotFound || tExceptionInformationRange.location==NSNotFound)
+        return NO;
+    
+    @try
+    {
+        _header=[[CUICrashLogHeader alloc] initWithTextualRepresentation:[inLines subarrayWithRange:tHeaderRange] error:NULL];
+        
+        if (_header==nil)
+            return NO;
+        
+        _exceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithTextualRepresentation:[inLines subarrayWithRange:tExceptionInformationRange] reportVersion:_header.reportVersion error:NULL];
+        
+        if (_exceptionInformation==nil)
+        {
+            _header=nil;
+            
+            return NO;
+        }
+    }
+    
+    @catch (NSException *exception)
+    {
+        _header=nil;
+        _exceptionInformation=nil;
+        
+        return NO;
+    }
+    
+    _headerRange=tHeaderRange;
+    _exceptionInformationRange=tExceptionInformationRange;
+    
+    return YES;
+}
+
+#pragma mark -
+
+- (void)_parseHeaderIfNeeded
+{
+    @synchronized(self)
+    {
+        if (_header!=nil && _exceptionInformation!=nil)
+            return;
+        
+        // The header of an IPS report listed from its summary is decoded from the structural index of the report
+        // (the threads and binary images are not materialized)
+        
+        if (self.isHeaderOnly==YES)
+        {
+            CUIIPSReportIndex * tIndex=[self ipsReportIndex];
+            
+            if (tIndex!=nil)
             {
+                CUICrashLogHeader * tHeader=[[CUICrashLogHeader alloc] initWithIPSReportIndex:tIndex error:NULL];
+                CUICrashLogExceptionInformation * tExceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithIPSReportIndex:tIndex error:NULL];
+                
+                if (tHeader!=nil && tExceptionInformation!=nil)
+                {
+                    _header=tHeader;
+                    _exceptionInformation=tExceptionInformation;
+                    
+                    return;
+                }
             }
         }
-	}
+        
+        [self readContentsIfNeeded];
+    }
+}
+
+- (CUICrashLogHeader *)header
+{
+    if (_header==nil)
+        [self _parseHeaderIfNeeded];
     
-	return self;
+    return _header;
+}
+
+- (CUICrashLogExceptionInformation *)exceptionInformation
+{
+    if (_exceptionInformation==nil)
+        [self _parseHeaderIfNeeded];
+    
+    return _exceptionInformation;
+}
+
+- (CUICrashLogDianosticMessages *)diagnosticMessages
+{
+    if (_diagnosticMessages==nil)
+        [self readContentsIfNeeded];
+    
+    return _diagnosticMessages;
 }
 
 #pragma mark -
@@ -265,6 +370,11 @@
 
 - (id)valueForKeyPath:(NSString *)inKeyPath
 {
+    // The summary of a report that has not been read yet
+    
+    if (_header==nil)
+        return [super valueForKeyPath:inKeyPath];
+    
     if ([inKeyPath isEqualToString:@"header.bundleIdentifier"]==YES)
         return self.header.bundleIdentifier;
     
@@ -286,12 +396,18 @@
 
 - (NSString *)processName
 {
-    return self.header.processName;
+    if (_header==nil)
+        return [super processName];
+    
+    return _header.processName;
 }
 
 - (NSDate *)dateTime
 {
-    return self.header.dateTime;
+    if (_header==nil)
+        return [super dateTime];
+    
+    return _header.dateTime;
 }
 
 - (NSUInteger)reportVersion
@@ -312,129 +428,102 @@
 
 #pragma mark -
 
-- (BOOL)detectSectionsOfTextualRepresentation:(NSArray *)inLines error:(NSError **)outError
+- (NSArray<CUIStackFrame *> *)stackFramesForBinaryUUID:(NSString *)inBinaryUUID
 {
-    NSRange tRange;
-    NSUInteger tFirstLine=0;
-    
-    // Header Section (Required)
+    if (inBinaryUUID==nil)
+        return @[];
     
-    tRange=[CUICrashLogSectionsDetector detectHeaderSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
-    
-    if (tRange.location==NSNotFound)
+    if (self.stackFramesRegistry==nil)
     {
-        if (outError!=NULL)
-            *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Header"}];
+        CUICrashLogBacktraces * tBacktraces=self.backtraces;
+        CUICrashLogBinaryImages * tBinaryImages=self.binaryImages;
         
-        return NO;
+        // Not parsed yet
+        
+        if (tBacktraces==nil || tBinaryImages==nil)
+            return @[];
+        
+        NSMutableDictionary<NSString *,NSMutableArray<CUIStackFrame *> *> * tMutableRegistry=[NSMutableDictionary dictionary];
+        NSMutableDictionary<NSString *,id> * tUUIDsCache=[NSMutableDictionary dictionary];
+        
+        for(CUIThread * tThread in tBacktraces.threads)
+        {
+            for(CUIStackFrame * tStackFrame in tThread.callStackBacktrace.stackFrames)
+            {
+                NSString * tBinaryImageIdentifier=tStackFrame.binaryImageIdentifier;
+                
+                if (tBinaryImageIdentifier==nil)
+                    continue;
+                
+                id tUUID=tUUIDsCache[tBinaryImageIdentifier];
+                
+                if (tUUID==nil)
+                {
+                    CUIBinaryImage * tBinaryImage=[tBinaryImages binaryImageWithIdentifier:tBinaryImageIdentifier];
+                    
+                    if (tBinaryImage==nil)
+                    {
+                        NSString * tAlternateIdentifier=[tBinaryImages binaryImageIdentifierForName:tBinaryImageIdentifier];
+                        
+                        if (tAlternateIdentifier!=nil)
+                            tBinaryImage=[tBinaryImages binaryImageWithIdentifier:tAlternateIdentifier];
+                    }
+                    
+                    tUUID=(tBinaryImage.UUID!=nil) ? tBinaryImage.UUID : [NSNull null];
+                    
+                    tUUIDsCache[tBinaryImageIdentifier]=tUUID;
+                }
+                
+                if (tUUID==[NSNull null])
+                    continue;
+                
+                NSMutableArray * tStackFrames=tMutableRegistry[tUUID];
+                
+                if (tStackFrames==nil)
+                {
+                    tStackFrames=[NSMutableArray array];
+                    tMutableRegistry[tUUID]=tStackFrames;
+                }
+                
+                [tStackFrames addObject:tStackFrame];
+            }
+        }
+        
+        self.stackFramesRegistry=[tMutableRegistry copy];
     }
     
-    self.headerRange=tRange;
+    NSArray * tStackFrames=self.stackFramesRegistry[inBinaryUUID];
     
-    // Exception Information Section (Required)
-    
-    tFirstLine=NSMaxRange(tRange);
+    return (tStackFrames!=nil) ? tStackFrames : @[];
+}
+
+#pragma mark -
+
+- (BOOL)detectSectionsOfTextualRepresentation:(CUICrashLogTextLines *)inLines error:(NSError **)outError
+{
+    CUICrashLogSectionsDetector * tDetector=[[CUICrashLogSectionsDetector alloc] initWithLines:inLines];
     
-    tRange=[CUICrashLogSectionsDetector detectExceptionInformationSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
+    NSError * tError=nil;
     
-    if (tRange.location==NSNotFound)
+    if (tDetector==nil || [tDetector detectSections:&tError]==NO)
     {
         if (outError!=NULL)
-            *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Exception Information"}];
+            *outError=(tError!=nil) ? tError : [NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Header"}];
         
         return NO;
     }
     
-    self.exceptionInformationRange=tRange;
-    
-    // Diagnostic Messages (Optional)
-    
-    tFirstLine=NSMaxRange(tRange);
-    
-    NSString * tString=inLines[tFirstLine];
-    
-    if ([tString hasPrefix:@"Application Specific Information:"]==YES ||
-        [tString hasPrefix:@"VM Regions Near"]==YES ||
-        [tString hasPrefix:@"VM Region Info:"]==YES)
-    {
-        tRange=[CUICrashLogSectionsDetector detectDiagnosticMessageSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
-        
-        if (tRange.location==NSNotFound)
-        {
-            if (outError!=NULL)
-                *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Diagnostic Messages"}];
-            
-            return NO;
-        }
-        
-        self.diagnosticMessagesRange=tRange;
-        
-        tFirstLine=NSMaxRange(tRange);
-        
-        tString=inLines[tFirstLine];
-    }
-    
-    // Backtraces
+    self.headerRange=[tDetector rangeOfSection:CUICrashLogSectionTypeHeader].lineRange;
     
-    if ([tString isEqualToString:@"Backtrace not available"]==YES ||
-        [tString hasPrefix:@"Application Specific Backtrace"]==YES ||
-        [tString hasPrefix:@"Thread 0"]==YES)
-    {
-        tRange=[CUICrashLogSectionsDetector detectBacktracesSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
-        
-        if (tRange.location==NSNotFound)
-        {
-            if (outError!=NULL)
-                *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Backtraces"}];
-            
-            return NO;
-        }
-        
-        self.backtracesRange=tRange;
-        
-        tFirstLine=NSMaxRange(tRange);
-        
-        tString=inLines[tFirstLine];
-    }
+    self.exceptionInformationRange=[tDetector rangeOfSection:CUICrashLogSectionTypeExceptionInformation].lineRange;
     
-    // Thread State
+    self.diagnosticMessagesRange=[tDetector rangeOfSection:CUICrashLogSectionTypeDiagnosticMessages].lineRange;
     
-    if ((([tString hasPrefix:@"Thread"]==YES || [tString hasPrefix:@"Unknown thread"]==YES) && [tString rangeOfString:@"crashed with"].location!=NSNotFound) ||
-        ([tString rangeOfString:@"Thread State" options:NSCaseInsensitiveSearch].location==0))
-    {
-        tRange=[CUICrashLogSectionsDetector detectThreadStateSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
-        
-        if (tRange.location==NSNotFound)
-        {
-            if (outError!=NULL)
-                *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Thread State"}];
-            
-            return NO;
-        }
-        
-        self.threadStateRange=tRange;
-        
-        tFirstLine=NSMaxRange(tRange);
-        
-        tString=inLines[tFirstLine];
-    }
+    self.backtracesRange=[tDetector rangeOfSection:CUICrashLogSectionTypeBacktraces].lineRange;
     
-    // Binary Images
+    self.threadStateRange=[tDetector rangeOfSection:CUICrashLogSectionTypeThreadState].lineRange;
     
-    if ([tString rangeOfString:@"Binary Images" options:NSCaseInsensitiveSearch].location==0)
-    {
-        tRange=[CUICrashLogSectionsDetector detectBinaryImagesSectionRangeInTextualRepresentation:inLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,inLines.count-tFirstLine)]];
-        
-        if (tRange.location==NSNotFound)
-        {
-            if (outError!=NULL)
-                *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Binary Images"}];
-            
-            return NO;
-        }
-        
-        self.binaryImagesRange=tRange;
-    }
+    self.binaryImagesRange=[tDetector rangeOfSection:CUICrashLogSectionTypeBinaryImages].lineRange;
     
     return YES;
 }
@@ -493,12 +582,7 @@
         return YES;
     }
     
-    NSMutableArray * tLines=[NSMutableArray array];
-    
-    [self.rawText enumerateLinesUsingBlock:^(NSString * bLine, BOOL * bOutStop) {
-        
-        [tLines addObject:bLine];
-    }];
+    CUICrashLogTextLines * tLines=self.textLines;
     
     if (self.backtracesRange.location!=NSNotFound)
     {
@@ -31,8 +31,14 @@
 
 - (CUIBinaryImage *)binaryImageWithIdentifier:(NSString *)inIdentifier;
 
+// The look ups are binary searches in the address ranges sorted when the binary images are parsed. They can be done from any thread.
+
 - (CUIBinaryImage *)binaryImageForMemoryAddress:(NSUInteger)inMemoryAddress;
 
+// The addresses are expected in ascending order (the look up of each address is then amortized). NSNull for the addresses in no binary image.
+
+- (NSArray *)binaryImagesForSortedMemoryAddresses:(const NSUInteger *)inMemoryAddresses count:(NSUInteger)inCount;
+
 - (BOOL)isUserCodeAtMemoryAddress:(NSUInteger)inMemoryAddress inBinaryImage:(NSString *)inIdentifier;
 
 - (BOOL)isUserCodeAtMemoryAddress:(NSUInteger)inMemoryAddress inBinaryName:(NSString *)inName;
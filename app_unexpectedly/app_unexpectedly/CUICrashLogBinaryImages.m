@@ -15,8 +15,37 @@
 
 #import "CUIParsingErrors.h"
 
+#import "CUICrashLogTextLines.h"
+
+#import "CUIUTF8Scanner.h"
+
 #import "NSArray+WBExtensions.h"
 
+typedef struct
+{
+    NSUInteger start;
+    NSUInteger end;             // excluded
+    
+    NSUInteger maximumEnd;      // of this range and of the ranges before it
+    
+    NSUInteger index;           // in the binary images
+    
+} CUIBinaryImageAddressesRange;
+
+static int CUIBinaryImageAddressesRangeCompare(const void * inRange1,const void * inRange2)
+{
+    const CUIBinaryImageAddressesRange * tRange1=inRange1;
+    const CUIBinaryImageAddressesRange * tRange2=inRange2;
+    
+    if (tRange1->start!=tRange2->start)
+        return (tRange1->start<tRange2->start) ? -1 : 1;
+    
+    if (tRange1->index!=tRange2->index)
+        return (tRange1->index<tRange2->index) ? -1 : 1;
+    
+    return 0;
+}
+
 @interface CUICrashLogBinaryImages ()
 {
     NSMutableDictionary * _binaryImagesRegistry;
@@ -24,12 +53,24 @@
     NSMutableDictionary * _binaryNamesRegistry;
     
     NSMutableDictionary * _binaryNameToIdentifierRosettaStone;
+    
+    // Sorted by start address, built once the binary images are parsed and not modified afterwards
+    
+    CUIBinaryImageAddressesRange * _addressesRanges;
+    
+    NSUInteger _addressesRangesCount;
 }
 
 @property (readwrite) NSArray<CUIBinaryImage *> * binaryImages;
 
 - (BOOL)parseTextualRepresentation:(NSArray *)inLines reportVersion:(NSUInteger)inReportVersion outError:(NSError **)outError;
 
+- (void)_sortAddressesRanges;
+
+- (NSUInteger)_indexOfFirstAddressesRangeAfterMemoryAddress:(NSUInteger)inMemoryAddress;
+
+- (NSUInteger)_indexOfBinaryImageForMemoryAddress:(NSUInteger)inMemoryAddress fromAddressesRangeIndex:(NSUInteger)inIndex;
+
 @end
 
 
@@ -61,6 +102,8 @@
         {
             return nil;
         }
+        
+        [self _sortAddressesRanges];
     }
     
     return self;
@@ -117,11 +160,18 @@
         _binaryNamesRegistry=tBinaryNamesRegistry;
         
         _binaryNameToIdentifierRosettaStone=tBinaryNameToIdentifierRosettaStone;
+        
+        [self _sortAddressesRanges];
     }
     
     return self;
 }
 
+- (void)dealloc
+{
+    free(_addressesRanges);
+}
+
 #pragma mark -
 
 - (BOOL)parseTextualRepresentation:(NSArray *)inLines reportVersion:(NSUInteger)inReportVersion outError:(NSError **)outError
@@ -129,45 +179,74 @@
     if ([inLines.firstObject isEqualToString:@"Binary images description not available"]==YES)
         return YES;
     
-    __block NSError * tError=nil;
+    NSError * tError=nil;
     
     NSArray * tImagesLines=[inLines subarrayWithRange:NSMakeRange(1, inLines.count-1)];
     
     NSMutableArray * tBinaryImages=[NSMutableArray array];
     
-    [tImagesLines enumerateObjectsUsingBlock:^(NSString * bLine, NSUInteger bLineNumber, BOOL *bOutStop) {
-        
-        NSUInteger tLineLength=bLine.length;
+    // The lines of a textual crash log are scanned from its bytes (no string is created for them)
+    
+    CUICrashLogTextLines * tTextLines=([tImagesLines isKindOfClass:CUICrashLogTextLines.class]==YES) ? (CUICrashLogTextLines *)tImagesLines : nil;
+    const uint8_t * tBytes=(const uint8_t *)tTextLines.data.bytes;
+    
+    NSUInteger tCount=tImagesLines.count;
+    
+    for(NSUInteger tLineNumber=0;tLineNumber<tCount;tLineNumber++)
+    {
+        CUIBinaryImage * tBinaryImage=nil;
         
-        if (tLineLength==0)
+        if (tTextLines!=nil)
         {
-            *bOutStop=YES;
+            NSRange tRange=[tTextLines byteRangeOfLineAtIndex:tLineNumber];
+            const uint8_t * tLine=tBytes+tRange.location;
             
-            return;
+            if (tRange.length==0)
+                break;
+            
+            if (CUIUTF8BytesAreASCII(tLine,tRange.length)==YES)
+            {
+                tBinaryImage=[[CUIBinaryImage alloc] initWithUTF8Bytes:tLine length:tRange.length reportVersion:inReportVersion error:&tError];
+            }
+            else
+            {
+                // The bytes may not be valid UTF-8
+                
+                NSString * tString=tTextLines[tLineNumber];
+                
+                if (tString.length==0)
+                    break;
+                
+                tBinaryImage=[[CUIBinaryImage alloc] initWithString:tString reportVersion:inReportVersion error:&tError];
+            }
+        }
+        else
+        {
+            NSString * tLine=tImagesLines[tLineNumber];
+            
+            if (tLine.length==0)
+                break;
+            
+            tBinaryImage=[[CUIBinaryImage alloc] initWithString:tLine reportVersion:inReportVersion error:&tError];
         }
-        
-        CUIBinaryImage * tBinaryImage=[[CUIBinaryImage alloc] initWithString:bLine reportVersion:inReportVersion error:&tError];
         
         if (tBinaryImage==nil)
         {
-            tError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingUnknownError userInfo:@{CUIParsingErrorLineKey:@(bLineNumber)}];
+            tError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingUnknownError userInfo:@{CUIParsingErrorLineKey:@(tLineNumber)}];
             
-            *bOutStop=YES;
-            
-            return;
+            break;
         }
         
         [tBinaryImages addObject:tBinaryImage];
         
-        self->_binaryImagesRegistry[tBinaryImage.identifier]=tBinaryImage;
+        _binaryImagesRegistry[tBinaryImage.identifier]=tBinaryImage;
         
         NSString * tBinartName=tBinaryImage.path.lastPathComponent;
         
-        self->_binaryNamesRegistry[tBinartName]=tBinaryImage;
-        
-        self->_binaryNameToIdentifierRosettaStone[tBinartName]=tBinaryImage.identifier;
+        _binaryNamesRegistry[tBinartName]=tBinaryImage;
         
-    }];
+        _binaryNameToIdentifierRosettaStone[tBinartName]=tBinaryImage.identifier;
+    }
     
     _binaryImages=[tBinaryImages copy];
     
@@ -219,31 +298,129 @@
 
 - (CUIBinaryImage *)binaryImageForMemoryAddress:(NSUInteger)inMemoryAddress
 {
-    static CUIBinaryImage * sLastFoundBinaryImage=nil;
+    NSUInteger tIndex=[self _indexOfBinaryImageForMemoryAddress:inMemoryAddress fromAddressesRangeIndex:[self _indexOfFirstAddressesRangeAfterMemoryAddress:inMemoryAddress]];
     
-    if (sLastFoundBinaryImage!=nil)
-    {
-        CUIAddressesRange * tRange=sLastFoundBinaryImage.addressesRange;
-        
-        if (inMemoryAddress>=tRange.loadAddress && inMemoryAddress<(tRange.loadAddress+tRange.length))
-            return sLastFoundBinaryImage;
-    }
+    return (tIndex!=NSNotFound) ? _binaryImages[tIndex] : nil;
+}
+
+- (NSArray *)binaryImagesForSortedMemoryAddresses:(const NSUInteger *)inMemoryAddresses count:(NSUInteger)inCount
+{
+    if (inMemoryAddresses==NULL)
+        return @[];
+    
+    NSMutableArray * tBinaryImages=[NSMutableArray arrayWithCapacity:inCount];
+    
+    NSNull * tNull=[NSNull null];
     
-    for(CUIBinaryImage * tBinaryImage in _binaryImages)
+    // The ranges and the addresses are walked together
+    
+    NSUInteger tRangeIndex=0;
+    
+    for(NSUInteger tAddressIndex=0;tAddressIndex<inCount;tAddressIndex++)
     {
-        CUIAddressesRange * tRange=tBinaryImage.addressesRange;
+        NSUInteger tMemoryAddress=inMemoryAddresses[tAddressIndex];
         
-        if (inMemoryAddress>=tRange.loadAddress && inMemoryAddress<(tRange.loadAddress+tRange.length))
+        if (tAddressIndex>0 && tMemoryAddress<inMemoryAddresses[tAddressIndex-1])
         {
-            sLastFoundBinaryImage=tBinaryImage;
+            // Not sorted
             
-            return tBinaryImage;
+            tRangeIndex=[self _indexOfFirstAddressesRangeAfterMemoryAddress:tMemoryAddress];
         }
+        else
+        {
+            while (tRangeIndex<_addressesRangesCount && _addressesRanges[tRangeIndex].start<=tMemoryAddress)
+                tRangeIndex++;
+        }
+        
+        NSUInteger tIndex=[self _indexOfBinaryImageForMemoryAddress:tMemoryAddress fromAddressesRangeIndex:tRangeIndex];
+        
+        [tBinaryImages addObject:(tIndex!=NSNotFound) ? _binaryImages[tIndex] : tNull];
     }
     
-    return nil;
+    return [tBinaryImages copy];
 }
 
+#pragma mark -
+
+- (void)_sortAddressesRanges
+{
+    NSUInteger tCount=_binaryImages.count;
+    
+    if (tCount==0)
+        return;
+    
+    _addressesRanges=malloc(tCount*sizeof(CUIBinaryImageAddressesRange));
+    
+    if (_addressesRanges==NULL)
+        return;
+    
+    [_binaryImages enumerateObjectsUsingBlock:^(CUIBinaryImage * bBinaryImage, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        CUIAddressesRange * tRange=bBinaryImage.addressesRange;
+        
+        NSUInteger tStart=tRange.loadAddress;
+        NSUInteger tEnd=tStart+tRange.length;
+        
+        // No address can be found in an empty (or overflowing) range
+        
+        if (tEnd<=tStart)
+            return;
+        
+        self->_addressesRanges[self->_addressesRangesCount++]=(CUIBinaryImageAddressesRange){.start=tStart,.end=tEnd,.maximumEnd=0,.index=bIndex};
+    }];
+    
+    qsort(_addressesRanges,_addressesRangesCount,sizeof(CUIBinaryImageAddressesRange),CUIBinaryImageAddressesRangeCompare);
+    
+    NSUInteger tMaximumEnd=0;
+    
+    for(NSUInteger tIndex=0;tIndex<_addressesRangesCount;tIndex++)
+    {
+        tMaximumEnd=MAX(tMaximumEnd,_addressesRanges[tIndex].end);
+        
+        _addressesRanges[tIndex].maximumEnd=tMaximumEnd;
+    }
+}
+
+- (NSUInteger)_indexOfFirstAddressesRangeAfterMemoryAddress:(NSUInteger)inMemoryAddress
+{
+    NSUInteger tLowerIndex=0;
+    NSUInteger tUpperIndex=_addressesRangesCount;
+    
+    while (tLowerIndex<tUpperIndex)
+    {
+        NSUInteger tMiddleIndex=tLowerIndex+(tUpperIndex-tLowerIndex)/2;
+        
+        if (_addressesRanges[tMiddleIndex].start<=inMemoryAddress)
+            tLowerIndex=tMiddleIndex+1;
+        else
+            tUpperIndex=tMiddleIndex;
+    }
+    
+    return tLowerIndex;
+}
+
+- (NSUInteger)_indexOfBinaryImageForMemoryAddress:(NSUInteger)inMemoryAddress fromAddressesRangeIndex:(NSUInteger)inIndex
+{
+    // The ranges before inIndex start at or before the address. When ranges overlap, the first binary image of the list wins.
+    
+    NSUInteger tFoundIndex=NSNotFound;
+    
+    for(NSUInteger tIndex=inIndex;tIndex>0;tIndex--)
+    {
+        const CUIBinaryImageAddressesRange * tRange=&_addressesRanges[tIndex-1];
+        
+        if (tRange->maximumEnd<=inMemoryAddress)
+            break;
+        
+        if (inMemoryAddress<tRange->end && tRange->index<tFoundIndex)
+            tFoundIndex=tRange->index;
+    }
+    
+    return tFoundIndex;
+}
+
+#pragma mark -
+
 - (BOOL)isUserCodeAtMemoryAddress:(NSUInteger)inMemoryAddress inBinaryImage:(NSString *)inIdentifier
 {
     CUIBinaryImage * tBinaryImage=_binaryImagesRegistry[inIdentifier];
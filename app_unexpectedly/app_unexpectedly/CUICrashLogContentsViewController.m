@@ -23,6 +23,10 @@
 
 #import "CUIdSYMHunter.h"
 
+#import "CUISymbolicationManager.h"
+
+#import "CUICrashLogRegistersAnnotator.h"
+
 NSString * const CUIDefaultsPresentationModeKey=@"ui.presentationMode";
 
 NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"CUICrashLogContentsViewPresentationModeDidChangeNotification";
@@ -36,6 +40,11 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
     
     CUICrashLogPresentationViewController * _currentPresentationViewController;
     
+    // Cancellation token of the symbolication look ups of the crash log being presented.
+    // A crash log can be displayed in more than one window so it can't be the token.
+    
+    id _symbolicationCancellationToken;
+    
     CUIdSYMHunter * _shareddSYMHunter;
 }
 
@@ -47,6 +56,8 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
 
 - (void)huntDidFinish:(NSNotification *)inNotification;
 
+- (void)dSYMBundlesManagerDidAddBundles:(NSNotification *)inNotification;
+
 @end
 
 @implementation CUICrashLogContentsViewController
@@ -91,6 +102,8 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
     // Register for notifications
     
     [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(huntDidFinish:) name:CUIdSYMHunterHuntDidFinishNotification object:nil];
+    
+    [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(dSYMBundlesManagerDidAddBundles:) name:CUIdSYMBundlesManagerDidAddBundlesNotification object:nil];
 }
 
 #pragma mark -
@@ -217,18 +230,35 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
     if (_crashLog==inCrashLog)
         return;
     
+    // The look ups scheduled for the previous crash log are not needed anymore
+    
+    if (_symbolicationCancellationToken!=nil)
+        [[CUISymbolicationManager sharedSymbolicationManager] cancelLookUpsWithCancellationToken:_symbolicationCancellationToken];
+    
     _crashLog=inCrashLog;
     
+    _symbolicationCancellationToken=nil;
+    
     CUIApplicationPreferences * tApplicationPreferences=[CUIApplicationPreferences sharedPreferences];
     
     if (inCrashLog==nil)
         return;
     
+    _symbolicationCancellationToken=[NSObject new];
+    
+    // Parse the symbols files in the background before the presentation starts looking up the stack frames
+    
+    if (tApplicationPreferences.symbolicateAutomatically==YES)
+        [[CUISymbolicationManager sharedSymbolicationManager] prewarmSymbolsFilesOfCrashLog:inCrashLog cancellationToken:_symbolicationCancellationToken];
+    
+    _currentPresentationViewController.symbolicationCancellationToken=_symbolicationCancellationToken;
     _currentPresentationViewController.crashLog=inCrashLog;
     
     if ([inCrashLog isKindOfClass:[CUICrashLog class]]==NO)
         return;
     
+    [[CUICrashLogRegistersAnnotator sharedAnnotator] annotateRegistersOfCrashLog:inCrashLog cancellationToken:_symbolicationCancellationToken];
+    
     if (tApplicationPreferences.searchForSymbolsFilesAutomatically==YES)
         [self symbolicate];
 }
@@ -254,30 +284,19 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
 
 - (void)symbolicate
 {
-    NSArray * tUserCodeBinaryUUIDs=[self.crashLog.binaryImages.userCodeBinaryImages WB_arrayByMappingObjectsUsingBlock:^NSString *(CUIBinaryImage * bImage, NSUInteger bIndex) {
-        
-        return bImage.UUID;
-        
-    }];
+    // Skip the binary images whose UUIDs are already known to the dSYMBundleManager
     
-    NSMutableSet * tUUIDsSet=[NSMutableSet setWithArray:tUserCodeBinaryUUIDs];
-    
-    // Remove the UUIDs that are already known to the dSYMBundleManager
+    CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
     
-    [[CUIdSYMBundlesManager sharedManager].bundlesSet enumerateObjectsUsingBlock:^(CUIdSYMBundle * bBundle, BOOL * bOutStop) {
-        
-        NSArray * tUUIDs=bBundle.binaryUUIDs;
-        
-        if (tUUIDs.count==0)
-            return;
+    NSArray * tBinaryImages=[self.crashLog.binaryImages.userCodeBinaryImages WB_filteredArrayUsingBlock:^BOOL(CUIBinaryImage * bImage, NSUInteger bIndex) {
         
-        [tUUIDsSet minusSet:[NSSet setWithArray:tUUIDs]];
+        return (bImage.UUID!=nil && [tBundlesManager bundleForBinaryUUID:bImage.UUID]==nil);
     }];
     
-    if (tUUIDsSet.count==0)
+    if (tBinaryImages.count==0)
         return;
     
-    [_shareddSYMHunter huntBundleWithUUIDs:tUUIDsSet];
+    [_shareddSYMHunter huntBundlesForBinaryImages:tBinaryImages];
 }
 
 - (void)setPresentationMode:(CUIPresentationMode)inPresentationMode
@@ -348,6 +367,7 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
     
     if (inTransferCrashLog==YES)
     {
+        _currentPresentationViewController.symbolicationCancellationToken=_symbolicationCancellationToken;
         _currentPresentationViewController.crashLog=tCurrentCrashLog;
     }
     
@@ -498,4 +518,17 @@ NSString * const CUICrashLogContentsViewPresentationModeDidChangeNotification=@"
     // A COMPLETER
 }
 
+- (void)dSYMBundlesManagerDidAddBundles:(NSNotification *)inNotification
+{
+    // The registers and the stack frames pointing into the binary images of the new bundles can now be symbolicated
+    
+    if ([self.crashLog isKindOfClass:[CUICrashLog class]]==NO)
+        return;
+    
+    [[CUICrashLogRegistersAnnotator sharedAnnotator] annotateRegistersOfCrashLog:self.crashLog cancellationToken:_symbolicationCancellationToken];
+    
+    if ([CUIApplicationPreferences sharedPreferences].symbolicateAutomatically==YES)
+        [[CUISymbolicationManager sharedSymbolicationManager] prewarmSymbolsFilesOfCrashLog:self.crashLog cancellationToken:_symbolicationCancellationToken];
+}
+
 @end
@@ -15,6 +15,8 @@
 
 #import "IPSIncident.h"
 
+#import "CUIIPSReportIndex.h"
+
 @interface CUICrashLogExceptionInformation : NSObject
 
     @property (readonly) NSInteger crashedThreadIndex;  // -1 -> Unknown
@@ -39,6 +41,8 @@
 
 - (instancetype)initWithIPSIncident:(IPSIncident *)inIncident error:(NSError **)outError;
 
+- (instancetype)initWithIPSReportIndex:(CUIIPSReportIndex *)inIndex error:(NSError **)outError;
+
 - (NSString *)displayedExceptionType;
 
 @end
@@ -251,6 +251,51 @@
     return self;
 }
 
+- (instancetype)initWithIPSReportIndex:(CUIIPSReportIndex *)inIndex error:(NSError **)outError
+{
+    if ([inIndex isKindOfClass:CUIIPSReportIndex.class]==NO)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _crashedThreadIndex=inIndex.faultingThreadIndex;
+        
+        NSString * tQueue=inIndex.triggeredThreadQueue;
+        
+        if (tQueue!=nil)
+            _crashedThreadName=[NSString stringWithFormat:@"Dispatch queue: %@",tQueue];
+        
+        _exceptionType=inIndex.exceptionType;
+        
+        _exceptionSignal=inIndex.exceptionSignal;
+        
+        _exceptionSubtype=inIndex.exceptionCodes;
+        
+        NSUInteger tNumberOfRawCodes=inIndex.numberOfExceptionRawCodes;
+        NSMutableArray * tExceptionCodes=[NSMutableArray arrayWithCapacity:tNumberOfRawCodes];
+        
+        for(NSUInteger tIndex=0;tIndex<tNumberOfRawCodes;tIndex++)
+            [tExceptionCodes addObject:@"A COMPLETER"];
+        
+        _exceptionCodes=[tExceptionCodes copy];
+        
+        _exceptionNote=(inIndex.isCorpse==YES) ? @"EXC_CORPSE_NOTIFY" : nil;
+        
+        _terminationNamespace=inIndex.terminationNamespace;
+        
+        _terminationCode=inIndex.terminationCode;
+    }
+    
+    return self;
+}
+
 #pragma mark -
 
 - (BOOL)parseTextualRepresentation:(NSArray *)inLines outError:(NSError **)outError
@@ -15,6 +15,8 @@
 
 #import "IPSIncident.h"
 
+#import "CUIIPSReportIndex.h"
+
 #import "CUIOperatingSystemVersion.h"
 
 #include "CUICodeType.h"
@@ -73,4 +75,6 @@
 
 - (instancetype)initWithIPSIncident:(IPSIncident *)inIncident error:(NSError **)outError;
 
+- (instancetype)initWithIPSReportIndex:(CUIIPSReportIndex *)inIndex error:(NSError **)outError;
+
 @end
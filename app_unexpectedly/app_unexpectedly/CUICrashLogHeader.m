@@ -15,6 +15,25 @@
 
 #import "CUIParsingErrors.h"
 
+static CUIOperatingSystemVersion * CUIOperatingSystemVersionWithTrain(NSString * inTrain)
+{
+    NSString * tPrefix=@"Mac OS X ";
+    
+    // A COMPLETER (Think iOS)
+    
+    if ([inTrain hasPrefix:tPrefix]==NO)
+    {
+        tPrefix=@"macOS ";
+        
+        if ([inTrain hasPrefix:tPrefix]==NO)
+        {
+            tPrefix=@"";
+        }
+    }
+    
+    return [[CUIOperatingSystemVersion alloc] initWithString:[inTrain substringFromIndex:tPrefix.length]];
+}
+
 @interface CUICrashLogHeader ()
 {
     NSDateFormatter * _dateFormatter;
@@ -211,23 +230,7 @@
         
         _dateTime=tIPSHeader.captureTime;
         
-        NSString * tSystemVersionTrain=tIPSHeader.operatingSystemVersion.train;
-        
-        NSString * tPrefix=@"Mac OS X ";
-        
-        // A COMPLETER (Think iOS)
-        
-        if ([tSystemVersionTrain hasPrefix:tPrefix]==NO)
-        {
-            tPrefix=@"macOS ";
-            
-            if ([tSystemVersionTrain hasPrefix:tPrefix]==NO)
-            {
-                tPrefix=@"";
-            }
-        }
-        
-        _operatingSystemVersion=[[CUIOperatingSystemVersion alloc] initWithString:[tSystemVersionTrain substringFromIndex:tPrefix.length]];
+        _operatingSystemVersion=CUIOperatingSystemVersionWithTrain(tIPSHeader.operatingSystemVersion.train);
         
         _systemIntegrityProtectionEnabled=tIPSHeader.systemIntegrityProtectionEnable;
         
@@ -285,6 +288,74 @@
     return self;
 }
 
+- (instancetype)initWithIPSReportIndex:(CUIIPSReportIndex *)inIndex error:(NSError **)outError
+{
+    if ([inIndex isKindOfClass:CUIIPSReportIndex.class]==NO)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        // Same values as the ones of the IPS incident
+        
+        _reportVersion=12;
+        
+        _dateTime=inIndex.captureTime;
+        
+        _operatingSystemVersion=CUIOperatingSystemVersionWithTrain(inIndex.operatingSystemTrain);
+        
+        _systemIntegrityProtectionEnabled=inIndex.isSystemIntegrityProtectionEnabled;
+        
+        _bridgeOSVersion=nil;
+        
+        _anonymousUUID=inIndex.crashReporterKey;
+        
+        
+        NSString * tCPUType=inIndex.cpuType;
+        
+        _codeType=([tCPUType isEqualToString:@"X86-64"]==YES) ? CUICodeTypeX86_64 : CUICodeTypeARM_64;
+        
+        _native=(inIndex.isTranslated==NO);
+        
+        
+        _executablePath=inIndex.processPath;
+        
+        _bundleIdentifier=inIndex.bundleIdentifier;
+        
+        NSString * tBundleVersion=inIndex.bundleVersion;
+        
+        if (tBundleVersion!=nil)
+        {
+            _executableVersion=[NSString stringWithFormat:@"%@ (%@)",inIndex.bundleShortVersionString,tBundleVersion];
+        }
+        else
+        {
+            _executableVersion=inIndex.bundleShortVersionString;
+        }
+        
+        
+        _responsibleProcessName=inIndex.responsibleProcessName;
+        _responsibleProcessIdentifier=inIndex.responsibleProcessIdentifier;
+        
+        _processName=inIndex.processName;
+        _processIdentifier=inIndex.processIdentifier;
+        
+        _parentProcessName=inIndex.parentProcessName;
+        _parentProcessIdentifier=inIndex.parentProcessIdentifier;
+        
+        
+        _userIdentifier=inIndex.userIdentifier;
+    }
+    
+    return self;
+}
+
 #pragma mark -
 
 - (BOOL)parseTextualRepresentation:(NSArray *)inLines outError:(NSError **)outError
@@ -0,0 +1,139 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUICrashLogHeaderReader.h"
+
+#import "CUICrashLogSectionsDetector.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CUICrashLogHeaderReaderChunkSize        16384
+
+#define CUICrashLogHeaderReaderMaximumSize      262144
+
+@interface CUICrashLogHeaderReader ()
+
++ (NSUInteger)_lengthOfHeaderInData:(NSData *)inData;
+
+@end
+
+@implementation CUICrashLogHeaderReader
+
++ (NSUInteger)_lengthOfHeaderInData:(NSData *)inData
+{
+    const uint8_t * tBytes=(const uint8_t *)inData.bytes;
+    NSUInteger tLength=inData.length;
+    
+    if (tLength==0)
+        return 0;
+    
+    // IPS report: the summary is a JSON object on the first line
+    
+    if (tBytes[0]=='{')
+    {
+        const uint8_t * tNewLine=memchr(tBytes,'\n',tLength);
+        
+        return (tNewLine!=NULL) ? (tNewLine-tBytes)+1 : 0;
+    }
+    
+    if (tLength<(sizeof("Process:")-1))
+        return 0;
+    
+    if (memcmp(tBytes,"Process:",sizeof("Process:")-1)!=0)
+        return NSNotFound;
+    
+    // Textual crash log: only the complete lines are looked at
+    
+    NSUInteger tLinesLength=tLength;
+    
+    while (tLinesLength>0 && tBytes[tLinesLength-1]!='\n')
+        tLinesLength--;
+    
+    if (tLinesLength==0)
+        return 0;
+    
+    CUICrashLogTextLines * tLines=[[CUICrashLogTextLines alloc] initWithData:[NSData dataWithBytesNoCopy:(void *)tBytes length:tLinesLength freeWhenDone:NO]];
+    
+    CUICrashLogSectionsDetector * tDetector=[[CUICrashLogSectionsDetector alloc] initWithLines:tLines];
+    
+    if ([tDetector detectSectionsThroughSection:CUICrashLogSectionTypeExceptionInformation error:NULL]==NO)
+        return 0;
+    
+    return tLinesLength;
+}
+
++ (NSData *)headerDataOfFileAtURL:(NSURL *)inURL endOfFile:(BOOL *)outEndOfFile
+{
+    if ([inURL isKindOfClass:NSURL.class]==NO || inURL.isFileURL==NO)
+        return nil;
+    
+    int tFileDescriptor=open(inURL.fileSystemRepresentation,O_RDONLY|O_CLOEXEC);
+    
+    if (tFileDescriptor==-1)
+        return nil;
+    
+    NSMutableData * tData=[NSMutableData dataWithCapacity:CUICrashLogHeaderReaderChunkSize];
+    NSData * tHeaderData=nil;
+    BOOL tEndOfFile=NO;
+    
+    while (tData.length<CUICrashLogHeaderReaderMaximumSize)
+    {
+        NSUInteger tLength=tData.length;
+        
+        tData.length=tLength+CUICrashLogHeaderReaderChunkSize;
+        
+        ssize_t tReadSize=read(tFileDescriptor,(uint8_t *)tData.mutableBytes+tLength,CUICrashLogHeaderReaderChunkSize);
+        
+        if (tReadSize<0)
+        {
+            tData.length=tLength;
+            
+            if (errno==EINTR)
+                continue;
+            
+            break;
+        }
+        
+        tData.length=tLength+tReadSize;
+        
+        if (tReadSize==0)
+        {
+            tHeaderData=tData;
+            tEndOfFile=YES;
+            
+            break;
+        }
+        
+        NSUInteger tHeaderLength=[self _lengthOfHeaderInData:tData];
+        
+        if (tHeaderLength==NSNotFound)
+            break;
+        
+        if (tHeaderLength>0)
+        {
+            tHeaderData=[tData subdataWithRange:NSMakeRange(0,tHeaderLength)];
+            
+            break;
+        }
+    }
+    
+    close(tFileDescriptor);
+    
+    if (outEndOfFile!=NULL)
+        *outEndOfFile=tEndOfFile;
+    
+    return tHeaderData;
+}
+
+@end
@@ -350,6 +350,7 @@ typedef NS_ENUM(NSUInteger, CUIThreadsModeView)
         }
     }
     
+    _threadsViewController.symbolicationCancellationToken=self.symbolicationCancellationToken;
     _threadsViewController.crashLog=inCrashLog;
 	
     _threadsViewController.showOnlyCrashedThread=self.displaySettings.showOnlyCrashedThread;
@@ -450,6 +451,7 @@ typedef NS_ENUM(NSUInteger, CUIThreadsModeView)
 	
 	[_threadsContainerView addSubview:_threadsViewController.view];
     
+	_threadsViewController.symbolicationCancellationToken=self.symbolicationCancellationToken;
 	_threadsViewController.crashLog=self.crashLog;
 	
 	_threadsViewController.showOnlyCrashedThread=self.showOnlyCrashedThread;
@@ -78,6 +78,10 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
     NSArray * _sectionsList;
     
     NSDictionary * _sectionsRanges;
+    
+    CUIReportThemedTransform * _textTransform;
+    
+    NSMutableSet<CUIStackFrame *> * _symbolicatedStackFrames;
 }
 
 @property CUITextModeDisplaySettings * displaySettings;
@@ -86,6 +90,10 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
 
 - (void)refreshText;
 
+- (void)refreshSectionsRanges;
+
+- (void)refreshSymbolicatedStackFrames;
+
 - (IBAction)CUI_MENUACTION_exportCrashLog:(id)sender;
 
 
@@ -598,6 +606,8 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
         tDataTransform.input=tCrashLog;
     }
     
+    ((CUIReportThemedTransform *)tDataTransform).symbolicationCancellationToken=self.symbolicationCancellationToken;
+    
     tDataTransform.displaySettings=self.displaySettings;
     tDataTransform.fontSizeDelta=_fontSizeDelta;
     
@@ -621,6 +631,21 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
     
     //[_textView.layoutManager ensureLayoutForTextContainer:_textView.textContainer];
     
+    // The symbols of the stack frames being symbolicated are replaced in place
+    
+    _textTransform=(CUIReportThemedTransform *)tDataTransform;
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(refreshSymbolicatedStackFrames) object:nil];
+    
+    [_symbolicatedStackFrames removeAllObjects];
+    
+    [self refreshSectionsRanges];
+}
+
+- (void)refreshSectionsRanges
+{
+    NSAttributedString * tAttributedString=_textView.textStorage;
+    
     // Compute sections ranges
     
     __block NSString * tPreviousSection=nil;
@@ -681,6 +706,56 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
     _sectionsRanges=[tMutableDictionary copy];
 }
 
+- (void)refreshSymbolicatedStackFrames
+{
+    NSTextStorage * tTextStorage=_textView.textStorage;
+    
+    NSMutableArray<NSValue *> * tRanges=[NSMutableArray array];
+    NSMutableArray<CUIStackFrame *> * tStackFrames=[NSMutableArray array];
+    
+    // Ranges are collected from the end so that replacing one does not shift the others
+    
+    [tTextStorage enumerateAttribute:CUIStackFrameSymbolAttributeName
+                             inRange:NSMakeRange(0,tTextStorage.length)
+                             options:NSAttributedStringEnumerationReverse
+                          usingBlock:^(CUIStackFrame * bStackFrame, NSRange bRange, BOOL * bOutStop) {
+                              
+                              if (bStackFrame==nil)
+                                  return;
+                              
+                              if ([self->_symbolicatedStackFrames containsObject:bStackFrame]==NO)
+                                  return;
+                              
+                              [tRanges addObject:[NSValue valueWithRange:bRange]];
+                              [tStackFrames addObject:bStackFrame];
+                          }];
+    
+    [_symbolicatedStackFrames removeAllObjects];
+    
+    if (tRanges.count==0)
+        return;
+    
+    [tTextStorage beginEditing];
+    
+    [tRanges enumerateObjectsUsingBlock:^(NSValue * bValue, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        NSString * tSymbol=[self->_textTransform symbolicatedSymbolOfStackFrame:tStackFrames[bIndex]];
+        
+        if (tSymbol==nil)
+            return;
+        
+        NSRange tRange=bValue.rangeValue;
+        
+        [tTextStorage replaceCharactersInRange:tRange withString:tSymbol];
+        
+        [tTextStorage removeAttribute:CUIStackFrameSymbolAttributeName range:NSMakeRange(tRange.location,tSymbol.length)];
+    }];
+    
+    [tTextStorage endEditing];
+    
+    [self refreshSectionsRanges];
+}
+
 #pragma mark - CUIEQuickHelpPopUpViewControllerDelegate
 
 - (void)quickHelpPopUpViewController:(CUIQuickHelpPopUpViewController *)inController didComputeSizeOfPopover:(NSPopover *)inPopover
@@ -1205,6 +1280,8 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
             tDataTransform.input=self.crashLog;
         }
         
+        ((CUIReportThemedTransform *)tDataTransform).symbolicationCancellationToken=self.symbolicationCancellationToken;
+        
         tDataTransform.displaySettings=[tAccessoryViewController.displaySettings copy];
         tDataTransform.fontSizeDelta=0;
         
@@ -1739,11 +1816,72 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
     if ([self.crashLog isMemberOfClass:[CUIRawCrashLog class]]==YES)
         return;
     
-    // Ideally we should just request to symbolicate the machineInstructionAddresses that can be
+    if ([CUIApplicationPreferences sharedPreferences].symbolicateAutomatically==NO)
+        return;
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(refreshText) object:nil];
+    // Only look up the displayed stack frames located in the new binaries which are not symbolicated yet
     
-    [self performSelector:@selector(refreshText) withObject:nil afterDelay:0.1];
+    NSMutableSet<CUIStackFrame *> * tAffectedStackFrames=[NSMutableSet set];
+    
+    for(NSString * tBinaryUUID in inNotification.object)
+        [tAffectedStackFrames addObjectsFromArray:[self.crashLog stackFramesForBinaryUUID:tBinaryUUID]];
+    
+    if (tAffectedStackFrames.count==0)
+        return;
+    
+    NSMutableSet<CUIStackFrame *> * tStackFrames=[NSMutableSet set];
+    
+    NSTextStorage * tTextStorage=_textView.textStorage;
+    
+    [tTextStorage enumerateAttribute:CUIStackFrameSymbolAttributeName
+                             inRange:NSMakeRange(0,tTextStorage.length)
+                             options:0
+                          usingBlock:^(CUIStackFrame * bStackFrame, NSRange bRange, BOOL * bOutStop) {
+                              
+                              if (bStackFrame==nil || bStackFrame.symbolicationData!=nil)
+                                  return;
+                              
+                              if ([tAffectedStackFrames containsObject:bStackFrame]==YES)
+                                  [tStackFrames addObject:bStackFrame];
+                          }];
+    
+    CUICrashLog * tCrashLog=self.crashLog;
+    
+    for(CUIStackFrame * tStackFrame in tStackFrames)
+    {
+        CUIBinaryImage * tBinaryImage=[tCrashLog.binaryImages binaryImageWithIdentifierOrName:tStackFrame.binaryImageIdentifier identifier:NULL];
+        
+        if (tBinaryImage==nil)
+            continue;
+        
+        NSUInteger tAddress=tStackFrame.machineInstructionAddress-tBinaryImage.binaryImageOffset;
+        
+        [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
+                                                                                                       binaryUUID:tBinaryImage.UUID
+                                                                                                         priority:CUISymbolicationPriorityRestOfLog
+                                                                                                cancellationToken:self.symbolicationCancellationToken
+                                                                                                completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
+                                                                                                    
+                                                                                                    switch(bLookUpResult)
+                                                                                                    {
+                                                                                                        case CUISymbolicationDataLookUpResultError:
+                                                                                                        case CUISymbolicationDataLookUpResultNotFound:
+                                                                                                            
+                                                                                                            break;
+                                                                                                            
+                                                                                                        case CUISymbolicationDataLookUpResultFound:
+                                                                                                        case CUISymbolicationDataLookUpResultFoundInCache:
+                                                                                                            
+                                                                                                            tStackFrame.symbolicationData=bSymbolicationData;
+                                                                                                            
+                                                                                                            [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
+                                                                                                                                                              object:tCrashLog
+                                                                                                                                                            userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tStackFrame}];
+                                                                                                            
+                                                                                                            break;
+                                                                                                    }
+                                                                                                }];
+    }
 }
 
 - (void)stackFrameSymbolicationDidSucceed:(NSNotification *)inNotification
@@ -1754,9 +1892,21 @@ NSString * const CUICrashLogPresentationTextViewFontSizeDelta=@"ui.text.fontSize
     if ([self.crashLog isMemberOfClass:[CUIRawCrashLog class]]==YES)
         return;
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(refreshText) object:nil];
+    CUIStackFrame * tStackFrame=inNotification.userInfo[CUIStackFrameSymbolicationStackFrameKey];
     
-    [self performSelector:@selector(refreshText) withObject:nil afterDelay:0.1];
+    if (tStackFrame==nil)
+        return;
+    
+    // Only replace the symbols of the symbolicated stack frames (coalesced)
+    
+    if (_symbolicatedStackFrames==nil)
+        _symbolicatedStackFrames=[NSMutableSet set];
+    
+    [_symbolicatedStackFrames addObject:tStackFrame];
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(refreshSymbolicatedStackFrames) object:nil];
+    
+    [self performSelector:@selector(refreshSymbolicatedStackFrames) withObject:nil afterDelay:0.1];
 }
 
 @end
@@ -37,6 +37,10 @@ extern NSString * const CUICrashLogPresentationVisibleSectionsDidChangeNotificat
     IBOutlet NSButton * _showBinaryNameButton;
 }
 
+    // Set before the crash log. The symbolication look ups of the presentation are made with it.
+
+    @property (nonatomic) id symbolicationCancellationToken;
+
     @property (nonatomic) CUICrashLog * crashLog;
 
     @property (nonatomic) CUIStackFrameComponents visibleStackFrameComponents;
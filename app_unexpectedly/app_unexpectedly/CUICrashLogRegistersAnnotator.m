@@ -0,0 +1,256 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUICrashLogRegistersAnnotator.h"
+
+#import "CUIRegisterAnnotation.h"
+
+#import "CUIdSYMBundlesManager.h"
+
+#import "CUISymbolicationManager.h"
+
+#include <mach/machine.h>
+
+// Pointer authentication codes are stored in the upper bits of the arm64e code pointers
+
+#define CUIARM64AddressMask     0x0000007FFFFFFFFFUL
+
+NSString * const CUICrashLogRegistersAnnotatorDidAnnotateRegistersNotification=@"CUICrashLogRegistersAnnotatorDidAnnotateRegistersNotification";
+
+@interface CUIVMRegion : NSObject
+
+    @property NSUInteger start;
+
+    @property NSUInteger end;
+
+    @property (copy) NSString * name;
+
+@end
+
+@implementation CUIVMRegion
+@end
+
+@interface CUICrashLogRegistersAnnotator ()
+
++ (NSArray<CUIVMRegion *> *)VMRegionsOfDiagnosticMessages:(NSString *)inMessages;
+
+@end
+
+@implementation CUICrashLogRegistersAnnotator
+
++ (CUICrashLogRegistersAnnotator *)sharedAnnotator
+{
+    static CUICrashLogRegistersAnnotator * sAnnotator=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sAnnotator=[CUICrashLogRegistersAnnotator new];
+    });
+    
+    return sAnnotator;
+}
+
++ (NSArray<CUIVMRegion *> *)VMRegionsOfDiagnosticMessages:(NSString *)inMessages
+{
+    if (inMessages.length==0)
+        return @[];
+    
+    // e.g. "--->  __TEXT    102560000-102568000    [   32K] r-x/r-x SM=COW  /path/to/binary"
+    
+    static NSRegularExpression * sRegionRegularExpression=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sRegionRegularExpression=[NSRegularExpression regularExpressionWithPattern:@"^\\s*(?:--->?\\s*)?(\\S.*?)\\s+([0-9a-fA-F]+)-([0-9a-fA-F]+)\\s+\\["
+                                                                           options:NSRegularExpressionAnchorsMatchLines
+                                                                             error:NULL];
+    });
+    
+    NSMutableArray * tRegions=[NSMutableArray array];
+    
+    [sRegionRegularExpression enumerateMatchesInString:inMessages options:0 range:NSMakeRange(0,inMessages.length) usingBlock:^(NSTextCheckingResult * bResult, NSMatchingFlags bFlags, BOOL * bOutStop) {
+        
+        CUIVMRegion * tRegion=[CUIVMRegion new];
+        
+        tRegion.name=[inMessages substringWithRange:[bResult rangeAtIndex:1]];
+        
+        tRegion.start=strtoul([inMessages substringWithRange:[bResult rangeAtIndex:2]].UTF8String, NULL, 16);
+        tRegion.end=strtoul([inMessages substringWithRange:[bResult rangeAtIndex:3]].UTF8String, NULL, 16);
+        
+        if (tRegion.end>tRegion.start)
+            [tRegions addObject:tRegion];
+    }];
+    
+    [tRegions sortUsingComparator:^NSComparisonResult(CUIVMRegion * bRegion1, CUIVMRegion * bRegion2) {
+        
+        if (bRegion1.start<bRegion2.start)
+            return NSOrderedAscending;
+        
+        if (bRegion1.start>bRegion2.start)
+            return NSOrderedDescending;
+        
+        return NSOrderedSame;
+    }];
+    
+    return tRegions;
+}
+
+#pragma mark -
+
+- (void)annotateRegistersOfCrashLog:(CUICrashLog *)inCrashLog cancellationToken:(id)inToken
+{
+    if ([inCrashLog isKindOfClass:CUICrashLog.class]==NO)
+        return;
+    
+    CUICrashLogThreadState * tThreadState=inCrashLog.threadState;
+    
+    if (tThreadState.registers.count==0)
+        return;
+    
+    BOOL tStripsPointerAuthentication=(tThreadState.CPUType==CPU_TYPE_ARM64);
+    
+    // Sort the registers by address so that a single walk classifies all the values
+    
+    NSArray<CUIRegister *> * tRegisters=[tThreadState.registers sortedArrayUsingComparator:^NSComparisonResult(CUIRegister * bRegister1, CUIRegister * bRegister2) {
+        
+        NSUInteger tValue1=(tStripsPointerAuthentication==YES) ? (bRegister1.value & CUIARM64AddressMask) : bRegister1.value;
+        NSUInteger tValue2=(tStripsPointerAuthentication==YES) ? (bRegister2.value & CUIARM64AddressMask) : bRegister2.value;
+        
+        if (tValue1<tValue2)
+            return NSOrderedAscending;
+        
+        if (tValue1>tValue2)
+            return NSOrderedDescending;
+        
+        return NSOrderedSame;
+    }];
+    
+    NSUInteger tRegistersCount=tRegisters.count;
+    NSMutableData * tValuesData=[NSMutableData dataWithLength:tRegistersCount*sizeof(NSUInteger)];
+    NSUInteger * tValues=(NSUInteger *)tValuesData.mutableBytes;
+    
+    for(NSUInteger tRegisterIndex=0;tRegisterIndex<tRegistersCount;tRegisterIndex++)
+    {
+        NSUInteger tValue=tRegisters[tRegisterIndex].value;
+        
+        tValues[tRegisterIndex]=(tStripsPointerAuthentication==YES) ? (tValue & CUIARM64AddressMask) : tValue;
+    }
+    
+    NSArray * tBinaryImages=[inCrashLog.binaryImages binaryImagesForSortedMemoryAddresses:tValues count:tRegistersCount];
+    
+    NSArray<CUIVMRegion *> * tRegions=[CUICrashLogRegistersAnnotator VMRegionsOfDiagnosticMessages:inCrashLog.diagnosticMessages.messages];
+    
+    NSUInteger tRegionsCount=tRegions.count;
+    NSUInteger tRegionIndex=0;
+    
+    NSMutableArray<CUIRegister *> * tRegistersToLookUp=[NSMutableArray array];
+    NSMutableArray<CUIBinaryImage *> * tBinaryImagesToLookUp=[NSMutableArray array];
+    
+    CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
+    
+    for(NSUInteger tRegisterIndex=0;tRegisterIndex<tRegistersCount;tRegisterIndex++)
+    {
+        CUIRegister * tRegister=tRegisters[tRegisterIndex];
+        NSUInteger tValue=tValues[tRegisterIndex];
+        
+        if (tValue==0)
+        {
+            tRegister.annotation=[CUIRegisterAnnotation nullAnnotation];
+            
+            continue;
+        }
+        
+        CUIBinaryImage * tBinaryImage=tBinaryImages[tRegisterIndex];
+        
+        if ([tBinaryImage isKindOfClass:CUIBinaryImage.class]==YES)
+        {
+            CUIAddressesRange * tRange=tBinaryImage.addressesRange;
+            
+            CUIRegisterAnnotation * tAnnotation=[[CUIRegisterAnnotation alloc] initWithBinaryImageIdentifier:tBinaryImage.identifier
+                                                                                                     offset:tValue-tRange.loadAddress
+                                                                                                   userCode:tBinaryImage.isUserCode];
+            
+            // Keep the symbol found by a previous pass
+            
+            CUIRegisterAnnotation * tPreviousAnnotation=tRegister.annotation;
+            
+            if (tPreviousAnnotation.kind==CUIRegisterAnnotationKindBinaryImage && tPreviousAnnotation.binaryImageOffset==tAnnotation.binaryImageOffset)
+                tAnnotation.symbolicationData=tPreviousAnnotation.symbolicationData;
+            
+            tRegister.annotation=tAnnotation;
+            
+            if (tAnnotation.symbolicationData==nil && tBinaryImage.UUID!=nil && [tBundlesManager bundleForBinaryUUID:tBinaryImage.UUID]!=nil)
+            {
+                [tRegistersToLookUp addObject:tRegister];
+                [tBinaryImagesToLookUp addObject:tBinaryImage];
+            }
+            
+            continue;
+        }
+        
+        while (tRegionIndex<tRegionsCount && tRegions[tRegionIndex].end<=tValue)
+            tRegionIndex++;
+        
+        if (tRegionIndex<tRegionsCount && tValue>=tRegions[tRegionIndex].start)
+        {
+            tRegister.annotation=[[CUIRegisterAnnotation alloc] initWithRegionName:tRegions[tRegionIndex].name];
+            
+            continue;
+        }
+        
+        tRegister.annotation=nil;
+    }
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:CUICrashLogRegistersAnnotatorDidAnnotateRegistersNotification object:inCrashLog];
+    
+    if (tRegistersToLookUp.count==0)
+        return;
+    
+    // The completion handlers are called on the main queue. They are not called for the cancelled look ups.
+    
+    __block NSUInteger tPendingLookUpsCount=tRegistersToLookUp.count;
+    
+    __block BOOL tFoundSymbols=NO;
+    
+    CUISymbolicationManager * tSymbolicationManager=[CUISymbolicationManager sharedSymbolicationManager];
+    
+    [tRegistersToLookUp enumerateObjectsUsingBlock:^(CUIRegister * bRegister, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        CUIBinaryImage * tBinaryImage=tBinaryImagesToLookUp[bIndex];
+        
+        CUIRegisterAnnotation * tAnnotation=bRegister.annotation;
+        
+        [tSymbolicationManager lookUpSymbolicationDataForMachineInstructionAddress:tBinaryImage.addressesRange.loadAddress+tAnnotation.binaryImageOffset-tBinaryImage.binaryImageOffset
+                                                                        binaryUUID:tBinaryImage.UUID
+                                                                          priority:CUISymbolicationPriorityVisibleFrames
+                                                                 cancellationToken:inToken
+                                                                 completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                                     
+                                                                     if (bLookUpResult==CUISymbolicationDataLookUpResultFound || bLookUpResult==CUISymbolicationDataLookUpResultFoundInCache)
+                                                                     {
+                                                                         tAnnotation.symbolicationData=bSymbolicationData;
+                                                                         
+                                                                         tFoundSymbols=YES;
+                                                                     }
+                                                                     
+                                                                     tPendingLookUpsCount--;
+                                                                     
+                                                                     if (tPendingLookUpsCount==0 && tFoundSymbols==YES)
+                                                                         [[NSNotificationCenter defaultCenter] postNotificationName:CUICrashLogRegistersAnnotatorDidAnnotateRegistersNotification object:inCrashLog];
+                                                                 }];
+    }];
+}
+
+@end
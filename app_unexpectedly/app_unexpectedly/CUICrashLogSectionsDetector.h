@@ -11,20 +11,42 @@
  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#import <Foundation/Foundation.h>
+#import "CUICrashLogTextLines.h"
+
+typedef NS_ENUM(NSUInteger, CUICrashLogSectionType)
+{
+    CUICrashLogSectionTypeHeader=0,
+    CUICrashLogSectionTypeExceptionInformation,
+    CUICrashLogSectionTypeDiagnosticMessages,
+    CUICrashLogSectionTypeBacktraces,
+    CUICrashLogSectionTypeThreadState,
+    CUICrashLogSectionTypeBinaryImages
+};
+
+#define CUICrashLogSectionTypesCount    (CUICrashLogSectionTypeBinaryImages+1)
+
+typedef struct
+{
+    NSRange lineRange;      // location is NSNotFound when the section is not available
+    
+    NSRange byteRange;      // Line terminators included
+    
+} CUICrashLogSectionRange;
+
+// Finds the sections of a textual crash log in one pass over the bytes of its lines.
 
 @interface CUICrashLogSectionsDetector : NSObject
 
-+ (NSRange)detectHeaderSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+- (instancetype)initWithLines:(CUICrashLogTextLines *)inLines;
 
-+ (NSRange)detectExceptionInformationSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+// The name of the section which could not be delimited is set in the userInfo of the error (CUIParsingErrorSectionNameKey)
 
-+ (NSRange)detectDiagnosticMessageSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+- (BOOL)detectSections:(NSError **)outError;
 
-+ (NSRange)detectBacktracesSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+// Stops once this section is delimited (the lines can be the beginning of the log only), the later sections are not detected
 
-+ (NSRange)detectThreadStateSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+- (BOOL)detectSectionsThroughSection:(CUICrashLogSectionType)inSectionType error:(NSError **)outError;
 
-+ (NSRange)detectBinaryImagesSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes;
+- (CUICrashLogSectionRange)rangeOfSection:(CUICrashLogSectionType)inSectionType;
 
 @end
@@ -13,153 +13,303 @@
 
 #import "CUICrashLogSectionsDetector.h"
 
-@implementation CUICrashLogSectionsDetector
+#import "CUIParsingErrors.h"
+
+#include <string.h>
+#include <strings.h>
+
+// Section markers which can be found at the beginning of a line
+
+typedef NS_OPTIONS(uint32_t, CUICrashLogLineMarkers)
+{
+    CUICrashLogLineMarkerCrashedThread=1<<0,                    // Crashed Thread:
+    CUICrashLogLineMarkerExceptionType=1<<1,                    // Exception Type:
+    CUICrashLogLineMarkerApplicationSpecificInformation=1<<2,   // Application Specific Information:
+    CUICrashLogLineMarkerVMRegionsNear=1<<3,                    // VM Regions Near
+    CUICrashLogLineMarkerVMRegionInfo=1<<4,                     // VM Region Info:
+    CUICrashLogLineMarkerBacktraceNotAvailable=1<<5,            // Backtrace not available (whole line)
+    CUICrashLogLineMarkerApplicationSpecificBacktrace=1<<6,     // Application Specific Backtrace
+    CUICrashLogLineMarkerThread0=1<<7,                          // Thread 0
+    CUICrashLogLineMarkerThreadCrashedWith=1<<8,                // Thread ... crashed with
+    CUICrashLogLineMarkerUnknownCrashedWith=1<<9,               // Unknown ... crashed with
+    CUICrashLogLineMarkerUnknownThreadCrashedWith=1<<10,        // Unknown thread ... crashed with
+    CUICrashLogLineMarkerThreadState=1<<11,                     // Thread State (case insensitive)
+    CUICrashLogLineMarkerBinaryImages=1<<12                     // Binary Images (case insensitive)
+};
+
+// Lines starting an optional section (the section must start right after the previous one)
+
+static const CUICrashLogLineMarkers CUICrashLogSectionStartMarkers[CUICrashLogSectionTypesCount]=
+{
+    0,
+    0,
+    CUICrashLogLineMarkerApplicationSpecificInformation|CUICrashLogLineMarkerVMRegionsNear|CUICrashLogLineMarkerVMRegionInfo,
+    CUICrashLogLineMarkerBacktraceNotAvailable|CUICrashLogLineMarkerApplicationSpecificBacktrace|CUICrashLogLineMarkerThread0,
+    CUICrashLogLineMarkerThreadCrashedWith|CUICrashLogLineMarkerUnknownThreadCrashedWith|CUICrashLogLineMarkerThreadState,
+    CUICrashLogLineMarkerBinaryImages
+};
+
+// Lines ending a section (the Binary Images section ends with the log)
+
+static const CUICrashLogLineMarkers CUICrashLogSectionEndMarkers[CUICrashLogSectionTypesCount]=
+{
+    CUICrashLogLineMarkerCrashedThread|CUICrashLogLineMarkerExceptionType,
+    CUICrashLogLineMarkerApplicationSpecificInformation|CUICrashLogLineMarkerVMRegionsNear|CUICrashLogLineMarkerVMRegionInfo|CUICrashLogLineMarkerBacktraceNotAvailable|CUICrashLogLineMarkerApplicationSpecificBacktrace|CUICrashLogLineMarkerThread0,
+    CUICrashLogLineMarkerApplicationSpecificBacktrace|CUICrashLogLineMarkerThread0|CUICrashLogLineMarkerThreadCrashedWith|CUICrashLogLineMarkerBinaryImages,
+    CUICrashLogLineMarkerThreadCrashedWith|CUICrashLogLineMarkerUnknownCrashedWith|CUICrashLogLineMarkerThreadState|CUICrashLogLineMarkerBinaryImages,
+    CUICrashLogLineMarkerBinaryImages,
+    0
+};
 
-+ (NSRange)detectHeaderSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
+static NSString * const CUICrashLogSectionNames[CUICrashLogSectionTypesCount]=
 {
-    __block NSRange tRange={.location=NSNotFound,.length=0};
+    @"Header",
+    @"Exception Information",
+    @"Diagnostic Messages",
+    @"Backtraces",
+    @"Thread State",
+    @"Binary Images"
+};
+
+#define CUILineHasPrefix(inLine,inLength,inLiteral)                    ((inLength)>=(sizeof(inLiteral)-1) && memcmp((inLine),(inLiteral),sizeof(inLiteral)-1)==0)
+
+#define CUILineHasCaseInsensitivePrefix(inLine,inLength,inLiteral)     ((inLength)>=(sizeof(inLiteral)-1) && strncasecmp((const char *)(inLine),(inLiteral),sizeof(inLiteral)-1)==0)
+
+#define CUILineContains(inLine,inLength,inLiteral)                     (memmem((inLine),(inLength),(inLiteral),sizeof(inLiteral)-1)!=NULL)
+
+static CUICrashLogLineMarkers CUICrashLogLineMarkersOfLine(const uint8_t * inLine,NSUInteger inLength)
+{
+    if (inLength==0)
+        return 0;
     
-    // Find the "Exception Information" section start
+    CUICrashLogLineMarkers tMarkers=0;
     
-    [inLines enumerateObjectsAtIndexes:inIndexes options:0 usingBlock:^(NSString * bLine , NSUInteger bLineNumber, BOOL * bOutStop) {
-        
-        if ([bLine hasPrefix:@"Crashed Thread:"]==YES ||
-            [bLine hasPrefix:@"Exception Type:"]==YES)
-        {
-            NSUInteger tFirstLine=inIndexes.firstIndex;
-            NSUInteger tLastLine=bLineNumber-1;
+    // The first byte selects the few keywords worth comparing
+    
+    switch(inLine[0])
+    {
+        case 'A':
             
-            tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
+            if (CUILineHasPrefix(inLine,inLength,"Application Specific ")==YES)
+            {
+                const uint8_t * tSuffix=inLine+sizeof("Application Specific ")-1;
+                NSUInteger tSuffixLength=inLength-(sizeof("Application Specific ")-1);
+                
+                if (CUILineHasPrefix(tSuffix,tSuffixLength,"Information:")==YES)
+                    tMarkers|=CUICrashLogLineMarkerApplicationSpecificInformation;
+                else if (CUILineHasPrefix(tSuffix,tSuffixLength,"Backtrace")==YES)
+                    tMarkers|=CUICrashLogLineMarkerApplicationSpecificBacktrace;
+            }
             
-            *bOutStop=YES;
+            break;
             
-            return;
-        }
-    }];
-    
-    return tRange;
-}
-
-+ (NSRange)detectExceptionInformationSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
-{
-    __block NSRange tRange={.location=NSNotFound,.length=0};
-    
-    // Find the "Diagnostic Message" or "Backtrace" section start
-    
-    [inLines enumerateObjectsAtIndexes:inIndexes options:0 usingBlock:^(NSString * bLine , NSUInteger bLineNumber, BOOL * bOutStop) {
-        
-        if ([bLine hasPrefix:@"Application Specific Information:"]==YES ||
-            [bLine hasPrefix:@"VM Regions Near"]==YES ||
-            [bLine hasPrefix:@"VM Region Info:"]==YES ||
+        case 'B':
             
-            [bLine isEqualToString:@"Backtrace not available"]==YES ||
+            if (inLength==sizeof("Backtrace not available")-1 && CUILineHasPrefix(inLine,inLength,"Backtrace not available")==YES)
+                tMarkers|=CUICrashLogLineMarkerBacktraceNotAvailable;
             
-            [bLine hasPrefix:@"Application Specific Backtrace"]==YES ||
-            [bLine hasPrefix:@"Thread 0"]==YES)
-        {
-            NSUInteger tFirstLine=inIndexes.firstIndex;
-            NSUInteger tLastLine=bLineNumber-1;
+            // Fall through
             
-            tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
+        case 'b':
             
-            *bOutStop=YES;
+            if (CUILineHasCaseInsensitivePrefix(inLine,inLength,"Binary Images")==YES)
+                tMarkers|=CUICrashLogLineMarkerBinaryImages;
             
-            return;
-        }
-    }];
-    
-    return tRange;
-}
-
-+ (NSRange)detectDiagnosticMessageSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
-{
-    __block NSRange tRange={.location=NSNotFound,.length=0};
-    
-    // Find the "Backtrace" or "Thread State" or "Binary Images" section start
-    
-    [inLines enumerateObjectsAtIndexes:inIndexes options:0 usingBlock:^(NSString * bLine , NSUInteger bLineNumber, BOOL * bOutStop) {
-        
-        if ([bLine hasPrefix:@"Application Specific Backtrace"]==YES ||
-            [bLine hasPrefix:@"Thread 0"]==YES ||
+            break;
             
-            ([bLine hasPrefix:@"Thread"]==YES && [bLine rangeOfString:@"crashed with"].location !=NSNotFound) ||
+        case 'C':
             
-            [bLine rangeOfString:@"Binary Images" options:NSCaseInsensitiveSearch].location==0
-            )
-        {
-            NSUInteger tFirstLine=inIndexes.firstIndex;
-            NSUInteger tLastLine=bLineNumber-1;
+            if (CUILineHasPrefix(inLine,inLength,"Crashed Thread:")==YES)
+                tMarkers|=CUICrashLogLineMarkerCrashedThread;
             
-            tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
+            break;
             
-            *bOutStop=YES;
+        case 'E':
             
-            return;
-        }
-    }];
+            if (CUILineHasPrefix(inLine,inLength,"Exception Type:")==YES)
+                tMarkers|=CUICrashLogLineMarkerExceptionType;
+            
+            break;
+            
+        case 'T':
+            
+            if (CUILineHasPrefix(inLine,inLength,"Thread")==YES)
+            {
+                if (CUILineHasPrefix(inLine,inLength,"Thread 0")==YES)
+                    tMarkers|=CUICrashLogLineMarkerThread0;
+                
+                if (CUILineContains(inLine,inLength,"crashed with")==YES)
+                    tMarkers|=CUICrashLogLineMarkerThreadCrashedWith;
+            }
+            
+            // Fall through
+            
+        case 't':
+            
+            if (CUILineHasCaseInsensitivePrefix(inLine,inLength,"Thread State")==YES)
+                tMarkers|=CUICrashLogLineMarkerThreadState;
+            
+            break;
+            
+        case 'U':
+            
+            if (CUILineHasPrefix(inLine,inLength,"Unknown")==YES && CUILineContains(inLine,inLength,"crashed with")==YES)
+            {
+                tMarkers|=CUICrashLogLineMarkerUnknownCrashedWith;
+                
+                if (CUILineHasPrefix(inLine,inLength,"Unknown thread")==YES)
+                    tMarkers|=CUICrashLogLineMarkerUnknownThreadCrashedWith;
+            }
+            
+            break;
+            
+        case 'V':
+            
+            if (CUILineHasPrefix(inLine,inLength,"VM Regions Near")==YES)
+                tMarkers|=CUICrashLogLineMarkerVMRegionsNear;
+            else if (CUILineHasPrefix(inLine,inLength,"VM Region Info:")==YES)
+                tMarkers|=CUICrashLogLineMarkerVMRegionInfo;
+            
+            break;
+            
+        default:
+            
+            break;
+    }
     
-    return tRange;
+    return tMarkers;
 }
 
-+ (NSRange)detectBacktracesSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
+@interface CUICrashLogSectionsDetector ()
 {
-    __block NSRange tRange={.location=NSNotFound,.length=0};
+    CUICrashLogTextLines * _lines;
     
-    // Find the "Thread State" or "Binary Images" section start
+    CUICrashLogSectionRange _sectionsRanges[CUICrashLogSectionTypesCount];
+}
+
+- (void)_setLineRange:(NSRange)inLineRange ofSection:(CUICrashLogSectionType)inSectionType;
+
+@end
+
+@implementation CUICrashLogSectionsDetector
+
+- (instancetype)initWithLines:(CUICrashLogTextLines *)inLines
+{
+    if ([inLines isKindOfClass:CUICrashLogTextLines.class]==NO)
+        return nil;
+    
+    self=[super init];
     
-    [inLines enumerateObjectsAtIndexes:inIndexes options:0 usingBlock:^(NSString * bLine , NSUInteger bLineNumber, BOOL * bOutStop) {
+    if (self!=nil)
+    {
+        _lines=inLines;
         
-        if ((([bLine hasPrefix:@"Thread"]==YES || [bLine hasPrefix:@"Unknown"]==YES) && [bLine rangeOfString:@"crashed with"].location!=NSNotFound) ||
-            [bLine rangeOfString:@"Thread State" options:NSCaseInsensitiveSearch].location==0 ||
-            [bLine rangeOfString:@"Binary Images" options:NSCaseInsensitiveSearch].location==0
-            )
+        for(NSUInteger tIndex=0;tIndex<CUICrashLogSectionTypesCount;tIndex++)
         {
-            NSUInteger tFirstLine=inIndexes.firstIndex;
-            NSUInteger tLastLine=bLineNumber-1;
-            
-            tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
-            
-            *bOutStop=YES;
-            
-            return;
+            _sectionsRanges[tIndex].lineRange=NSMakeRange(NSNotFound,0);
+            _sectionsRanges[tIndex].byteRange=NSMakeRange(NSNotFound,0);
         }
-    }];
+    }
     
-    return tRange;
+    return self;
+}
+
+#pragma mark -
+
+- (BOOL)detectSections:(NSError **)outError
+{
+    return [self detectSectionsThroughSection:CUICrashLogSectionTypeBinaryImages error:outError];
 }
 
-+ (NSRange)detectThreadStateSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
+- (BOOL)detectSectionsThroughSection:(CUICrashLogSectionType)inSectionType error:(NSError **)outError
 {
-    __block NSRange tRange={.location=NSNotFound,.length=0};
+    const uint8_t * tBytes=(const uint8_t *)_lines.data.bytes;
+    NSUInteger tNumberOfLines=_lines.count;
+    
+    // The header starts the log, the exception information follows it, the other sections are optional
     
-    // Find the "Thread State" or "Binary Images" section start
+    CUICrashLogSectionType tSectionType=CUICrashLogSectionTypeHeader;
+    BOOL tInSection=YES;
     
-    [inLines enumerateObjectsAtIndexes:inIndexes options:0 usingBlock:^(NSString * bLine , NSUInteger bLineNumber, BOOL * bOutStop) {
+    NSUInteger tSectionFirstLine=0;
+    
+    for(NSUInteger tLineNumber=0;tLineNumber<tNumberOfLines;tLineNumber++)
+    {
+        // Only the lines which can open or close a section are looked at
+        
+        if (tSectionType>=CUICrashLogSectionTypesCount || (tInSection==YES && CUICrashLogSectionEndMarkers[tSectionType]==0))
+            break;
+        
+        NSRange tLineRange=[_lines byteRangeOfLineAtIndex:tLineNumber];
+        
+        CUICrashLogLineMarkers tMarkers=CUICrashLogLineMarkersOfLine(tBytes+tLineRange.location,tLineRange.length);
+        
+        // A line can close a section and open the next one
         
-        if ([bLine rangeOfString:@"Binary Images" options:NSCaseInsensitiveSearch].location==0)
+        while (tSectionType<CUICrashLogSectionTypesCount)
         {
-            NSUInteger tFirstLine=inIndexes.firstIndex;
-            NSUInteger tLastLine=bLineNumber-1;
+            if (tInSection==YES)
+            {
+                if ((tMarkers & CUICrashLogSectionEndMarkers[tSectionType])==0)
+                    break;
+                
+                [self _setLineRange:NSMakeRange(tSectionFirstLine,tLineNumber-tSectionFirstLine) ofSection:tSectionType];
+                
+                if (tSectionType==inSectionType)
+                    return YES;
+                
+                tSectionType++;
+                
+                tInSection=(tSectionType==CUICrashLogSectionTypeExceptionInformation);
+            }
+            else
+            {
+                if ((tMarkers & CUICrashLogSectionStartMarkers[tSectionType])==0)
+                {
+                    // This section is not available, maybe the next one is
+                    
+                    tSectionType++;
+                    
+                    continue;
+                }
+                
+                tInSection=YES;
+            }
             
-            tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
-            
-            *bOutStop=YES;
+            tSectionFirstLine=tLineNumber;
+        }
+    }
+    
+    if (tSectionType<CUICrashLogSectionTypesCount && tInSection==YES && tSectionType<=inSectionType)
+    {
+        if (tSectionType!=CUICrashLogSectionTypeBinaryImages)
+        {
+            if (outError!=NULL)
+                *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:CUICrashLogSectionNames[tSectionType]}];
             
-            return;
+            return NO;
         }
-    }];
+        
+        // The Binary Images section ends with the log
+        
+        [self _setLineRange:NSMakeRange(tSectionFirstLine,tNumberOfLines-tSectionFirstLine) ofSection:tSectionType];
+    }
     
-    return tRange;
+    return YES;
 }
 
-+ (NSRange)detectBinaryImagesSectionRangeInTextualRepresentation:(NSArray *)inLines atIndexes:(NSIndexSet *)inIndexes
+- (void)_setLineRange:(NSRange)inLineRange ofSection:(CUICrashLogSectionType)inSectionType
 {
-    NSUInteger tFirstLine=inIndexes.firstIndex;
-    NSUInteger tLastLine=inIndexes.lastIndex;
-    
-    NSRange tRange=NSMakeRange(tFirstLine, tLastLine-tFirstLine+1);
+    _sectionsRanges[inSectionType].lineRange=inLineRange;
+    _sectionsRanges[inSectionType].byteRange=[_lines byteRangeOfLinesInRange:inLineRange];
+}
+
+- (CUICrashLogSectionRange)rangeOfSection:(CUICrashLogSectionType)inSectionType
+{
+    if (inSectionType>=CUICrashLogSectionTypesCount)
+        return (CUICrashLogSectionRange){.lineRange={.location=NSNotFound,.length=0},.byteRange={.location=NSNotFound,.length=0}};
     
-    return tRange;
+    return _sectionsRanges[inSectionType];
 }
 
 @end
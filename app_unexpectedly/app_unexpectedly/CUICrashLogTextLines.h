@@ -0,0 +1,36 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// The lines of a textual crash log. The bytes of the log are kept as is (the file is memory-mapped)
+// and the strings are only created when the lines are accessed.
+// The lines are terminated by \n or \r\n (the line terminators are not part of the lines).
+
+@interface CUICrashLogTextLines : NSArray<NSString *>
+
+    @property (readonly) NSData * data;
+
+- (instancetype)initWithData:(NSData *)inData;
+
+// The byte ranges are relative to the beginning of the data
+
+- (NSRange)byteRangeOfLineAtIndex:(NSUInteger)inIndex;      // Line terminator excluded
+
+- (NSRange)byteRangeOfLinesInRange:(NSRange)inRange;        // Line terminators included
+
+// The lines share the storage of the receiver
+
+- (CUICrashLogTextLines *)linesInRange:(NSRange)inRange;
+
+@end
@@ -0,0 +1,183 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUICrashLogTextLines.h"
+
+#include <string.h>
+
+@interface CUICrashLogTextLines ()
+{
+    NSData * _linesOffsets;     // uint32_t, the offset of the end of the data is appended
+    
+    NSUInteger _firstLineIndex;
+    
+    NSUInteger _numberOfLines;
+}
+
+- (instancetype)initWithData:(NSData *)inData linesOffsets:(NSData *)inLinesOffsets range:(NSRange)inRange;
+
+@end
+
+@implementation CUICrashLogTextLines
+
+- (instancetype)initWithData:(NSData *)inData
+{
+    if ([inData isKindOfClass:NSData.class]==NO)
+        return nil;
+    
+    NSUInteger tLength=inData.length;
+    
+    if (tLength>UINT32_MAX)
+        return nil;
+    
+    const uint8_t * tBytes=(const uint8_t *)inData.bytes;
+    
+    NSUInteger tCapacity=tLength/64+16;
+    uint32_t * tOffsets=malloc(tCapacity*sizeof(uint32_t));
+    
+    if (tOffsets==NULL)
+        return nil;
+    
+    NSUInteger tCount=0;
+    
+    if (tLength>0)
+        tOffsets[tCount++]=0;
+    
+    const uint8_t * tCursor=tBytes;
+    const uint8_t * tBytesEnd=tBytes+tLength;
+    
+    while (tCursor<tBytesEnd)
+    {
+        const uint8_t * tNewLine=memchr(tCursor,'\n',tBytesEnd-tCursor);
+        
+        if (tNewLine==NULL || (tNewLine+1)==tBytesEnd)
+            break;
+        
+        tCursor=tNewLine+1;
+        
+        if ((tCount+1)>=tCapacity)
+        {
+            tCapacity*=2;
+            
+            uint32_t * tReallocatedOffsets=realloc(tOffsets,tCapacity*sizeof(uint32_t));
+            
+            if (tReallocatedOffsets==NULL)
+            {
+                free(tOffsets);
+                
+                return nil;
+            }
+            
+            tOffsets=tReallocatedOffsets;
+        }
+        
+        tOffsets[tCount++]=(uint32_t)(tCursor-tBytes);
+    }
+    
+    tOffsets[tCount]=(uint32_t)tLength;
+    
+    NSData * tLinesOffsets=[NSData dataWithBytesNoCopy:tOffsets length:(tCount+1)*sizeof(uint32_t) freeWhenDone:YES];
+    
+    return [self initWithData:inData linesOffsets:tLinesOffsets range:NSMakeRange(0,tCount)];
+}
+
+- (instancetype)initWithData:(NSData *)inData linesOffsets:(NSData *)inLinesOffsets range:(NSRange)inRange
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _data=inData;
+        
+        _linesOffsets=inLinesOffsets;
+        
+        _firstLineIndex=inRange.location;
+        
+        _numberOfLines=inRange.length;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)count
+{
+    return _numberOfLines;
+}
+
+- (NSString *)objectAtIndex:(NSUInteger)inIndex
+{
+    NSRange tRange=[self byteRangeOfLineAtIndex:inIndex];
+    
+    const uint8_t * tLine=(const uint8_t *)_data.bytes+tRange.location;
+    
+    NSString * tString=[[NSString alloc] initWithBytes:tLine length:tRange.length encoding:NSUTF8StringEncoding];
+    
+    if (tString==nil)
+        tString=[[NSString alloc] initWithBytes:tLine length:tRange.length encoding:NSASCIIStringEncoding];
+    
+    return (tString!=nil) ? tString : @"";
+}
+
+- (NSArray *)subarrayWithRange:(NSRange)inRange
+{
+    return [self linesInRange:inRange];
+}
+
+- (id)copyWithZone:(NSZone *)inZone
+{
+    return self;
+}
+
+#pragma mark -
+
+- (NSRange)byteRangeOfLineAtIndex:(NSUInteger)inIndex
+{
+    if (inIndex>=_numberOfLines)
+        [NSException raise:NSRangeException format:@"*** -[CUICrashLogTextLines byteRangeOfLineAtIndex:]: index %lu beyond bounds [0 .. %lu]",(unsigned long)inIndex,(unsigned long)_numberOfLines];
+    
+    const uint32_t * tOffsets=(const uint32_t *)_linesOffsets.bytes+_firstLineIndex+inIndex;
+    const uint8_t * tBytes=(const uint8_t *)_data.bytes;
+    
+    NSUInteger tStart=tOffsets[0];
+    NSUInteger tEnd=tOffsets[1];
+    
+    if (tEnd>tStart && tBytes[tEnd-1]=='\n')
+        tEnd--;
+    
+    if (tEnd>tStart && tBytes[tEnd-1]=='\r')
+        tEnd--;
+    
+    return NSMakeRange(tStart,tEnd-tStart);
+}
+
+- (NSRange)byteRangeOfLinesInRange:(NSRange)inRange
+{
+    if (NSMaxRange(inRange)>_numberOfLines)
+        [NSException raise:NSRangeException format:@"*** -[CUICrashLogTextLines byteRangeOfLinesInRange:]: range %@ beyond bounds [0 .. %lu]",NSStringFromRange(inRange),(unsigned long)_numberOfLines];
+    
+    const uint32_t * tOffsets=(const uint32_t *)_linesOffsets.bytes+_firstLineIndex;
+    
+    return NSMakeRange(tOffsets[inRange.location],tOffsets[NSMaxRange(inRange)]-tOffsets[inRange.location]);
+}
+
+- (CUICrashLogTextLines *)linesInRange:(NSRange)inRange
+{
+    if (NSMaxRange(inRange)>_numberOfLines)
+        [NSException raise:NSRangeException format:@"*** -[CUICrashLogTextLines linesInRange:]: range %@ beyond bounds [0 .. %lu]",NSStringFromRange(inRange),(unsigned long)_numberOfLines];
+    
+    return [[CUICrashLogTextLines alloc] initWithData:_data linesOffsets:_linesOffsets range:NSMakeRange(_firstLineIndex+inRange.location,inRange.length)];
+}
+
+@end
@@ -181,7 +181,9 @@ NSString * const CUIRetiredPathComponent=@"Retired";
 		
 		NSError * tError=nil;
 		
-		id tCrashLog=[[CUICrashLog alloc] initWithContentsOfFile:tFilePath error:&tError];
+		// Only the beginning of the files is read to populate the list, the rest is read when a crash log is displayed
+		
+		id tCrashLog=[[CUICrashLog alloc] initWithContentsOfFile:tFilePath options:CUICrashLogReadingHeaderOnly error:&tError];
 		
         if (tCrashLog==nil)
         {
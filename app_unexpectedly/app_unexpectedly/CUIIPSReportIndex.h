@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "CUIJSONStructuralIndex.h"
+
+// The structural index of an IPS report: the summary (first line) and the incident (the rest of the file).
+// The accessors only decode the values they return, the threads and binary images are not materialized.
+
+@interface CUIIPSReportIndex : NSObject
+
+    @property (readonly) NSData * data;
+
+    @property (readonly) NSDictionary * summary;
+
+    @property (readonly) CUIJSONValue * incident;
+
+- (instancetype)initWithData:(NSData *)inData;     // nil if the data is not an IPS report
+
+// Header
+
+    @property (readonly,copy) NSString * processName;
+
+    @property (readonly) pid_t processIdentifier;
+
+    @property (readonly,copy) NSString * processPath;
+
+    @property (readonly,copy) NSString * parentProcessName;
+
+    @property (readonly) pid_t parentProcessIdentifier;
+
+    @property (readonly,copy) NSString * responsibleProcessName;
+
+    @property (readonly) pid_t responsibleProcessIdentifier;
+
+    @property (readonly) uid_t userIdentifier;
+
+    @property (readonly) NSDate * captureTime;
+
+    @property (readonly,copy) NSString * operatingSystemTrain;
+
+    @property (readonly,copy) NSString * cpuType;
+
+    @property (readonly,getter=isTranslated) BOOL translated;
+
+    @property (readonly,getter=isSystemIntegrityProtectionEnabled) BOOL systemIntegrityProtectionEnabled;
+
+    @property (readonly,copy) NSString * crashReporterKey;
+
+    @property (readonly,copy) NSString * bundleIdentifier;
+
+    @property (readonly,copy) NSString * bundleShortVersionString;
+
+    @property (readonly,copy) NSString * bundleVersion;
+
+// Exception information
+
+    @property (readonly) NSInteger faultingThreadIndex;     // -1 -> Unknown
+
+    @property (readonly,copy) NSString * triggeredThreadQueue;
+
+    @property (readonly,copy) NSString * exceptionType;
+
+    @property (readonly,copy) NSString * exceptionSignal;
+
+    @property (readonly,copy) NSString * exceptionCodes;
+
+    @property (readonly) NSUInteger numberOfExceptionRawCodes;
+
+    @property (readonly,getter=isCorpse) BOOL corpse;
+
+    @property (readonly,copy) NSString * terminationNamespace;
+
+    @property (readonly) NSUInteger terminationCode;
+
+// Threads and binary images (the elements are looked up once)
+
+    @property (readonly) NSArray<CUIJSONValue *> * threads;
+
+    @property (readonly) NSArray<CUIJSONValue *> * usedImages;
+
+- (NSArray<CUIJSONValue *> *)framesOfThreadAtIndex:(NSUInteger)inIndex;
+
+@end
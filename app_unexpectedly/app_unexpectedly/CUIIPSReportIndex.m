@@ -0,0 +1,279 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUIIPSReportIndex.h"
+
+@interface CUIIPSReportIndex ()
+{
+    CUIJSONStructuralIndex * _incidentIndex;
+    
+    NSArray<CUIJSONValue *> * _threads;
+    
+    NSArray<CUIJSONValue *> * _usedImages;
+}
+
+- (NSString *)_stringForMemberPath:(NSString *)inPath;
+
+@end
+
+@implementation CUIIPSReportIndex
+
+- (instancetype)initWithData:(NSData *)inData
+{
+    if ([inData isKindOfClass:NSData.class]==NO || inData.length==0)
+        return nil;
+    
+    const uint8_t * tBytes=(const uint8_t *)inData.bytes;
+    
+    if (tBytes[0]!='{')
+        return nil;
+    
+    const uint8_t * tNewLine=memchr(tBytes,'\n',inData.length);
+    
+    if (tNewLine==NULL)
+        return nil;
+    
+    NSUInteger tSummaryLength=tNewLine-tBytes;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _data=inData;
+        
+        // The summary is small, it is parsed as a whole
+        
+        _summary=[NSJSONSerialization JSONObjectWithData:[inData subdataWithRange:NSMakeRange(0,tSummaryLength)] options:0 error:NULL];
+        
+        if ([_summary isKindOfClass:NSDictionary.class]==NO)
+            return nil;
+        
+        _incidentIndex=[[CUIJSONStructuralIndex alloc] initWithData:inData range:NSMakeRange(tSummaryLength+1,inData.length-tSummaryLength-1)];
+        
+        _incident=_incidentIndex.rootValue;
+        
+        if (_incident.type!=CUIJSONValueTypeObject)
+            return nil;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSString *)_stringForMemberPath:(NSString *)inPath
+{
+    return [_incident valueForMemberPath:inPath].stringValue;
+}
+
+#pragma mark - Header
+
+- (NSString *)processName
+{
+    return [self _stringForMemberPath:@"procName"];
+}
+
+- (pid_t)processIdentifier
+{
+    return (pid_t)[_incident valueForMemberName:@"pid"].longLongValue;
+}
+
+- (NSString *)processPath
+{
+    return [self _stringForMemberPath:@"procPath"];
+}
+
+- (NSString *)parentProcessName
+{
+    return [self _stringForMemberPath:@"parentProc"];
+}
+
+- (pid_t)parentProcessIdentifier
+{
+    return (pid_t)[_incident valueForMemberName:@"parentPid"].longLongValue;
+}
+
+- (NSString *)responsibleProcessName
+{
+    return [self _stringForMemberPath:@"responsibleProc"];
+}
+
+- (pid_t)responsibleProcessIdentifier
+{
+    return (pid_t)[_incident valueForMemberName:@"responsiblePid"].longLongValue;
+}
+
+- (uid_t)userIdentifier
+{
+    return (uid_t)[_incident valueForMemberName:@"userID"].unsignedLongLongValue;
+}
+
+- (NSDate *)captureTime
+{
+    static NSDateFormatter * sDateFormatter=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sDateFormatter=[NSDateFormatter new];
+        sDateFormatter.locale=[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];    // Technical Q&A QA1480
+        sDateFormatter.dateFormat=@"yyyy-MM-dd HH:mm:ss.SSSS Z";
+    });
+    
+    NSString * tCaptureTime=[self _stringForMemberPath:@"captureTime"];
+    
+    if (tCaptureTime==nil)
+        return nil;
+    
+    return [sDateFormatter dateFromString:tCaptureTime];
+}
+
+- (NSString *)operatingSystemTrain
+{
+    return [self _stringForMemberPath:@"osVersion.train"];
+}
+
+- (NSString *)cpuType
+{
+    return [self _stringForMemberPath:@"cpuType"];
+}
+
+- (BOOL)isTranslated
+{
+    return [_incident valueForMemberName:@"translated"].boolValue;
+}
+
+- (BOOL)isSystemIntegrityProtectionEnabled
+{
+    return [[self _stringForMemberPath:@"sip"] isEqualToString:@"enabled"];
+}
+
+- (NSString *)crashReporterKey
+{
+    return [self _stringForMemberPath:@"crashReporterKey"];
+}
+
+- (NSString *)bundleIdentifier
+{
+    return [self _stringForMemberPath:@"bundleInfo.CFBundleIdentifier"];
+}
+
+- (NSString *)bundleShortVersionString
+{
+    return [self _stringForMemberPath:@"bundleInfo.CFBundleShortVersionString"];
+}
+
+- (NSString *)bundleVersion
+{
+    return [self _stringForMemberPath:@"bundleInfo.CFBundleVersion"];
+}
+
+#pragma mark - Exception information
+
+- (NSInteger)faultingThreadIndex
+{
+    CUIJSONValue * tValue=[_incident valueForMemberName:@"faultingThread"];
+    
+    if (tValue.type!=CUIJSONValueTypeNumber)
+        return -1;
+    
+    return (NSInteger)tValue.longLongValue;
+}
+
+- (NSString *)triggeredThreadQueue
+{
+    return [self _stringForMemberPath:@"legacyInfo.threadTriggered.queue"];
+}
+
+- (NSString *)exceptionType
+{
+    return [self _stringForMemberPath:@"exception.type"];
+}
+
+- (NSString *)exceptionSignal
+{
+    return [self _stringForMemberPath:@"exception.signal"];
+}
+
+- (NSString *)exceptionCodes
+{
+    return [self _stringForMemberPath:@"exception.codes"];
+}
+
+- (NSUInteger)numberOfExceptionRawCodes
+{
+    return [_incident valueForMemberPath:@"exception.rawCodes"].count;
+}
+
+- (BOOL)isCorpse
+{
+    return [_incident valueForMemberName:@"isCorpse"].boolValue;
+}
+
+- (NSString *)terminationNamespace
+{
+    return [self _stringForMemberPath:@"termination.namespace"];
+}
+
+- (NSUInteger)terminationCode
+{
+    return (NSUInteger)[_incident valueForMemberPath:@"termination.code"].unsignedLongLongValue;
+}
+
+#pragma mark - Threads and binary images
+
+- (NSArray<CUIJSONValue *> *)threads
+{
+    @synchronized(self)
+    {
+        if (_threads==nil)
+        {
+            _threads=[_incident valueForMemberName:@"threads"].elements;
+            
+            if (_threads==nil)
+                _threads=@[];
+        }
+        
+        return _threads;
+    }
+}
+
+- (NSArray<CUIJSONValue *> *)usedImages
+{
+    @synchronized(self)
+    {
+        if (_usedImages==nil)
+        {
+            _usedImages=[_incident valueForMemberName:@"usedImages"].elements;
+            
+            if (_usedImages==nil)
+                _usedImages=@[];
+        }
+        
+        return _usedImages;
+    }
+}
+
+- (NSArray<CUIJSONValue *> *)framesOfThreadAtIndex:(NSUInteger)inIndex
+{
+    NSArray<CUIJSONValue *> * tThreads=self.threads;
+    
+    if (inIndex>=tThreads.count)
+        return nil;
+    
+    NSArray<CUIJSONValue *> * tFrames=[tThreads[inIndex] valueForMemberName:@"frames"].elements;
+    
+    return (tFrames!=nil) ? tFrames : @[];
+}
+
+@end
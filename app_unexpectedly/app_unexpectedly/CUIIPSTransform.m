@@ -754,7 +754,7 @@
             if (tSymbolicationData.stackFrameSymbol==nil)
                 NSLog(@"Missing stackFrameSymbol");
             
-            [tMutableAttributedString appendAttributedString:[self attributedStringForUser:tIsUserCode code:[self.symbolicationDataFormatter stringForObjectValue:tSymbolicationData]]];
+            [tMutableAttributedString appendAttributedString:[self attributedStringForUser:tIsUserCode code:[self symbolicatedSymbolOfStackFrame:tStackFrame]]];
         }
         else
         {
@@ -766,6 +766,8 @@
                 
                 [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tMachineInstructionAddress-tBinaryImage.binaryImageOffset
                                                                                                                binaryUUID:tBinaryImage.UUID.UUIDString
+                                                                                                                 priority:self.symbolicationPriority
+                                                                                                        cancellationToken:self.symbolicationCancellationToken
                                                                                                         completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                             
                                                                                                             switch(bLookUpResult)
@@ -780,7 +782,8 @@
                                                                                                                     tStackFrame.symbolicationData=bSymbolicationData;
                                                                                                                     
                                                                                                                     [[NSNotificationCenter defaultCenter] postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                        object:self.crashlog];
+                                                                                                                                                                        object:self.crashlog
+                                                                                                                                                                      userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tStackFrame}];
                                                                                                                     
                                                                                                                     break;
                                                                                                                 }
@@ -789,7 +792,7 @@
                                                                                                                 {
                                                                                                                     tStackFrame.symbolicationData=bSymbolicationData;
                                                                                                                     
-                                                                                                                    tCachedResultedAttributedString=[self attributedStringForUser:tIsUserCode code:[self.symbolicationDataFormatter stringForObjectValue:bSymbolicationData]];
+                                                                                                                    tCachedResultedAttributedString=[self attributedStringForUser:tIsUserCode code:[self symbolicatedSymbolOfStackFrame:tStackFrame]];
                                                                                                                     
                                                                                                                     break;
                                                                                                                 }
@@ -800,6 +803,8 @@
                 
                 if (tCachedResultedAttributedString==nil)
                 {
+                    NSUInteger tSymbolLocation=tMutableAttributedString.length;
+                    
                     if (bFrame.symbol!=nil)
                     {
                         [tMutableAttributedString appendAttributedString:[self attributedStringForUser:tIsUserCode code:bFrame.symbol]];
@@ -817,6 +822,13 @@
                     
                     if (bFrame.sourceFile!=nil)
                         [tMutableAttributedString appendAttributedString:[self attributedStringForUser:tIsUserCode codeWithFormat:@" (%@:%lu)",bFrame.sourceFile,(unsigned long)bFrame.sourceLine]];
+                    
+                    if (tStackFrame!=nil && tStackFrame.symbolicationData==nil)
+                    {
+                        // The symbol will be replaced in place when the look up succeeds
+                        
+                        [tMutableAttributedString addAttribute:CUIStackFrameSymbolAttributeName value:tStackFrame range:NSMakeRange(tSymbolLocation,tMutableAttributedString.length-tSymbolLocation)];
+                    }
                 }
                 else
                 {
@@ -995,10 +1007,16 @@
 #ifndef __DISABLE_SYMBOLICATION_
         tBacktraceThread=tBacktracesThreads[bThreadIndex + tThreadIndexOffset];
         tStackFrames=tBacktraceThread.callStackBacktrace.stackFrames;
+        
+        self.symbolicationPriority=(bThread.triggered==YES) ? CUISymbolicationPriorityCrashedThread : CUISymbolicationPriorityRestOfLog;
 #endif
         
         [bThread.frames enumerateObjectsUsingBlock:transformThreadFrame];
         
+#ifndef __DISABLE_SYMBOLICATION_
+        self.symbolicationPriority=CUISymbolicationPriorityRestOfLog;
+#endif
+        
         [tMutableArray addObject:@""];
     }];
     
@@ -0,0 +1,88 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// A JSON document indexed in one pass: the offsets of the structural characters ({ } [ ] : ,) located outside of the strings
+// are recorded and the brackets are paired. The values are only decoded when they are accessed, so looking up a few values
+// of a large document does not create the objects of the whole document.
+// Only the structure is checked by the indexing. A malformed scalar is reported when it is accessed (nil, 0).
+
+typedef NS_ENUM(NSUInteger, CUIJSONValueType)
+{
+    CUIJSONValueTypeInvalid=0,
+    CUIJSONValueTypeObject,
+    CUIJSONValueTypeArray,
+    CUIJSONValueTypeString,
+    CUIJSONValueTypeNumber,
+    CUIJSONValueTypeBoolean,
+    CUIJSONValueTypeNull
+};
+
+@class CUIJSONValue;
+
+@interface CUIJSONStructuralIndex : NSObject
+
+    @property (readonly) NSData * data;
+
+    @property (readonly) NSUInteger numberOfStructuralCharacters;
+
+    @property (readonly) CUIJSONValue * rootValue;
+
+- (instancetype)initWithData:(NSData *)inData;
+
+// Only this range of the data is indexed (e.g. the incident of an IPS report)
+
+- (instancetype)initWithData:(NSData *)inData range:(NSRange)inRange;
+
+@end
+
+@interface CUIJSONValue : NSObject
+
+    @property (readonly) CUIJSONValueType type;
+
+    @property (readonly) NSRange byteRange;         // Relative to the beginning of the data
+
+    @property (readonly) NSUInteger count;          // Number of members of an object, of elements of an array (0 otherwise)
+
+// Objects (the keys are compared as is, the keys of a member path are separated by dots)
+
+- (CUIJSONValue *)valueForMemberName:(NSString *)inName;
+
+- (CUIJSONValue *)valueForMemberPath:(NSString *)inPath;
+
+- (void)enumerateMembersUsingBlock:(void (^)(NSString * bName,CUIJSONValue * bValue,BOOL * bOutStop))inBlock;
+
+// Arrays (an element is looked up from the beginning of the array, the elements array is faster for repeated accesses)
+
+- (CUIJSONValue *)elementAtIndex:(NSUInteger)inIndex;
+
+- (NSArray<CUIJSONValue *> *)elements;
+
+// Scalars
+
+    @property (readonly,copy) NSString * stringValue;     // nil if the value is not a string
+
+    @property (readonly) NSNumber * numberValue;          // nil if the value is not a number or a boolean
+
+    @property (readonly) long long longLongValue;
+
+    @property (readonly) unsigned long long unsignedLongLongValue;
+
+    @property (readonly) BOOL boolValue;
+
+// The Foundation objects of the value and of all its descendants
+
+- (id)objectValue;
+
+@end
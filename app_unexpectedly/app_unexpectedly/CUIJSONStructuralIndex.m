@@ -0,0 +1,734 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUIJSONStructuralIndex.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#pragma mark - Structural characters
+
+#define CUIJSONCharacterClassBackslash      0x01
+#define CUIJSONCharacterClassQuote          0x02
+#define CUIJSONCharacterClassStructural     0x04
+
+static const uint8_t sCUIJSONCharacterClasses[256]=
+{
+    ['\\']=CUIJSONCharacterClassBackslash,
+    ['"']=CUIJSONCharacterClassQuote,
+    ['{']=CUIJSONCharacterClassStructural,
+    ['}']=CUIJSONCharacterClassStructural,
+    ['[']=CUIJSONCharacterClassStructural,
+    [']']=CUIJSONCharacterClassStructural,
+    [':']=CUIJSONCharacterClassStructural,
+    [',']=CUIJSONCharacterClassStructural
+};
+
+#define CUIJSONEvenBits     0x5555555555555555ULL
+#define CUIJSONOddBits      0xAAAAAAAAAAAAAAAAULL
+
+// The characters following an odd number of backslashes (the runs of backslashes can span several blocks)
+
+static inline uint64_t CUIJSONEscapedCharacters(uint64_t inBackslashes,uint64_t * ioPreviousEndsOddBackslash)
+{
+    uint64_t tStartEdges=inBackslashes & ~(inBackslashes<<1);
+    
+    uint64_t tEvenStartMask=CUIJSONEvenBits ^ *ioPreviousEndsOddBackslash;
+    uint64_t tEvenStarts=tStartEdges & tEvenStartMask;
+    uint64_t tOddStarts=tStartEdges & ~tEvenStartMask;
+    
+    uint64_t tEvenCarries=inBackslashes+tEvenStarts;
+    uint64_t tOddCarries=inBackslashes+tOddStarts;
+    
+    bool tEndsOddBackslash=(tOddCarries<inBackslashes);
+    
+    tOddCarries|=*ioPreviousEndsOddBackslash;
+    
+    *ioPreviousEndsOddBackslash=(tEndsOddBackslash==true) ? 1 : 0;
+    
+    uint64_t tEvenCarryEnds=tEvenCarries & ~inBackslashes;
+    uint64_t tOddCarryEnds=tOddCarries & ~inBackslashes;
+    
+    return (tEvenCarryEnds & CUIJSONOddBits) | (tOddCarryEnds & CUIJSONEvenBits);
+}
+
+// Bit i is set if an odd number of bits are set in [0,i]
+
+static inline uint64_t CUIJSONPrefixXOR(uint64_t inBits)
+{
+    inBits^=inBits<<1;
+    inBits^=inBits<<2;
+    inBits^=inBits<<4;
+    inBits^=inBits<<8;
+    inBits^=inBits<<16;
+    inBits^=inBits<<32;
+    
+    return inBits;
+}
+
+// Returns the number of structural characters located outside of the strings or -1 (unterminated string, out of memory).
+// The bytes are processed by blocks of 64: the bitmasks of a block are computed without branches so that the loop can be vectorized.
+
+static int64_t CUIJSONIndexStructuralCharacters(const uint8_t * inBytes,size_t inLength,uint32_t ** ioOffsets,size_t * ioCapacity)
+{
+    uint64_t tPreviousEndsOddBackslash=0;
+    uint64_t tPreviousInString=0;
+    size_t tCount=0;
+    
+    for(size_t tBlockOffset=0;tBlockOffset<inLength;tBlockOffset+=64)
+    {
+        uint8_t tPaddedBlock[64];
+        const uint8_t * tBlock=inBytes+tBlockOffset;
+        size_t tBlockLength=inLength-tBlockOffset;
+        
+        if (tBlockLength<64)
+        {
+            memset(tPaddedBlock,' ',64);
+            memcpy(tPaddedBlock,tBlock,tBlockLength);
+            
+            tBlock=tPaddedBlock;
+        }
+        
+        uint64_t tBackslashes=0;
+        uint64_t tQuotes=0;
+        uint64_t tStructurals=0;
+        
+        for(unsigned int tIndex=0;tIndex<64;tIndex++)
+        {
+            uint64_t tClass=sCUIJSONCharacterClasses[tBlock[tIndex]];
+            
+            tBackslashes|=(tClass & CUIJSONCharacterClassBackslash)<<tIndex;
+            tQuotes|=((tClass & CUIJSONCharacterClassQuote)>>1)<<tIndex;
+            tStructurals|=((tClass & CUIJSONCharacterClassStructural)>>2)<<tIndex;
+        }
+        
+        uint64_t tEscaped=(tBackslashes==0 && tPreviousEndsOddBackslash==0) ? 0 : CUIJSONEscapedCharacters(tBackslashes,&tPreviousEndsOddBackslash);
+        
+        tQuotes&=~tEscaped;
+        
+        uint64_t tInString=CUIJSONPrefixXOR(tQuotes) ^ tPreviousInString;
+        
+        tPreviousInString=(uint64_t)((int64_t)tInString>>63);
+        
+        tStructurals&=~tInString;
+        
+        size_t tBlockCount=(size_t)__builtin_popcountll(tStructurals);
+        
+        if (tCount+tBlockCount>*ioCapacity)
+        {
+            size_t tCapacity=MAX(*ioCapacity*2,tCount+tBlockCount);
+            uint32_t * tOffsets=realloc(*ioOffsets,tCapacity*sizeof(uint32_t));
+            
+            if (tOffsets==NULL)
+                return -1;
+            
+            *ioOffsets=tOffsets;
+            *ioCapacity=tCapacity;
+        }
+        
+        uint32_t * tOffsets=*ioOffsets;
+        
+        while (tStructurals!=0)
+        {
+            tOffsets[tCount++]=(uint32_t)(tBlockOffset+(size_t)__builtin_ctzll(tStructurals));
+            
+            tStructurals&=tStructurals-1;
+        }
+    }
+    
+    if (tPreviousInString!=0)
+        return -1;
+    
+    return (int64_t)tCount;
+}
+
+static inline BOOL CUIJSONIsWhitespace(uint8_t inCharacter)
+{
+    return (inCharacter==' ' || inCharacter=='\n' || inCharacter=='\r' || inCharacter=='\t');
+}
+
+static inline NSUInteger CUIJSONSkipWhitespaces(const uint8_t * inBytes,NSUInteger inOffset,NSUInteger inEnd)
+{
+    while (inOffset<inEnd && CUIJSONIsWhitespace(inBytes[inOffset])==YES)
+        inOffset++;
+    
+    return inOffset;
+}
+
+static inline NSUInteger CUIJSONTrimWhitespaces(const uint8_t * inBytes,NSUInteger inStart,NSUInteger inEnd)
+{
+    while (inEnd>inStart && CUIJSONIsWhitespace(inBytes[inEnd-1])==YES)
+        inEnd--;
+    
+    return inEnd;
+}
+
+#pragma mark -
+
+@interface CUIJSONStructuralIndex ()
+{
+    NSData * _data;
+    
+    const uint8_t * _bytes;     // The beginning of the indexed range
+    
+    NSUInteger _baseOffset;
+    
+    NSUInteger _length;
+    
+    uint32_t * _offsets;
+    
+    uint32_t * _partners;       // The index of the closing bracket of an opening bracket
+    
+    NSUInteger _count;
+}
+
+@end
+
+@interface CUIJSONValue ()
+{
+    CUIJSONStructuralIndex * _index;    // Owns the offsets
+    
+    NSData * _data;
+    
+    NSUInteger _baseOffset;
+    
+    const uint8_t * _bytes;
+    
+    const uint32_t * _offsets;
+    
+    const uint32_t * _partners;
+    
+    NSRange _range;             // Relative to the beginning of the indexed range
+    
+    NSUInteger _tapeIndex;      // NSNotFound for a scalar
+}
+
+- (instancetype)_initWithIndex:(CUIJSONStructuralIndex *)inIndex data:(NSData *)inData baseOffset:(NSUInteger)inBaseOffset offsets:(const uint32_t *)inOffsets partners:(const uint32_t *)inPartners range:(NSRange)inRange tapeIndex:(NSUInteger)inTapeIndex;
+
+- (CUIJSONValue *)_valueInRange:(NSRange)inRange tapeIndex:(NSUInteger)inTapeIndex;
+
+- (void)_enumerateValuesUsingBlock:(void (^)(NSRange bKeyRange,NSRange bValueRange,NSUInteger bValueTapeIndex,BOOL * bOutStop))inBlock;
+
+- (NSString *)_stringInRange:(NSRange)inRange;
+
+@end
+
+@implementation CUIJSONStructuralIndex
+
+- (instancetype)initWithData:(NSData *)inData
+{
+    return [self initWithData:inData range:NSMakeRange(0,inData.length)];
+}
+
+- (instancetype)initWithData:(NSData *)inData range:(NSRange)inRange
+{
+    if ([inData isKindOfClass:NSData.class]==NO || NSMaxRange(inRange)>inData.length || inRange.length>UINT32_MAX)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _data=inData;
+        
+        _baseOffset=inRange.location;
+        
+        _bytes=(const uint8_t *)inData.bytes+inRange.location;
+        
+        _length=inRange.length;
+        
+        size_t tCapacity=_length/8+64;
+        
+        _offsets=malloc(tCapacity*sizeof(uint32_t));
+        
+        if (_offsets==NULL)
+            return nil;
+        
+        int64_t tCount=CUIJSONIndexStructuralCharacters(_bytes,_length,&_offsets,&tCapacity);
+        
+        if (tCount<0)
+            return nil;
+        
+        _count=(NSUInteger)tCount;
+        
+        // Pair the brackets
+        
+        _partners=calloc(MAX(_count,1),sizeof(uint32_t));
+        uint32_t * tStack=malloc(MAX(_count,1)*sizeof(uint32_t));
+        
+        if (_partners==NULL || tStack==NULL)
+        {
+            free(tStack);
+            
+            return nil;
+        }
+        
+        NSUInteger tDepth=0;
+        BOOL tValid=YES;
+        
+        for(NSUInteger tIndex=0;tIndex<_count;tIndex++)
+        {
+            uint8_t tCharacter=_bytes[_offsets[tIndex]];
+            
+            if (tCharacter=='{' || tCharacter=='[')
+            {
+                tStack[tDepth++]=(uint32_t)tIndex;
+            }
+            else if (tCharacter=='}' || tCharacter==']')
+            {
+                if (tDepth==0)
+                {
+                    tValid=NO;
+                    break;
+                }
+                
+                uint32_t tOpeningIndex=tStack[--tDepth];
+                
+                if (_bytes[_offsets[tOpeningIndex]]!=((tCharacter=='}') ? '{' : '['))
+                {
+                    tValid=NO;
+                    break;
+                }
+                
+                _partners[tOpeningIndex]=(uint32_t)tIndex;
+            }
+            else if (tDepth==0)
+            {
+                // A separator outside of the root value
+                
+                tValid=NO;
+                break;
+            }
+        }
+        
+        free(tStack);
+        
+        if (tValid==NO || tDepth!=0)
+            return nil;
+        
+        // Only one root value
+        
+        NSUInteger tStart=CUIJSONSkipWhitespaces(_bytes,0,_length);
+        
+        if (tStart==_length)
+            return nil;
+        
+        if (_count>0)
+        {
+            if (_offsets[0]!=tStart || _partners[0]!=_count-1 || CUIJSONSkipWhitespaces(_bytes,_offsets[_count-1]+1,_length)!=_length)
+                return nil;
+        }
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_offsets);
+    free(_partners);
+}
+
+#pragma mark -
+
+- (NSUInteger)numberOfStructuralCharacters
+{
+    return _count;
+}
+
+- (CUIJSONValue *)rootValue
+{
+    NSUInteger tStart=CUIJSONSkipWhitespaces(_bytes,0,_length);
+    
+    NSRange tRange=(_count>0) ? NSMakeRange(tStart,_offsets[_count-1]+1-tStart) : NSMakeRange(tStart,CUIJSONTrimWhitespaces(_bytes,tStart,_length)-tStart);
+    
+    return [[CUIJSONValue alloc] _initWithIndex:self data:_data baseOffset:_baseOffset offsets:_offsets partners:_partners range:tRange tapeIndex:(_count>0) ? 0 : NSNotFound];
+}
+
+@end
+
+@implementation CUIJSONValue
+
+- (instancetype)_initWithIndex:(CUIJSONStructuralIndex *)inIndex data:(NSData *)inData baseOffset:(NSUInteger)inBaseOffset offsets:(const uint32_t *)inOffsets partners:(const uint32_t *)inPartners range:(NSRange)inRange tapeIndex:(NSUInteger)inTapeIndex
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _index=inIndex;
+        
+        _data=inData;
+        
+        _baseOffset=inBaseOffset;
+        
+        _bytes=(const uint8_t *)inData.bytes+inBaseOffset;
+        
+        _offsets=inOffsets;
+        
+        _partners=inPartners;
+        
+        _range=inRange;
+        
+        _tapeIndex=inTapeIndex;
+    }
+    
+    return self;
+}
+
+- (CUIJSONValue *)_valueInRange:(NSRange)inRange tapeIndex:(NSUInteger)inTapeIndex
+{
+    return [[CUIJSONValue alloc] _initWithIndex:_index data:_data baseOffset:_baseOffset offsets:_offsets partners:_partners range:inRange tapeIndex:inTapeIndex];
+}
+
+#pragma mark -
+
+- (CUIJSONValueType)type
+{
+    if (_range.length==0)
+        return CUIJSONValueTypeInvalid;
+    
+    switch(_bytes[_range.location])
+    {
+        case '{':
+            
+            return CUIJSONValueTypeObject;
+            
+        case '[':
+            
+            return CUIJSONValueTypeArray;
+            
+        case '"':
+            
+            return CUIJSONValueTypeString;
+            
+        case 't':
+        case 'f':
+            
+            return CUIJSONValueTypeBoolean;
+            
+        case 'n':
+            
+            return CUIJSONValueTypeNull;
+            
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            
+            return CUIJSONValueTypeNumber;
+    }
+    
+    return CUIJSONValueTypeInvalid;
+}
+
+- (NSRange)byteRange
+{
+    return NSMakeRange(_range.location+_baseOffset,_range.length);
+}
+
+- (NSUInteger)count
+{
+    __block NSUInteger tCount=0;
+    
+    [self _enumerateValuesUsingBlock:^(NSRange bKeyRange, NSRange bValueRange, NSUInteger bValueTapeIndex, BOOL *bOutStop) {
+        
+        tCount++;
+    }];
+    
+    return tCount;
+}
+
+// Members of an object (with their key range) or elements of an array (the key range is not found)
+
+- (void)_enumerateValuesUsingBlock:(void (^)(NSRange bKeyRange,NSRange bValueRange,NSUInteger bValueTapeIndex,BOOL * bOutStop))inBlock
+{
+    if (_tapeIndex==NSNotFound)
+        return;
+    
+    BOOL tIsObject=(_bytes[_offsets[_tapeIndex]]=='{');
+    NSUInteger tClosingIndex=_partners[_tapeIndex];
+    NSUInteger tEnd=_offsets[tClosingIndex];
+    
+    NSUInteger tOffset=_offsets[_tapeIndex]+1;
+    
+    if (CUIJSONSkipWhitespaces(_bytes,tOffset,tEnd)==tEnd)
+        return;
+    
+    NSUInteger tIndex=_tapeIndex+1;
+    BOOL tStop=NO;
+    
+    while (tIndex<=tClosingIndex)
+    {
+        NSRange tKeyRange=NSMakeRange(NSNotFound,0);
+        
+        if (tIsObject==YES)
+        {
+            if (_bytes[_offsets[tIndex]]!=':')
+                return;
+            
+            NSUInteger tKeyStart=CUIJSONSkipWhitespaces(_bytes,tOffset,_offsets[tIndex]);
+            
+            tKeyRange=NSMakeRange(tKeyStart,CUIJSONTrimWhitespaces(_bytes,tKeyStart,_offsets[tIndex])-tKeyStart);
+            
+            tOffset=_offsets[tIndex]+1;
+            tIndex++;
+        }
+        
+        NSUInteger tValueStart=CUIJSONSkipWhitespaces(_bytes,tOffset,tEnd);
+        NSUInteger tValueTapeIndex=NSNotFound;
+        NSRange tValueRange;
+        
+        if (_offsets[tIndex]==tValueStart && (_bytes[tValueStart]=='{' || _bytes[tValueStart]=='['))
+        {
+            tValueTapeIndex=tIndex;
+            tIndex=_partners[tValueTapeIndex];
+            
+            tValueRange=NSMakeRange(tValueStart,_offsets[tIndex]+1-tValueStart);
+            
+            tIndex++;
+        }
+        else
+        {
+            tValueRange=NSMakeRange(tValueStart,CUIJSONTrimWhitespaces(_bytes,tValueStart,_offsets[tIndex])-tValueStart);
+        }
+        
+        if (tIndex>tClosingIndex)
+            return;
+        
+        inBlock(tKeyRange,tValueRange,tValueTapeIndex,&tStop);
+        
+        if (tStop==YES || tIndex==tClosingIndex)
+            return;
+        
+        if (_bytes[_offsets[tIndex]]!=',')
+            return;
+        
+        tOffset=_offsets[tIndex]+1;
+        tIndex++;
+    }
+}
+
+- (NSString *)_stringInRange:(NSRange)inRange
+{
+    if (inRange.length<2 || _bytes[inRange.location]!='"' || _bytes[NSMaxRange(inRange)-1]!='"')
+        return nil;
+    
+    const uint8_t * tCharacters=_bytes+inRange.location+1;
+    NSUInteger tLength=inRange.length-2;
+    
+    if (memchr(tCharacters,'\\',tLength)==NULL)
+        return [[NSString alloc] initWithBytes:tCharacters length:tLength encoding:NSUTF8StringEncoding];
+    
+    // Escape sequences
+    
+    NSString * tString=[NSJSONSerialization JSONObjectWithData:[_data subdataWithRange:NSMakeRange(inRange.location+_baseOffset,inRange.length)] options:NSJSONReadingAllowFragments error:NULL];
+    
+    return ([tString isKindOfClass:NSString.class]==YES) ? tString : nil;
+}
+
+#pragma mark - Objects
+
+- (CUIJSONValue *)valueForMemberName:(NSString *)inName
+{
+    if (inName==nil || _tapeIndex==NSNotFound || _bytes[_range.location]!='{')
+        return nil;
+    
+    const char * tName=inName.UTF8String;
+    size_t tNameLength=strlen(tName);
+    
+    __block CUIJSONValue * tValue=nil;
+    
+    [self _enumerateValuesUsingBlock:^(NSRange bKeyRange, NSRange bValueRange, NSUInteger bValueTapeIndex, BOOL *bOutStop) {
+        
+        if (bKeyRange.length<2)
+            return;
+        
+        const uint8_t * tKey=self->_bytes+bKeyRange.location+1;
+        NSUInteger tKeyLength=bKeyRange.length-2;
+        
+        if (memchr(tKey,'\\',tKeyLength)==NULL)
+        {
+            if (tKeyLength!=tNameLength || memcmp(tKey,tName,tNameLength)!=0)
+                return;
+        }
+        else if ([[self _stringInRange:bKeyRange] isEqualToString:inName]==NO)
+        {
+            return;
+        }
+        
+        tValue=[self _valueInRange:bValueRange tapeIndex:bValueTapeIndex];
+        
+        *bOutStop=YES;
+    }];
+    
+    return tValue;
+}
+
+- (CUIJSONValue *)valueForMemberPath:(NSString *)inPath
+{
+    CUIJSONValue * tValue=self;
+    
+    for(NSString * tName in [inPath componentsSeparatedByString:@"."])
+    {
+        tValue=[tValue valueForMemberName:tName];
+        
+        if (tValue==nil)
+            return nil;
+    }
+    
+    return tValue;
+}
+
+- (void)enumerateMembersUsingBlock:(void (^)(NSString * bName,CUIJSONValue * bValue,BOOL * bOutStop))inBlock
+{
+    if (inBlock==nil || _tapeIndex==NSNotFound || _bytes[_range.location]!='{')
+        return;
+    
+    [self _enumerateValuesUsingBlock:^(NSRange bKeyRange, NSRange bValueRange, NSUInteger bValueTapeIndex, BOOL *bOutStop) {
+        
+        NSString * tName=[self _stringInRange:bKeyRange];
+        
+        if (tName==nil)
+            return;
+        
+        inBlock(tName,[self _valueInRange:bValueRange tapeIndex:bValueTapeIndex],bOutStop);
+    }];
+}
+
+#pragma mark - Arrays
+
+- (CUIJSONValue *)elementAtIndex:(NSUInteger)inIndex
+{
+    if (_tapeIndex==NSNotFound || _bytes[_range.location]!='[')
+        return nil;
+    
+    __block NSUInteger tIndex=0;
+    __block CUIJSONValue * tValue=nil;
+    
+    [self _enumerateValuesUsingBlock:^(NSRange bKeyRange, NSRange bValueRange, NSUInteger bValueTapeIndex, BOOL *bOutStop) {
+        
+        if (tIndex==inIndex)
+        {
+            tValue=[self _valueInRange:bValueRange tapeIndex:bValueTapeIndex];
+            
+            *bOutStop=YES;
+        }
+        
+        tIndex++;
+    }];
+    
+    return tValue;
+}
+
+- (NSArray<CUIJSONValue *> *)elements
+{
+    if (_tapeIndex==NSNotFound || _bytes[_range.location]!='[')
+        return nil;
+    
+    NSMutableArray * tMutableArray=[NSMutableArray array];
+    
+    [self _enumerateValuesUsingBlock:^(NSRange bKeyRange, NSRange bValueRange, NSUInteger bValueTapeIndex, BOOL *bOutStop) {
+        
+        [tMutableArray addObject:[self _valueInRange:bValueRange tapeIndex:bValueTapeIndex]];
+    }];
+    
+    return [tMutableArray copy];
+}
+
+#pragma mark - Scalars
+
+- (NSString *)stringValue
+{
+    return [self _stringInRange:_range];
+}
+
+- (NSNumber *)numberValue
+{
+    switch(self.type)
+    {
+        case CUIJSONValueTypeBoolean:
+            
+            return @(self.boolValue);
+            
+        case CUIJSONValueTypeNumber:
+        {
+            if (memchr(_bytes+_range.location,'.',_range.length)!=NULL ||
+                memchr(_bytes+_range.location,'e',_range.length)!=NULL ||
+                memchr(_bytes+_range.location,'E',_range.length)!=NULL)
+            {
+                NSNumber * tNumber=[NSJSONSerialization JSONObjectWithData:[_data subdataWithRange:self.byteRange] options:NSJSONReadingAllowFragments error:NULL];
+                
+                return ([tNumber isKindOfClass:NSNumber.class]==YES) ? tNumber : nil;
+            }
+            
+            if (_bytes[_range.location]=='-')
+                return @(self.longLongValue);
+            
+            return @(self.unsignedLongLongValue);
+        }
+            
+        default:
+            
+            break;
+    }
+    
+    return nil;
+}
+
+- (long long)longLongValue
+{
+    char tBuffer[32];
+    
+    if (self.type!=CUIJSONValueTypeNumber || _range.length>=sizeof(tBuffer))
+        return 0;
+    
+    memcpy(tBuffer,_bytes+_range.location,_range.length);
+    tBuffer[_range.length]='\0';
+    
+    return strtoll(tBuffer,NULL,10);
+}
+
+- (unsigned long long)unsignedLongLongValue
+{
+    char tBuffer[32];
+    
+    if (self.type!=CUIJSONValueTypeNumber || _bytes[_range.location]=='-' || _range.length>=sizeof(tBuffer))
+        return 0;
+    
+    memcpy(tBuffer,_bytes+_range.location,_range.length);
+    tBuffer[_range.length]='\0';
+    
+    return strtoull(tBuffer,NULL,10);
+}
+
+- (BOOL)boolValue
+{
+    if (_range.length==4 && memcmp(_bytes+_range.location,"true",4)==0)
+        return YES;
+    
+    if (self.type==CUIJSONValueTypeNumber)
+        return (self.longLongValue!=0);
+    
+    return NO;
+}
+
+#pragma mark -
+
+- (id)objectValue
+{
+    if (self.type==CUIJSONValueTypeInvalid)
+        return nil;
+    
+    return [NSJSONSerialization JSONObjectWithData:[_data subdataWithRange:self.byteRange] options:NSJSONReadingAllowFragments error:NULL];
+}
+
+@end
@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CUIPortableTypes_h
+#define CUIPortableTypes_h
+
+// The Foundation types used by the plain C sources, so that they can also be built without Foundation (e.g. on Linux, see tool_symbolicate/CMakeLists.txt).
+
+#if defined(__OBJC__)
+
+#import <Foundation/Foundation.h>
+
+#else
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+
+#if defined(__APPLE__)
+
+// Same definition as the one seen by the Objective-C sources
+
+#include <objc/objc.h>
+
+#else
+
+#include <stdbool.h>
+
+typedef bool BOOL;
+
+#define YES true
+#define NO false
+
+#endif
+
+typedef long NSInteger;
+typedef unsigned long NSUInteger;
+
+#define NSIntegerMax LONG_MAX
+#define NSIntegerMin LONG_MIN
+
+#define NSNotFound NSIntegerMax
+
+#define NS_INLINE static __inline__ __attribute__((always_inline))
+
+typedef struct _NSRange
+{
+    NSUInteger location;
+    NSUInteger length;
+} NSRange;
+
+NS_INLINE NSRange NSMakeRange(NSUInteger inLocation,NSUInteger inLength)
+{
+    NSRange tRange={inLocation,inLength};
+    
+    return tRange;
+}
+
+NS_INLINE NSUInteger NSMaxRange(NSRange inRange)
+{
+    return (inRange.location+inRange.length);
+}
+
+#endif
+
+#endif
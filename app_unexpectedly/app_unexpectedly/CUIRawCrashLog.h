@@ -17,6 +17,15 @@
 
 #import "IPSReport.h"
 
+#import "CUICrashLogTextLines.h"
+
+#import "CUIIPSReportIndex.h"
+
+typedef NS_OPTIONS(NSUInteger, CUICrashLogReadingOptions)
+{
+    CUICrashLogReadingHeaderOnly=1      // The rest of the file is read when it is needed
+};
+
 typedef NS_ENUM(NSUInteger, CUICrashLogReportSourceType)
 {
     CUICrashLogReportSourceTypeSystem=0,
@@ -32,12 +41,16 @@ typedef NS_ENUM(NSUInteger, CUICrashLogReportSourceType)
 
     @property (readonly,copy) NSString * rawText;   // Can be nil
 
+    @property (readonly) CUICrashLogTextLines * textLines;  // Can be nil
+
     @property (readonly,copy) NSString * crashLogFilePath;
 
     @property (nonatomic,readonly) CUICrashLogReportSourceType reportSourceType;
 
     @property (nonatomic,readonly) BOOL isFullyParsed;
 
+    @property (nonatomic,readonly,getter=isHeaderOnly) BOOL headerOnly;     // Only the beginning of the file has been read
+
 
     @property (nonatomic,readonly,getter=isHeaderAvailable) BOOL headerAvailable;
 
@@ -71,14 +84,34 @@ typedef NS_ENUM(NSUInteger, CUICrashLogReportSourceType)
 
 - (instancetype)initWithContentsOfURL:(NSURL *)inURL error:(NSError **)outError;
 
+- (instancetype)initWithContentsOfURL:(NSURL *)inURL options:(CUICrashLogReadingOptions)inOptions error:(NSError **)outError;
+
 - (instancetype)initWithContentsOfFile:(NSString *)inPath error:(NSError **)outError;
 
+- (instancetype)initWithContentsOfFile:(NSString *)inPath options:(CUICrashLogReadingOptions)inOptions error:(NSError **)outError;
+
 - (instancetype)initWithData:(NSData *)inData error:(NSError **)outError;
 
 - (instancetype)initWithString:(NSString *)inString error:(NSError **)outError;
 
 - (BOOL)finalizeParsing;
 
+// Reads the rest of the file of a header only crash log
+
+- (void)readContentsIfNeeded;
+
+// Subclasses parse the crash log there once its contents has been read
+
+- (BOOL)parseContents;
+
+// and there when only the beginning of a textual crash log has been read
+
+- (BOOL)parseHeaderOfTextLines:(CUICrashLogTextLines *)inLines;
+
+// A new structural index of the file of an IPS report (nil otherwise). The report is not parsed.
+
+- (CUIIPSReportIndex *)ipsReportIndex;
+
 
 @property (nonatomic,readonly,copy) NSString * crashLogFileName;
 
@@ -15,14 +15,34 @@
 
 #import "CUICrashLogSectionsDetector.h"
 
+#import "CUICrashLogHeaderReader.h"
+
 #import "CUICrashLogHeader.h"
 
+#import "CUIParsingErrors.h"
+
 #import "NSFileManager+ExtendedAttributes.h"
 
+#import <os/lock.h>
+
 @interface CUIRawCrashLog ()
 {
     BOOL _isLastHopeParseDone;
     
+    // Set while only the beginning of the file has been read
+    
+    NSURL * _contentsURL;
+    
+    // The bytes of a textual crash log (mapped when read from a file)
+    
+    NSData * _rawData;
+    
+    os_unfair_lock _textLock;
+    
+    NSString * _rawText;
+    
+    CUICrashLogTextLines * _textLines;
+    
     id _reserved1;  // processName
     id _reserved2;  // dateTime
     id _reserved3;  // header.bundleIdentifier
@@ -33,20 +53,44 @@
 
     @property (copy) NSString * crashLogFilePath;
 
-    @property (copy) NSString * rawText;
-
     // Extended Attributes
 
     @property (copy) NSString * reopenFilePath;
 
 
-- (instancetype)initWithString:(NSString *)inString error:(NSError **)outError;
++ (NSDictionary *)_crashReportSummaryWithData:(NSData *)inData;
+
+- (instancetype)_initWithHeaderData:(NSData *)inData summary:(NSDictionary *)inSummary contentsURL:(NSURL *)inURL error:(NSError **)outError;
+
+- (instancetype)_initWithString:(NSString *)inString error:(NSError **)outError;
 
 @end
 
 @implementation CUIRawCrashLog
 
++ (NSDictionary *)_crashReportSummaryWithData:(NSData *)inData
+{
+    NSDictionary * tSummary=[NSJSONSerialization JSONObjectWithData:inData options:0 error:NULL];
+    
+    if ([tSummary isKindOfClass:NSDictionary.class]==NO)
+        return nil;
+    
+    // Only the crash reports are listed from their summary
+    
+    id tBugType=tSummary[@"bug_type"];
+    
+    if ([tBugType respondsToSelector:@selector(integerValue)]==NO || [tBugType integerValue]!=309)
+        return nil;
+    
+    return tSummary;
+}
+
 - (instancetype)initWithContentsOfURL:(NSURL *)inURL error:(NSError **)outError
+{
+    return [self initWithContentsOfURL:inURL options:0 error:outError];
+}
+
+- (instancetype)initWithContentsOfURL:(NSURL *)inURL options:(CUICrashLogReadingOptions)inOptions error:(NSError **)outError
 {
     if ([inURL isKindOfClass:NSURL.class]==NO)
     {
@@ -56,19 +100,56 @@
         return nil;
     }
     
-    NSError * tError=nil;
-    
-    NSData * tData=[NSData dataWithContentsOfURL:inURL options:0 error:&tError];
+    NSData * tData=nil;
+    BOOL tHeaderOnly=NO;
+    NSDictionary * tSummary=nil;
     
-    if (tData==nil)
+    if ((inOptions & CUICrashLogReadingHeaderOnly)==CUICrashLogReadingHeaderOnly)
     {
-        if (outError!=NULL)
-            *outError=tError;
+        BOOL tEndOfFile=NO;
         
-        return nil;
+        tData=[CUICrashLogHeaderReader headerDataOfFileAtURL:inURL endOfFile:&tEndOfFile];
+        
+        if (tData!=nil && tEndOfFile==NO)
+        {
+            tHeaderOnly=YES;
+            
+            if (((const uint8_t *)tData.bytes)[0]=='{')
+            {
+                tSummary=[CUIRawCrashLog _crashReportSummaryWithData:tData];
+                
+                if (tSummary==nil)
+                {
+                    tHeaderOnly=NO;
+                    tData=nil;
+                }
+            }
+        }
     }
     
-    self=[self initWithData:tData error:outError];
+    if (tHeaderOnly==YES)
+    {
+        self=[self _initWithHeaderData:tData summary:tSummary contentsURL:inURL error:outError];
+    }
+    else
+    {
+        if (tData==nil)
+        {
+            NSError * tError=nil;
+            
+            tData=[NSData dataWithContentsOfURL:inURL options:NSDataReadingMappedIfSafe error:&tError];
+            
+            if (tData==nil)
+            {
+                if (outError!=NULL)
+                    *outError=tError;
+                
+                return nil;
+            }
+        }
+        
+        self=[self initWithData:tData error:outError];
+    }
     
     if (self!=nil)
     {
@@ -116,6 +197,86 @@
     return [self initWithContentsOfURL:[NSURL fileURLWithPath:inPath] error:outError];
 }
 
+- (instancetype)initWithContentsOfFile:(NSString *)inPath options:(CUICrashLogReadingOptions)inOptions error:(NSError **)outError
+{
+    if ([inPath isKindOfClass:NSString.class]==NO)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
+    return [self initWithContentsOfURL:[NSURL fileURLWithPath:inPath] options:inOptions error:outError];
+}
+
+- (instancetype)_initWithHeaderData:(NSData *)inData summary:(NSDictionary *)inSummary contentsURL:(NSURL *)inURL error:(NSError **)outError
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _contentsURL=inURL;
+        
+        _textLock=OS_UNFAIR_LOCK_INIT;
+        
+        _resourceIdentifier=[NSUUID UUID];
+        
+        _isLastHopeParseDone=YES;
+        
+        if (inSummary!=nil)
+        {
+            // The header of an IPS report is parsed with the rest of the report
+            
+            static NSDateFormatter * sSummaryDateFormatter=nil;
+            
+            static dispatch_once_t onceToken;
+            dispatch_once(&onceToken, ^{
+                
+                sSummaryDateFormatter=[NSDateFormatter new];
+                sSummaryDateFormatter.locale=[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];    // Technical Q&A QA1480
+                sSummaryDateFormatter.dateFormat=@"yyyy-MM-dd HH:mm:ss.SS Z";
+            });
+            
+            NSString * tProcessName=inSummary[@"name"];
+            
+            if ([tProcessName isKindOfClass:NSString.class]==NO)
+                tProcessName=inSummary[@"app_name"];
+            
+            if ([tProcessName isKindOfClass:NSString.class]==YES)
+                _reserved1=[tProcessName copy];
+            
+            NSString * tTimestamp=inSummary[@"timestamp"];
+            
+            if ([tTimestamp isKindOfClass:NSString.class]==YES)
+                _reserved2=[sSummaryDateFormatter dateFromString:tTimestamp];
+            
+            if ([inSummary[@"bundleID"] isKindOfClass:NSString.class]==YES)
+                _reserved3=[inSummary[@"bundleID"] copy];
+            
+            if ([inSummary[@"app_version"] isKindOfClass:NSString.class]==YES)
+                _reserved5=[inSummary[@"app_version"] copy];
+            
+            if ([inSummary[@"os_version"] isKindOfClass:NSString.class]==YES)
+                _reserved6=[inSummary[@"os_version"] copy];
+        }
+        else
+        {
+            CUICrashLogTextLines * tLines=[[CUICrashLogTextLines alloc] initWithData:inData];
+            
+            if ([self parseHeaderOfTextLines:tLines]==NO)
+            {
+                if (outError!=NULL)
+                    *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Header"}];
+                
+                return nil;
+            }
+        }
+    }
+    
+    return self;
+}
+
 - (instancetype)initWithData:(NSData *)inData error:(NSError **)outError
 {
     if ([inData isKindOfClass:NSData.class]==NO)
@@ -126,6 +287,27 @@
         return nil;
     }
     
+    // The bytes of a textual crash log are kept as is, the strings are created when needed
+    
+    if (inData.length>=(sizeof("Process:")-1) && memcmp(inData.bytes,"Process:",sizeof("Process:")-1)==0)
+    {
+        self=[super init];
+        
+        if (self!=nil)
+        {
+            _rawData=inData;
+            
+            _textLock=OS_UNFAIR_LOCK_INIT;
+            
+            _resourceIdentifier=[NSUUID UUID];
+            
+            if ([self parseContents]==NO)
+                return nil;
+        }
+        
+        return self;
+    }
+    
     NSString * tString=[[NSString alloc] initWithData:inData encoding:NSUTF8StringEncoding];
     
     if (tString==nil)
@@ -139,10 +321,15 @@
         return nil;
     }
     
-    return [self initWithString:tString error:outError];
+    return [self _initWithString:tString error:outError];
 }
 
 - (instancetype)initWithString:(NSString *)inString error:(NSError **)outError
+{
+    return [self _initWithString:inString error:outError];
+}
+
+- (instancetype)_initWithString:(NSString *)inString error:(NSError **)outError
 {
     if ([inString isKindOfClass:NSString.class]==NO)
     {
@@ -160,6 +347,10 @@
         {
             _rawText=[inString copy];
             
+            _rawData=[_rawText dataUsingEncoding:NSUTF8StringEncoding];
+            
+            _textLock=OS_UNFAIR_LOCK_INIT;
+            
             _resourceIdentifier=[NSUUID UUID];
         }
     }
@@ -203,11 +394,66 @@
         return nil;
     }
     
+    if ([self parseContents]==NO)
+        return nil;
+    
     return self;
 }
 
 #pragma mark -
 
+- (IPSReport *)ipsReport
+{
+    [self readContentsIfNeeded];
+    
+    return _ipsReport;
+}
+
+- (NSString *)rawText
+{
+    [self readContentsIfNeeded];
+    
+    if (_rawData==nil)
+        return nil;
+    
+    os_unfair_lock_lock(&_textLock);
+    
+    if (_rawText==nil)
+    {
+        _rawText=[[NSString alloc] initWithData:_rawData encoding:NSUTF8StringEncoding];
+        
+        if (_rawText==nil)
+            _rawText=[[NSString alloc] initWithData:_rawData encoding:NSASCIIStringEncoding];
+    }
+    
+    NSString * tRawText=_rawText;
+    
+    os_unfair_lock_unlock(&_textLock);
+    
+    return tRawText;
+}
+
+- (CUICrashLogTextLines *)textLines
+{
+    [self readContentsIfNeeded];
+    
+    if (_rawData==nil)
+        return nil;
+    
+    os_unfair_lock_lock(&_textLock);
+    
+    if (_textLines==nil)
+        _textLines=[[CUICrashLogTextLines alloc] initWithData:_rawData];
+    
+    CUICrashLogTextLines * tTextLines=_textLines;
+    
+    os_unfair_lock_unlock(&_textLock);
+    
+    return tTextLines;
+}
+
+#pragma mark -
+
 - (BOOL)isHeaderAvailable
 {
     return (self.ipsReport.incident.header!=nil);
@@ -357,34 +603,100 @@
     return _isLastHopeParseDone;
 }
 
+- (BOOL)isHeaderOnly
+{
+    return (_contentsURL!=nil);
+}
+
 - (BOOL)finalizeParsing
 {
     _isLastHopeParseDone=YES;
     
-    NSRange tRange;
+    return [self parseHeaderOfTextLines:self.textLines];
+}
+
+- (void)readContentsIfNeeded
+{
+    @synchronized(self)
+    {
+        NSURL * tURL=_contentsURL;
+        
+        if (tURL==nil)
+            return;
+        
+        _contentsURL=nil;
+        
+        NSError * tError=nil;
+        
+        NSData * tData=[NSData dataWithContentsOfURL:tURL options:NSDataReadingMappedIfSafe error:&tError];
+        
+        if (tData==nil)
+        {
+            NSLog(@"Error when reading report file \"%@\": %@",tURL.path,tError.description);
+            
+            return;
+        }
+        
+        if (tData.length>0 && ((const uint8_t *)tData.bytes)[0]=='{')
+        {
+            NSString * tString=[[NSString alloc] initWithData:tData encoding:NSUTF8StringEncoding];
+            
+            if (tString==nil)
+                tString=[[NSString alloc] initWithData:tData encoding:NSASCIIStringEncoding];
+            
+            _ipsReport=[[IPSReport alloc] initWithString:tString error:&tError];
+            
+            if (_ipsReport==nil)
+            {
+                NSLog(@"Error when parsing report file \"%@\": %@",tURL.path,tError.description);
+                
+                return;
+            }
+        }
+        else
+        {
+            _rawData=tData;
+        }
+        
+        if ([self parseContents]==NO)
+            NSLog(@"Error when parsing report file \"%@\"",tURL.path);
+    }
+}
+
+- (BOOL)parseContents
+{
+    return YES;
+}
+
+- (CUIIPSReportIndex *)ipsReportIndex
+{
+    NSString * tPath=self.crashLogFilePath;
     
-    NSMutableArray * tLines=[NSMutableArray array];
+    if (tPath==nil)
+        return nil;
     
-    [self.rawText enumerateLinesUsingBlock:^(NSString * bLine, BOOL * bOutStop) {
-        
-        [tLines addObject:bLine];
-    }];
+    NSData * tData=[NSData dataWithContentsOfFile:tPath options:NSDataReadingMappedIfSafe error:NULL];
+    
+    if (tData==nil)
+        return nil;
+    
+    return [[CUIIPSReportIndex alloc] initWithData:tData];
+}
 
-    NSUInteger tFirstLine=0;
+- (BOOL)parseHeaderOfTextLines:(CUICrashLogTextLines *)inLines
+{
+    // Try to parse at least the header (the detection of the other sections may fail)
     
-    // Try to parse at least the header
+    CUICrashLogSectionsDetector * tDetector=[[CUICrashLogSectionsDetector alloc] initWithLines:inLines];
     
-    tRange=[CUICrashLogSectionsDetector detectHeaderSectionRangeInTextualRepresentation:tLines atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(tFirstLine,tLines.count-tFirstLine)]];
+    [tDetector detectSectionsThroughSection:CUICrashLogSectionTypeHeader error:NULL];
     
-    if (tRange.location==NSNotFound)
-    {
-        /*if (outError!=NULL)
-            *outError=[NSError errorWithDomain:CUIParsingErrorDomain code:CUIParsingSectionDetectionFailedError userInfo:@{CUIParsingErrorSectionNameKey:@"Header"}];*/
-        
+    NSRange tRange=[tDetector rangeOfSection:CUICrashLogSectionTypeHeader].lineRange;
+    
+    if (tDetector==nil || tRange.location==NSNotFound)
         return NO;
-    }
     
-    CUICrashLogHeader * tHeader=[[CUICrashLogHeader alloc] initWithTextualRepresentation:[tLines subarrayWithRange:tRange] error:NULL];
+    CUICrashLogHeader * tHeader=[[CUICrashLogHeader alloc] initWithTextualRepresentation:[inLines subarrayWithRange:tRange] error:NULL];
     
     if (tHeader!=nil)
     {
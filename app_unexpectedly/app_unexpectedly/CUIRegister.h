@@ -13,10 +13,16 @@
 
 #import <Foundation/Foundation.h>
 
+@class CUIRegisterAnnotation;
+
 @interface CUIRegister : NSObject <NSCopying>
 
     @property (copy) NSString * name;
 
     @property NSUInteger value;
 
+    // Set by CUICrashLogRegistersAnnotator
+
+    @property CUIRegisterAnnotation * annotation;
+
 @end
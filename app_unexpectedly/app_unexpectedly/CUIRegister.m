@@ -30,6 +30,8 @@
     
     nRegister.value=self.value;
     
+    nRegister.annotation=self.annotation;
+    
     return nRegister;
 }
 
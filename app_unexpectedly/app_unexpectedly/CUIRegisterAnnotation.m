@@ -0,0 +1,129 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUIRegisterAnnotation.h"
+
+#import "CUISymbolicationDataFormatter.h"
+
+@interface CUIRegisterAnnotation ()
+
+    @property CUIRegisterAnnotationKind kind;
+
+    @property (copy) NSString * binaryImageIdentifier;
+
+    @property NSUInteger binaryImageOffset;
+
+    @property (getter=isUserCode) BOOL userCode;
+
+    @property (copy) NSString * regionName;
+
+@end
+
+@implementation CUIRegisterAnnotation
+
++ (CUIRegisterAnnotation *)nullAnnotation
+{
+    static CUIRegisterAnnotation * sNullAnnotation=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sNullAnnotation=[CUIRegisterAnnotation new];
+        sNullAnnotation.kind=CUIRegisterAnnotationKindNull;
+    });
+    
+    return sNullAnnotation;
+}
+
+- (instancetype)initWithBinaryImageIdentifier:(NSString *)inIdentifier offset:(NSUInteger)inOffset userCode:(BOOL)inUserCode
+{
+    if (inIdentifier==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _kind=CUIRegisterAnnotationKindBinaryImage;
+        
+        _binaryImageIdentifier=[inIdentifier copy];
+        _binaryImageOffset=inOffset;
+        _userCode=inUserCode;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithRegionName:(NSString *)inRegionName
+{
+    if (inRegionName==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _kind=CUIRegisterAnnotationKindVMRegion;
+        
+        _regionName=[inRegionName copy];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSString *)description
+{
+    return [self displayString];
+}
+
+- (NSString *)displayString
+{
+    switch(self.kind)
+    {
+        case CUIRegisterAnnotationKindNull:
+            
+            return NSLocalizedString(@"NULL",@"");
+            
+        case CUIRegisterAnnotationKindBinaryImage:
+        {
+            CUISymbolicationData * tSymbolicationData=self.symbolicationData;
+            
+            if (tSymbolicationData!=nil)
+            {
+                NSString * tSymbolString=[CUISymbolicationDataFormatter localizedStringFromSymbolicationData:tSymbolicationData
+                                                                                                 symbolStyle:CUISymbolicationDataFormatterFullStyle
+                                                                                                   pathStyle:CUISymbolicationDataFormatterShortStyle
+                                                                                            coordinatesStyle:CUISymbolicationDataFormatterShortStyle
+                                                                                                     options:CUISymbolicationDataFormatterOptionDefaults];
+                
+                return [NSString stringWithFormat:@"%@ - %@",self.binaryImageIdentifier,tSymbolString];
+            }
+            
+            return [NSString stringWithFormat:@"%@ + 0x%lx",self.binaryImageIdentifier,(unsigned long)self.binaryImageOffset];
+        }
+            
+        case CUIRegisterAnnotationKindVMRegion:
+            
+            return self.regionName;
+            
+        default:
+            
+            break;
+    }
+    
+    return nil;
+}
+
+@end
@@ -19,6 +19,8 @@
 
 #import "CUICollectionViewRegisterItem.h"
 
+#import "CUICrashLogRegistersAnnotator.h"
+
 @interface CUIRegistersViewController () <NSCollectionViewDataSource,NSCollectionViewDelegate>
 {
     IBOutlet NSCollectionView * _collectionView;
@@ -28,6 +30,8 @@
 
 - (void)registerItemValueAsDidChange:(NSNotification *)inNotification;
 
+- (void)registersAnnotatorDidAnnotateRegisters:(NSNotification *)inNotification;
+
 @end
 
 @implementation CUIRegistersViewController
@@ -58,6 +62,8 @@
     // Register for notifications
     
     [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(registerItemValueAsDidChange:) name:CUIRegisterItemViewAsValueDidChangeNotification object:nil];
+    
+    [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(registersAnnotatorDidAnnotateRegisters:) name:CUICrashLogRegistersAnnotatorDidAnnotateRegistersNotification object:nil];
 }
 
 #pragma mark -
@@ -161,4 +167,14 @@
     self.browsingState.registersViewValues[tRegister.name]=tViewAsValueNumber;
 }
 
+- (void)registersAnnotatorDidAnnotateRegisters:(NSNotification *)inNotification
+{
+    CUICrashLog * tCrashLog=inNotification.object;
+    
+    if (tCrashLog.threadState!=self.threadState || self.threadState==nil)
+        return;
+    
+    [self refreshUI];
+}
+
 @end
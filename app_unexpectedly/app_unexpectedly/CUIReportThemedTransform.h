@@ -24,6 +24,10 @@
 #import "CUISymbolicationManager.h"
 
 #import "CUISymbolicationDataFormatter.h"
+
+// Attribute of the symbol of a stack frame whose symbolication is pending (value: CUIStackFrame)
+
+extern NSString * const CUIStackFrameSymbolAttributeName;
 #endif
 
 @interface CUIReportThemedTransform : CUIDataTransform
@@ -63,6 +67,14 @@
 
 #ifndef __DISABLE_SYMBOLICATION_
     @property (readonly)  CUISymbolicationDataFormatter * symbolicationDataFormatter;
+
+    // Priority of the look ups for the stack frames being processed
+
+    @property CUISymbolicationPriority symbolicationPriority;
+
+    // Cancellation token of the look ups (see CUISymbolicationManager)
+
+    @property id symbolicationCancellationToken;
 #endif
 
     @property (copy) NSString * processPath;
@@ -76,4 +88,12 @@
 
 - (id)processedStackFrameLine:(NSString *)inLine stackFrame:(CUIStackFrame *)inStackFrame;
 
+#ifndef __DISABLE_SYMBOLICATION_
+
+// Text replacing the symbol of a stack frame once it has been symbolicated
+
+- (NSString *)symbolicatedSymbolOfStackFrame:(CUIStackFrame *)inStackFrame;
+
+#endif
+
 @end
@@ -18,6 +18,10 @@
 
 #import "CUIThemeItemsGroup+UI.h"
 
+#ifndef __DISABLE_SYMBOLICATION_
+NSString * const CUIStackFrameSymbolAttributeName=@"CUIStackFrameSymbolAttributeName";
+#endif
+
 @interface CUIReportThemedTransform ()
 
     @property (readwrite) NSDictionary * plainTextAttributes;
@@ -62,6 +66,8 @@
         
 #ifndef __DISABLE_SYMBOLICATION_
         _symbolicationDataFormatter=[CUISymbolicationDataFormatter new];
+        
+        _symbolicationPriority=CUISymbolicationPriorityRestOfLog;
 #endif
         
         _whitespaceCharacterSet=[NSCharacterSet whitespaceCharacterSet];
@@ -229,6 +235,8 @@
     
 #ifndef __DISABLE_SYMBOLICATION_
     
+    NSUInteger tSymbolLocation=tScanner.scanLocation-tSymbol.length;
+    
     BOOL tSymbolicateAutomatically=[CUIApplicationPreferences sharedPreferences].symbolicateAutomatically;
     
     if (self.symbolicationMode==CUISymbolicationModeNone)
@@ -243,7 +251,7 @@
     
     if (tSymbolicationData!=nil)
     {
-        NSMutableString * tTemporaryLine=[[tLine substringToIndex:tScanner.scanLocation-tSymbol.length] mutableCopy];
+        NSMutableString * tTemporaryLine=[[tLine substringToIndex:tSymbolLocation] mutableCopy];
         
         if (tSymbolicationData.stackFrameSymbol==nil)
         {
@@ -266,6 +274,8 @@
             
             [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
                                                                                                            binaryUUID:tBinaryImage.UUID
+                                                                                                             priority:self.symbolicationPriority
+                                                                                                    cancellationToken:self.symbolicationCancellationToken
                                                                                                     completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                         
                                                                                                         switch(bLookUpResult)
@@ -280,7 +290,8 @@
                                                                                                                 inStackFrame.symbolicationData=bSymbolicationData;
                                                                                                                 
                                                                                                                 [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                  object:self.input];
+                                                                                                                                                                  object:self.crashlog
+                                                                                                                                                                userInfo:@{CUIStackFrameSymbolicationStackFrameKey:inStackFrame}];
                                                                                                                 
                                                                                                                 break;
                                                                                                             }
@@ -289,7 +300,7 @@
                                                                                                             {
                                                                                                                 inStackFrame.symbolicationData=bSymbolicationData;
                                                                                                                 
-                                                                                                                NSMutableString * tTemporaryLine=[[tLine substringToIndex:tScanner.scanLocation-tSymbol.length] mutableCopy];
+                                                                                                                NSMutableString * tTemporaryLine=[[tLine substringToIndex:tSymbolLocation] mutableCopy];
                                                                                                                 
                                                                                                                 tSavedScanLocation+=(bSymbolicationData.stackFrameSymbol.length-tSymbol.length);
                                                                                                                 
@@ -316,6 +327,15 @@
     
     [tProcessedLine addAttributes:tDictionary range:tRange];
     
+#ifndef __DISABLE_SYMBOLICATION_
+    if (tSymbolicateAutomatically==YES && inStackFrame!=nil && inStackFrame.symbolicationData==nil)
+    {
+        // The symbol (and byte offset) will be replaced in place when the look up succeeds
+        
+        [tProcessedLine addAttribute:CUIStackFrameSymbolAttributeName value:inStackFrame range:NSMakeRange(tSymbolLocation,tLine.length-tSymbolLocation)];
+    }
+#endif
+    
     
     if ((self.displaySettings.visibleStackFrameComponents & CUIStackFrameByteOffsetComponent)==0)
     {
@@ -423,4 +443,23 @@
     return tProcessedLine;
 }
 
+#ifndef __DISABLE_SYMBOLICATION_
+
+- (NSString *)symbolicatedSymbolOfStackFrame:(CUIStackFrame *)inStackFrame
+{
+    CUISymbolicationData * tSymbolicationData=inStackFrame.symbolicationData;
+    
+    if (tSymbolicationData==nil)
+        return nil;
+    
+    // Without the byte offset, the source file coordinates are not displayed either
+    
+    if ((self.displaySettings.visibleStackFrameComponents & CUIStackFrameByteOffsetComponent)==0)
+        return tSymbolicationData.stackFrameSymbol;
+    
+    return [self.symbolicationDataFormatter stringForObjectValue:tSymbolicationData];
+}
+
+#endif
+
 @end
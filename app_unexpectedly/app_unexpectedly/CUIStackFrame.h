@@ -21,6 +21,10 @@
 
 extern NSString * const CUIStackFrameSymbolicationDidSucceedNotification;
 
+// userInfo key of the symbolicated stack frame
+
+extern NSString * const CUIStackFrameSymbolicationStackFrameKey;
+
 @interface CUIStackFrame : NSObject <NSCopying>
 
     @property (readonly) NSUInteger index;
@@ -42,6 +46,10 @@ extern NSString * const CUIStackFrameSymbolicationDidSucceedNotification;
 
 - (instancetype)initWithString:(NSString *)inString error:(NSError **)outError;
 
+// The line must be valid UTF-8 (without its line terminator)
+
+- (instancetype)initWithUTF8Bytes:(const uint8_t *)inBytes length:(NSUInteger)inLength error:(NSError **)outError;
+
 - (instancetype)initWithThreadFrame:(IPSThreadFrame *)inFrame atIndex:(NSUInteger)inIndex image:(IPSImage *)inImage error:(NSError **)outError;
 
 - (CUIStackFrame *)stackFrameCloneWithBinaryImageIdentifier:(NSString *)inBinaryImageIdentifier;
@@ -13,8 +13,14 @@
 
 #import "CUIStackFrame.h"
 
+#import "CUIUTF8Scanner.h"
+
+#define CUIStackFrameLineBufferSize     1024
+
 NSString * const CUIStackFrameSymbolicationDidSucceedNotification=@"CUIStackFrameSymbolicationDidSucceedNotification";
 
+NSString * const CUIStackFrameSymbolicationStackFrameKey=@"stackFrame";
+
 @interface CUIStackFrame ()
 
     @property NSUInteger index;
@@ -45,62 +51,80 @@ NSString * const CUIStackFrameSymbolicationDidSucceedNotification=@"CUIStackFram
         return nil;
     }
     
+    uint8_t tBuffer[CUIStackFrameLineBufferSize];
+    NSUInteger tLength=0;
+    
+    const uint8_t * tBytes=CUIUTF8BytesOfString(inString,tBuffer,sizeof(tBuffer),&tLength);
+    
+    return [self initWithUTF8Bytes:tBytes length:tLength error:outError];
+}
+
+// Line example:
+// 3   com.apple.AppKit              	0x00007fff2318a5c5 -[NSApplication run] + 660 (NSApplication.m:1234)
+
+- (instancetype)initWithUTF8Bytes:(const uint8_t *)inBytes length:(NSUInteger)inLength error:(NSError **)outError
+{
+    if (inBytes==NULL)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
     self=[super init];
     
     if (self!=nil)
     {
-        NSUInteger tLength=inString.length;
-        NSCharacterSet * tWhitespaceCharacterSet=[NSCharacterSet whitespaceCharacterSet];
-        
-        NSScanner * tScanner=[NSScanner scannerWithString:inString];
-        
-        tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+        CUIUTF8Scanner tScanner=CUIUTF8ScannerMake(inBytes,inLength);
         
         NSInteger tInteger=-1;
         
-        if ([tScanner scanInteger:&tInteger]==NO)
+        if (CUIUTF8ScannerScanInteger(&tScanner,&tInteger)==NO)
             return nil;
         
         _index=tInteger;
         
-        tScanner.charactersToBeSkipped=[NSCharacterSet characterSetWithCharactersInString:@"\t"];
+        NSRange tRange;
         
-        NSString * tString=nil;
+        NSUInteger tCurrentScanLocation=tScanner.location;
         
-        NSUInteger tCurrentScanLocation=tScanner.scanLocation;
+        CUIUTF8ScannerSkipCharacter(&tScanner,'\t');
         
-        if ([tScanner scanUpToString:@"0x" intoString:&tString]==NO)
+        if (CUIUTF8ScannerScanUpToString(&tScanner,"0x",&tRange)==NO)
             return nil;
         
-        if (tScanner.scanLocation==tLength)
+        if (tScanner.location==inLength)
         {
             // try to find a \t
             
-            tScanner.scanLocation=tCurrentScanLocation;
+            tScanner.location=tCurrentScanLocation;
             
-            if ([tScanner scanUpToString:@"\t" intoString:&tString]==NO)
+            CUIUTF8ScannerSkipCharacter(&tScanner,'\t');
+            
+            if (CUIUTF8ScannerScanUpToString(&tScanner,"\t",&tRange)==NO)
                 return nil;
         }
         
-        _binaryImageIdentifier=[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
-        
-        tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+        _binaryImageIdentifier=CUIUTF8String(inBytes,CUIUTF8TrimmedRange(inBytes,tRange));
         
         unsigned long long tHexaValue=0;
         
-        if ([tScanner scanHexLongLong:&tHexaValue]==NO)
+        if (CUIUTF8ScannerScanHexLongLong(&tScanner,&tHexaValue)==NO)
             return nil;
         
         _machineInstructionAddress=tHexaValue;
         
-        if ([tScanner scanUpToString:@" +" intoString:&tString]==NO)
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
+        
+        if (CUIUTF8ScannerScanUpToString(&tScanner," +",&tRange)==NO)
             return nil;
         
-        _symbol=[tString copy];
+        _symbol=CUIUTF8String(inBytes,tRange);
         
-        if ([tScanner scanInteger:&tInteger]==NO)
+        if (CUIUTF8ScannerScanInteger(&tScanner,&tInteger)==NO)
         {
-            if ([_symbol isEqualToString:@"???"]==NO)
+            if (tRange.length!=3 || memcmp(inBytes+tRange.location,"???",3)!=0)
                 return nil;
             
             tInteger=0;
@@ -108,34 +132,43 @@ NSString * const CUIStackFrameSymbolicationDidSucceedNotification=@"CUIStackFram
         
         _byteOffset=tInteger;
         
-        if (tScanner.scanLocation<(tLength-3))
+        // At least 4 characters remaining
+        
+        if (CUIUTF8UTF16Length(inBytes+tScanner.location,inLength-tScanner.location)>3)
         {
-            tScanner.charactersToBeSkipped=nil;
+            // Without a '(' up to the end of the line, there is no file reference
             
-            if ([tScanner scanUpToString:@"(" intoString:NULL]==YES)
+            if (CUIUTF8ScannerScanUpToString(&tScanner,"(",NULL)==YES && tScanner.location<inLength)
             {
-                tScanner.scanLocation+=1;
-                
-                NSString * tFileReference=nil;
+                tScanner.location+=1;
                 
-                if ([tScanner scanUpToString:@")" intoString:&tFileReference]==YES)
+                if (CUIUTF8ScannerScanUpToString(&tScanner,")",&tRange)==YES)
                 {
-                    NSRange tRange=[tFileReference rangeOfString:@":" options:NSBackwardsSearch];
+                    NSUInteger tColonLocation=NSNotFound;
+                    
+                    for(NSUInteger tLocation=NSMaxRange(tRange);tLocation>tRange.location;tLocation--)
+                    {
+                        if (inBytes[tLocation-1]==':')
+                        {
+                            tColonLocation=tLocation-1;
+                            
+                            break;
+                        }
+                    }
                     
-                    if (tRange.location==NSNotFound)
+                    if (tColonLocation==NSNotFound)
                     {
-                        _sourceFile=[tFileReference copy];
+                        _sourceFile=CUIUTF8String(inBytes,tRange);
                     }
                     else
                     {
-                        _sourceFile=[tFileReference substringToIndex:tRange.location];
+                        _sourceFile=CUIUTF8String(inBytes,NSMakeRange(tRange.location,tColonLocation-tRange.location));
                         
-                        _lineNumber=[[tFileReference substringFromIndex:tRange.location+1] integerValue];
+                        _lineNumber=CUIUTF8IntegerValue(inBytes,NSMakeRange(tColonLocation+1,NSMaxRange(tRange)-tColonLocation-1));
                     }
                 }
             }
         }
-        
     }
     
     return self;
@@ -0,0 +1,41 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// A symbol source is a store of dSYM bundles laid out by binary UUID: <location>/<UUID>/<name>.dSYM
+
+@interface CUISymbolSource : NSObject
+
+    @property (nonatomic,readonly,copy) NSString * location;
+
+// A http(s) URL, a file URL or the path of a directory
+
++ (CUISymbolSource *)symbolSourceWithLocation:(NSString *)inLocation;
+
+// Foo.app/Contents/MacOS/Foo -> Foo.app.dSYM, /usr/lib/libfoo.dylib -> libfoo.dylib.dSYM
+
++ (NSString *)dSYMBundleNameForBinaryPath:(NSString *)inBinaryPath;
+
+// Writes the minimal Info.plist file CUIdSYMBundle needs (e.g. when a store only provides the DWARF file)
+
++ (BOOL)writeInfoPropertyListOfdSYMBundleAtPath:(NSString *)inBundlePath binaryName:(NSString *)inBinaryName error:(NSError **)outError;
+
+- (instancetype)initWithLocation:(NSString *)inLocation;
+
+// Synchronous. Called from a background queue.
+// Copies the dSYM bundle of the binary UUID into the inDirectoryPath folder. Returns NO with no error when the source does not have this dSYM bundle.
+
+- (BOOL)copydSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath toDirectory:(NSString *)inDirectoryPath error:(NSError **)outError;
+
+@end
@@ -0,0 +1,120 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolSource.h"
+
+#import "CUISymbolSourceDirectory.h"
+
+#import "CUISymbolSourceHTTP.h"
+
+@implementation CUISymbolSource
+
++ (CUISymbolSource *)symbolSourceWithLocation:(NSString *)inLocation
+{
+    if (inLocation.length==0)
+        return nil;
+    
+    NSURL * tURL=[NSURL URLWithString:inLocation];
+    
+    NSString * tScheme=tURL.scheme.lowercaseString;
+    
+    if ([tScheme isEqualToString:@"http"]==YES || [tScheme isEqualToString:@"https"]==YES)
+        return [[CUISymbolSourceHTTP alloc] initWithURL:tURL];
+    
+    if (tURL.isFileURL==YES)
+        return [[CUISymbolSourceDirectory alloc] initWithPath:tURL.path];
+    
+    return [[CUISymbolSourceDirectory alloc] initWithPath:inLocation];
+}
+
++ (NSString *)dSYMBundleNameForBinaryPath:(NSString *)inBinaryPath
+{
+    if (inBinaryPath.length==0)
+        return nil;
+    
+    static NSSet * sBundleExtensions=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sBundleExtensions=[NSSet setWithArray:@[@"app",@"appex",@"bundle",@"framework",@"kext",@"plugin",@"xpc"]];
+        
+    });
+    
+    // The dSYM bundle of a binary inside a bundle is named after the innermost bundle
+    
+    NSArray * tComponents=inBinaryPath.pathComponents;
+    
+    for(NSString * tComponent in tComponents.reverseObjectEnumerator)
+    {
+        if ([sBundleExtensions containsObject:tComponent.pathExtension.lowercaseString]==YES)
+            return [tComponent stringByAppendingPathExtension:@"dSYM"];
+    }
+    
+    return [inBinaryPath.lastPathComponent stringByAppendingPathExtension:@"dSYM"];
+}
+
++ (BOOL)writeInfoPropertyListOfdSYMBundleAtPath:(NSString *)inBundlePath binaryName:(NSString *)inBinaryName error:(NSError **)outError
+{
+    if (inBundlePath==nil || inBinaryName==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    NSDictionary * tInfoDictionary=@{
+                                     @"CFBundleDevelopmentRegion":@"English",
+                                     @"CFBundleIdentifier":[NSString stringWithFormat:@"com.apple.xcode.dsym.%@",inBinaryName],
+                                     @"CFBundleInfoDictionaryVersion":@"6.0",
+                                     @"CFBundlePackageType":@"dSYM",
+                                     @"CFBundleSignature":@"????",
+                                     @"CFBundleShortVersionString":@"1.0",
+                                     @"CFBundleVersion":@"1"
+                                     };
+    
+    NSData * tData=[NSPropertyListSerialization dataWithPropertyList:tInfoDictionary format:NSPropertyListXMLFormat_v1_0 options:0 error:outError];
+    
+    if (tData==nil)
+        return NO;
+    
+    return [tData writeToFile:[inBundlePath stringByAppendingPathComponent:@"Contents/Info.plist"] options:NSDataWritingAtomic error:outError];
+}
+
+- (instancetype)initWithLocation:(NSString *)inLocation
+{
+    if (inLocation==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _location=[inLocation copy];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (BOOL)copydSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath toDirectory:(NSString *)inDirectoryPath error:(NSError **)outError
+{
+    if (outError!=NULL)
+        *outError=nil;
+    
+    return NO;
+}
+
+@end
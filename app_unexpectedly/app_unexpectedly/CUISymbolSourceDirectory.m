@@ -0,0 +1,92 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolSourceDirectory.h"
+
+@interface CUISymbolSourceDirectory ()
+
+- (NSString *)_dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath;
+
+@end
+
+@implementation CUISymbolSourceDirectory
+
+- (instancetype)initWithPath:(NSString *)inPath
+{
+    return [super initWithLocation:inPath.stringByStandardizingPath];
+}
+
+#pragma mark -
+
+- (NSString *)_dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath
+{
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    NSString * tBundleName=[CUISymbolSource dSYMBundleNameForBinaryPath:inBinaryPath];
+    
+    // Build-artifact stores do not all agree on the case of the UUIDs
+    
+    NSArray * tFolderNames=@[inBinaryUUID.uppercaseString,inBinaryUUID.lowercaseString];
+    
+    for(NSString * tFolderName in tFolderNames)
+    {
+        NSString * tFolderPath=[self.location stringByAppendingPathComponent:tFolderName];
+        BOOL tIsDirectory=NO;
+        
+        if ([tFileManager fileExistsAtPath:tFolderPath isDirectory:&tIsDirectory]==NO || tIsDirectory==NO)
+            continue;
+        
+        if (tBundleName!=nil)
+        {
+            NSString * tBundlePath=[tFolderPath stringByAppendingPathComponent:tBundleName];
+            
+            if ([tFileManager fileExistsAtPath:tBundlePath]==YES)
+                return tBundlePath;
+        }
+        
+        // The store may not follow the naming convention
+        
+        for(NSString * tComponent in [tFileManager contentsOfDirectoryAtPath:tFolderPath error:NULL])
+        {
+            if ([tComponent.pathExtension caseInsensitiveCompare:@"dSYM"]==NSOrderedSame)
+                return [tFolderPath stringByAppendingPathComponent:tComponent];
+        }
+    }
+    
+    return nil;
+}
+
+- (BOOL)copydSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath toDirectory:(NSString *)inDirectoryPath error:(NSError **)outError
+{
+    if (outError!=NULL)
+        *outError=nil;
+    
+    if (inBinaryUUID==nil || inDirectoryPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    NSString * tBundlePath=[self _dSYMBundlePathForBinaryUUID:inBinaryUUID binaryPath:inBinaryPath];
+    
+    if (tBundlePath==nil)
+        return NO;
+    
+    // The copy is a clone on APFS volumes
+    
+    return [[NSFileManager defaultManager] copyItemAtPath:tBundlePath toPath:[inDirectoryPath stringByAppendingPathComponent:tBundlePath.lastPathComponent] error:outError];
+}
+
+@end
@@ -0,0 +1,214 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolSourceHTTP.h"
+
+#define CUISymbolSourceHTTPStatusCodeOK         200
+#define CUISymbolSourceHTTPStatusCodeNotFound   404
+
+@interface CUISymbolSourceHTTP ()
+{
+    NSURL * _URL;
+    
+    NSURLSession * _session;
+}
+
+- (NSInteger)_downloadFileAtURL:(NSURL *)inURL toPath:(NSString *)inPath error:(NSError **)outError;
+
+@end
+
+@implementation CUISymbolSourceHTTP
+
+- (instancetype)initWithURL:(NSURL *)inURL
+{
+    if (inURL==nil)
+        return nil;
+    
+    self=[super initWithLocation:inURL.absoluteString];
+    
+    if (self!=nil)
+    {
+        _URL=inURL;
+        
+        _timeoutInterval=60.0;
+        
+        // The downloaded files are cached by the symbol sources manager
+        
+        _session=[NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [_session finishTasksAndInvalidate];
+}
+
+#pragma mark -
+
+- (NSInteger)_downloadFileAtURL:(NSURL *)inURL toPath:(NSString *)inPath error:(NSError **)outError
+{
+    __block NSInteger tStatusCode=-1;
+    __block NSError * tError=nil;
+    
+    dispatch_semaphore_t tSemaphore=dispatch_semaphore_create(0);
+    
+    NSURLRequest * tRequest=[NSURLRequest requestWithURL:inURL cachePolicy:NSURLRequestReloadIgnoringLocalCacheData timeoutInterval:self.timeoutInterval];
+    
+    NSURLSessionDownloadTask * tDownloadTask=[_session downloadTaskWithRequest:tRequest completionHandler:^(NSURL * bLocation, NSURLResponse * bResponse, NSError * bError) {
+        
+        if (bLocation==nil)
+        {
+            if ([bError.domain isEqualToString:NSURLErrorDomain]==YES && bError.code==NSURLErrorFileDoesNotExist)
+                tStatusCode=CUISymbolSourceHTTPStatusCodeNotFound;
+            else
+                tError=bError;
+        }
+        else
+        {
+            // A file URL is fine too (e.g. a local stand-in of the server)
+            
+            tStatusCode=([bResponse isKindOfClass:NSHTTPURLResponse.class]==YES) ? ((NSHTTPURLResponse *)bResponse).statusCode : CUISymbolSourceHTTPStatusCodeOK;
+            
+            // The downloaded file is deleted when this block returns
+            
+            if (tStatusCode==CUISymbolSourceHTTPStatusCodeOK)
+            {
+                NSError * tMoveError=nil;
+                
+                if ([[NSFileManager defaultManager] moveItemAtURL:bLocation toURL:[NSURL fileURLWithPath:inPath] error:&tMoveError]==NO)
+                {
+                    tStatusCode=-1;
+                    
+                    tError=tMoveError;
+                }
+            }
+        }
+        
+        dispatch_semaphore_signal(tSemaphore);
+    }];
+    
+    if (tDownloadTask==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:ENOMEM userInfo:@{}];
+        
+        return -1;
+    }
+    
+    [tDownloadTask resume];
+    
+    dispatch_semaphore_wait(tSemaphore, DISPATCH_TIME_FOREVER);
+    
+    if (outError!=NULL)
+        *outError=tError;
+    
+    return tStatusCode;
+}
+
+- (BOOL)copydSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath toDirectory:(NSString *)inDirectoryPath error:(NSError **)outError
+{
+    if (outError!=NULL)
+        *outError=nil;
+    
+    if (inBinaryUUID==nil || inDirectoryPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    // The server can not be browsed so the name of the dSYM bundle must be known
+    
+    if (inBinaryPath.length==0)
+        return NO;
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    NSString * tBinaryName=inBinaryPath.lastPathComponent;
+    
+    NSString * tBundleName=[CUISymbolSource dSYMBundleNameForBinaryPath:inBinaryPath];
+    
+    NSString * tBundlePath=[inDirectoryPath stringByAppendingPathComponent:tBundleName];
+    
+    NSString * tDWARFFolderPath=[tBundlePath stringByAppendingPathComponent:@"Contents/Resources/DWARF"];
+    
+    if ([tFileManager createDirectoryAtPath:tDWARFFolderPath withIntermediateDirectories:YES attributes:nil error:outError]==NO)
+        return NO;
+    
+    // Build-artifact stores do not all agree on the case of the UUIDs
+    
+    NSArray * tFolderNames=@[inBinaryUUID.uppercaseString,inBinaryUUID.lowercaseString];
+    
+    NSURL * tBundleURL=nil;
+    
+    for(NSString * tFolderName in tFolderNames)
+    {
+        NSURL * tURL=[[_URL URLByAppendingPathComponent:tFolderName] URLByAppendingPathComponent:tBundleName];
+        
+        NSError * tError=nil;
+        
+        NSInteger tStatusCode=[self _downloadFileAtURL:[[tURL URLByAppendingPathComponent:@"Contents/Resources/DWARF"] URLByAppendingPathComponent:tBinaryName]
+                                                toPath:[tDWARFFolderPath stringByAppendingPathComponent:tBinaryName]
+                                                 error:&tError];
+        
+        if (tStatusCode==CUISymbolSourceHTTPStatusCodeOK)
+        {
+            tBundleURL=tURL;
+            
+            break;
+        }
+        
+        if (tStatusCode==CUISymbolSourceHTTPStatusCodeNotFound)
+            continue;
+        
+        [tFileManager removeItemAtPath:tBundlePath error:NULL];
+        
+        if (outError!=NULL)
+        {
+            if (tError==nil)
+                tError=[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:@{NSURLErrorFailingURLErrorKey:tURL}];
+            
+            *outError=tError;
+        }
+        
+        return NO;
+    }
+    
+    if (tBundleURL==nil)
+    {
+        [tFileManager removeItemAtPath:tBundlePath error:NULL];
+        
+        return NO;
+    }
+    
+    // The Info.plist file is optional, a minimal one is enough for CUIdSYMBundle
+    
+    NSString * tInfoPath=[tBundlePath stringByAppendingPathComponent:@"Contents/Info.plist"];
+    
+    if ([self _downloadFileAtURL:[tBundleURL URLByAppendingPathComponent:@"Contents/Info.plist"] toPath:tInfoPath error:NULL]!=CUISymbolSourceHTTPStatusCodeOK)
+    {
+        if ([CUISymbolSource writeInfoPropertyListOfdSYMBundleAtPath:tBundlePath binaryName:tBinaryName error:outError]==NO)
+        {
+            [tFileManager removeItemAtPath:tBundlePath error:NULL];
+            
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+@end
@@ -0,0 +1,236 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolSourcesManager.h"
+
+#import "CUIdSYMBundle.h"
+
+@interface CUISymbolSourcesManager ()
+{
+    NSOperationQueue * _fetchOperationQueue;
+    
+    // The callers waiting for a binary UUID being fetched
+    
+    NSMutableDictionary<NSString *,NSMutableArray *> * _pendingFetchesHandlers;
+    
+    NSLock * _lock;
+}
+
+- (void)_fetchdSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath completionHandler:(void (^)(NSString * bdSYMBundlePath))inHandler;
+
+- (NSString *)_dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath;
+
+@end
+
+@implementation CUISymbolSourcesManager
+
+- (instancetype)initWithSources:(NSArray<CUISymbolSource *> *)inSources cache:(CUISymbolsFilesCache *)inCache
+{
+    if (inSources==nil || inCache==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _sources=[inSources copy];
+        
+        _cache=inCache;
+        
+        _fetchOperationQueue=[NSOperationQueue new];
+        _fetchOperationQueue.name=@"fr.whitebox.unexpectedly.symbol-sources";
+        _fetchOperationQueue.qualityOfService=NSQualityOfServiceUtility;
+        _fetchOperationQueue.maxConcurrentOperationCount=4;
+        
+        _pendingFetchesHandlers=[NSMutableDictionary dictionary];
+        
+        _lock=[NSLock new];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)maximumNumberOfConcurrentFetches
+{
+    return _fetchOperationQueue.maxConcurrentOperationCount;
+}
+
+- (void)setMaximumNumberOfConcurrentFetches:(NSUInteger)inMaximumNumberOfConcurrentFetches
+{
+    _fetchOperationQueue.maxConcurrentOperationCount=(inMaximumNumberOfConcurrentFetches>0) ? inMaximumNumberOfConcurrentFetches : 1;
+}
+
+#pragma mark -
+
+- (NSString *)_dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath
+{
+    NSString * tBundlePath=[self.cache dSYMBundlePathForBinaryUUID:inBinaryUUID];
+    
+    if (tBundlePath!=nil)
+        return tBundlePath;
+    
+    if ([self.cache isBinaryUUIDMissing:inBinaryUUID]==YES)
+        return nil;
+    
+    BOOL tFailed=NO;
+    
+    for(CUISymbolSource * tSource in self.sources)
+    {
+        NSError * tError=nil;
+        
+        NSString * tStagingDirectoryPath=[self.cache createStagingDirectory:&tError];
+        
+        if (tStagingDirectoryPath==nil)
+        {
+            NSLog(@"Could not create a staging directory in the symbols cache: %@",tError);
+            
+            return nil;
+        }
+        
+        if ([tSource copydSYMBundleForBinaryUUID:inBinaryUUID binaryPath:inBinaryPath toDirectory:tStagingDirectoryPath error:&tError]==NO)
+        {
+            [[NSFileManager defaultManager] removeItemAtPath:tStagingDirectoryPath error:NULL];
+            
+            if (tError!=nil)
+            {
+                NSLog(@"Could not fetch the dSYM bundle of %@ from %@: %@",inBinaryUUID,tSource.location,tError);
+                
+                tFailed=YES;
+            }
+            
+            continue;
+        }
+        
+        tBundlePath=[self.cache storedSYMBundleOfStagingDirectory:tStagingDirectoryPath binaryUUID:inBinaryUUID error:&tError];
+        
+        if (tBundlePath!=nil)
+        {
+            // The cache is addressed by binary UUID, make sure the contents match the address
+            
+            CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:tBundlePath];
+            
+            if (tBundle.isDSYMBundle==YES && [tBundle.binaryUUIDs containsObject:inBinaryUUID.uppercaseString]==YES)
+                return tBundlePath;
+            
+            NSLog(@"The dSYM bundle of %@ from %@ does not match the binary UUID",inBinaryUUID,tSource.location);
+            
+            [self.cache removedSYMBundleForBinaryUUID:inBinaryUUID];
+            
+            tBundlePath=nil;
+            
+            tFailed=YES;
+            
+            continue;
+        }
+        
+        NSLog(@"Could not store the dSYM bundle of %@ in the symbols cache: %@",inBinaryUUID,tError);
+        
+        tFailed=YES;
+    }
+    
+    // Do not remember a binary UUID as missing because of a transient error (e.g. network)
+    
+    if (tFailed==NO)
+        [self.cache setBinaryUUIDMissing:inBinaryUUID];
+    
+    return nil;
+}
+
+- (void)_fetchdSYMBundleForBinaryUUID:(NSString *)inBinaryUUID binaryPath:(NSString *)inBinaryPath completionHandler:(void (^)(NSString * bdSYMBundlePath))inHandler
+{
+    [_lock lock];
+    
+    NSMutableArray * tHandlers=_pendingFetchesHandlers[inBinaryUUID];
+    
+    if (tHandlers!=nil)
+    {
+        // Already being fetched for another caller
+        
+        [tHandlers addObject:[inHandler copy]];
+        
+        [_lock unlock];
+        
+        return;
+    }
+    
+    _pendingFetchesHandlers[inBinaryUUID]=[NSMutableArray arrayWithObject:[inHandler copy]];
+    
+    [_lock unlock];
+    
+    [_fetchOperationQueue addOperationWithBlock:^{
+        
+        NSString * tBundlePath=nil;
+        
+        @autoreleasepool
+        {
+            tBundlePath=[self _dSYMBundlePathForBinaryUUID:inBinaryUUID binaryPath:inBinaryPath];
+        }
+        
+        [self->_lock lock];
+        
+        NSArray * tPendingHandlers=self->_pendingFetchesHandlers[inBinaryUUID];
+        
+        [self->_pendingFetchesHandlers removeObjectForKey:inBinaryUUID];
+        
+        [self->_lock unlock];
+        
+        for(void (^tHandler)(NSString *) in tPendingHandlers)
+            tHandler(tBundlePath);
+    }];
+}
+
+- (void)fetchdSYMBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages completionHandler:(void (^)(NSArray<NSString *> * bdSYMBundlesPaths))inHandler
+{
+    if (inHandler==nil)
+        return;
+    
+    NSMutableArray * tBundlesPaths=[NSMutableArray array];
+    
+    NSMutableSet * tBinaryUUIDs=[NSMutableSet set];
+    
+    dispatch_group_t tGroup=dispatch_group_create();
+    
+    for(CUIBinaryImage * tBinaryImage in inBinaryImages)
+    {
+        NSString * tBinaryUUID=tBinaryImage.UUID.uppercaseString;
+        
+        if (tBinaryUUID==nil || [tBinaryUUIDs containsObject:tBinaryUUID]==YES)
+            continue;
+        
+        [tBinaryUUIDs addObject:tBinaryUUID];
+        
+        dispatch_group_enter(tGroup);
+        
+        [self _fetchdSYMBundleForBinaryUUID:tBinaryUUID binaryPath:tBinaryImage.path completionHandler:^(NSString * bdSYMBundlePath) {
+            
+            if (bdSYMBundlePath!=nil)
+            {
+                @synchronized(tBundlesPaths)
+                {
+                    [tBundlesPaths addObject:bdSYMBundlePath];
+                }
+            }
+            
+            dispatch_group_leave(tGroup);
+        }];
+    }
+    
+    dispatch_group_notify(tGroup, dispatch_get_global_queue(QOS_CLASS_UTILITY,0), ^{
+        
+        inHandler([tBundlesPaths copy]);
+    });
+}
+
+@end
@@ -15,10 +15,29 @@
 
 #import "CUISymbolicationData.h"
 
+typedef struct
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    
+    uint64_t bytes;     // Estimated memory footprint of the cached entries
+    uint64_t count;
+    
+} CUISymbolicationDataCacheStatistics;
+
+// The cache can be used from any thread.
+
 @interface CUISymbolicationDataCache : NSObject
 
+    @property (readonly) size_t byteBudget;
+
+    @property (nonatomic,readonly) CUISymbolicationDataCacheStatistics statistics;
+
 + (CUISymbolicationDataCache *)sharedCache;
 
+- (instancetype)initWithByteBudget:(size_t)inByteBudget;
+
 - (CUISymbolicationData *)symbolicationDataForAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID;
 
 - (void)setSymbolicationData:(CUISymbolicationData *)inSymbolicationData forAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID;
@@ -15,13 +15,79 @@
 
 #include <pthread.h>
 
+#define CUISymbolicationDataCacheDefaultByteBudget      (32*1024*1024)
+
+#define CUISymbolicationDataCacheInitialCapacity        1024
+
+#define CUISymbolicationDataCacheSlotEmpty              0
+
+typedef struct
+{
+    uint64_t address;
+    
+    uint32_t binaryIndex;       // CUISymbolicationDataCacheSlotEmpty for a free slot
+    
+    uint32_t cost;
+    
+    uint8_t referenced;         // Second chance bit for the clock eviction
+    
+    void * symbolicationData;   // Retained CUISymbolicationData
+    
+} CUISymbolicationDataCacheSlot;
+
+NS_INLINE uint64_t CUISymbolicationDataCacheHash(uint32_t inBinaryIndex,uint64_t inAddress)
+{
+    uint64_t tHash=inAddress ^ (((uint64_t)inBinaryIndex)<<48) ^ inBinaryIndex;
+    
+    // fmix64 (MurmurHash3 finalizer)
+    
+    tHash^=tHash>>33;
+    tHash*=0xff51afd7ed558ccdULL;
+    tHash^=tHash>>33;
+    tHash*=0xc4ceb9fe1a85ec53ULL;
+    tHash^=tHash>>33;
+    
+    return tHash;
+}
+
+NS_INLINE uint32_t CUISymbolicationDataCacheCost(CUISymbolicationData * inSymbolicationData)
+{
+    uint64_t tCost=sizeof(CUISymbolicationDataCacheSlot)+64;
+    
+    tCost+=inSymbolicationData.stackFrameSymbol.length*sizeof(unichar)+32;
+    tCost+=inSymbolicationData.sourceFilePath.length*sizeof(unichar)+32;
+    
+    return (tCost>UINT32_MAX) ? UINT32_MAX : (uint32_t)tCost;
+}
+
 @interface CUISymbolicationDataCache ()
 {
-    NSCache * _cache;
+    CUISymbolicationDataCacheSlot * _slots;
+    
+    size_t _capacity;       // Always a power of 2
+    
+    size_t _count;
+    
+    size_t _clockHand;
+    
+    NSMutableDictionary<NSString *,NSNumber *> * _binaryIndexesRegistry;
+    
+    uint64_t _hits;
+    uint64_t _misses;
+    uint64_t _evictions;
+    uint64_t _bytes;
     
     pthread_rwlock_t _readWriteLock;
 }
 
+- (size_t)_indexOfSlotForAddress:(uint64_t)inAddress binaryIndex:(uint32_t)inBinaryIndex;
+
+- (BOOL)_growIfNeeded;
+
+- (void)_removeSlotAtIndex:(size_t)inIndex;
+
+- (void)_evictIfNeeded;
+
 @end
 
 @implementation CUISymbolicationDataCache
@@ -41,6 +107,11 @@
 }
 
 - (instancetype)init
+{
+    return [self initWithByteBudget:CUISymbolicationDataCacheDefaultByteBudget];
+}
+
+- (instancetype)initWithByteBudget:(size_t)inByteBudget
 {
     self=[super init];
     
@@ -54,12 +125,183 @@
             return nil;
         }
         
-        _cache=[NSCache new];
+        _byteBudget=inByteBudget;
+        
+        _capacity=CUISymbolicationDataCacheInitialCapacity;
+        
+        _slots=calloc(_capacity,sizeof(CUISymbolicationDataCacheSlot));
+        
+        if (_slots==NULL)
+        {
+            pthread_rwlock_destroy(&_readWriteLock);
+            
+            return nil;
+        }
+        
+        _binaryIndexesRegistry=[NSMutableDictionary dictionary];
     }
     
     return self;
 }
 
+- (void)dealloc
+{
+    for(size_t tIndex=0;tIndex<_capacity;tIndex++)
+    {
+        if (_slots[tIndex].binaryIndex!=CUISymbolicationDataCacheSlotEmpty)
+            CFRelease(_slots[tIndex].symbolicationData);
+    }
+    
+    free(_slots);
+    
+    pthread_rwlock_destroy(&_readWriteLock);
+}
+
+#pragma mark -
+
+- (CUISymbolicationDataCacheStatistics)statistics
+{
+    CUISymbolicationDataCacheStatistics tStatistics;
+    
+    pthread_rwlock_rdlock(&_readWriteLock);
+    
+    tStatistics.hits=__atomic_load_n(&_hits,__ATOMIC_RELAXED);
+    tStatistics.misses=__atomic_load_n(&_misses,__ATOMIC_RELAXED);
+    tStatistics.evictions=_evictions;
+    tStatistics.bytes=_bytes;
+    tStatistics.count=_count;
+    
+    pthread_rwlock_unlock(&_readWriteLock);
+    
+    return tStatistics;
+}
+
+#pragma mark -
+
+- (size_t)_indexOfSlotForAddress:(uint64_t)inAddress binaryIndex:(uint32_t)inBinaryIndex
+{
+    size_t tMask=_capacity-1;
+    size_t tIndex=(size_t)(CUISymbolicationDataCacheHash(inBinaryIndex,inAddress) & tMask);
+    
+    // Linear probing: stop on the matching slot or on the first free one.
+    
+    while (_slots[tIndex].binaryIndex!=CUISymbolicationDataCacheSlotEmpty)
+    {
+        if (_slots[tIndex].binaryIndex==inBinaryIndex && _slots[tIndex].address==inAddress)
+            break;
+        
+        tIndex=(tIndex+1) & tMask;
+    }
+    
+    return tIndex;
+}
+
+- (BOOL)_growIfNeeded
+{
+    // Keep the load factor below 0.75
+    
+    if ((_count+1)*4<_capacity*3)
+        return YES;
+    
+    CUISymbolicationDataCacheSlot * tOldSlots=_slots;
+    size_t tOldCapacity=_capacity;
+    
+    CUISymbolicationDataCacheSlot * tNewSlots=calloc(tOldCapacity*2,sizeof(CUISymbolicationDataCacheSlot));
+    
+    if (tNewSlots==NULL)
+        return NO;
+    
+    _slots=tNewSlots;
+    _capacity=tOldCapacity*2;
+    _clockHand=0;
+    
+    for(size_t tIndex=0;tIndex<tOldCapacity;tIndex++)
+    {
+        if (tOldSlots[tIndex].binaryIndex==CUISymbolicationDataCacheSlotEmpty)
+            continue;
+        
+        size_t tNewIndex=[self _indexOfSlotForAddress:tOldSlots[tIndex].address binaryIndex:tOldSlots[tIndex].binaryIndex];
+        
+        _slots[tNewIndex]=tOldSlots[tIndex];
+    }
+    
+    free(tOldSlots);
+    
+    return YES;
+}
+
+- (void)_removeSlotAtIndex:(size_t)inIndex
+{
+    size_t tMask=_capacity-1;
+    
+    CFRelease(_slots[inIndex].symbolicationData);
+    
+    _bytes-=_slots[inIndex].cost;
+    _count--;
+    
+    // Backward shift deletion so that no tombstone is needed
+    
+    size_t tHoleIndex=inIndex;
+    size_t tIndex=inIndex;
+    
+    while (1)
+    {
+        tIndex=(tIndex+1) & tMask;
+        
+        if (_slots[tIndex].binaryIndex==CUISymbolicationDataCacheSlotEmpty)
+            break;
+        
+        size_t tHomeIndex=(size_t)(CUISymbolicationDataCacheHash(_slots[tIndex].binaryIndex,_slots[tIndex].address) & tMask);
+        
+        // The entry can stay where it is if its home slot lies cyclically in ]hole, index]
+        
+        BOOL tCanStay=(tHoleIndex<=tIndex) ? (tHoleIndex<tHomeIndex && tHomeIndex<=tIndex) : (tHoleIndex<tHomeIndex || tHomeIndex<=tIndex);
+        
+        if (tCanStay==YES)
+            continue;
+        
+        _slots[tHoleIndex]=_slots[tIndex];
+        
+        tHoleIndex=tIndex;
+    }
+    
+    memset(&_slots[tHoleIndex],0,sizeof(CUISymbolicationDataCacheSlot));
+}
+
+- (void)_evictIfNeeded
+{
+    // Clock (second chance) approximation of LRU
+    
+    size_t tMask=_capacity-1;
+    
+    while (_bytes>_byteBudget && _count>1)
+    {
+        CUISymbolicationDataCacheSlot * tSlot=&_slots[_clockHand];
+        
+        if (tSlot->binaryIndex==CUISymbolicationDataCacheSlotEmpty)
+        {
+            _clockHand=(_clockHand+1) & tMask;
+            
+            continue;
+        }
+        
+        if (tSlot->referenced!=0)
+        {
+            tSlot->referenced=0;
+            
+            _clockHand=(_clockHand+1) & tMask;
+            
+            continue;
+        }
+        
+        // The slot may be refilled by the backward shift so the hand does not move
+        
+        [self _removeSlotAtIndex:_clockHand];
+        
+        _evictions++;
+    }
+}
+
 #pragma mark -
 
 - (CUISymbolicationData *)symbolicationDataForAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID
@@ -67,12 +309,34 @@
     if (inBinaryUUID==nil)
         return nil;
     
-    NSCache * tAddressesCache=[_cache objectForKey:inBinaryUUID];
+    CUISymbolicationData * tSymbolicationData=nil;
     
-    if (tAddressesCache==nil)
-        return nil;
+    pthread_rwlock_rdlock(&_readWriteLock);
+    
+    uint32_t tBinaryIndex=[_binaryIndexesRegistry[inBinaryUUID] unsignedIntValue];
     
-    return [tAddressesCache objectForKey:@(inAddress)];
+    if (tBinaryIndex!=CUISymbolicationDataCacheSlotEmpty)
+    {
+        size_t tIndex=[self _indexOfSlotForAddress:inAddress binaryIndex:tBinaryIndex];
+        
+        CUISymbolicationDataCacheSlot * tSlot=&_slots[tIndex];
+        
+        if (tSlot->binaryIndex!=CUISymbolicationDataCacheSlotEmpty)
+        {
+            tSymbolicationData=(__bridge CUISymbolicationData *)tSlot->symbolicationData;
+            
+            __atomic_store_n(&tSlot->referenced,1,__ATOMIC_RELAXED);
+        }
+    }
+    
+    pthread_rwlock_unlock(&_readWriteLock);
+    
+    if (tSymbolicationData!=nil)
+        __atomic_fetch_add(&_hits,1,__ATOMIC_RELAXED);
+    else
+        __atomic_fetch_add(&_misses,1,__ATOMIC_RELAXED);
+    
+    return tSymbolicationData;
 }
 
 - (void)setSymbolicationData:(CUISymbolicationData *)inSymbolicationData forAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID
@@ -80,19 +344,61 @@
     if (inSymbolicationData==nil || inBinaryUUID==nil)
         return;
     
-    NSCache * tAddressesCache=[_cache objectForKey:inBinaryUUID];
+    uint32_t tCost=CUISymbolicationDataCacheCost(inSymbolicationData);
+    
+    pthread_rwlock_wrlock(&_readWriteLock);
+    
+    NSNumber * tNumber=_binaryIndexesRegistry[inBinaryUUID];
     
-    if (tAddressesCache==nil)
+    if (tNumber==nil)
     {
-        tAddressesCache=[NSCache new];
+        tNumber=@(_binaryIndexesRegistry.count+1);
         
-        if (tAddressesCache==nil)
+        _binaryIndexesRegistry[inBinaryUUID]=tNumber;
+    }
+    
+    uint32_t tBinaryIndex=tNumber.unsignedIntValue;
+    
+    size_t tIndex=[self _indexOfSlotForAddress:inAddress binaryIndex:tBinaryIndex];
+    
+    CUISymbolicationDataCacheSlot * tSlot=&_slots[tIndex];
+    
+    if (tSlot->binaryIndex!=CUISymbolicationDataCacheSlotEmpty)
+    {
+        // Replace the existing entry
+        
+        CFRelease(tSlot->symbolicationData);
+        
+        _bytes-=tSlot->cost;
+    }
+    else
+    {
+        if ([self _growIfNeeded]==NO)
+        {
+            pthread_rwlock_unlock(&_readWriteLock);
+            
             return;
+        }
+        
+        tIndex=[self _indexOfSlotForAddress:inAddress binaryIndex:tBinaryIndex];
+        
+        tSlot=&_slots[tIndex];
         
-        [_cache setObject:tAddressesCache forKey:inBinaryUUID];
+        tSlot->binaryIndex=tBinaryIndex;
+        tSlot->address=inAddress;
+        
+        _count++;
     }
     
-    [tAddressesCache setObject:inSymbolicationData forKey:@(inAddress)];
+    tSlot->symbolicationData=(void *)CFBridgingRetain(inSymbolicationData);
+    tSlot->cost=tCost;
+    tSlot->referenced=1;
+    
+    _bytes+=tCost;
+    
+    [self _evictIfNeeded];
+    
+    pthread_rwlock_unlock(&_readWriteLock);
 }
 
 @end
@@ -0,0 +1,745 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolicationDataStore.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CUISymbolicationDataStoreLogMagic               0x474F4C53  // SLOG
+#define CUISymbolicationDataStoreIndexMagic             0x58444E49  // INDX
+
+#define CUISymbolicationDataStoreFormatVersion          1
+
+// Compacting rewrites the whole log so it's only worth it when the records it drops are a fraction of the ones it keeps
+
+#define CUISymbolicationDataStoreMinimumCompactedRecordsCount   512
+
+#define CUISymbolicationDataStoreDeadRecordsRatio               0.25
+
+NSString * const CUISymbolicationDataStoreLogFileName=@"symbolication.log";
+
+NSString * const CUISymbolicationDataStoreIndexFileName=@"symbolication.index";
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    
+    uint64_t generation;
+    
+} CUISymbolicationDataStoreLogHeader;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    
+    uint64_t generation;    // Must match the generation of the log
+    
+    uint64_t logLength;     // Length of the log covered by the index
+    
+    uint64_t count;
+    
+} CUISymbolicationDataStoreIndexHeader;
+
+typedef struct
+{
+    uint8_t uuid[16];
+    
+    uint64_t address;
+    
+    uint64_t recordOffset;
+    
+} CUISymbolicationDataStoreIndexEntry;
+
+typedef struct
+{
+    uint32_t recordLength;
+    
+    uint32_t lineNumber;
+    
+    uint8_t uuid[16];
+    
+    uint64_t address;
+    
+    uint64_t modificationTime;
+    uint64_t size;
+    
+    uint64_t byteOffset;
+    
+    uint32_t columnNumber;
+    
+    uint16_t stackFrameSymbolLength;
+    uint16_t sourceFilePathLength;
+    
+    // Followed by the UTF-8 bytes of the symbol and of the source file path
+    
+} CUISymbolicationDataStoreRecordHeader;
+
+static int CUISymbolicationDataStoreCompareIndexEntries(const void * inFirst, const void * inSecond)
+{
+    const CUISymbolicationDataStoreIndexEntry * tFirstEntry=inFirst;
+    const CUISymbolicationDataStoreIndexEntry * tSecondEntry=inSecond;
+    
+    int tResult=memcmp(tFirstEntry->uuid,tSecondEntry->uuid,sizeof(tFirstEntry->uuid));
+    
+    if (tResult!=0)
+        return tResult;
+    
+    if (tFirstEntry->address<tSecondEntry->address)
+        return -1;
+    
+    if (tFirstEntry->address>tSecondEntry->address)
+        return 1;
+    
+    return 0;
+}
+
+static NSData * CUISymbolicationDataStoreKey(const uint8_t inUUID[16],uint64_t inAddress)
+{
+    uint8_t tBytes[24];
+    
+    memcpy(tBytes,inUUID,16);
+    memcpy(tBytes+16,&inAddress,sizeof(uint64_t));
+    
+    return [NSData dataWithBytes:tBytes length:sizeof(tBytes)];
+}
+
+// Returns 0 if the record is truncated or corrupted
+
+static uint32_t CUISymbolicationDataStoreReadRecordHeader(const uint8_t * inBytes,uint64_t inAvailableLength,CUISymbolicationDataStoreRecordHeader * outHeader)
+{
+    if (inAvailableLength<sizeof(CUISymbolicationDataStoreRecordHeader))
+        return 0;
+    
+    memcpy(outHeader,inBytes,sizeof(CUISymbolicationDataStoreRecordHeader));
+    
+    uint64_t tExpectedLength=sizeof(CUISymbolicationDataStoreRecordHeader)+outHeader->stackFrameSymbolLength+outHeader->sourceFilePathLength;
+    
+    if (outHeader->recordLength!=tExpectedLength || tExpectedLength>inAvailableLength)
+        return 0;
+    
+    return outHeader->recordLength;
+}
+
+static CUISymbolicationData * CUISymbolicationDataStoreDecodeRecord(const uint8_t * inBytes,const CUISymbolicationDataStoreRecordHeader * inHeader)
+{
+    const uint8_t * tStringsPtr=inBytes+sizeof(CUISymbolicationDataStoreRecordHeader);
+    
+    NSString * tStackFrameSymbol=[[NSString alloc] initWithBytes:tStringsPtr length:inHeader->stackFrameSymbolLength encoding:NSUTF8StringEncoding];
+    
+    if (tStackFrameSymbol==nil)
+        return nil;
+    
+    NSString * tSourceFilePath=nil;
+    
+    if (inHeader->sourceFilePathLength>0)
+    {
+        tSourceFilePath=[[NSString alloc] initWithBytes:tStringsPtr+inHeader->stackFrameSymbolLength length:inHeader->sourceFilePathLength encoding:NSUTF8StringEncoding];
+        
+        if (tSourceFilePath==nil)
+            return nil;
+    }
+    
+    CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
+    
+    tSymbolicationData.stackFrameSymbol=tStackFrameSymbol;
+    tSymbolicationData.byteOffset=inHeader->byteOffset;
+    tSymbolicationData.sourceFilePath=tSourceFilePath;
+    tSymbolicationData.lineNumber=inHeader->lineNumber;
+    tSymbolicationData.columnNumber=inHeader->columnNumber;
+    
+    return tSymbolicationData;
+}
+
+NS_INLINE BOOL CUISymbolicationDataStoreSignatureMatches(const CUISymbolicationDataStoreRecordHeader * inHeader,CUISymbolsFileSignature inSignature)
+{
+    return (inHeader->modificationTime==inSignature.modificationTime && inHeader->size==inSignature.size);
+}
+
+@interface CUISymbolicationDataStoreEntry : NSObject
+
+    @property (readonly) CUISymbolicationData * symbolicationData;
+
+    @property (readonly) CUISymbolsFileSignature signature;
+
+- (instancetype)initWithSymbolicationData:(CUISymbolicationData *)inSymbolicationData signature:(CUISymbolsFileSignature)inSignature;
+
+@end
+
+@implementation CUISymbolicationDataStoreEntry
+
+- (instancetype)initWithSymbolicationData:(CUISymbolicationData *)inSymbolicationData signature:(CUISymbolsFileSignature)inSignature
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _symbolicationData=inSymbolicationData;
+        _signature=inSignature;
+    }
+    
+    return self;
+}
+
+@end
+
+@interface CUISymbolicationDataStore ()
+{
+    NSString * _logFilePath;
+    
+    NSString * _indexFilePath;
+    
+    // Memory-mapped files
+    
+    NSData * _logData;
+    
+    NSData * _indexData;
+    
+    // Records appended after the index was built
+    
+    NSMutableDictionary<NSData *,CUISymbolicationDataStoreEntry *> * _unindexedEntries;
+    
+    // Number of records in the index, of (UUID, address) in the log and of records superseded by a later one
+    
+    NSUInteger _indexedRecordsCount;
+    
+    NSUInteger _liveRecordsCount;
+    
+    NSUInteger _deadRecordsCount;
+    
+    int _logFileDescriptor;
+    
+    dispatch_queue_t _queue;
+    
+    NSLock * _lock;
+}
+
+- (BOOL)_openFiles;
+
+// The following methods must be called with the lock held
+
+- (BOOL)_isIndexedRecordWithKey:(NSData *)inKey;
+
+- (void)_countRecordWithKey:(NSData *)inKey;
+
+- (BOOL)_needsCompaction;
+
+- (void)_compact;
+
+@end
+
+@implementation CUISymbolicationDataStore
+
++ (CUISymbolicationDataStore *)sharedStore
+{
+    static CUISymbolicationDataStore * sSymbolicationDataStore=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        NSArray * tArray=NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES);
+        
+        NSString * tBundleIdentifier=[NSBundle mainBundle].bundleIdentifier;
+        
+        if (tArray.count==0 || tBundleIdentifier==nil)
+            return;
+        
+        NSString * tDirectoryPath=[[tArray.firstObject stringByAppendingPathComponent:tBundleIdentifier] stringByAppendingPathComponent:@"Symbolication"];
+        
+        sSymbolicationDataStore=[[CUISymbolicationDataStore alloc] initWithDirectoryPath:tDirectoryPath];
+        
+    });
+    
+    return sSymbolicationDataStore;
+}
+
+- (instancetype)initWithDirectoryPath:(NSString *)inDirectoryPath
+{
+    if (inDirectoryPath==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        NSError * tError=nil;
+        
+        if ([[NSFileManager defaultManager] createDirectoryAtPath:inDirectoryPath withIntermediateDirectories:YES attributes:nil error:&tError]==NO)
+        {
+            NSLog(@"Unable to create the symbolication data store directory: %@",tError);
+            
+            return nil;
+        }
+        
+        _logFilePath=[inDirectoryPath stringByAppendingPathComponent:CUISymbolicationDataStoreLogFileName];
+        
+        _indexFilePath=[inDirectoryPath stringByAppendingPathComponent:CUISymbolicationDataStoreIndexFileName];
+        
+        _unindexedEntries=[NSMutableDictionary dictionary];
+        
+        _logFileDescriptor=-1;
+        
+        _queue=dispatch_queue_create("fr.whitebox.unexpectedly.symbolicationdatastore", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        
+        _lock=[NSLock new];
+        
+        if ([self _openFiles]==NO)
+            return nil;
+        
+        if ([self _needsCompaction]==YES)
+        {
+            dispatch_async(_queue, ^{
+                
+                [self _compact];
+            });
+        }
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_logFileDescriptor!=-1)
+        close(_logFileDescriptor);
+}
+
+#pragma mark -
+
+- (BOOL)_openFiles
+{
+    if (_logFileDescriptor!=-1)
+    {
+        close(_logFileDescriptor);
+        
+        _logFileDescriptor=-1;
+    }
+    
+    _logData=[NSData dataWithContentsOfFile:_logFilePath options:NSDataReadingMappedAlways error:NULL];
+    
+    CUISymbolicationDataStoreLogHeader tLogHeader={0};
+    
+    if (_logData.length>=sizeof(CUISymbolicationDataStoreLogHeader))
+        memcpy(&tLogHeader,_logData.bytes,sizeof(CUISymbolicationDataStoreLogHeader));
+    
+    if (tLogHeader.magic!=CUISymbolicationDataStoreLogMagic || tLogHeader.version!=CUISymbolicationDataStoreFormatVersion)
+    {
+        // Missing, corrupted or obsolete log: start from scratch
+        
+        tLogHeader.magic=CUISymbolicationDataStoreLogMagic;
+        tLogHeader.version=CUISymbolicationDataStoreFormatVersion;
+        tLogHeader.generation=((uint64_t)arc4random()<<32) | arc4random();
+        
+        NSData * tData=[NSData dataWithBytes:&tLogHeader length:sizeof(CUISymbolicationDataStoreLogHeader)];
+        
+        if ([tData writeToFile:_logFilePath options:NSDataWritingAtomic error:NULL]==NO)
+        {
+            NSLog(@"Unable to create the symbolication data log");
+            
+            return NO;
+        }
+        
+        [[NSFileManager defaultManager] removeItemAtPath:_indexFilePath error:NULL];
+        
+        _logData=tData;
+    }
+    
+    // Index
+    
+    uint64_t tIndexedLogLength=sizeof(CUISymbolicationDataStoreLogHeader);
+    
+    _indexData=[NSData dataWithContentsOfFile:_indexFilePath options:NSDataReadingMappedAlways error:NULL];
+    
+    if (_indexData!=nil)
+    {
+        CUISymbolicationDataStoreIndexHeader tIndexHeader={0};
+        
+        if (_indexData.length>=sizeof(CUISymbolicationDataStoreIndexHeader))
+            memcpy(&tIndexHeader,_indexData.bytes,sizeof(CUISymbolicationDataStoreIndexHeader));
+        
+        if (tIndexHeader.magic!=CUISymbolicationDataStoreIndexMagic ||
+            tIndexHeader.version!=CUISymbolicationDataStoreFormatVersion ||
+            tIndexHeader.generation!=tLogHeader.generation ||
+            tIndexHeader.logLength>_logData.length ||
+            _indexData.length!=sizeof(CUISymbolicationDataStoreIndexHeader)+tIndexHeader.count*sizeof(CUISymbolicationDataStoreIndexEntry))
+        {
+            _indexData=nil;
+        }
+        else
+        {
+            tIndexedLogLength=tIndexHeader.logLength;
+            
+            _indexedRecordsCount=(NSUInteger)tIndexHeader.count;
+        }
+    }
+    
+    if (_indexData==nil)
+        _indexedRecordsCount=0;
+    
+    // A compacted log has no dead records
+    
+    _liveRecordsCount=_indexedRecordsCount;
+    
+    _deadRecordsCount=0;
+    
+    // Load the records not covered by the index
+    
+    const uint8_t * tBytes=_logData.bytes;
+    uint64_t tLength=_logData.length;
+    uint64_t tOffset=tIndexedLogLength;
+    
+    [_unindexedEntries removeAllObjects];
+    
+    while (tOffset<tLength)
+    {
+        CUISymbolicationDataStoreRecordHeader tRecordHeader;
+        
+        uint32_t tRecordLength=CUISymbolicationDataStoreReadRecordHeader(tBytes+tOffset,tLength-tOffset,&tRecordHeader);
+        
+        if (tRecordLength==0)
+            break;
+        
+        CUISymbolicationData * tSymbolicationData=CUISymbolicationDataStoreDecodeRecord(tBytes+tOffset,&tRecordHeader);
+        
+        if (tSymbolicationData!=nil)
+        {
+            NSData * tKey=CUISymbolicationDataStoreKey(tRecordHeader.uuid,tRecordHeader.address);
+            
+            CUISymbolsFileSignature tSignature={.modificationTime=tRecordHeader.modificationTime,.size=tRecordHeader.size};
+            
+            [self _countRecordWithKey:tKey];
+            
+            _unindexedEntries[tKey]=[[CUISymbolicationDataStoreEntry alloc] initWithSymbolicationData:tSymbolicationData signature:tSignature];
+        }
+        else
+        {
+            _deadRecordsCount++;
+        }
+        
+        tOffset+=tRecordLength;
+    }
+    
+    if (tOffset<tLength)
+    {
+        // Drop the incomplete record left by an interrupted write
+        
+        NSLog(@"Truncating the symbolication data log at offset %llu",tOffset);
+        
+        truncate(_logFilePath.fileSystemRepresentation,(off_t)tOffset);
+    }
+    
+    _logFileDescriptor=open(_logFilePath.fileSystemRepresentation,O_WRONLY|O_APPEND);
+    
+    if (_logFileDescriptor==-1)
+    {
+        NSLog(@"Unable to open the symbolication data log for writing");
+        
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (BOOL)_isIndexedRecordWithKey:(NSData *)inKey
+{
+    if (_indexData==nil)
+        return NO;
+    
+    CUISymbolicationDataStoreIndexEntry tSearchedEntry={0};
+    
+    [inKey getBytes:tSearchedEntry.uuid range:NSMakeRange(0,16)];
+    [inKey getBytes:&tSearchedEntry.address range:NSMakeRange(16,sizeof(uint64_t))];
+    
+    return (bsearch(&tSearchedEntry,
+                    (const uint8_t *)_indexData.bytes+sizeof(CUISymbolicationDataStoreIndexHeader),
+                    _indexedRecordsCount,
+                    sizeof(CUISymbolicationDataStoreIndexEntry),
+                    CUISymbolicationDataStoreCompareIndexEntries)!=NULL);
+}
+
+- (void)_countRecordWithKey:(NSData *)inKey
+{
+    // A record for an address already in the log makes the previous one dead
+    
+    if (_unindexedEntries[inKey]!=nil || [self _isIndexedRecordWithKey:inKey]==YES)
+        _deadRecordsCount++;
+    else
+        _liveRecordsCount++;
+}
+
+- (BOOL)_needsCompaction
+{
+    if (_deadRecordsCount>=CUISymbolicationDataStoreMinimumCompactedRecordsCount &&
+        _deadRecordsCount>_liveRecordsCount*CUISymbolicationDataStoreDeadRecordsRatio)
+        return YES;
+    
+    // The unindexed records are kept in memory and read again at launch. The index is rebuilt when they outnumber
+    // the indexed ones so the log is rewritten each time it has doubled.
+    
+    return (_unindexedEntries.count>=CUISymbolicationDataStoreMinimumCompactedRecordsCount &&
+            _unindexedEntries.count>_indexedRecordsCount);
+}
+
+- (void)_compact
+{
+    NSData * tLogData=[NSData dataWithContentsOfFile:_logFilePath options:NSDataReadingMappedAlways error:NULL];
+    
+    if (tLogData.length<sizeof(CUISymbolicationDataStoreLogHeader))
+        return;
+    
+    const uint8_t * tBytes=tLogData.bytes;
+    uint64_t tLength=tLogData.length;
+    
+    // Keep the last record for every (UUID, address) and the last signature seen for every UUID
+    
+    NSMutableDictionary<NSData *,NSNumber *> * tLatestRecordsOffsets=[NSMutableDictionary dictionary];
+    
+    NSMutableDictionary<NSData *,NSData *> * tLatestSignatures=[NSMutableDictionary dictionary];
+    
+    uint64_t tOffset=sizeof(CUISymbolicationDataStoreLogHeader);
+    
+    while (tOffset<tLength)
+    {
+        CUISymbolicationDataStoreRecordHeader tRecordHeader;
+        
+        uint32_t tRecordLength=CUISymbolicationDataStoreReadRecordHeader(tBytes+tOffset,tLength-tOffset,&tRecordHeader);
+        
+        if (tRecordLength==0)
+            break;
+        
+        tLatestRecordsOffsets[CUISymbolicationDataStoreKey(tRecordHeader.uuid,tRecordHeader.address)]=@(tOffset);
+        
+        uint64_t tSignature[2]={tRecordHeader.modificationTime,tRecordHeader.size};
+        
+        tLatestSignatures[[NSData dataWithBytes:tRecordHeader.uuid length:16]]=[NSData dataWithBytes:tSignature length:sizeof(tSignature)];
+        
+        tOffset+=tRecordLength;
+    }
+    
+    NSUInteger tCount=tLatestRecordsOffsets.count;
+    
+    CUISymbolicationDataStoreIndexEntry * tEntries=malloc(MAX(tCount,1)*sizeof(CUISymbolicationDataStoreIndexEntry));
+    
+    if (tEntries==NULL)
+        return;
+    
+    __block NSUInteger tEntriesCount=0;
+    
+    [tLatestRecordsOffsets enumerateKeysAndObjectsUsingBlock:^(NSData * bKey, NSNumber * bOffset, BOOL * bOutStop) {
+        
+        CUISymbolicationDataStoreRecordHeader tRecordHeader;
+        
+        memcpy(&tRecordHeader,tBytes+bOffset.unsignedLongLongValue,sizeof(CUISymbolicationDataStoreRecordHeader));
+        
+        // Records resolved from a previous version of the symbols file are obsolete
+        
+        uint64_t tSignature[2]={tRecordHeader.modificationTime,tRecordHeader.size};
+        
+        if ([tLatestSignatures[[bKey subdataWithRange:NSMakeRange(0,16)]] isEqualToData:[NSData dataWithBytes:tSignature length:sizeof(tSignature)]]==NO)
+            return;
+        
+        memcpy(tEntries[tEntriesCount].uuid,tRecordHeader.uuid,16);
+        tEntries[tEntriesCount].address=tRecordHeader.address;
+        tEntries[tEntriesCount].recordOffset=bOffset.unsignedLongLongValue;
+        
+        tEntriesCount++;
+    }];
+    
+    qsort(tEntries,tEntriesCount,sizeof(CUISymbolicationDataStoreIndexEntry),CUISymbolicationDataStoreCompareIndexEntries);
+    
+    // Rewrite the log in the index order
+    
+    CUISymbolicationDataStoreLogHeader tLogHeader;
+    
+    tLogHeader.magic=CUISymbolicationDataStoreLogMagic;
+    tLogHeader.version=CUISymbolicationDataStoreFormatVersion;
+    tLogHeader.generation=((uint64_t)arc4random()<<32) | arc4random();
+    
+    NSMutableData * tNewLogData=[NSMutableData dataWithBytes:&tLogHeader length:sizeof(CUISymbolicationDataStoreLogHeader)];
+    
+    for(NSUInteger tIndex=0;tIndex<tEntriesCount;tIndex++)
+    {
+        const uint8_t * tRecordPtr=tBytes+tEntries[tIndex].recordOffset;
+        
+        uint32_t tRecordLength;
+        
+        memcpy(&tRecordLength,tRecordPtr,sizeof(uint32_t));
+        
+        tEntries[tIndex].recordOffset=tNewLogData.length;
+        
+        [tNewLogData appendBytes:tRecordPtr length:tRecordLength];
+    }
+    
+    CUISymbolicationDataStoreIndexHeader tIndexHeader;
+    
+    tIndexHeader.magic=CUISymbolicationDataStoreIndexMagic;
+    tIndexHeader.version=CUISymbolicationDataStoreFormatVersion;
+    tIndexHeader.generation=tLogHeader.generation;
+    tIndexHeader.logLength=tNewLogData.length;
+    tIndexHeader.count=tEntriesCount;
+    
+    NSMutableData * tNewIndexData=[NSMutableData dataWithBytes:&tIndexHeader length:sizeof(CUISymbolicationDataStoreIndexHeader)];
+    
+    [tNewIndexData appendBytes:tEntries length:tEntriesCount*sizeof(CUISymbolicationDataStoreIndexEntry)];
+    
+    free(tEntries);
+    
+    // The generation check protects against a log and an index from different compactions
+    
+    if ([tNewLogData writeToFile:_logFilePath options:NSDataWritingAtomic error:NULL]==NO ||
+        [tNewIndexData writeToFile:_indexFilePath options:NSDataWritingAtomic error:NULL]==NO)
+    {
+        NSLog(@"Unable to compact the symbolication data store");
+    }
+    
+    [_lock lock];
+    
+    if ([self _openFiles]==NO)
+    {
+        _logData=nil;
+        _indexData=nil;
+    }
+    
+    [_lock unlock];
+}
+
+#pragma mark -
+
+- (CUISymbolicationData *)symbolicationDataForAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID symbolsFileSignature:(CUISymbolsFileSignature)inSignature
+{
+    if (inBinaryUUID==nil)
+        return nil;
+    
+    NSUUID * tUUID=[[NSUUID alloc] initWithUUIDString:inBinaryUUID];
+    
+    if (tUUID==nil)
+        return nil;
+    
+    CUISymbolicationDataStoreIndexEntry tSearchedEntry={0};
+    
+    [tUUID getUUIDBytes:tSearchedEntry.uuid];
+    tSearchedEntry.address=inAddress;
+    
+    CUISymbolicationData * tSymbolicationData=nil;
+    
+    [_lock lock];
+    
+    CUISymbolicationDataStoreEntry * tEntry=_unindexedEntries[CUISymbolicationDataStoreKey(tSearchedEntry.uuid,inAddress)];
+    
+    if (tEntry!=nil)
+    {
+        if (tEntry.signature.modificationTime==inSignature.modificationTime && tEntry.signature.size==inSignature.size)
+            tSymbolicationData=tEntry.symbolicationData;
+    }
+    else if (_indexData!=nil)
+    {
+        CUISymbolicationDataStoreIndexHeader tIndexHeader;
+        
+        memcpy(&tIndexHeader,_indexData.bytes,sizeof(CUISymbolicationDataStoreIndexHeader));
+        
+        const CUISymbolicationDataStoreIndexEntry * tFoundEntry=bsearch(&tSearchedEntry,
+                                                                        (const uint8_t *)_indexData.bytes+sizeof(CUISymbolicationDataStoreIndexHeader),
+                                                                        tIndexHeader.count,
+                                                                        sizeof(CUISymbolicationDataStoreIndexEntry),
+                                                                        CUISymbolicationDataStoreCompareIndexEntries);
+        
+        if (tFoundEntry!=NULL && tFoundEntry->recordOffset<tIndexHeader.logLength)
+        {
+            const uint8_t * tRecordPtr=(const uint8_t *)_logData.bytes+tFoundEntry->recordOffset;
+            
+            CUISymbolicationDataStoreRecordHeader tRecordHeader;
+            
+            if (CUISymbolicationDataStoreReadRecordHeader(tRecordPtr,tIndexHeader.logLength-tFoundEntry->recordOffset,&tRecordHeader)!=0 &&
+                CUISymbolicationDataStoreSignatureMatches(&tRecordHeader,inSignature)==YES)
+            {
+                tSymbolicationData=CUISymbolicationDataStoreDecodeRecord(tRecordPtr,&tRecordHeader);
+            }
+        }
+    }
+    
+    [_lock unlock];
+    
+    return tSymbolicationData;
+}
+
+- (void)setSymbolicationData:(CUISymbolicationData *)inSymbolicationData forAddress:(uint64_t)inAddress binary:(NSString *)inBinaryUUID symbolsFileSignature:(CUISymbolsFileSignature)inSignature
+{
+    if (inSymbolicationData==nil || inBinaryUUID==nil)
+        return;
+    
+    NSUUID * tUUID=[[NSUUID alloc] initWithUUIDString:inBinaryUUID];
+    
+    if (tUUID==nil)
+        return;
+    
+    NSData * tStackFrameSymbolData=[inSymbolicationData.stackFrameSymbol dataUsingEncoding:NSUTF8StringEncoding];
+    NSData * tSourceFilePathData=[inSymbolicationData.sourceFilePath dataUsingEncoding:NSUTF8StringEncoding];
+    
+    if (tStackFrameSymbolData==nil || tStackFrameSymbolData.length>UINT16_MAX || tSourceFilePathData.length>UINT16_MAX)
+        return;
+    
+    CUISymbolicationDataStoreRecordHeader tRecordHeader={0};
+    
+    [tUUID getUUIDBytes:tRecordHeader.uuid];
+    
+    tRecordHeader.address=inAddress;
+    tRecordHeader.modificationTime=inSignature.modificationTime;
+    tRecordHeader.size=inSignature.size;
+    tRecordHeader.byteOffset=inSymbolicationData.byteOffset;
+    tRecordHeader.lineNumber=(uint32_t)inSymbolicationData.lineNumber;
+    tRecordHeader.columnNumber=(uint32_t)inSymbolicationData.columnNumber;
+    tRecordHeader.stackFrameSymbolLength=(uint16_t)tStackFrameSymbolData.length;
+    tRecordHeader.sourceFilePathLength=(uint16_t)tSourceFilePathData.length;
+    tRecordHeader.recordLength=(uint32_t)(sizeof(CUISymbolicationDataStoreRecordHeader)+tRecordHeader.stackFrameSymbolLength+tRecordHeader.sourceFilePathLength);
+    
+    NSMutableData * tRecordData=[NSMutableData dataWithBytes:&tRecordHeader length:sizeof(CUISymbolicationDataStoreRecordHeader)];
+    
+    [tRecordData appendData:tStackFrameSymbolData];
+    
+    if (tSourceFilePathData!=nil)
+        [tRecordData appendData:tSourceFilePathData];
+    
+    NSData * tKey=CUISymbolicationDataStoreKey(tRecordHeader.uuid,inAddress);
+    
+    CUISymbolicationDataStoreEntry * tEntry=[[CUISymbolicationDataStoreEntry alloc] initWithSymbolicationData:inSymbolicationData signature:inSignature];
+    
+    dispatch_async(_queue, ^{
+        
+        if (self->_logFileDescriptor==-1)
+            return;
+        
+        if (write(self->_logFileDescriptor,tRecordData.bytes,tRecordData.length)!=(ssize_t)tRecordData.length)
+        {
+            NSLog(@"Unable to append to the symbolication data log");
+            
+            return;
+        }
+        
+        [self->_lock lock];
+        
+        [self _countRecordWithKey:tKey];
+        
+        self->_unindexedEntries[tKey]=tEntry;
+        
+        BOOL tNeedsCompaction=[self _needsCompaction];
+        
+        [self->_lock unlock];
+        
+        if (tNeedsCompaction==YES)
+            [self _compact];
+    });
+}
+
+@end
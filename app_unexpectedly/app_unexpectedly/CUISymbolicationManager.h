@@ -15,10 +15,42 @@
 
 #import "CUISymbolicationData.h"
 
+@class CUICrashLog;
+
+typedef NS_ENUM(NSUInteger, CUISymbolicationPriority)
+{
+    CUISymbolicationPriorityCrashedThread=0,
+    CUISymbolicationPriorityVisibleFrames,
+    CUISymbolicationPriorityRestOfLog,
+    CUISymbolicationPriorityPrefetch
+};
+
 @interface CUISymbolicationManager : NSObject
 
+    // Number of look ups actually sent to the dSYM bundles
+
+    @property (readonly) NSUInteger issuedLookUpsCount;
+
+    // Number of requests attached to a look up already in progress
+
+    @property (readonly) NSUInteger coalescedLookUpsCount;
+
 + (CUISymbolicationManager *)sharedSymbolicationManager;
 
 - (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
 
+// The cancellation token is compared by identity (usually the token of the presentation displaying the frame)
+
+- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID priority:(CUISymbolicationPriority)inPriority cancellationToken:(id)inToken completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+
+// Maps the symbols files of the binary images of the crash log and parses the compilation units of the stack frames
+// at background QoS, the images of the crashed thread first. A new job replaces the one with the same token. The stack
+// frames are then looked up at the prefetch priority (without completion handler) to fill the cache. Main thread only.
+
+- (void)prewarmSymbolsFilesOfCrashLog:(CUICrashLog *)inCrashLog cancellationToken:(id)inToken;
+
+// The completion handlers of the cancelled requests are never called. The prewarm jobs are stopped too.
+
+- (void)cancelLookUpsWithCancellationToken:(id)inToken;
+
 @end
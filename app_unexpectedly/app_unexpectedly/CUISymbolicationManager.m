@@ -15,15 +15,111 @@
 
 #import "CUISymbolicationDataCache.h"
 
+#import "CUISymbolicationDataStore.h"
+
+#import "CUISymbolicationNegativeCache.h"
+
 #import "CUIdSYMBundlesManager.h"
 
+#import "CUISymbolicationMetrics.h"
+
+#import "CUICrashLog.h"
+
+@interface CUISymbolicationLookUpRequest : NSObject
+
+    @property (nonatomic,copy) void (^completionHandler)(CUISymbolicationDataLookUpResult,CUISymbolicationData *);
+
+    @property (nonatomic) id cancellationToken;
+
+@end
+
+@implementation CUISymbolicationLookUpRequest
+@end
+
+@interface CUISymbolicationPendingLookUp : NSObject
+
+    @property (nonatomic) NSUInteger address;
+
+    @property (nonatomic,copy) NSString * binaryUUID;
+
+    @property (nonatomic) CUIdSYMBundle * bundle;
+
+    @property (nonatomic) CUISymbolicationPriority priority;
+
+    @property (nonatomic,getter=isRunning) BOOL running;
+
+    @property (nonatomic) CUISymbolicationInterval queueWaitInterval;
+
+    @property (nonatomic,readonly) NSMutableArray<CUISymbolicationLookUpRequest *> * requests;
+
+@end
+
+@implementation CUISymbolicationPendingLookUp
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _requests=[NSMutableArray array];
+    }
+    
+    return self;
+}
+
+@end
+
+@interface CUISymbolicationPrewarmJob : NSObject
+
+    @property (nonatomic) id cancellationToken;
+
+    @property (atomic,getter=isCancelled) BOOL cancelled;
+
+@end
+
+@implementation CUISymbolicationPrewarmJob
+@end
+
+#define CUISymbolicationPrioritiesCount    (CUISymbolicationPriorityPrefetch+1)
+
 @interface CUISymbolicationManager ()
 {
     CUISymbolicationDataCache * _cache;
     
+    CUISymbolicationDataStore * _store;
+    
+    CUISymbolicationNegativeCache * _negativeCache;
+    
     CUIdSYMBundlesManager * _bundlesManager;
+    
+    // Look ups scheduled or in progress
+    
+    NSMutableDictionary<NSString *,CUISymbolicationPendingLookUp *> * _pendingLookUpsRegistry;
+    
+    // One FIFO per priority
+    
+    NSArray<NSMutableArray<CUISymbolicationPendingLookUp *> *> * _scheduledLookUpsQueues;
+    
+    NSLock * _pendingLookUpsLock;
+    
+    dispatch_queue_t _symbolicationQueue;
+    
+    // Prewarm jobs scheduled or in progress (protected by _pendingLookUpsLock)
+    
+    NSMutableArray<CUISymbolicationPrewarmJob *> * _prewarmJobs;
+    
+    dispatch_queue_t _prewarmQueue;
 }
 
+- (void)_performNextScheduledLookUp;
+
+- (void)_cancelPrewarmJobsWithCancellationToken:(id)inToken;
+
+    @property NSUInteger issuedLookUpsCount;
+
+    @property NSUInteger coalescedLookUpsCount;
+
 @end
 
 @implementation CUISymbolicationManager
@@ -50,7 +146,28 @@
     {
         _cache=[CUISymbolicationDataCache sharedCache];
         
+        _store=[CUISymbolicationDataStore sharedStore];
+        
+        _negativeCache=[CUISymbolicationNegativeCache sharedCache];
+        
         _bundlesManager=[CUIdSYMBundlesManager sharedManager];
+        
+        _pendingLookUpsRegistry=[NSMutableDictionary dictionary];
+        
+        NSMutableArray * tQueues=[NSMutableArray array];
+        
+        for(NSUInteger tPriority=0;tPriority<CUISymbolicationPrioritiesCount;tPriority++)
+            [tQueues addObject:[NSMutableArray array]];
+        
+        _scheduledLookUpsQueues=[tQueues copy];
+        
+        _pendingLookUpsLock=[NSLock new];
+        
+        _symbolicationQueue=dispatch_queue_create("fr.whitebox.unexpectedly.searchqueue", DISPATCH_QUEUE_SERIAL);
+        
+        _prewarmJobs=[NSMutableArray array];
+        
+        _prewarmQueue=dispatch_queue_create("fr.whitebox.unexpectedly.prewarmqueue", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0));
     }
     
     return self;
@@ -59,6 +176,11 @@
 #pragma mark -
 
 - (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+{
+    [self lookUpSymbolicationDataForMachineInstructionAddress:inAddress binaryUUID:inBinaryUUID priority:CUISymbolicationPriorityRestOfLog cancellationToken:nil completionHandler:handler];
+}
+
+- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID priority:(CUISymbolicationPriority)inPriority cancellationToken:(id)inToken completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler
 {
     CUISymbolicationData * tData=[_cache symbolicationDataForAddress:inAddress binary:inBinaryUUID];
     
@@ -70,18 +192,372 @@
         return;
     }
     
+    if ([_negativeCache isBinaryUUIDUnavailable:inBinaryUUID]==YES)
+    {
+        if (handler!=nil)
+            handler(CUISymbolicationDataLookUpResultNotFound,nil);
+        
+        return;
+    }
+    
     CUIdSYMBundle * tBundle=[_bundlesManager bundleForBinaryUUID:inBinaryUUID];
     
     if (tBundle==nil)
     {
+        [_negativeCache setBinaryUUIDUnavailable:inBinaryUUID];
+        
         if (handler!=nil)
             handler(CUISymbolicationDataLookUpResultNotFound,tData);
         
         return;
     }
     
-    [tBundle lookUpSymbolicationDataForMachineInstructionAddress:inAddress binaryUUID:inBinaryUUID completionHandler:handler];
+    // Results found during a previous launch
+    
+    CUISymbolsFileSignature tSignature=tBundle.symbolsFileSignature;
+    
+    tData=[_store symbolicationDataForAddress:inAddress binary:inBinaryUUID symbolsFileSignature:tSignature];
+    
+    if (tData!=nil)
+    {
+        [_cache setSymbolicationData:tData forAddress:inAddress binary:inBinaryUUID];
+        
+        if (handler!=nil)
+            handler(CUISymbolicationDataLookUpResultFoundInCache,tData);
+        
+        return;
+    }
+    
+    if ([_negativeCache isAddressUnresolvable:inAddress binary:inBinaryUUID symbolsFileSignature:tSignature]==YES)
+    {
+        if (handler!=nil)
+            handler(CUISymbolicationDataLookUpResultNotFound,nil);
+        
+        return;
+    }
+    
+    // A request without a completion handler still performs the look up so that its result is cached
+    
+    if (inPriority>=CUISymbolicationPrioritiesCount)
+        inPriority=CUISymbolicationPriorityPrefetch;
+    
+    CUISymbolicationLookUpRequest * tRequest=[CUISymbolicationLookUpRequest new];
+    tRequest.completionHandler=handler;
+    tRequest.cancellationToken=inToken;
+    
+    // Attach the request to the look up scheduled or in progress for the same address if there's one
+    
+    NSString * tKey=[NSString stringWithFormat:@"%@-%lx",inBinaryUUID,(unsigned long)inAddress];
+    
+    [_pendingLookUpsLock lock];
+    
+    CUISymbolicationPendingLookUp * tPendingLookUp=_pendingLookUpsRegistry[tKey];
+    
+    if (tPendingLookUp!=nil)
+    {
+        [tPendingLookUp.requests addObject:tRequest];
+        
+        // Move it to a more urgent queue if needed
+        
+        if (tPendingLookUp.isRunning==NO && inPriority<tPendingLookUp.priority)
+        {
+            [_scheduledLookUpsQueues[tPendingLookUp.priority] removeObjectIdenticalTo:tPendingLookUp];
+            
+            tPendingLookUp.priority=inPriority;
+            
+            [_scheduledLookUpsQueues[inPriority] addObject:tPendingLookUp];
+        }
+        
+        self.coalescedLookUpsCount+=1;
+        
+        [_pendingLookUpsLock unlock];
+        
+        return;
+    }
+    
+    tPendingLookUp=[CUISymbolicationPendingLookUp new];
+    tPendingLookUp.address=inAddress;
+    tPendingLookUp.binaryUUID=inBinaryUUID;
+    tPendingLookUp.bundle=tBundle;
+    tPendingLookUp.priority=inPriority;
+    tPendingLookUp.queueWaitInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageQueueWait);
+    
+    [tPendingLookUp.requests addObject:tRequest];
+    
+    _pendingLookUpsRegistry[tKey]=tPendingLookUp;
+    
+    [_scheduledLookUpsQueues[inPriority] addObject:tPendingLookUp];
+    
+    self.issuedLookUpsCount+=1;
+    
+    [_pendingLookUpsLock unlock];
+    
+    // Each call performs the most urgent look up at that time, not necessarily this one
+    
+    dispatch_async(_symbolicationQueue, ^{
+        
+        [self _performNextScheduledLookUp];
+    });
 }
 
-@end
+- (void)_performNextScheduledLookUp
+{
+    CUISymbolicationPendingLookUp * tPendingLookUp=nil;
+    
+    [_pendingLookUpsLock lock];
+    
+    for(NSMutableArray * tQueue in _scheduledLookUpsQueues)
+    {
+        if (tQueue.count==0)
+            continue;
+        
+        tPendingLookUp=tQueue.firstObject;
+        
+        [tQueue removeObjectAtIndex:0];
+        
+        tPendingLookUp.running=YES;
+        
+        break;
+    }
+    
+    [_pendingLookUpsLock unlock];
+    
+    // The look up may have been cancelled
+    
+    if (tPendingLookUp==nil)
+        return;
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageQueueWait,tPendingLookUp.queueWaitInterval);
+    
+    CUISymbolicationData * tSymbolicationData=nil;
+    
+    CUISymbolicationDataLookUpResult tLookUpResult=[tPendingLookUp.bundle lookUpSymbolicationDataForMachineInstructionAddress:tPendingLookUp.address binaryUUID:tPendingLookUp.binaryUUID symbolicationData:&tSymbolicationData];
+    
+    NSString * tKey=[NSString stringWithFormat:@"%@-%lx",tPendingLookUp.binaryUUID,(unsigned long)tPendingLookUp.address];
+    
+    CUISymbolicationInterval tDeliveryInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageMainQueueDelivery);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        
+        CUISymbolicationIntervalEnd(CUISymbolicationStageMainQueueDelivery,tDeliveryInterval);
+        
+        [self->_pendingLookUpsLock lock];
+        
+        NSArray * tRequests=[tPendingLookUp.requests copy];
+        
+        [self->_pendingLookUpsRegistry removeObjectForKey:tKey];
+        
+        [self->_pendingLookUpsLock unlock];
+        
+        for(CUISymbolicationLookUpRequest * tRequest in tRequests)
+        {
+            if (tRequest.completionHandler!=nil)
+                tRequest.completionHandler(tLookUpResult,tSymbolicationData);
+        }
+    });
+}
 
+- (void)prewarmSymbolsFilesOfCrashLog:(CUICrashLog *)inCrashLog cancellationToken:(id)inToken
+{
+    if ([inCrashLog isKindOfClass:CUICrashLog.class]==NO)
+        return;
+    
+    CUICrashLogBinaryImages * tBinaryImages=inCrashLog.binaryImages;
+    
+    // Binary UUID -> addresses of the stack frames (relative to the image), the images of the crashed thread first
+    
+    NSMutableArray<NSString *> * tOrderedBinaryUUIDs=[NSMutableArray array];
+    NSMutableDictionary<NSString *,NSMutableOrderedSet<NSNumber *> *> * tAddressesRegistry=[NSMutableDictionary dictionary];
+    
+    NSArray<CUIThread *> * tThreads=inCrashLog.backtraces.threads;
+    
+    NSIndexSet * tCrashedThreadsIndexes=[tThreads indexesOfObjectsPassingTest:^BOOL(CUIThread * bThread, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        return bThread.isCrashed;
+    }];
+    
+    NSMutableArray<CUIThread *> * tOrderedThreads=[[tThreads objectsAtIndexes:tCrashedThreadsIndexes] mutableCopy];
+    
+    [tThreads enumerateObjectsUsingBlock:^(CUIThread * bThread, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        if ([tCrashedThreadsIndexes containsIndex:bIndex]==NO)
+            [tOrderedThreads addObject:bThread];
+    }];
+    
+    for(CUIThread * tThread in tOrderedThreads)
+    {
+        for(CUIStackFrame * tStackFrame in tThread.callStackBacktrace.stackFrames)
+        {
+            NSString * tBinaryImageIdentifier=tStackFrame.binaryImageIdentifier;
+            
+            if (tBinaryImageIdentifier==nil)
+                continue;
+            
+            CUIBinaryImage * tBinaryImage=[tBinaryImages binaryImageWithIdentifier:tBinaryImageIdentifier];
+            
+            if (tBinaryImage==nil)
+            {
+                NSString * tAlternateIdentifier=[tBinaryImages binaryImageIdentifierForName:tBinaryImageIdentifier];
+                
+                if (tAlternateIdentifier!=nil)
+                    tBinaryImage=[tBinaryImages binaryImageWithIdentifier:tAlternateIdentifier];
+            }
+            
+            NSString * tBinaryUUID=tBinaryImage.UUID;
+            
+            if (tBinaryUUID==nil)
+                continue;
+            
+            NSMutableOrderedSet * tAddresses=tAddressesRegistry[tBinaryUUID];
+            
+            if (tAddresses==nil)
+            {
+                tAddresses=[NSMutableOrderedSet orderedSet];
+                
+                tAddressesRegistry[tBinaryUUID]=tAddresses;
+                
+                [tOrderedBinaryUUIDs addObject:tBinaryUUID];
+            }
+            
+            // Already symbolicated
+            
+            if (tStackFrame.symbolicationData!=nil)
+                continue;
+            
+            [tAddresses addObject:@(tStackFrame.machineInstructionAddress-tBinaryImage.binaryImageOffset)];
+        }
+    }
+    
+    // The symbols files of the other binary images are only mapped
+    
+    for(NSString * tBinaryUUID in tBinaryImages.allUUIDs)
+    {
+        if (tAddressesRegistry[tBinaryUUID]!=nil)
+            continue;
+        
+        tAddressesRegistry[tBinaryUUID]=[NSMutableOrderedSet orderedSet];
+        
+        [tOrderedBinaryUUIDs addObject:tBinaryUUID];
+    }
+    
+    CUISymbolicationPrewarmJob * tJob=[CUISymbolicationPrewarmJob new];
+    tJob.cancellationToken=inToken;
+    
+    [_pendingLookUpsLock lock];
+    
+    // A new job replaces the one of the same presentation (e.g. when dSYM bundles have been added)
+    
+    if (inToken!=nil)
+        [self _cancelPrewarmJobsWithCancellationToken:inToken];
+    
+    [_prewarmJobs addObject:tJob];
+    
+    [_pendingLookUpsLock unlock];
+    
+    for(NSString * tBinaryUUID in tOrderedBinaryUUIDs)
+    {
+        if ([_negativeCache isBinaryUUIDUnavailable:tBinaryUUID]==YES)
+            continue;
+        
+        CUIdSYMBundle * tBundle=[_bundlesManager bundleForBinaryUUID:tBinaryUUID];
+        
+        if (tBundle==nil)
+            continue;
+        
+        NSArray * tAddresses=tAddressesRegistry[tBinaryUUID].array;
+        
+        // A look up of the same bundle waits for at most one compilation unit to be parsed.
+        // The bundle lock boosts the priority of the prewarm queue while it does.
+        
+        dispatch_async(_prewarmQueue, ^{
+            
+            if (tJob.isCancelled==YES)
+                return;
+            
+            // A job can be cancelled while a bundle is being prewarmed (e.g. a large crashed thread)
+            
+            [tBundle prewarmSymbolsFileForBinaryUUID:tBinaryUUID machineInstructionAddresses:tAddresses isCancelled:^BOOL{
+                
+                return tJob.isCancelled;
+            }];
+        });
+    }
+    
+    // The frames are then looked up at the lowest priority so that the ones scrolled into view are found in the cache
+    
+    for(NSString * tBinaryUUID in tOrderedBinaryUUIDs)
+    {
+        for(NSNumber * tAddress in tAddressesRegistry[tBinaryUUID])
+            [self lookUpSymbolicationDataForMachineInstructionAddress:tAddress.unsignedIntegerValue binaryUUID:tBinaryUUID priority:CUISymbolicationPriorityPrefetch cancellationToken:inToken completionHandler:nil];
+    }
+    
+    dispatch_async(_prewarmQueue, ^{
+        
+        [self->_pendingLookUpsLock lock];
+        
+        [self->_prewarmJobs removeObjectIdenticalTo:tJob];
+        
+        [self->_pendingLookUpsLock unlock];
+    });
+}
+
+- (void)_cancelPrewarmJobsWithCancellationToken:(id)inToken
+{
+    NSIndexSet * tIndexSet=[_prewarmJobs indexesOfObjectsPassingTest:^BOOL(CUISymbolicationPrewarmJob * bJob, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        return (bJob.cancellationToken==inToken);
+    }];
+    
+    for(CUISymbolicationPrewarmJob * tJob in [_prewarmJobs objectsAtIndexes:tIndexSet])
+        tJob.cancelled=YES;
+    
+    [_prewarmJobs removeObjectsAtIndexes:tIndexSet];
+}
+
+- (void)cancelLookUpsWithCancellationToken:(id)inToken
+{
+    if (inToken==nil)
+        return;
+    
+    [_pendingLookUpsLock lock];
+    
+    NSMutableArray * tCancelledKeys=[NSMutableArray array];
+    
+    [_pendingLookUpsRegistry enumerateKeysAndObjectsUsingBlock:^(NSString * bKey, CUISymbolicationPendingLookUp * bPendingLookUp, BOOL * bOutStop) {
+        
+        NSIndexSet * tIndexSet=[bPendingLookUp.requests indexesOfObjectsPassingTest:^BOOL(CUISymbolicationLookUpRequest * bRequest, NSUInteger bIndex, BOOL * bOutStop2) {
+            
+            return (bRequest.cancellationToken==inToken);
+        }];
+        
+        [bPendingLookUp.requests removeObjectsAtIndexes:tIndexSet];
+        
+        // A look up in progress will complete anyway
+        
+        if (bPendingLookUp.requests.count==0 && bPendingLookUp.isRunning==NO)
+            [tCancelledKeys addObject:bKey];
+    }];
+    
+    if (tCancelledKeys.count>0)
+    {
+        NSSet * tCancelledLookUps=[NSSet setWithArray:[_pendingLookUpsRegistry objectsForKeys:tCancelledKeys notFoundMarker:[NSNull null]]];
+        
+        for(NSMutableArray * tQueue in _scheduledLookUpsQueues)
+        {
+            NSIndexSet * tIndexSet=[tQueue indexesOfObjectsPassingTest:^BOOL(CUISymbolicationPendingLookUp * bPendingLookUp, NSUInteger bIndex, BOOL * bOutStop) {
+                
+                return [tCancelledLookUps containsObject:bPendingLookUp];
+            }];
+            
+            [tQueue removeObjectsAtIndexes:tIndexSet];
+        }
+        
+        [_pendingLookUpsRegistry removeObjectsForKeys:tCancelledKeys];
+    }
+    
+    [self _cancelPrewarmJobsWithCancellationToken:inToken];
+    
+    [_pendingLookUpsLock unlock];
+}
+
+@end
@@ -0,0 +1,58 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// Per stage latency histograms of the symbolication pipeline.
+// Recording is lock-free and each interval is also emitted as an os_signpost interval (macOS 10.14 or later)
+// so that it can be inspected with Instruments.
+
+typedef NS_ENUM(NSUInteger, CUISymbolicationStage)
+{
+    CUISymbolicationStageBundleLookUp=0,
+    CUISymbolicationStageQueueWait,
+    CUISymbolicationStageAddressRangesLookUp,
+    CUISymbolicationStageCompilationUnitParsing,
+    CUISymbolicationStageDebuggingInformationEntrySearch,
+    CUISymbolicationStageLineNumberProgram,
+    CUISymbolicationStageDemangling,
+    CUISymbolicationStageMainQueueDelivery,
+    
+    CUISymbolicationStagesCount
+};
+
+typedef struct
+{
+    uint64_t startTime;         // mach_absolute_time units
+    
+    uint64_t signpostID;
+    
+} CUISymbolicationInterval;
+
+// The interval can be ended on another thread than the one which started it
+
+CUISymbolicationInterval CUISymbolicationIntervalBegin(CUISymbolicationStage inStage);
+
+void CUISymbolicationIntervalEnd(CUISymbolicationStage inStage,CUISymbolicationInterval inInterval);
+
+@interface CUISymbolicationMetrics : NSObject
+
++ (CUISymbolicationMetrics *)sharedMetrics;
+
+// Count, p50, p90, p99 and max duration per stage
+
+- (NSString *)report;
+
+- (void)reset;
+
+@end
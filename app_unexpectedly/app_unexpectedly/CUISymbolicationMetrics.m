@@ -0,0 +1,305 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolicationMetrics.h"
+
+#include <mach/mach_time.h>
+#include <os/log.h>
+#include <os/signpost.h>
+
+// Log-linear buckets (HDR-style): 8 sub-buckets per power of 2, i.e. a relative error of at most 12.5%
+
+#define CUISymbolicationSubBucketsBits      3
+
+#define CUISymbolicationSubBucketsCount     (1<<CUISymbolicationSubBucketsBits)
+
+#define CUISymbolicationBucketsCount        ((64-CUISymbolicationSubBucketsBits+1)*CUISymbolicationSubBucketsCount)
+
+typedef struct
+{
+    uint64_t maximum;
+    
+    uint64_t buckets[CUISymbolicationBucketsCount];
+    
+} CUISymbolicationHistogram;
+
+static CUISymbolicationHistogram sHistograms[CUISymbolicationStagesCount];
+
+static mach_timebase_info_data_t sTimebaseInfo;
+
+static os_log_t sSignpostLog=nil;
+
+static void CUISymbolicationMetricsInitialize(void)
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        mach_timebase_info(&sTimebaseInfo);
+        
+        sSignpostLog=os_log_create("fr.whitebox.unexpectedly","symbolication");
+    });
+}
+
+static inline NSUInteger CUISymbolicationBucketIndex(uint64_t inValue)
+{
+    if (inValue<CUISymbolicationSubBucketsCount)
+        return (NSUInteger)inValue;
+    
+    NSUInteger tExponent=63-__builtin_clzll(inValue);
+    
+    NSUInteger tSubBucket=(NSUInteger)(inValue>>(tExponent-CUISymbolicationSubBucketsBits)) & (CUISymbolicationSubBucketsCount-1);
+    
+    return (tExponent-CUISymbolicationSubBucketsBits+1)*CUISymbolicationSubBucketsCount+tSubBucket;
+}
+
+static uint64_t CUISymbolicationBucketHighestValue(NSUInteger inIndex)
+{
+    NSUInteger tGroup=inIndex/CUISymbolicationSubBucketsCount;
+    
+    uint64_t tSubBucket=inIndex%CUISymbolicationSubBucketsCount;
+    
+    if (tGroup==0)
+        return tSubBucket;
+    
+    uint64_t tLowestValue=(CUISymbolicationSubBucketsCount+tSubBucket)<<(tGroup-1);
+    
+    return tLowestValue+(1ULL<<(tGroup-1))-1;
+}
+
+#define CUISymbolicationSignpostCase(stage,name) \
+    case stage: \
+        if (inBegin==YES) \
+            os_signpost_interval_begin(sSignpostLog,inSignpostID,name); \
+        else \
+            os_signpost_interval_end(sSignpostLog,inSignpostID,name); \
+        break;
+
+static void CUISymbolicationSignpost(CUISymbolicationStage inStage,os_signpost_id_t inSignpostID,BOOL inBegin) API_AVAILABLE(macos(10.14))
+{
+    // The names need to be string literals
+    
+    switch(inStage)
+    {
+        CUISymbolicationSignpostCase(CUISymbolicationStageBundleLookUp,"Bundle Look Up")
+        CUISymbolicationSignpostCase(CUISymbolicationStageQueueWait,"Queue Wait")
+        CUISymbolicationSignpostCase(CUISymbolicationStageAddressRangesLookUp,"Address Ranges Look Up")
+        CUISymbolicationSignpostCase(CUISymbolicationStageCompilationUnitParsing,"Compilation Unit Parsing")
+        CUISymbolicationSignpostCase(CUISymbolicationStageDebuggingInformationEntrySearch,"DIE Search")
+        CUISymbolicationSignpostCase(CUISymbolicationStageLineNumberProgram,"Line Number Program")
+        CUISymbolicationSignpostCase(CUISymbolicationStageDemangling,"Demangling")
+        CUISymbolicationSignpostCase(CUISymbolicationStageMainQueueDelivery,"Main Queue Delivery")
+        
+        default:
+            break;
+    }
+}
+
+#pragma mark -
+
+CUISymbolicationInterval CUISymbolicationIntervalBegin(CUISymbolicationStage inStage)
+{
+    CUISymbolicationMetricsInitialize();
+    
+    CUISymbolicationInterval tInterval={.startTime=mach_absolute_time(),.signpostID=OS_SIGNPOST_ID_NULL};
+    
+    if (@available(macOS 10.14, *))
+    {
+        if (os_signpost_enabled(sSignpostLog)==true)
+        {
+            tInterval.signpostID=os_signpost_id_generate(sSignpostLog);
+            
+            CUISymbolicationSignpost(inStage,tInterval.signpostID,YES);
+        }
+    }
+    
+    return tInterval;
+}
+
+void CUISymbolicationIntervalEnd(CUISymbolicationStage inStage,CUISymbolicationInterval inInterval)
+{
+    uint64_t tEndTime=mach_absolute_time();
+    
+    if (inStage>=CUISymbolicationStagesCount)
+        return;
+    
+    if (inInterval.signpostID!=OS_SIGNPOST_ID_NULL)
+    {
+        if (@available(macOS 10.14, *))
+            CUISymbolicationSignpost(inStage,inInterval.signpostID,NO);
+    }
+    
+    uint64_t tDuration=(tEndTime>inInterval.startTime) ? tEndTime-inInterval.startTime : 0;
+    
+    if (sTimebaseInfo.numer!=sTimebaseInfo.denom)
+        tDuration=tDuration*sTimebaseInfo.numer/sTimebaseInfo.denom;
+    
+    CUISymbolicationHistogram * tHistogram=&sHistograms[inStage];
+    
+    __atomic_fetch_add(&tHistogram->buckets[CUISymbolicationBucketIndex(tDuration)],1,__ATOMIC_RELAXED);
+    
+    uint64_t tMaximum=__atomic_load_n(&tHistogram->maximum,__ATOMIC_RELAXED);
+    
+    while (tDuration>tMaximum)
+    {
+        if (__atomic_compare_exchange_n(&tHistogram->maximum,&tMaximum,tDuration,true,__ATOMIC_RELAXED,__ATOMIC_RELAXED)==true)
+            break;
+    }
+}
+
+#pragma mark -
+
+static NSString * CUISymbolicationStageName(CUISymbolicationStage inStage)
+{
+    switch(inStage)
+    {
+        case CUISymbolicationStageBundleLookUp:
+            return @"Bundle look up";
+        case CUISymbolicationStageQueueWait:
+            return @"Queue wait";
+        case CUISymbolicationStageAddressRangesLookUp:
+            return @"Address ranges look up";
+        case CUISymbolicationStageCompilationUnitParsing:
+            return @"Compilation unit parsing";
+        case CUISymbolicationStageDebuggingInformationEntrySearch:
+            return @"DIE search";
+        case CUISymbolicationStageLineNumberProgram:
+            return @"Line number program";
+        case CUISymbolicationStageDemangling:
+            return @"Demangling";
+        case CUISymbolicationStageMainQueueDelivery:
+            return @"Main queue delivery";
+        default:
+            break;
+    }
+    
+    return @"-";
+}
+
+static NSString * CUISymbolicationFormattedDuration(uint64_t inDuration)
+{
+    if (inDuration<1000)
+        return [NSString stringWithFormat:@"%llu ns",inDuration];
+    
+    if (inDuration<1000000)
+        return [NSString stringWithFormat:@"%.1f us",inDuration/1e3];
+    
+    if (inDuration<1000000000)
+        return [NSString stringWithFormat:@"%.1f ms",inDuration/1e6];
+    
+    return [NSString stringWithFormat:@"%.2f s",inDuration/1e9];
+}
+
+@implementation CUISymbolicationMetrics
+
++ (CUISymbolicationMetrics *)sharedMetrics
+{
+    static CUISymbolicationMetrics * sSymbolicationMetrics=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sSymbolicationMetrics=[CUISymbolicationMetrics new];
+    });
+    
+    return sSymbolicationMetrics;
+}
+
+#pragma mark -
+
+- (NSString *)report
+{
+    static double sPercentiles[3]={0.5,0.9,0.99};
+    
+    NSMutableString * tReport=[NSMutableString stringWithFormat:@"%-26s %10s %10s %10s %10s %10s\n","Stage","Count","p50","p90","p99","Max"];
+    
+    for(NSUInteger tStage=0;tStage<CUISymbolicationStagesCount;tStage++)
+    {
+        CUISymbolicationHistogram * tHistogram=&sHistograms[tStage];
+        
+        // Snapshot of the buckets, intervals may still be recorded
+        
+        uint64_t tBuckets[CUISymbolicationBucketsCount];
+        
+        uint64_t tCount=0;
+        
+        for(NSUInteger tIndex=0;tIndex<CUISymbolicationBucketsCount;tIndex++)
+        {
+            tBuckets[tIndex]=__atomic_load_n(&tHistogram->buckets[tIndex],__ATOMIC_RELAXED);
+            
+            tCount+=tBuckets[tIndex];
+        }
+        
+        uint64_t tMaximum=__atomic_load_n(&tHistogram->maximum,__ATOMIC_RELAXED);
+        
+        NSMutableArray * tColumns=[NSMutableArray arrayWithObject:[NSString stringWithFormat:@"%llu",tCount]];
+        
+        for(NSUInteger tPercentileIndex=0;tPercentileIndex<3;tPercentileIndex++)
+        {
+            if (tCount==0)
+            {
+                [tColumns addObject:@"-"];
+                
+                continue;
+            }
+            
+            uint64_t tRank=(uint64_t)ceil(sPercentiles[tPercentileIndex]*tCount);
+            
+            if (tRank==0)
+                tRank=1;
+            
+            uint64_t tCumulatedCount=0;
+            
+            uint64_t tValue=tMaximum;
+            
+            for(NSUInteger tIndex=0;tIndex<CUISymbolicationBucketsCount;tIndex++)
+            {
+                tCumulatedCount+=tBuckets[tIndex];
+                
+                if (tCumulatedCount>=tRank)
+                {
+                    tValue=MIN(CUISymbolicationBucketHighestValue(tIndex),tMaximum);
+                    
+                    break;
+                }
+            }
+            
+            [tColumns addObject:CUISymbolicationFormattedDuration(tValue)];
+        }
+        
+        [tColumns addObject:(tCount==0) ? @"-" : CUISymbolicationFormattedDuration(tMaximum)];
+        
+        [tReport appendFormat:@"%-26s",CUISymbolicationStageName(tStage).UTF8String];
+        
+        for(NSString * tColumn in tColumns)
+            [tReport appendFormat:@" %10s",tColumn.UTF8String];
+        
+        [tReport appendString:@"\n"];
+    }
+    
+    return [tReport copy];
+}
+
+- (void)reset
+{
+    for(NSUInteger tStage=0;tStage<CUISymbolicationStagesCount;tStage++)
+    {
+        CUISymbolicationHistogram * tHistogram=&sHistograms[tStage];
+        
+        for(NSUInteger tIndex=0;tIndex<CUISymbolicationBucketsCount;tIndex++)
+            __atomic_store_n(&tHistogram->buckets[tIndex],0,__ATOMIC_RELAXED);
+        
+        __atomic_store_n(&tHistogram->maximum,0,__ATOMIC_RELAXED);
+    }
+}
+
+@end
@@ -0,0 +1,201 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolicationNegativeCache.h"
+
+// A missing dSYM can also show up without the bundles manager being told (e.g. Spotlight index being updated)
+
+#define CUISymbolicationNegativeCacheUnavailableBinaryTimeToLive    (10*60.0)
+
+@interface CUISymbolicationNegativeCacheAddresses : NSObject
+
+    @property CUISymbolsFileSignature signature;
+
+    @property (readonly) NSMutableSet<NSNumber *> * addresses;
+
+@end
+
+@implementation CUISymbolicationNegativeCacheAddresses
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _addresses=[NSMutableSet set];
+    }
+    
+    return self;
+}
+
+@end
+
+@interface CUISymbolicationNegativeCache ()
+{
+    NSMutableDictionary<NSString *,NSDate *> * _unavailableBinariesExpirationDates;
+    
+    NSMutableDictionary<NSString *,CUISymbolicationNegativeCacheAddresses *> * _unresolvableAddressesRegistry;
+    
+    NSLock * _lock;
+}
+
+@end
+
+@implementation CUISymbolicationNegativeCache
+
++ (CUISymbolicationNegativeCache *)sharedCache
+{
+    static CUISymbolicationNegativeCache * sNegativeCache=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sNegativeCache=[CUISymbolicationNegativeCache new];
+        
+    });
+    
+    return sNegativeCache;
+}
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _unavailableBinariesExpirationDates=[NSMutableDictionary dictionary];
+        
+        _unresolvableAddressesRegistry=[NSMutableDictionary dictionary];
+        
+        _lock=[NSLock new];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (BOOL)isBinaryUUIDUnavailable:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return NO;
+    
+    BOOL tUnavailable=NO;
+    
+    [_lock lock];
+    
+    NSDate * tExpirationDate=_unavailableBinariesExpirationDates[inBinaryUUID];
+    
+    if (tExpirationDate!=nil)
+    {
+        if (tExpirationDate.timeIntervalSinceNow>0)
+            tUnavailable=YES;
+        else
+            [_unavailableBinariesExpirationDates removeObjectForKey:inBinaryUUID];
+    }
+    
+    [_lock unlock];
+    
+    return tUnavailable;
+}
+
+- (void)setBinaryUUIDUnavailable:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return;
+    
+    [_lock lock];
+    
+    _unavailableBinariesExpirationDates[inBinaryUUID]=[NSDate dateWithTimeIntervalSinceNow:CUISymbolicationNegativeCacheUnavailableBinaryTimeToLive];
+    
+    [_lock unlock];
+}
+
+- (BOOL)isAddressUnresolvable:(uint64_t)inAddress binary:(NSString *)inBinaryUUID symbolsFileSignature:(CUISymbolsFileSignature)inSignature
+{
+    if (inBinaryUUID==nil)
+        return NO;
+    
+    BOOL tUnresolvable=NO;
+    
+    [_lock lock];
+    
+    CUISymbolicationNegativeCacheAddresses * tAddresses=_unresolvableAddressesRegistry[inBinaryUUID];
+    
+    if (tAddresses!=nil &&
+        tAddresses.signature.modificationTime==inSignature.modificationTime &&
+        tAddresses.signature.size==inSignature.size)
+    {
+        tUnresolvable=[tAddresses.addresses containsObject:@(inAddress)];
+    }
+    
+    [_lock unlock];
+    
+    return tUnresolvable;
+}
+
+- (void)setAddressUnresolvable:(uint64_t)inAddress binary:(NSString *)inBinaryUUID symbolsFileSignature:(CUISymbolsFileSignature)inSignature
+{
+    if (inBinaryUUID==nil)
+        return;
+    
+    [_lock lock];
+    
+    CUISymbolicationNegativeCacheAddresses * tAddresses=_unresolvableAddressesRegistry[inBinaryUUID];
+    
+    if (tAddresses==nil ||
+        tAddresses.signature.modificationTime!=inSignature.modificationTime ||
+        tAddresses.signature.size!=inSignature.size)
+    {
+        // The entries recorded for another version of the dSYM are obsolete
+        
+        tAddresses=[CUISymbolicationNegativeCacheAddresses new];
+        
+        tAddresses.signature=inSignature;
+        
+        _unresolvableAddressesRegistry[inBinaryUUID]=tAddresses;
+    }
+    
+    [tAddresses.addresses addObject:@(inAddress)];
+    
+    [_lock unlock];
+}
+
+#pragma mark -
+
+- (void)removeUnavailableBinaryUUIDs:(NSArray<NSString *> *)inBinaryUUIDs
+{
+    if (inBinaryUUIDs.count==0)
+        return;
+    
+    [_lock lock];
+    
+    [_unavailableBinariesExpirationDates removeObjectsForKeys:inBinaryUUIDs];
+    
+    [_lock unlock];
+}
+
+- (void)removeUnresolvableAddressesForBinaryUUIDs:(NSArray<NSString *> *)inBinaryUUIDs
+{
+    if (inBinaryUUIDs.count==0)
+        return;
+    
+    [_lock lock];
+    
+    [_unresolvableAddressesRegistry removeObjectsForKeys:inBinaryUUIDs];
+    
+    [_lock unlock];
+}
+
+@end
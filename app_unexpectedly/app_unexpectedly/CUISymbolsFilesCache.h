@@ -0,0 +1,51 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// On-disk cache of the dSYM bundles fetched from symbol sources. The entries are addressed by binary UUID (<directory>/<UUID>/<name>.dSYM)
+// and evicted by least recent use when the size limit is exceeded. The binary UUIDs no symbol source knows about are remembered too.
+
+@interface CUISymbolsFilesCache : NSObject
+
+    @property (readonly,copy) NSString * directoryPath;
+
+    // 0 means no limit. Default: 2 GB
+
+    @property unsigned long long sizeLimit;
+
+    // Default: 1 day
+
+    @property NSTimeInterval missingBinaryUUIDsTimeToLive;
+
++ (NSString *)defaultDirectoryPath;
+
+- (instancetype)initWithDirectoryPath:(NSString *)inDirectoryPath;
+
+- (NSString *)dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID;
+
+// Returns a new empty folder where a symbol source can copy a dSYM bundle
+
+- (NSString *)createStagingDirectory:(NSError **)outError;
+
+// Moves the dSYM bundle of the staging folder into the cache and returns its new path. The staging folder is removed.
+
+- (NSString *)storedSYMBundleOfStagingDirectory:(NSString *)inStagingDirectoryPath binaryUUID:(NSString *)inBinaryUUID error:(NSError **)outError;
+
+- (void)removedSYMBundleForBinaryUUID:(NSString *)inBinaryUUID;
+
+- (BOOL)isBinaryUUIDMissing:(NSString *)inBinaryUUID;
+
+- (void)setBinaryUUIDMissing:(NSString *)inBinaryUUID;
+
+@end
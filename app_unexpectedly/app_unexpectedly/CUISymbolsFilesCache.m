@@ -0,0 +1,468 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUISymbolsFilesCache.h"
+
+#define CUISymbolsFilesCacheDefaultSizeLimit                (2ULL*1024*1024*1024)
+
+#define CUISymbolsFilesCacheDefaultMissingBinaryTimeToLive  (24*60*60.0)
+
+NSString * const CUISymbolsFilesCacheEntriesFolderName=@"Entries";
+
+NSString * const CUISymbolsFilesCacheStagingFolderName=@"Staging";
+
+NSString * const CUISymbolsFilesCacheMissingBinaryUUIDsFileName=@"MissingBinaryUUIDs.plist";
+
+@interface CUISymbolsFilesCacheEntry : NSObject
+
+    @property unsigned long long size;
+
+    @property NSDate * lastAccessDate;
+
+@end
+
+@implementation CUISymbolsFilesCacheEntry
+
+@end
+
+@interface CUISymbolsFilesCache ()
+{
+    NSString * _entriesFolderPath;
+    
+    NSString * _stagingFolderPath;
+    
+    NSMutableDictionary<NSString *,CUISymbolsFilesCacheEntry *> * _entries;
+    
+    unsigned long long _totalSize;
+    
+    // The dSYM bundles handed out by this instance may be in use, they are not evicted
+    
+    NSMutableSet<NSString *> * _pinnedBinaryUUIDs;
+    
+    NSMutableDictionary<NSString *,NSDate *> * _missingBinaryUUIDsDates;
+    
+    NSLock * _lock;
+}
+
+    @property (readwrite,copy) NSString * directoryPath;
+
++ (unsigned long long)_sizeOfItemAtPath:(NSString *)inPath;
+
+- (void)_loadEntriesIfNeeded;
+
+- (void)_loadMissingBinaryUUIDsIfNeeded;
+
+- (void)_evictEntriesIfNeeded;
+
+@end
+
+@implementation CUISymbolsFilesCache
+
++ (NSString *)defaultDirectoryPath
+{
+    NSString * tCachesPath=NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    
+    if (tCachesPath==nil)
+        tCachesPath=NSTemporaryDirectory();
+    
+    // Shared by the application and the command line tool
+    
+    return [tCachesPath stringByAppendingPathComponent:@"fr.whitebox.unexpectedly/Symbols"];
+}
+
++ (unsigned long long)_sizeOfItemAtPath:(NSString *)inPath
+{
+    unsigned long long tSize=0;
+    
+    NSDirectoryEnumerator * tDirectoryEnumerator=[[NSFileManager defaultManager] enumeratorAtURL:[NSURL fileURLWithPath:inPath]
+                                                                      includingPropertiesForKeys:@[NSURLTotalFileAllocatedSizeKey]
+                                                                                         options:0
+                                                                                    errorHandler:nil];
+    
+    for(NSURL * tURL in tDirectoryEnumerator)
+    {
+        NSNumber * tNumber=nil;
+        
+        if ([tURL getResourceValue:&tNumber forKey:NSURLTotalFileAllocatedSizeKey error:NULL]==YES)
+            tSize+=tNumber.unsignedLongLongValue;
+    }
+    
+    return tSize;
+}
+
+- (instancetype)initWithDirectoryPath:(NSString *)inDirectoryPath
+{
+    if (inDirectoryPath==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _directoryPath=[inDirectoryPath.stringByStandardizingPath copy];
+        
+        _entriesFolderPath=[_directoryPath stringByAppendingPathComponent:CUISymbolsFilesCacheEntriesFolderName];
+        
+        _stagingFolderPath=[_directoryPath stringByAppendingPathComponent:CUISymbolsFilesCacheStagingFolderName];
+        
+        _sizeLimit=CUISymbolsFilesCacheDefaultSizeLimit;
+        
+        _missingBinaryUUIDsTimeToLive=CUISymbolsFilesCacheDefaultMissingBinaryTimeToLive;
+        
+        _pinnedBinaryUUIDs=[NSMutableSet set];
+        
+        _lock=[NSLock new];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (void)_loadEntriesIfNeeded
+{
+    if (_entries!=nil)
+        return;
+    
+    _entries=[NSMutableDictionary dictionary];
+    
+    _totalSize=0;
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    [tFileManager createDirectoryAtPath:_entriesFolderPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    // Leftovers of interrupted fetches
+    
+    [tFileManager removeItemAtPath:_stagingFolderPath error:NULL];
+    
+    NSArray * tURLs=[tFileManager contentsOfDirectoryAtURL:[NSURL fileURLWithPath:_entriesFolderPath]
+                                includingPropertiesForKeys:@[NSURLContentModificationDateKey]
+                                                   options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                     error:NULL];
+    
+    for(NSURL * tURL in tURLs)
+    {
+        CUISymbolsFilesCacheEntry * tEntry=[CUISymbolsFilesCacheEntry new];
+        
+        NSDate * tDate=nil;
+        
+        [tURL getResourceValue:&tDate forKey:NSURLContentModificationDateKey error:NULL];
+        
+        tEntry.lastAccessDate=(tDate!=nil) ? tDate : [NSDate distantPast];
+        
+        tEntry.size=[CUISymbolsFilesCache _sizeOfItemAtPath:tURL.path];
+        
+        _entries[tURL.lastPathComponent]=tEntry;
+        
+        _totalSize+=tEntry.size;
+    }
+}
+
+- (void)_evictEntriesIfNeeded
+{
+    if (self.sizeLimit==0 || _totalSize<=self.sizeLimit)
+        return;
+    
+    NSArray * tSortedBinaryUUIDs=[_entries keysSortedByValueUsingComparator:^NSComparisonResult(CUISymbolsFilesCacheEntry * bEntry, CUISymbolsFilesCacheEntry * bOtherEntry) {
+        
+        return [bEntry.lastAccessDate compare:bOtherEntry.lastAccessDate];
+    }];
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    for(NSString * tBinaryUUID in tSortedBinaryUUIDs)
+    {
+        if (_totalSize<=self.sizeLimit)
+            break;
+        
+        if ([_pinnedBinaryUUIDs containsObject:tBinaryUUID]==YES)
+            continue;
+        
+        if ([tFileManager removeItemAtPath:[_entriesFolderPath stringByAppendingPathComponent:tBinaryUUID] error:NULL]==NO)
+            continue;
+        
+        _totalSize-=_entries[tBinaryUUID].size;
+        
+        [_entries removeObjectForKey:tBinaryUUID];
+    }
+}
+
+#pragma mark -
+
+- (NSString *)dSYMBundlePathForBinaryUUID:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return nil;
+    
+    NSString * tBinaryUUID=inBinaryUUID.uppercaseString;
+    
+    NSString * tFolderPath=[_entriesFolderPath stringByAppendingPathComponent:tBinaryUUID];
+    
+    NSString * tBundlePath=nil;
+    
+    [_lock lock];
+    
+    [self _loadEntriesIfNeeded];
+    
+    // Another process sharing the cache may have stored it
+    
+    for(NSString * tComponent in [[NSFileManager defaultManager] contentsOfDirectoryAtPath:tFolderPath error:NULL])
+    {
+        if ([tComponent.pathExtension isEqualToString:@"dSYM"]==YES)
+        {
+            tBundlePath=[tFolderPath stringByAppendingPathComponent:tComponent];
+            break;
+        }
+    }
+    
+    CUISymbolsFilesCacheEntry * tEntry=_entries[tBinaryUUID];
+    
+    if (tBundlePath==nil)
+    {
+        // Removed behind our back
+        
+        if (tEntry!=nil)
+        {
+            _totalSize-=tEntry.size;
+            
+            [_entries removeObjectForKey:tBinaryUUID];
+        }
+    }
+    else
+    {
+        if (tEntry==nil)
+        {
+            tEntry=[CUISymbolsFilesCacheEntry new];
+            
+            tEntry.size=[CUISymbolsFilesCache _sizeOfItemAtPath:tFolderPath];
+            
+            _entries[tBinaryUUID]=tEntry;
+            
+            _totalSize+=tEntry.size;
+        }
+        
+        // The modification date of the folder is the last access date used for the eviction
+        
+        tEntry.lastAccessDate=[NSDate date];
+        
+        [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate:tEntry.lastAccessDate} ofItemAtPath:tFolderPath error:NULL];
+        
+        [_pinnedBinaryUUIDs addObject:tBinaryUUID];
+    }
+    
+    [_lock unlock];
+    
+    return tBundlePath;
+}
+
+- (NSString *)createStagingDirectory:(NSError **)outError
+{
+    NSString * tPath=[_stagingFolderPath stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    
+    [_lock lock];
+    
+    [self _loadEntriesIfNeeded];
+    
+    [_lock unlock];
+    
+    if ([[NSFileManager defaultManager] createDirectoryAtPath:tPath withIntermediateDirectories:YES attributes:nil error:outError]==NO)
+        return nil;
+    
+    return tPath;
+}
+
+- (NSString *)storedSYMBundleOfStagingDirectory:(NSString *)inStagingDirectoryPath binaryUUID:(NSString *)inBinaryUUID error:(NSError **)outError
+{
+    if (inStagingDirectoryPath==nil || inBinaryUUID==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    NSString * tBundleName=nil;
+    
+    for(NSString * tComponent in [tFileManager contentsOfDirectoryAtPath:inStagingDirectoryPath error:NULL])
+    {
+        if ([tComponent.pathExtension isEqualToString:@"dSYM"]==YES)
+        {
+            tBundleName=tComponent;
+            break;
+        }
+    }
+    
+    if (tBundleName==nil)
+    {
+        [tFileManager removeItemAtPath:inStagingDirectoryPath error:NULL];
+        
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:ENOENT userInfo:@{}];
+        
+        return nil;
+    }
+    
+    NSString * tBinaryUUID=inBinaryUUID.uppercaseString;
+    
+    NSString * tFolderPath=[_entriesFolderPath stringByAppendingPathComponent:tBinaryUUID];
+    
+    unsigned long long tSize=[CUISymbolsFilesCache _sizeOfItemAtPath:inStagingDirectoryPath];
+    
+    [_lock lock];
+    
+    [self _loadEntriesIfNeeded];
+    
+    // The rename is atomic so another process sharing the cache never sees a partial entry
+    
+    if ([tFileManager moveItemAtPath:inStagingDirectoryPath toPath:tFolderPath error:outError]==NO)
+    {
+        [tFileManager removeItemAtPath:inStagingDirectoryPath error:NULL];
+        
+        // Another process may have stored it in the meantime
+        
+        if ([tFileManager fileExistsAtPath:[tFolderPath stringByAppendingPathComponent:tBundleName]]==NO)
+        {
+            [_lock unlock];
+            
+            return nil;
+        }
+        
+        if (outError!=NULL)
+            *outError=nil;
+        
+        tSize=[CUISymbolsFilesCache _sizeOfItemAtPath:tFolderPath];
+    }
+    
+    CUISymbolsFilesCacheEntry * tEntry=[CUISymbolsFilesCacheEntry new];
+    
+    tEntry.size=tSize;
+    tEntry.lastAccessDate=[NSDate date];
+    
+    _totalSize-=_entries[tBinaryUUID].size;
+    
+    _entries[tBinaryUUID]=tEntry;
+    
+    _totalSize+=tSize;
+    
+    [_pinnedBinaryUUIDs addObject:tBinaryUUID];
+    
+    [self _evictEntriesIfNeeded];
+    
+    [_lock unlock];
+    
+    return [tFolderPath stringByAppendingPathComponent:tBundleName];
+}
+
+- (void)removedSYMBundleForBinaryUUID:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return;
+    
+    NSString * tBinaryUUID=inBinaryUUID.uppercaseString;
+    
+    [_lock lock];
+    
+    [self _loadEntriesIfNeeded];
+    
+    [[NSFileManager defaultManager] removeItemAtPath:[_entriesFolderPath stringByAppendingPathComponent:tBinaryUUID] error:NULL];
+    
+    _totalSize-=_entries[tBinaryUUID].size;
+    
+    [_entries removeObjectForKey:tBinaryUUID];
+    
+    [_pinnedBinaryUUIDs removeObject:tBinaryUUID];
+    
+    [_lock unlock];
+}
+
+#pragma mark -
+
+- (void)_loadMissingBinaryUUIDsIfNeeded
+{
+    if (_missingBinaryUUIDsDates!=nil)
+        return;
+    
+    _missingBinaryUUIDsDates=[NSMutableDictionary dictionary];
+    
+    NSDictionary * tDictionary=[NSDictionary dictionaryWithContentsOfFile:[self.directoryPath stringByAppendingPathComponent:CUISymbolsFilesCacheMissingBinaryUUIDsFileName]];
+    
+    [tDictionary enumerateKeysAndObjectsUsingBlock:^(NSString * bBinaryUUID, NSDate * bDate, BOOL * bOutStop) {
+        
+        if ([bBinaryUUID isKindOfClass:NSString.class]==NO || [bDate isKindOfClass:NSDate.class]==NO)
+            return;
+        
+        self->_missingBinaryUUIDsDates[bBinaryUUID]=bDate;
+    }];
+}
+
+- (BOOL)isBinaryUUIDMissing:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return NO;
+    
+    NSString * tBinaryUUID=inBinaryUUID.uppercaseString;
+    
+    BOOL tMissing=NO;
+    
+    [_lock lock];
+    
+    [self _loadMissingBinaryUUIDsIfNeeded];
+    
+    NSDate * tDate=_missingBinaryUUIDsDates[tBinaryUUID];
+    
+    if (tDate!=nil)
+    {
+        if (-tDate.timeIntervalSinceNow<self.missingBinaryUUIDsTimeToLive)
+            tMissing=YES;
+        else
+            [_missingBinaryUUIDsDates removeObjectForKey:tBinaryUUID];
+    }
+    
+    [_lock unlock];
+    
+    return tMissing;
+}
+
+- (void)setBinaryUUIDMissing:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return;
+    
+    [_lock lock];
+    
+    [self _loadMissingBinaryUUIDsIfNeeded];
+    
+    _missingBinaryUUIDsDates[inBinaryUUID.uppercaseString]=[NSDate date];
+    
+    // Drop the expired records before saving
+    
+    NSTimeInterval tTimeToLive=self.missingBinaryUUIDsTimeToLive;
+    
+    NSSet * tExpiredBinaryUUIDs=[_missingBinaryUUIDsDates keysOfEntriesPassingTest:^BOOL(NSString * bBinaryUUID, NSDate * bDate, BOOL * bOutStop) {
+        
+        return (-bDate.timeIntervalSinceNow>=tTimeToLive);
+    }];
+    
+    [_missingBinaryUUIDsDates removeObjectsForKeys:tExpiredBinaryUUIDs.allObjects];
+    
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.directoryPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    [_missingBinaryUUIDsDates writeToFile:[self.directoryPath stringByAppendingPathComponent:CUISymbolsFilesCacheMissingBinaryUUIDsFileName] atomically:YES];
+    
+    [_lock unlock];
+}
+
+@end
@@ -54,12 +54,16 @@
     
     
     CGFloat _optimizedBinaryImageTextFieldWidth;
+    
+    NSMutableSet<CUIStackFrame *> * _symbolicatedStackFrames;
 }
 
     @property (nonatomic) NSArray * threads;
 
 - (void)delayedReloadSymbols;
 
+- (void)delayedReloadSymbolicatedStackFrames;
+
 @end
 
 @implementation CUIThreadsColumnViewController
@@ -450,6 +454,8 @@
                     
                     [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
                                                                                                                    binaryUUID:tBinaryImage.UUID
+                                                                                                                     priority:CUISymbolicationPriorityVisibleFrames
+                                                                                                            cancellationToken:self.symbolicationCancellationToken
                                                                                                             completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                                 
                                                                                                                 switch(bLookUpResult)
@@ -464,7 +470,8 @@
                                                                                                                         tCall.symbolicationData=bSymbolicationData;
                                                                                                                         
                                                                                                                         [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                          object:self.crashLog];
+                                                                                                                                                                          object:self.crashLog
+                                                                                                                                                                        userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tCall}];
                                                                                                                         
                                                                                                                         break;
                                                                                                                     }
@@ -701,6 +708,8 @@
                 
                 [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
                                                                                                                binaryUUID:tBinaryImage.UUID
+                                                                                                                 priority:CUISymbolicationPriorityVisibleFrames
+                                                                                                        cancellationToken:self.symbolicationCancellationToken
                                                                                                         completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                             
                                                                                                             switch(bLookUpResult)
@@ -715,7 +724,8 @@
                                                                                                                     tCall.symbolicationData=bSymbolicationData;
                                                                                                                     
                                                                                                                     [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                      object:self.crashLog];
+                                                                                                                                                                      object:self.crashLog
+                                                                                                                                                                    userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tCall}];
                                                                                                                     
                                                                                                                     break;
                                                                                                                 }
@@ -821,19 +831,58 @@
     [_backtraceTableView reloadDataForRowIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, _backtraceTableView.numberOfRows)] columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 4)]];
 }
 
+- (void)delayedReloadSymbolicatedStackFrames
+{
+    NSArray<CUIStackFrame *> * tStackFrames=_selectedThread.callStackBacktrace.stackFrames;
+    
+    NSMutableIndexSet * tRowIndexes=[NSMutableIndexSet indexSet];
+    
+    for(CUIStackFrame * tStackFrame in _symbolicatedStackFrames)
+    {
+        NSUInteger tRow=[tStackFrames indexOfObjectIdenticalTo:tStackFrame];
+        
+        if (tRow!=NSNotFound)
+            [tRowIndexes addIndex:tRow];
+    }
+    
+    [_symbolicatedStackFrames removeAllObjects];
+    
+    if (tRowIndexes.count==0)
+        return;
+    
+    [_backtraceTableView reloadDataForRowIndexes:tRowIndexes columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 4)]];
+}
+
 #pragma mark -
 
 - (void)dSYMBundlesManagerDidAddBundles:(NSNotification *)inNotification
 {
-    // Ideally we should just request to symbolicate the machineInstructionAddresses which can be
+    // Only reload the rows of the stack frames located in the new binaries (this will trigger their symbolication)
     
-    //NSArray * tBinaryUUIDs=inNotification.object;
+    NSArray * tBinaryUUIDs=inNotification.object;
     
-    // A COMPLETER
+    NSArray<CUIStackFrame *> * tStackFrames=_selectedThread.callStackBacktrace.stackFrames;
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbols) object:nil];
+    if (tStackFrames.count==0)
+        return;
     
-    [self performSelector:@selector(delayedReloadSymbols) withObject:nil afterDelay:0.1];
+    NSMutableIndexSet * tRowIndexes=[NSMutableIndexSet indexSet];
+    
+    for(NSString * tBinaryUUID in tBinaryUUIDs)
+    {
+        for(CUIStackFrame * tStackFrame in [self.crashLog stackFramesForBinaryUUID:tBinaryUUID])
+        {
+            NSUInteger tRow=[tStackFrames indexOfObjectIdenticalTo:tStackFrame];
+            
+            if (tRow!=NSNotFound)
+                [tRowIndexes addIndex:tRow];
+        }
+    }
+    
+    if (tRowIndexes.count==0)
+        return;
+    
+    [_backtraceTableView reloadDataForRowIndexes:tRowIndexes columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 4)]];
 }
 
 - (void)stackFrameSymbolicationDidSucceed:(NSNotification *)inNotification
@@ -841,9 +890,21 @@
     if (inNotification.object!=self.crashLog)
         return;
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbols) object:nil];
+    CUIStackFrame * tStackFrame=inNotification.userInfo[CUIStackFrameSymbolicationStackFrameKey];
     
-    [self performSelector:@selector(delayedReloadSymbols) withObject:nil afterDelay:0.1];
+    if (tStackFrame==nil)
+        return;
+    
+    // Only reload the rows of the symbolicated stack frames (coalesced)
+    
+    if (_symbolicatedStackFrames==nil)
+        _symbolicatedStackFrames=[NSMutableSet set];
+    
+    [_symbolicatedStackFrames addObject:tStackFrame];
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbolicatedStackFrames) object:nil];
+    
+    [self performSelector:@selector(delayedReloadSymbolicatedStackFrames) withObject:nil afterDelay:0.1];
 }
 
 - (void)symbolicateAutomaticallyDidChange:(NSNotification *)inNotification
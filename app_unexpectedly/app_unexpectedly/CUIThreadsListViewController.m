@@ -80,10 +80,14 @@
     BOOL _showCrashedThreadState;
     
     CGFloat _optimizedBinaryImageTextFieldWidth;
+    
+    NSMutableSet<CUIStackFrame *> * _symbolicatedStackFrames;
 }
 
 - (void)delayedReloadSymbols;
 
+- (void)delayedReloadSymbolicatedStackFrames;
+
 @end
 
 @implementation CUIThreadsListViewController
@@ -397,6 +401,26 @@
     [_outlineView reloadDataForRowIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, _outlineView.numberOfRows)] columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
 }
 
+- (void)delayedReloadSymbolicatedStackFrames
+{
+    NSMutableIndexSet * tRowIndexes=[NSMutableIndexSet indexSet];
+    
+    for(CUIStackFrame * tStackFrame in _symbolicatedStackFrames)
+    {
+        NSInteger tRow=[_outlineView rowForItem:tStackFrame];
+        
+        if (tRow!=-1)
+            [tRowIndexes addIndex:tRow];
+    }
+    
+    [_symbolicatedStackFrames removeAllObjects];
+    
+    if (tRowIndexes.count==0)
+        return;
+    
+    [_outlineView reloadDataForRowIndexes:tRowIndexes columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
+}
+
 #pragma mark - NSOutlineViewDataSource
 
 - (NSInteger)outlineView:(NSOutlineView *)inOutlineView numberOfChildrenOfItem:(id)inItem
@@ -587,6 +611,8 @@
                     
                     [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
                                                                                                                    binaryUUID:tBinaryImage.UUID
+                                                                                                                     priority:CUISymbolicationPriorityVisibleFrames
+                                                                                                            cancellationToken:self.symbolicationCancellationToken
                                                                                                             completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                                 
                                                                                                                 switch(bLookUpResult)
@@ -607,7 +633,8 @@
                                                                                                                         tCall.symbolicationData=bSymbolicationData;
                                                                                                                         
                                                                                                                         [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                          object:self.crashLog];
+                                                                                                                                                                          object:self.crashLog
+                                                                                                                                                                        userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tCall}];
                                                                                                                         
                                                                                                                         break;
                                                                                                                         
@@ -888,6 +915,8 @@
                 
                     [[CUISymbolicationManager sharedSymbolicationManager] lookUpSymbolicationDataForMachineInstructionAddress:tAddress
                                                                                                                    binaryUUID:tBinaryImage.UUID
+                                                                                                                     priority:CUISymbolicationPriorityVisibleFrames
+                                                                                                            cancellationToken:self.symbolicationCancellationToken
                                                                                                             completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData *bSymbolicationData) {
                                                                                                                 
                                                                                                                 switch(bLookUpResult)
@@ -902,7 +931,8 @@
                                                                                                                         tCall.symbolicationData=bSymbolicationData;
                                                                                                                         
                                                                                                                         [NSNotificationCenter.defaultCenter postNotificationName:CUIStackFrameSymbolicationDidSucceedNotification
-                                                                                                                                                                            object:self.crashLog];
+                                                                                                                                                                            object:self.crashLog
+                                                                                                                                                                          userInfo:@{CUIStackFrameSymbolicationStackFrameKey:tCall}];
                                                                                                                         
                                                                                                                         break;
                                                                                                                     }
@@ -1073,15 +1103,27 @@
 
 - (void)dSYMBundlesManagerDidAddBundles:(NSNotification *)inNotification
 {
-    // Ideally we should just request to symbolicate the machineInstructionAddresses which can be
+    // Only reload the rows of the stack frames located in the new binaries (this will trigger their symbolication)
     
-    //NSArray * tBinaryUUIDs=inNotification.object;
+    NSArray * tBinaryUUIDs=inNotification.object;
     
-    // A COMPLETER
+    NSMutableIndexSet * tRowIndexes=[NSMutableIndexSet indexSet];
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbols) object:nil];
+    for(NSString * tBinaryUUID in tBinaryUUIDs)
+    {
+        for(CUIStackFrame * tStackFrame in [self.crashLog stackFramesForBinaryUUID:tBinaryUUID])
+        {
+            NSInteger tRow=[_outlineView rowForItem:tStackFrame];
+            
+            if (tRow!=-1)
+                [tRowIndexes addIndex:tRow];
+        }
+    }
     
-    [self performSelector:@selector(delayedReloadSymbols) withObject:nil afterDelay:0.1];
+    if (tRowIndexes.count==0)
+        return;
+    
+    [_outlineView reloadDataForRowIndexes:tRowIndexes columnIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
 }
 
 - (void)stackFrameSymbolicationDidSucceed:(NSNotification *)inNotification
@@ -1089,9 +1131,21 @@
     if (inNotification.object!=self.crashLog)
         return;
     
-    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbols) object:nil];
+    CUIStackFrame * tStackFrame=inNotification.userInfo[CUIStackFrameSymbolicationStackFrameKey];
     
-    [self performSelector:@selector(delayedReloadSymbols) withObject:nil afterDelay:0.1];
+    if (tStackFrame==nil)
+        return;
+    
+    // Only reload the rows of the symbolicated stack frames (coalesced)
+    
+    if (_symbolicatedStackFrames==nil)
+        _symbolicatedStackFrames=[NSMutableSet set];
+    
+    [_symbolicatedStackFrames addObject:tStackFrame];
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(delayedReloadSymbolicatedStackFrames) object:nil];
+    
+    [self performSelector:@selector(delayedReloadSymbolicatedStackFrames) withObject:nil afterDelay:0.1];
 }
 
 - (void)symbolicateAutomaticallyDidChange:(NSNotification *)inNotification
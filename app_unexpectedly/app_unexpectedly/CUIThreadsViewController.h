@@ -30,6 +30,10 @@
     IBOutlet NSMenuItem * _showWithMenuItem;
 }
 
+    // Set before the crash log (see CUISymbolicationManager)
+
+    @property (nonatomic) id symbolicationCancellationToken;
+
     @property (nonatomic) CUICrashLog * crashLog;
 
     @property (nonatomic) BOOL showOnlyCrashedThread;
@@ -0,0 +1,47 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUIUTF8Scanner.h"
+
+const uint8_t * CUIUTF8BytesOfString(NSString * inString,uint8_t * inBuffer,NSUInteger inBufferSize,NSUInteger * outLength)
+{
+    const char * tCString=CFStringGetCStringPtr((__bridge CFStringRef)inString,kCFStringEncodingUTF8);
+    
+    if (tCString==NULL)
+    {
+        NSUInteger tUsedLength=0;
+        NSRange tRemainingRange=NSMakeRange(0,0);
+        
+        if ([inString getBytes:inBuffer maxLength:inBufferSize usedLength:&tUsedLength encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0,inString.length) remainingRange:&tRemainingRange]==YES &&
+            tRemainingRange.length==0)
+        {
+            *outLength=tUsedLength;
+            
+            return inBuffer;
+        }
+        
+        tCString=inString.UTF8String;
+        
+        if (tCString==NULL)
+            tCString="";
+    }
+    
+    *outLength=strlen(tCString);
+    
+    return (const uint8_t *)tCString;
+}
+
+NSString * CUIUTF8String(const uint8_t * inBytes,NSRange inRange)
+{
+    return [[NSString alloc] initWithBytes:inBytes+inRange.location length:inRange.length encoding:NSUTF8StringEncoding];
+}
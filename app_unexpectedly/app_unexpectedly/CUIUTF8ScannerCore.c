@@ -0,0 +1,330 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CUIUTF8ScannerCore.h"
+
+#include <string.h>
+
+#define CUIUTF8IsContinuationByte(b)   (((b)&0xC0)==0x80)
+
+#define CUIUTF8IsDigit(b)   ((b)>='0' && (b)<='9')
+
+NS_INLINE int CUIUTF8HexDigitValue(uint8_t inByte)
+{
+    if (inByte>='0' && inByte<='9')
+        return inByte-'0';
+    
+    if (inByte>='a' && inByte<='f')
+        return inByte-'a'+10;
+    
+    if (inByte>='A' && inByte<='F')
+        return inByte-'A'+10;
+    
+    return -1;
+}
+
+NS_INLINE uint8_t CUIUTF8LowercaseByte(uint8_t inByte)
+{
+    return (inByte>='A' && inByte<='Z') ? (inByte|0x20) : inByte;
+}
+
+BOOL CUIUTF8BytesAreASCII(const uint8_t * inBytes,NSUInteger inLength)
+{
+    NSUInteger tIndex=0;
+    
+    for(;(tIndex+8)<=inLength;tIndex+=8)
+    {
+        uint64_t tWord;
+        
+        memcpy(&tWord,inBytes+tIndex,sizeof(uint64_t));
+        
+        if ((tWord & 0x8080808080808080ULL)!=0)
+            return NO;
+    }
+    
+    for(;tIndex<inLength;tIndex++)
+    {
+        if (inBytes[tIndex]>=0x80)
+            return NO;
+    }
+    
+    return YES;
+}
+
+NSUInteger CUIUTF8UTF16Length(const uint8_t * inBytes,NSUInteger inLength)
+{
+    NSUInteger tLength=0;
+    
+    for(NSUInteger tIndex=0;tIndex<inLength;tIndex++)
+    {
+        uint8_t tByte=inBytes[tIndex];
+        
+        if (CUIUTF8IsContinuationByte(tByte)==0)
+            tLength+=(tByte>=0xF0) ? 2 : 1;     // Surrogate pair
+    }
+    
+    return tLength;
+}
+
+NSUInteger CUIUTF8WhitespaceLength(const uint8_t * inBytes,NSUInteger inLength)
+{
+    if (inLength==0)
+        return 0;
+    
+    uint8_t tByte=inBytes[0];
+    
+    if (tByte==' ' || tByte=='\t')
+        return 1;
+    
+    if (tByte<0xC2)
+        return 0;
+    
+    if (tByte==0xC2)
+        return (inLength>=2 && inBytes[1]==0xA0) ? 2 : 0;                       // U+00A0
+    
+    if (inLength<3)
+        return 0;
+    
+    switch(tByte)
+    {
+        case 0xE1:
+            
+            return (inBytes[1]==0x9A && inBytes[2]==0x80) ? 3 : 0;              // U+1680
+            
+        case 0xE2:
+            
+            if (inBytes[1]==0x80)
+                return (inBytes[2]<=0x8A || inBytes[2]==0xAF) ? 3 : 0;          // U+2000-U+200A, U+202F
+            
+            return (inBytes[1]==0x81 && inBytes[2]==0x9F) ? 3 : 0;              // U+205F
+            
+        case 0xE3:
+            
+            return (inBytes[1]==0x80 && inBytes[2]==0x80) ? 3 : 0;              // U+3000
+    }
+    
+    return 0;
+}
+
+NSUInteger CUIUTF8LocationOfLastCharacter(const uint8_t * inBytes,NSRange inRange)
+{
+    NSUInteger tLocation=NSMaxRange(inRange)-1;
+    
+    while (tLocation>inRange.location && CUIUTF8IsContinuationByte(inBytes[tLocation])!=0)
+        tLocation--;
+    
+    return tLocation;
+}
+
+NSRange CUIUTF8TrimmedRange(const uint8_t * inBytes,NSRange inRange)
+{
+    NSUInteger tStart=inRange.location;
+    NSUInteger tEnd=NSMaxRange(inRange);
+    NSUInteger tWhitespaceLength;
+    
+    while ((tWhitespaceLength=CUIUTF8WhitespaceLength(inBytes+tStart,tEnd-tStart))>0)
+        tStart+=tWhitespaceLength;
+    
+    while (tEnd>tStart)
+    {
+        NSUInteger tLocation=CUIUTF8LocationOfLastCharacter(inBytes,NSMakeRange(tStart,tEnd-tStart));
+        
+        if (CUIUTF8WhitespaceLength(inBytes+tLocation,tEnd-tLocation)!=(tEnd-tLocation))
+            break;
+        
+        tEnd=tLocation;
+    }
+    
+    return NSMakeRange(tStart,tEnd-tStart);
+}
+
+NSUInteger CUIUTF8LocationOfLastWhitespace(const uint8_t * inBytes,NSRange inRange)
+{
+    NSUInteger tEnd=NSMaxRange(inRange);
+    
+    while (tEnd>inRange.location)
+    {
+        NSUInteger tLocation=CUIUTF8LocationOfLastCharacter(inBytes,NSMakeRange(inRange.location,tEnd-inRange.location));
+        
+        if (CUIUTF8WhitespaceLength(inBytes+tLocation,tEnd-tLocation)>0)
+            return tLocation;
+        
+        tEnd=tLocation;
+    }
+    
+    return NSNotFound;
+}
+
+NSUInteger CUIUTF8LocationOfString(const uint8_t * inBytes,NSRange inRange,const char * inString)
+{
+    NSUInteger tStringLength=strlen(inString);
+    
+    if (tStringLength==0 || tStringLength>inRange.length)
+        return NSNotFound;
+    
+    uint8_t tFirstByte=CUIUTF8LowercaseByte((uint8_t)inString[0]);
+    NSUInteger tLastLocation=NSMaxRange(inRange)-tStringLength;
+    
+    for(NSUInteger tLocation=inRange.location;tLocation<=tLastLocation;tLocation++)
+    {
+        if (CUIUTF8LowercaseByte(inBytes[tLocation])!=tFirstByte)
+            continue;
+        
+        NSUInteger tIndex=1;
+        
+        while (tIndex<tStringLength && CUIUTF8LowercaseByte(inBytes[tLocation+tIndex])==CUIUTF8LowercaseByte((uint8_t)inString[tIndex]))
+            tIndex++;
+        
+        if (tIndex==tStringLength)
+            return tLocation;
+    }
+    
+    return NSNotFound;
+}
+
+NSInteger CUIUTF8IntegerValue(const uint8_t * inBytes,NSRange inRange)
+{
+    CUIUTF8Scanner tScanner=CUIUTF8ScannerMake(inBytes+inRange.location,inRange.length);
+    NSInteger tValue=0;
+    
+    if (CUIUTF8ScannerScanInteger(&tScanner,&tValue)==NO)
+        return 0;
+    
+    return tValue;
+}
+
+#pragma mark -
+
+void CUIUTF8ScannerSkipWhitespaces(CUIUTF8Scanner * ioScanner)
+{
+    NSUInteger tWhitespaceLength;
+    
+    while ((tWhitespaceLength=CUIUTF8WhitespaceLength(ioScanner->bytes+ioScanner->location,ioScanner->length-ioScanner->location))>0)
+        ioScanner->location+=tWhitespaceLength;
+}
+
+void CUIUTF8ScannerSkipCharacter(CUIUTF8Scanner * ioScanner,uint8_t inCharacter)
+{
+    while (ioScanner->location<ioScanner->length && ioScanner->bytes[ioScanner->location]==inCharacter)
+        ioScanner->location++;
+}
+
+BOOL CUIUTF8ScannerScanInteger(CUIUTF8Scanner * ioScanner,NSInteger * outValue)
+{
+    CUIUTF8Scanner tScanner=*ioScanner;
+    
+    CUIUTF8ScannerSkipWhitespaces(&tScanner);
+    
+    BOOL tNegative=NO;
+    
+    if (tScanner.location<tScanner.length && (tScanner.bytes[tScanner.location]=='+' || tScanner.bytes[tScanner.location]=='-'))
+    {
+        tNegative=(tScanner.bytes[tScanner.location]=='-');
+        
+        tScanner.location++;
+        
+        // As NSScanner, whitespaces are allowed after the sign ("+ 42")
+        
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
+    }
+    
+    if (tScanner.location>=tScanner.length || CUIUTF8IsDigit(tScanner.bytes[tScanner.location])==0)
+        return NO;
+    
+    // The value is clamped when it overflows
+    
+    unsigned long long tLimit=(tNegative==YES) ? ((unsigned long long)NSIntegerMax)+1 : (unsigned long long)NSIntegerMax;
+    unsigned long long tMagnitude=0;
+    
+    do
+    {
+        unsigned int tDigit=tScanner.bytes[tScanner.location]-'0';
+        
+        if (tMagnitude>(tLimit-tDigit)/10)
+            tMagnitude=tLimit;
+        else
+            tMagnitude=tMagnitude*10+tDigit;
+        
+        tScanner.location++;
+    }
+    while (tScanner.location<tScanner.length && CUIUTF8IsDigit(tScanner.bytes[tScanner.location])!=0);
+    
+    if (outValue!=NULL)
+    {
+        if (tNegative==NO)
+            *outValue=(NSInteger)tMagnitude;
+        else
+            *outValue=(tMagnitude==tLimit) ? NSIntegerMin : -(NSInteger)tMagnitude;
+    }
+    
+    ioScanner->location=tScanner.location;
+    
+    return YES;
+}
+
+BOOL CUIUTF8ScannerScanHexLongLong(CUIUTF8Scanner * ioScanner,unsigned long long * outValue)
+{
+    CUIUTF8Scanner tScanner=*ioScanner;
+    
+    CUIUTF8ScannerSkipWhitespaces(&tScanner);
+    
+    const uint8_t * tBytes=tScanner.bytes;
+    
+    if ((tScanner.location+2)<tScanner.length && tBytes[tScanner.location]=='0' && (tBytes[tScanner.location+1]|0x20)=='x' && CUIUTF8HexDigitValue(tBytes[tScanner.location+2])>=0)
+        tScanner.location+=2;
+    
+    if (tScanner.location>=tScanner.length || CUIUTF8HexDigitValue(tBytes[tScanner.location])<0)
+        return NO;
+    
+    // The value is clamped when it overflows
+    
+    unsigned long long tValue=0;
+    int tDigit;
+    
+    while (tScanner.location<tScanner.length && (tDigit=CUIUTF8HexDigitValue(tBytes[tScanner.location]))>=0)
+    {
+        tValue=(tValue>(ULLONG_MAX>>4)) ? ULLONG_MAX : ((tValue<<4)|(unsigned long long)tDigit);
+        
+        tScanner.location++;
+    }
+    
+    if (outValue!=NULL)
+        *outValue=tValue;
+    
+    ioScanner->location=tScanner.location;
+    
+    return YES;
+}
+
+BOOL CUIUTF8ScannerScanUpToString(CUIUTF8Scanner * ioScanner,const char * inString,NSRange * outRange)
+{
+    NSUInteger tLocation=ioScanner->location;
+    
+    if (tLocation>=ioScanner->length)
+        return NO;
+    
+    NSUInteger tStringLocation=CUIUTF8LocationOfString(ioScanner->bytes,NSMakeRange(tLocation,ioScanner->length-tLocation),inString);
+    
+    if (tStringLocation==tLocation)
+        return NO;
+    
+    if (tStringLocation==NSNotFound)
+        tStringLocation=ioScanner->length;
+    
+    if (outRange!=NULL)
+        *outRange=NSMakeRange(tLocation,tStringLocation-tLocation);
+    
+    ioScanner->location=tStringLocation;
+    
+    return YES;
+}
@@ -0,0 +1,91 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CUIUTF8ScannerCore_h
+#define CUIUTF8ScannerCore_h
+
+#include "CUIPortableTypes.h"
+
+// Scanning of the UTF-8 bytes of a line without creating intermediate objects.
+// The functions behave like the NSScanner methods of the same name (whitespaces are the ones of +[NSCharacterSet whitespaceCharacterSet],
+// the strings are searched case insensitively) except that the characters to be skipped are skipped explicitly.
+// The bytes must be valid UTF-8.
+
+typedef struct
+{
+    const uint8_t * bytes;
+    
+    NSUInteger length;
+    
+    NSUInteger location;
+    
+} CUIUTF8Scanner;
+
+NS_INLINE CUIUTF8Scanner CUIUTF8ScannerMake(const uint8_t * inBytes,NSUInteger inLength)
+{
+    CUIUTF8Scanner tScanner={inBytes,inLength,0};
+    
+    return tScanner;
+}
+
+NS_INLINE NSUInteger CUIUTF8CharacterLength(uint8_t inLeadingByte)
+{
+    if (inLeadingByte<0xC0)
+        return 1;
+    
+    if (inLeadingByte<0xE0)
+        return 2;
+    
+    return (inLeadingByte<0xF0) ? 3 : 4;
+}
+
+BOOL CUIUTF8BytesAreASCII(const uint8_t * inBytes,NSUInteger inLength);
+
+NSUInteger CUIUTF8UTF16Length(const uint8_t * inBytes,NSUInteger inLength);
+
+// Length of the whitespace character at the beginning of the bytes (0 if there is none)
+
+NSUInteger CUIUTF8WhitespaceLength(const uint8_t * inBytes,NSUInteger inLength);
+
+// Location of the first byte of the last character of the range (the range must not be empty)
+
+NSUInteger CUIUTF8LocationOfLastCharacter(const uint8_t * inBytes,NSRange inRange);
+
+NSRange CUIUTF8TrimmedRange(const uint8_t * inBytes,NSRange inRange);
+
+// Location of the last whitespace character of the range (NSNotFound if there is none)
+
+NSUInteger CUIUTF8LocationOfLastWhitespace(const uint8_t * inBytes,NSRange inRange);
+
+// Location of the first occurrence of the string in the range (NSNotFound if there is none)
+
+NSUInteger CUIUTF8LocationOfString(const uint8_t * inBytes,NSRange inRange,const char * inString);
+
+NSInteger CUIUTF8IntegerValue(const uint8_t * inBytes,NSRange inRange);     // -[NSString integerValue]
+
+
+void CUIUTF8ScannerSkipWhitespaces(CUIUTF8Scanner * ioScanner);
+
+void CUIUTF8ScannerSkipCharacter(CUIUTF8Scanner * ioScanner,uint8_t inCharacter);
+
+// The whitespaces are skipped. The location is not changed when NO is returned
+
+BOOL CUIUTF8ScannerScanInteger(CUIUTF8Scanner * ioScanner,NSInteger * outValue);
+
+BOOL CUIUTF8ScannerScanHexLongLong(CUIUTF8Scanner * ioScanner,unsigned long long * outValue);
+
+// NO is returned when the location is at the end or at the string. When the string is not found, the scan goes up to the end
+
+BOOL CUIUTF8ScannerScanUpToString(CUIUTF8Scanner * ioScanner,const char * inString,NSRange * outRange);
+
+#endif
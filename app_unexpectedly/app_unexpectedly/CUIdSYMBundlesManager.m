@@ -13,19 +13,58 @@
 
 #import "CUIdSYMBundlesManager.h"
 
+#import "CUISymbolicationNegativeCache.h"
+
+#import "CUISymbolicationMetrics.h"
+
+#include <sys/stat.h>
+
 NSString * const CUIdSYMBundlesManagerDidAddBundlesNotification=@"CUIdSYMBundlesManagerDidAddBundlesNotification";
 
 NSString * const CUIdSYMBundlesManagerDidRemoveBundlesNotification=@"CUIdSYMBundlesManagerDidRemoveBundlesNotification";
 
 NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
 
+NSString * const CUIdSYMBundlesManagerIndexKey=@"dSYMLibrary.index";
+
+NSString * const CUIdSYMBundlesIndexEntryPathKey=@"path";
+
+NSString * const CUIdSYMBundlesIndexEntrySymbolsFilePathKey=@"symbolsFilePath";
+
+NSString * const CUIdSYMBundlesIndexEntryBinaryUUIDsKey=@"UUIDs";
+
+NSString * const CUIdSYMBundlesIndexEntryModificationTimeKey=@"modificationTime";
+
+NSString * const CUIdSYMBundlesIndexEntrySizeKey=@"size";
+
 @interface CUIdSYMBundlesManager ()
 {
     NSMutableSet * _bundlesSet;
     
     NSMutableDictionary * _bundlesRegistry;
+    
+    // The keys are the normalized paths of the bundles
+    
+    NSMutableDictionary<NSString *,CUIdSYMBundle *> * _bundlesPathsRegistry;
+    
+    NSMutableDictionary<NSString *,NSArray *> * _binaryUUIDsRegistry;
+    
+    NSMutableDictionary<NSString *,NSDictionary *> * _indexEntriesRegistry;
+    
+    NSMutableArray<NSString *> * _pendingBundlesPaths;
+    
+    // Bundles of the library that could not be parsed at launch (e.g. on a volume that is not mounted).
+    // They are kept in the library and parsed again at the next launch.
+    
+    NSArray<NSString *> * _unavailableBundlesPaths;
 }
 
++ (NSString *)_normalizedPathOfBundle:(CUIdSYMBundle *)inBundle;
+
++ (NSDictionary *)_indexEntryForBundle:(CUIdSYMBundle *)inBundle;
+
++ (CUIdSYMBundle *)_bundleWithIndexEntry:(NSDictionary *)inEntry;
+
 - (BOOL)_addBundles:(NSArray *)inBundles andNotify:(BOOL)inNotify;
 
 - (void)_synchronizeDefaults;
@@ -58,18 +97,97 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
         
         _bundlesSet=[NSMutableSet set];
         
+        _bundlesPathsRegistry=[NSMutableDictionary dictionary];
+        
+        _binaryUUIDsRegistry=[NSMutableDictionary dictionary];
+        
+        _indexEntriesRegistry=[NSMutableDictionary dictionary];
+        
         NSUserDefaults * tDefaults=[NSUserDefaults standardUserDefaults];
         
         NSArray * tArray=[tDefaults arrayForKey:CUIdSYMBundlesManagerContentsKey];
         
         if (tArray.count>0)
         {
-            NSArray * tBundles=[tArray WB_arrayByMappingObjectsLenientlyUsingBlock:^CUIdSYMBundle *(NSString * bBundlePath, NSUInteger bIndex) {
+            // The bundles whose symbols file has not changed are registered from the index without being parsed
+            
+            NSMutableDictionary * tIndexEntries=[NSMutableDictionary dictionary];
+            
+            for(NSDictionary * tEntry in [tDefaults arrayForKey:CUIdSYMBundlesManagerIndexKey])
+            {
+                if ([tEntry isKindOfClass:NSDictionary.class]==NO)
+                    continue;
+                
+                NSString * tPath=tEntry[CUIdSYMBundlesIndexEntryPathKey];
+                
+                if ([tPath isKindOfClass:NSString.class]==YES)
+                    tIndexEntries[tPath]=tEntry;
+            }
+            
+            NSMutableArray * tBundles=[NSMutableArray array];
+            
+            _pendingBundlesPaths=[NSMutableArray array];
+            
+            for(NSString * tPath in tArray)
+            {
+                if ([tPath isKindOfClass:NSString.class]==NO)
+                    continue;
                 
-                return [[CUIdSYMBundle alloc] initWithPath:bBundlePath];
-            }];
+                NSDictionary * tEntry=tIndexEntries[tPath];
+                
+                CUIdSYMBundle * tBundle=[CUIdSYMBundlesManager _bundleWithIndexEntry:tEntry];
+                
+                if (tBundle==nil)
+                {
+                    [_pendingBundlesPaths addObject:tPath];
+                    
+                    continue;
+                }
+                
+                _indexEntriesRegistry[tPath]=tEntry;
+                
+                [tBundles addObject:tBundle];
+            }
             
             [self _addBundles:tBundles andNotify:NO];
+            
+            // The new or modified bundles are parsed on a background queue
+            
+            if (_pendingBundlesPaths.count>0)
+            {
+                NSArray * tPendingBundlesPaths=[_pendingBundlesPaths copy];
+                
+                dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY,0), ^{
+                    
+                    NSMutableArray * tParsedBundles=[NSMutableArray array];
+                    
+                    NSMutableArray * tUnavailableBundlesPaths=[NSMutableArray array];
+                    
+                    for(NSString * tBundlePath in tPendingBundlesPaths)
+                    {
+                        CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:tBundlePath];
+                        
+                        if (tBundle.binaryUUIDs.count>0)
+                            [tParsedBundles addObject:tBundle];
+                        else
+                            [tUnavailableBundlesPaths addObject:tBundlePath];
+                    }
+                    
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        
+                        self->_pendingBundlesPaths=nil;
+                        
+                        self->_unavailableBundlesPaths=[tUnavailableBundlesPaths copy];
+                        
+                        if ([self _addBundles:tParsedBundles andNotify:YES]==NO)
+                            [self _synchronizeDefaults];
+                    });
+                });
+            }
+            else
+            {
+                _pendingBundlesPaths=nil;
+            }
         }
     }
     
@@ -78,6 +196,67 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
 
 #pragma mark -
 
++ (NSString *)_normalizedPathOfBundle:(CUIdSYMBundle *)inBundle
+{
+    // Same semantics as a case insensitive comparison of the paths
+    
+    return inBundle.bundlePath.stringByStandardizingPath.lowercaseString;
+}
+
++ (NSDictionary *)_indexEntryForBundle:(CUIdSYMBundle *)inBundle
+{
+    NSString * tSymbolsFilePath=inBundle.symbolsFilePath;
+    
+    if (tSymbolsFilePath==nil)
+        return nil;
+    
+    CUISymbolsFileSignature tSignature=inBundle.symbolsFileSignature;
+    
+    return @{
+             CUIdSYMBundlesIndexEntryPathKey:inBundle.bundlePath,
+             CUIdSYMBundlesIndexEntrySymbolsFilePathKey:tSymbolsFilePath,
+             CUIdSYMBundlesIndexEntryBinaryUUIDsKey:inBundle.binaryUUIDs,
+             CUIdSYMBundlesIndexEntryModificationTimeKey:@(tSignature.modificationTime),
+             CUIdSYMBundlesIndexEntrySizeKey:@(tSignature.size)
+             };
+}
+
++ (CUIdSYMBundle *)_bundleWithIndexEntry:(NSDictionary *)inEntry
+{
+    if (inEntry==nil)
+        return nil;
+    
+    NSString * tSymbolsFilePath=inEntry[CUIdSYMBundlesIndexEntrySymbolsFilePathKey];
+    NSArray * tBinaryUUIDs=inEntry[CUIdSYMBundlesIndexEntryBinaryUUIDsKey];
+    NSNumber * tModificationTimeNumber=inEntry[CUIdSYMBundlesIndexEntryModificationTimeKey];
+    NSNumber * tSizeNumber=inEntry[CUIdSYMBundlesIndexEntrySizeKey];
+    
+    if ([tSymbolsFilePath isKindOfClass:NSString.class]==NO ||
+        [tBinaryUUIDs isKindOfClass:NSArray.class]==NO ||
+        [tModificationTimeNumber isKindOfClass:NSNumber.class]==NO ||
+        [tSizeNumber isKindOfClass:NSNumber.class]==NO)
+        return nil;
+    
+    // A stat is enough to know whether the symbols file is still the one that was indexed
+    
+    struct stat tStat;
+    
+    if (stat(tSymbolsFilePath.fileSystemRepresentation,&tStat)!=0)
+        return nil;
+    
+    CUISymbolsFileSignature tSignature;
+    
+    tSignature.modificationTime=(uint64_t)tStat.st_mtimespec.tv_sec*NSEC_PER_SEC+(uint64_t)tStat.st_mtimespec.tv_nsec;
+    tSignature.size=(uint64_t)tStat.st_size;
+    
+    if (tSignature.modificationTime!=tModificationTimeNumber.unsignedLongLongValue || tSignature.size!=tSizeNumber.unsignedLongLongValue)
+        return nil;
+    
+    return [[CUIdSYMBundle alloc] initWithPath:inEntry[CUIdSYMBundlesIndexEntryPathKey] binaryUUIDs:tBinaryUUIDs symbolsFileSignature:tSignature];
+}
+
+#pragma mark -
+
 - (NSSet *)bundlesSet
 {
     return _bundlesSet;
@@ -91,12 +270,34 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
     
     NSMutableArray * tMutableArray=[NSMutableArray array];
     
+    NSMutableArray * tIndexEntries=[NSMutableArray array];
+    
     [_bundlesSet enumerateObjectsUsingBlock:^(CUIdSYMBundle * bBundle, BOOL * bOutStop) {
         
-        [tMutableArray addObject:bBundle.bundlePath];
+        NSString * tPath=bBundle.bundlePath;
+        
+        [tMutableArray addObject:tPath];
+        
+        NSDictionary * tEntry=self->_indexEntriesRegistry[tPath];
+        
+        if (tEntry!=nil)
+            [tIndexEntries addObject:tEntry];
     }];
     
+    // Do not forget the bundles that are still being parsed or that were not available
+    
+    if (_pendingBundlesPaths!=nil)
+        [tMutableArray addObjectsFromArray:_pendingBundlesPaths];
+    
+    for(NSString * tPath in _unavailableBundlesPaths)
+    {
+        if ([tMutableArray containsObject:tPath]==NO)
+            [tMutableArray addObject:tPath];
+    }
+    
     [tDefaults setValue:tMutableArray forKey:CUIdSYMBundlesManagerContentsKey];
+    
+    [tDefaults setValue:tIndexEntries forKey:CUIdSYMBundlesManagerIndexKey];
 }
 
 #pragma mark -
@@ -106,13 +307,12 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
     if (inBundle==nil)
         return NO;
     
-    for(CUIdSYMBundle * tBundle in _bundlesSet)
-    {
-        if ([tBundle.bundlePath caseInsensitiveCompare:inBundle.bundlePath]==NSOrderedSame)
-            return YES;
-    }
+    NSString * tNormalizedPath=[CUIdSYMBundlesManager _normalizedPathOfBundle:inBundle];
     
-    return NO;
+    if (tNormalizedPath==nil)
+        return NO;
+    
+    return (_bundlesPathsRegistry[tNormalizedPath]!=nil);
 }
 
 - (BOOL)addBundle:(CUIdSYMBundle *)inBundle
@@ -137,13 +337,18 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
     
     for(CUIdSYMBundle * tBundle in inBundles)
     {
+        NSString * tNormalizedPath=[CUIdSYMBundlesManager _normalizedPathOfBundle:tBundle];
+        
+        if (tNormalizedPath==nil || _bundlesPathsRegistry[tNormalizedPath]!=nil)
+            continue;
+        
+        // The UUIDs are only read once. They are recorded for the removal.
+        
         NSArray * tBinaryUUIDs=[tBundle binaryUUIDs];
         
         if (tBinaryUUIDs.count==0)
             return NO;
         
-        
-        
         NSMutableArray * tAddedBinaryUUIds=[NSMutableArray array];
         
         for(NSString * tBinaryUUID in tBinaryUUIDs)
@@ -161,9 +366,25 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
             [tAllBinaryUUIDs addObjectsFromArray:tAddedBinaryUUIds];
             
             [_bundlesSet addObject:tBundle];
+            
+            _bundlesPathsRegistry[tNormalizedPath]=tBundle;
+            
+            _binaryUUIDsRegistry[tNormalizedPath]=[tBinaryUUIDs copy];
+            
+            NSString * tPath=tBundle.bundlePath;
+            
+            if (_indexEntriesRegistry[tPath]==nil)
+            {
+                NSDictionary * tEntry=[CUIdSYMBundlesManager _indexEntryForBundle:tBundle];
+                
+                if (tEntry!=nil)
+                    _indexEntriesRegistry[tPath]=tEntry;
+            }
         }
     }
     
+    [[CUISymbolicationNegativeCache sharedCache] removeUnavailableBinaryUUIDs:tAllBinaryUUIDs];
+    
     // Post Notification?
         
     if (inNotify==YES)
@@ -189,16 +410,59 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
     
     NSMutableArray * tAllBinaryUUIDs=[NSMutableArray array];
     
+    NSMutableArray * tRemovedPaths=[NSMutableArray array];
+    
     for(CUIdSYMBundle * tBundle in inBundles)
     {
-        NSArray * tBinaryUUIDs=tBundle.binaryUUIDs;
+        NSString * tNormalizedPath=[CUIdSYMBundlesManager _normalizedPathOfBundle:tBundle];
+        
+        if (tNormalizedPath==nil)
+            continue;
+        
+        CUIdSYMBundle * tRegisteredBundle=_bundlesPathsRegistry[tNormalizedPath];
+        
+        if (tRegisteredBundle==nil)
+            continue;
+        
+        for(NSString * tBinaryUUID in _binaryUUIDsRegistry[tNormalizedPath])
+        {
+            // Another bundle may provide the same UUID
+            
+            if (_bundlesRegistry[tBinaryUUID]!=tRegisteredBundle)
+                continue;
+            
+            [_bundlesRegistry removeObjectForKey:tBinaryUUID];
+            
+            [tAllBinaryUUIDs addObject:tBinaryUUID];
+        }
         
-        [tAllBinaryUUIDs addObjectsFromArray:tBinaryUUIDs];
+        [_bundlesSet removeObject:tRegisteredBundle];
+        
+        // The symbols files of the bundle must not be accounted anymore
+        
+        [tRegisteredBundle unloadSymbolsFiles];
+        
+        [tRemovedPaths addObject:tRegisteredBundle.bundlePath];
+        
+        [_indexEntriesRegistry removeObjectForKey:tRegisteredBundle.bundlePath];
+        
+        [_bundlesPathsRegistry removeObjectForKey:tNormalizedPath];
+        
+        [_binaryUUIDsRegistry removeObjectForKey:tNormalizedPath];
     }
     
-    [_bundlesRegistry removeObjectsForKeys:tAllBinaryUUIDs];
+    // A removed bundle must not come back from the unavailable ones
+    
+    if (_unavailableBundlesPaths.count>0)
+    {
+        NSMutableArray * tUnavailableBundlesPaths=[_unavailableBundlesPaths mutableCopy];
+        
+        [tUnavailableBundlesPaths removeObjectsInArray:tRemovedPaths];
+        
+        _unavailableBundlesPaths=[tUnavailableBundlesPaths copy];
+    }
     
-    [_bundlesSet minusSet:[NSSet setWithArray:inBundles]];
+    [[CUISymbolicationNegativeCache sharedCache] removeUnresolvableAddressesForBinaryUUIDs:tAllBinaryUUIDs];
     
     // Post Notification
     
@@ -214,7 +478,13 @@ NSString * const CUIdSYMBundlesManagerContentsKey=@"dSYMLibrary.contents";
     if (inBinaryUUID==nil)
         return nil;
     
-    return _bundlesRegistry[inBinaryUUID];
+    CUISymbolicationInterval tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageBundleLookUp);
+    
+    CUIdSYMBundle * tBundle=_bundlesRegistry[inBinaryUUID];
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageBundleLookUp,tInterval);
+    
+    return tBundle;
 }
 
 @end
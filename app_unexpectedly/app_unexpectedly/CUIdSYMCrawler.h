@@ -0,0 +1,33 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// Walks folders in parallel looking for dSYM bundles and bare Mach-O dSYM files (e.g. a DWARF file copied out of its bundle).
+// Only the UUID load commands of the files are read. A folder is only listed again when its modification date has changed
+// since the previous crawl: the results of the other folders are taken from a cache stored at inCacheFilePath.
+
+@interface CUIdSYMCrawler : NSObject
+
+    @property (readonly,copy) NSArray<NSString *> * rootPaths;
+
++ (NSString *)defaultCacheFilePath;
+
+- (instancetype)initWithRootPaths:(NSArray<NSString *> *)inRootPaths cacheFilePath:(NSString *)inCacheFilePath;
+
+// Synchronous. Must not be called concurrently.
+// Returns the path of the dSYM bundle or of the bare dSYM file for each binary UUID found.
+
+- (NSDictionary<NSString *,NSString *> *)crawl;
+
+@end
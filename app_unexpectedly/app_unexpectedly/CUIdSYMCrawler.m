@@ -0,0 +1,443 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "CUIdSYMCrawler.h"
+
+#include <mach-o/loader.h>
+#include <mach-o/fat.h>
+
+#include <libkern/OSByteOrder.h>
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CUIdSYMCrawlerMaximumNumberOfArchitectures      64
+
+#define CUIdSYMCrawlerMaximumLoadCommandsSize           (16*1024*1024)
+
+NSString * const CUIdSYMCrawlerCacheModificationTimeKey=@"modificationTime";
+
+NSString * const CUIdSYMCrawlerCacheSubdirectoriesKey=@"subdirectories";
+
+NSString * const CUIdSYMCrawlerCacheSymbolsFilesKey=@"symbolsFiles";
+
+#pragma mark - Mach-O headers
+
+static void CUIdSYMCrawlerAddUUIDsOfObjectFile(int inFileDescriptor, off_t inOffset, NSMutableArray * inUUIDs)
+{
+    struct mach_header tHeader;
+    
+    if (pread(inFileDescriptor, &tHeader, sizeof(struct mach_header), inOffset)!=sizeof(struct mach_header))
+        return;
+    
+    off_t tLoadCommandsOffset=inOffset;
+    
+    switch(tHeader.magic)
+    {
+        case MH_MAGIC:
+            
+            tLoadCommandsOffset+=sizeof(struct mach_header);
+            break;
+            
+        case MH_MAGIC_64:
+            
+            tLoadCommandsOffset+=sizeof(struct mach_header_64);
+            break;
+            
+        default:
+            
+            // Byte swapped object files are not supported by MCHObjectFile either
+            
+            return;
+    }
+    
+    if (tHeader.filetype!=MH_DSYM || tHeader.sizeofcmds==0 || tHeader.sizeofcmds>CUIdSYMCrawlerMaximumLoadCommandsSize)
+        return;
+    
+    uint8_t * tBuffer=malloc(tHeader.sizeofcmds);
+    
+    if (tBuffer==NULL)
+        return;
+    
+    if (pread(inFileDescriptor, tBuffer, tHeader.sizeofcmds, tLoadCommandsOffset)==(ssize_t)tHeader.sizeofcmds)
+    {
+        uint32_t tOffset=0;
+        
+        for(uint32_t tIndex=0;tIndex<tHeader.ncmds;tIndex++)
+        {
+            if (tOffset+sizeof(struct load_command)>tHeader.sizeofcmds)
+                break;
+            
+            struct load_command * tLoadCommand=(struct load_command *)(tBuffer+tOffset);
+            
+            if (tLoadCommand->cmdsize<sizeof(struct load_command) || tOffset+tLoadCommand->cmdsize>tHeader.sizeofcmds)
+                break;
+            
+            if (tLoadCommand->cmd==LC_UUID && tLoadCommand->cmdsize>=sizeof(struct uuid_command))
+            {
+                struct uuid_command * tUUIDCommand=(struct uuid_command *)tLoadCommand;
+                
+                NSUUID * tUUID=[[NSUUID alloc] initWithUUIDBytes:tUUIDCommand->uuid];
+                
+                [inUUIDs addObject:tUUID.UUIDString];
+                
+                break;
+            }
+            
+            tOffset+=tLoadCommand->cmdsize;
+        }
+    }
+    
+    free(tBuffer);
+}
+
+static NSArray<NSString *> * CUIdSYMCrawlerUUIDsOfSymbolsFile(const char * inPath)
+{
+    int tFileDescriptor=open(inPath, O_RDONLY);
+    
+    if (tFileDescriptor==-1)
+        return nil;
+    
+    NSMutableArray * tUUIDs=[NSMutableArray array];
+    
+    uint32_t tMagic=0;
+    
+    if (pread(tFileDescriptor, &tMagic, sizeof(uint32_t), 0)==sizeof(uint32_t))
+    {
+        // The fat header is always big endian
+        
+        uint32_t tFatMagic=OSSwapBigToHostInt32(tMagic);
+        
+        if (tFatMagic==FAT_MAGIC || tFatMagic==FAT_MAGIC_64)
+        {
+            struct fat_header tFatHeader;
+            
+            if (pread(tFileDescriptor, &tFatHeader, sizeof(struct fat_header), 0)==sizeof(struct fat_header))
+            {
+                uint32_t tNumberOfArchitectures=MIN(OSSwapBigToHostInt32(tFatHeader.nfat_arch),CUIdSYMCrawlerMaximumNumberOfArchitectures);
+                
+                off_t tArchitectureOffset=sizeof(struct fat_header);
+                
+                for(uint32_t tIndex=0;tIndex<tNumberOfArchitectures;tIndex++)
+                {
+                    off_t tObjectFileOffset=0;
+                    
+                    if (tFatMagic==FAT_MAGIC)
+                    {
+                        struct fat_arch tArchitecture;
+                        
+                        if (pread(tFileDescriptor, &tArchitecture, sizeof(struct fat_arch), tArchitectureOffset)!=sizeof(struct fat_arch))
+                            break;
+                        
+                        tObjectFileOffset=OSSwapBigToHostInt32(tArchitecture.offset);
+                        
+                        tArchitectureOffset+=sizeof(struct fat_arch);
+                    }
+                    else
+                    {
+                        struct fat_arch_64 tArchitecture;
+                        
+                        if (pread(tFileDescriptor, &tArchitecture, sizeof(struct fat_arch_64), tArchitectureOffset)!=sizeof(struct fat_arch_64))
+                            break;
+                        
+                        tObjectFileOffset=(off_t)OSSwapBigToHostInt64(tArchitecture.offset);
+                        
+                        tArchitectureOffset+=sizeof(struct fat_arch_64);
+                    }
+                    
+                    CUIdSYMCrawlerAddUUIDsOfObjectFile(tFileDescriptor, tObjectFileOffset, tUUIDs);
+                }
+            }
+        }
+        else
+        {
+            CUIdSYMCrawlerAddUUIDsOfObjectFile(tFileDescriptor, 0, tUUIDs);
+        }
+    }
+    
+    close(tFileDescriptor);
+    
+    return tUUIDs;
+}
+
+#pragma mark -
+
+@interface CUIdSYMCrawler ()
+{
+    NSString * _cacheFilePath;
+    
+    // root path -> folder path -> cache entry
+    
+    NSMutableDictionary<NSString *,NSDictionary *> * _cache;
+}
+
++ (NSDictionary *)_entryForDirectoryAtPath:(NSString *)inDirectoryPath modificationTime:(uint64_t)inModificationTime;
+
+- (void)_loadCache;
+
+- (void)_saveCache;
+
+@end
+
+@implementation CUIdSYMCrawler
+
++ (NSString *)defaultCacheFilePath
+{
+    NSString * tCachesPath=NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    
+    if (tCachesPath==nil)
+        tCachesPath=NSTemporaryDirectory();
+    
+    return [tCachesPath stringByAppendingPathComponent:@"fr.whitebox.unexpectedly/dSYMCrawler.plist"];
+}
+
+- (instancetype)initWithRootPaths:(NSArray<NSString *> *)inRootPaths cacheFilePath:(NSString *)inCacheFilePath
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _rootPaths=[[inRootPaths WB_arrayByMappingObjectsUsingBlock:^NSString *(NSString * bPath, NSUInteger bIndex) {
+            
+            return bPath.stringByExpandingTildeInPath.stringByStandardizingPath;
+        }] copy];
+        
+        _cacheFilePath=[inCacheFilePath copy];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (void)_loadCache
+{
+    if (_cache!=nil)
+        return;
+    
+    _cache=[NSMutableDictionary dictionary];
+    
+    if (_cacheFilePath==nil)
+        return;
+    
+    NSData * tData=[NSData dataWithContentsOfFile:_cacheFilePath];
+    
+    if (tData==nil)
+        return;
+    
+    NSDictionary * tDictionary=[NSPropertyListSerialization propertyListWithData:tData options:NSPropertyListImmutable format:NULL error:NULL];
+    
+    if ([tDictionary isKindOfClass:NSDictionary.class]==NO)
+        return;
+    
+    [tDictionary enumerateKeysAndObjectsUsingBlock:^(NSString * bRootPath, NSDictionary * bRootCache, BOOL * bOutStop) {
+        
+        if ([bRootCache isKindOfClass:NSDictionary.class]==YES)
+            self->_cache[bRootPath]=bRootCache;
+    }];
+}
+
+- (void)_saveCache
+{
+    if (_cacheFilePath==nil)
+        return;
+    
+    NSData * tData=[NSPropertyListSerialization dataWithPropertyList:_cache format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+    
+    if (tData==nil)
+        return;
+    
+    [[NSFileManager defaultManager] createDirectoryAtPath:[_cacheFilePath stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    if ([tData writeToFile:_cacheFilePath options:NSDataWritingAtomic error:NULL]==NO)
+        NSLog(@"Unable to write the dSYM crawler cache at path: %@",_cacheFilePath);
+}
+
+#pragma mark -
+
++ (NSDictionary *)_entryForDirectoryAtPath:(NSString *)inDirectoryPath modificationTime:(uint64_t)inModificationTime
+{
+    DIR * tDirectory=opendir(inDirectoryPath.fileSystemRepresentation);
+    
+    if (tDirectory==NULL)
+        return nil;
+    
+    NSMutableArray * tSubdirectories=[NSMutableArray array];
+    
+    NSMutableDictionary * tSymbolsFiles=[NSMutableDictionary dictionary];
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    struct dirent * tDirectoryEntry;
+    
+    while ((tDirectoryEntry=readdir(tDirectory))!=NULL)
+    {
+        // Skip ., .. and the hidden items
+        
+        if (tDirectoryEntry->d_name[0]=='.')
+            continue;
+        
+        NSString * tName=[tFileManager stringWithFileSystemRepresentation:tDirectoryEntry->d_name length:strlen(tDirectoryEntry->d_name)];
+        
+        NSString * tPath=[inDirectoryPath stringByAppendingPathComponent:tName];
+        
+        uint8_t tType=tDirectoryEntry->d_type;
+        
+        if (tType==DT_UNKNOWN)
+        {
+            struct stat tStat;
+            
+            if (lstat(tPath.fileSystemRepresentation, &tStat)!=0)
+                continue;
+            
+            if (S_ISDIR(tStat.st_mode))
+                tType=DT_DIR;
+            else if (S_ISREG(tStat.st_mode))
+                tType=DT_REG;
+        }
+        
+        // Symbolic links are not followed
+        
+        switch(tType)
+        {
+            case DT_DIR:
+            {
+                if ([tName.pathExtension caseInsensitiveCompare:@"dSYM"]!=NSOrderedSame)
+                {
+                    [tSubdirectories addObject:tName];
+                    
+                    break;
+                }
+                
+                NSString * tDWARFFolderPath=[tPath stringByAppendingPathComponent:@"Contents/Resources/DWARF"];
+                
+                for(NSString * tFileName in [tFileManager contentsOfDirectoryAtPath:tDWARFFolderPath error:NULL])
+                {
+                    NSArray * tUUIDs=CUIdSYMCrawlerUUIDsOfSymbolsFile([tDWARFFolderPath stringByAppendingPathComponent:tFileName].fileSystemRepresentation);
+                    
+                    for(NSString * tUUID in tUUIDs)
+                        tSymbolsFiles[tUUID]=tPath;
+                }
+                
+                break;
+            }
+                
+            case DT_REG:
+            {
+                // Bare dSYM files are named after their binary
+                
+                if (tName.pathExtension.length>0)
+                    break;
+                
+                NSArray * tUUIDs=CUIdSYMCrawlerUUIDsOfSymbolsFile(tPath.fileSystemRepresentation);
+                
+                for(NSString * tUUID in tUUIDs)
+                    tSymbolsFiles[tUUID]=tPath;
+                
+                break;
+            }
+                
+            default:
+                
+                break;
+        }
+    }
+    
+    closedir(tDirectory);
+    
+    return @{
+             CUIdSYMCrawlerCacheModificationTimeKey:@(inModificationTime),
+             CUIdSYMCrawlerCacheSubdirectoriesKey:tSubdirectories,
+             CUIdSYMCrawlerCacheSymbolsFilesKey:tSymbolsFiles
+             };
+}
+
+- (NSDictionary<NSString *,NSString *> *)crawl
+{
+    [self _loadCache];
+    
+    NSMutableDictionary * tSymbolsFiles=[NSMutableDictionary dictionary];
+    
+    NSMutableDictionary * tNewCache=[NSMutableDictionary dictionary];
+    
+    NSLock * tLock=[NSLock new];
+    
+    for(NSString * tRootPath in self.rootPaths)
+    {
+        NSDictionary * tRootCache=_cache[tRootPath];
+        
+        NSMutableDictionary * tNewRootCache=[NSMutableDictionary dictionary];
+        
+        // Breadth-first walk, the folders of a level are visited in parallel
+        
+        NSArray * tLevelPaths=@[tRootPath];
+        
+        while (tLevelPaths.count>0)
+        {
+            NSMutableArray * tNextLevelPaths=[NSMutableArray array];
+            
+            dispatch_apply(tLevelPaths.count, dispatch_get_global_queue(QOS_CLASS_UTILITY,0), ^(size_t bIndex) {
+                
+                NSString * tDirectoryPath=tLevelPaths[bIndex];
+                
+                struct stat tStat;
+                
+                if (lstat(tDirectoryPath.fileSystemRepresentation, &tStat)!=0 || S_ISDIR(tStat.st_mode)==0)
+                    return;
+                
+                uint64_t tModificationTime=(uint64_t)tStat.st_mtimespec.tv_sec*NSEC_PER_SEC+(uint64_t)tStat.st_mtimespec.tv_nsec;
+                
+                NSDictionary * tEntry=tRootCache[tDirectoryPath];
+                
+                if ([tEntry isKindOfClass:NSDictionary.class]==NO || [tEntry[CUIdSYMCrawlerCacheModificationTimeKey] unsignedLongLongValue]!=tModificationTime)
+                    tEntry=[CUIdSYMCrawler _entryForDirectoryAtPath:tDirectoryPath modificationTime:tModificationTime];
+                
+                if (tEntry==nil)
+                    return;
+                
+                NSArray * tSubdirectories=tEntry[CUIdSYMCrawlerCacheSubdirectoriesKey];
+                NSDictionary * tEntrySymbolsFiles=tEntry[CUIdSYMCrawlerCacheSymbolsFilesKey];
+                
+                if ([tSubdirectories isKindOfClass:NSArray.class]==NO || [tEntrySymbolsFiles isKindOfClass:NSDictionary.class]==NO)
+                    return;
+                
+                [tLock lock];
+                
+                tNewRootCache[tDirectoryPath]=tEntry;
+                
+                for(NSString * tSubdirectory in tSubdirectories)
+                    [tNextLevelPaths addObject:[tDirectoryPath stringByAppendingPathComponent:tSubdirectory]];
+                
+                [tSymbolsFiles addEntriesFromDictionary:tEntrySymbolsFiles];
+                
+                [tLock unlock];
+            });
+            
+            tLevelPaths=tNextLevelPaths;
+        }
+        
+        // The folders that do not exist anymore are dropped from the cache
+        
+        tNewCache[tRootPath]=tNewRootCache;
+    }
+    
+    _cache=tNewCache;
+    
+    [self _saveCache];
+    
+    return tSymbolsFiles;
+}
+
+@end
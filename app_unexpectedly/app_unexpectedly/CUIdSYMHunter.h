@@ -13,6 +13,8 @@
 
 #import <Foundation/Foundation.h>
 
+#import "CUIBinaryImage.h"
+
 extern NSString * const CUIdSYMHunterHuntDidFinishNotification;
 
 @interface CUIdSYMHunter : NSObject
@@ -21,6 +23,8 @@ extern NSString * const CUIdSYMHunterHuntDidFinishNotification;
 
 + (CUIdSYMHunter *)sharedHunter;
 
-- (void)huntBundleWithUUIDs:(NSSet *)inBundleUUIDs;
+// Looks for the dSYM bundles with Spotlight first, then in the search folders and finally in the symbol sources set in the preferences
+
+- (void)huntBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages;
 
 @end
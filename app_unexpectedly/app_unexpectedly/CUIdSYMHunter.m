@@ -15,6 +15,12 @@
 
 #import "CUIdSYMBundlesManager.h"
 
+#import "CUIApplicationPreferences.h"
+
+#import "CUISymbolSourcesManager.h"
+
+#import "CUIdSYMCrawler.h"
+
 NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFinishNotification";
 
 @interface  CUIdSYMHunter ()
@@ -26,8 +32,32 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
     NSMutableDictionary * _registry;
     
     NSLock * _lock;
+    
+    CUISymbolSourcesManager * _symbolSourcesManager;
+    
+    NSArray<NSString *> * _symbolSourcesLocations;
+    
+    CUISymbolsFilesCache * _symbolsFilesCache;
+    
+    CUIdSYMCrawler * _crawler;
+    
+    NSArray<NSString *> * _crawlerRootPaths;
+    
+    dispatch_queue_t _crawlerQueue;
 }
 
+- (CUISymbolSourcesManager *)_symbolSourcesManager;
+
+- (CUIdSYMCrawler *)_crawler;
+
+- (NSString *)_dSYMBundlePathForBareSymbolsFileAtPath:(NSString *)inPath binaryUUID:(NSString *)inBinaryUUID;
+
+- (void)_crawlForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages;
+
+- (void)_fetchBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages;
+
+- (void)_huntDidFinishForBinaryUUIDs:(NSSet *)inBinaryUUIDs;
+
 // Notifications
 
 - (void)metadataQueryDidFinishGathering:(NSNotification *)inNotification;
@@ -63,6 +93,12 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
         _registry=[NSMutableDictionary dictionary];
         
         _lock=[NSLock new];
+        
+        // Shared by the symbol sources and the bare dSYM files found by the crawler
+        
+        _symbolsFilesCache=[[CUISymbolsFilesCache alloc] initWithDirectoryPath:[CUISymbolsFilesCache defaultDirectoryPath]];
+        
+        _crawlerQueue=dispatch_queue_create("fr.whitebox.unexpectedly.dsymcrawler", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
     }
     
     return self;
@@ -85,15 +121,121 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
 
 #pragma mark -
 
-- (void)huntBundleWithUUIDs:(NSSet *)inBundleUUIDs
+- (CUISymbolSourcesManager *)_symbolSourcesManager
+{
+    CUIApplicationPreferences * tPreferences=[CUIApplicationPreferences sharedPreferences];
+    
+    NSArray<NSString *> * tLocations=tPreferences.symbolSourcesLocations;
+    
+    if (tLocations.count==0)
+        return nil;
+    
+    if (_symbolSourcesManager==nil || [_symbolSourcesLocations isEqualToArray:tLocations]==NO)
+    {
+        NSArray * tSources=[tLocations WB_arrayByMappingObjectsLenientlyUsingBlock:^CUISymbolSource *(NSString * bLocation, NSUInteger bIndex) {
+            
+            return [CUISymbolSource symbolSourceWithLocation:bLocation];
+        }];
+        
+        // Keep the cache (and its negative results) when only the sources change
+        
+        _symbolSourcesManager=[[CUISymbolSourcesManager alloc] initWithSources:tSources cache:_symbolsFilesCache];
+        
+        _symbolSourcesLocations=[tLocations copy];
+    }
+    
+    _symbolSourcesManager.cache.sizeLimit=((unsigned long long)tPreferences.symbolsCacheSizeLimit)*1024*1024;
+    
+    return _symbolSourcesManager;
+}
+
+- (CUIdSYMCrawler *)_crawler
+{
+    NSArray<NSString *> * tRootPaths=[CUIApplicationPreferences sharedPreferences].symbolsSearchDirectoriesPaths;
+    
+    if (tRootPaths.count==0)
+        return nil;
+    
+    // The cache of the crawler is keyed by root so that the folders of the roots kept in the list are not listed again
+    
+    if (_crawler==nil || [_crawlerRootPaths isEqualToArray:tRootPaths]==NO)
+    {
+        _crawler=[[CUIdSYMCrawler alloc] initWithRootPaths:tRootPaths cacheFilePath:[CUIdSYMCrawler defaultCacheFilePath]];
+        
+        _crawlerRootPaths=[tRootPaths copy];
+    }
+    
+    return _crawler;
+}
+
+- (NSString *)_dSYMBundlePathForBareSymbolsFileAtPath:(NSString *)inPath binaryUUID:(NSString *)inBinaryUUID
+{
+    // CUIdSYMBundle needs a bundle: one referencing the bare file is created in the symbols files cache
+    
+    NSString * tBundlePath=[_symbolsFilesCache dSYMBundlePathForBinaryUUID:inBinaryUUID];
+    
+    if (tBundlePath!=nil)
+        return tBundlePath;
+    
+    NSError * tError=nil;
+    
+    NSString * tStagingDirectoryPath=[_symbolsFilesCache createStagingDirectory:&tError];
+    
+    if (tStagingDirectoryPath==nil)
+    {
+        NSLog(@"Unable to create a staging folder in the symbols files cache: %@",tError);
+        
+        return nil;
+    }
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    NSString * tBinaryName=inPath.lastPathComponent;
+    
+    tBundlePath=[tStagingDirectoryPath stringByAppendingPathComponent:[tBinaryName stringByAppendingPathExtension:@"dSYM"]];
+    
+    NSString * tDWARFFolderPath=[tBundlePath stringByAppendingPathComponent:@"Contents/Resources/DWARF"];
+    
+    if ([tFileManager createDirectoryAtPath:tDWARFFolderPath withIntermediateDirectories:YES attributes:nil error:&tError]==NO ||
+        [tFileManager createSymbolicLinkAtPath:[tDWARFFolderPath stringByAppendingPathComponent:tBinaryName] withDestinationPath:inPath error:&tError]==NO ||
+        [CUISymbolSource writeInfoPropertyListOfdSYMBundleAtPath:tBundlePath binaryName:tBinaryName error:&tError]==NO)
+    {
+        NSLog(@"Unable to create a dSYM bundle for the file at path \"%@\": %@",inPath,tError);
+        
+        [tFileManager removeItemAtPath:tStagingDirectoryPath error:NULL];
+        
+        return nil;
+    }
+    
+    tBundlePath=[_symbolsFilesCache storedSYMBundleOfStagingDirectory:tStagingDirectoryPath binaryUUID:inBinaryUUID error:&tError];
+    
+    if (tBundlePath==nil)
+        NSLog(@"Unable to store the dSYM bundle for the file at path \"%@\": %@",inPath,tError);
+    
+    return tBundlePath;
+}
+
+#pragma mark -
+
+- (void)huntBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages
 {
     // Avoid looking for the same dSYM UUID multiple times at once
     
-    NSMutableSet * tMutableSet=[inBundleUUIDs mutableCopy];
+    NSMutableSet * tMutableSet=[NSMutableSet set];
+    NSMutableArray * tBinaryImages=[NSMutableArray array];
 
     [_lock lock];
     
-    [tMutableSet minusSet:_huntingBundleUUIDs];
+    for(CUIBinaryImage * tBinaryImage in inBinaryImages)
+    {
+        NSString * tUUID=tBinaryImage.UUID;
+        
+        if (tUUID==nil || [_huntingBundleUUIDs containsObject:tUUID]==YES || [tMutableSet containsObject:tUUID]==YES)
+            continue;
+        
+        [tMutableSet addObject:tUUID];
+        [tBinaryImages addObject:tBinaryImage];
+    }
     
     [_lock unlock];
     
@@ -126,11 +268,168 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
     
     [_huntingBundleUUIDs unionSet:tMutableSet];
     
-    _registry[[NSValue valueWithNonretainedObject:tMetadataQuery]]=tMutableSet;
+    _registry[[NSValue valueWithNonretainedObject:tMetadataQuery]]=tBinaryImages;
     
     [_lock unlock];
     
-    [tMetadataQuery startQuery];
+    if ([tMetadataQuery startQuery]==NO)
+    {
+        // Spotlight is not available, the crawler does not need it
+        
+        [NSNotificationCenter.defaultCenter removeObserver:self name:NSMetadataQueryDidFinishGatheringNotification object:tMetadataQuery];
+        
+        [_lock lock];
+        
+        [_registry removeObjectForKey:[NSValue valueWithNonretainedObject:tMetadataQuery]];
+        
+        [_runningQueries removeObject:tMetadataQuery];
+        
+        [_lock unlock];
+        
+        [self _crawlForBinaryImages:tBinaryImages];
+    }
+}
+
+- (void)_crawlForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages
+{
+    CUIdSYMCrawler * tCrawler=[self _crawler];
+    
+    if (tCrawler==nil)
+    {
+        [self _fetchBundlesForBinaryImages:inBinaryImages];
+        
+        return;
+    }
+    
+    dispatch_async(_crawlerQueue, ^{
+        
+        NSDictionary<NSString *,NSString *> * tSymbolsFiles=[tCrawler crawl];
+        
+        NSMutableArray * tBundlesPaths=[NSMutableArray array];
+        
+        for(CUIBinaryImage * tBinaryImage in inBinaryImages)
+        {
+            NSString * tPath=tSymbolsFiles[tBinaryImage.UUID];
+            
+            if (tPath==nil)
+                continue;
+            
+            if ([tPath.pathExtension caseInsensitiveCompare:@"dSYM"]!=NSOrderedSame)
+                tPath=[self _dSYMBundlePathForBareSymbolsFileAtPath:tPath binaryUUID:tBinaryImage.UUID];
+            
+            if (tPath!=nil)
+                [tBundlesPaths addObject:tPath];
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            
+            CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
+            
+            NSMutableArray * tBundles=[NSMutableArray array];
+            
+            for(NSString * tPath in tBundlesPaths)
+            {
+                CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:tPath];
+                
+                if (tBundle.isDSYMBundle==NO)
+                    continue;
+                
+                if ([tBundlesManager containsBundle:tBundle]==YES)
+                    continue;
+                
+                [tBundles addObject:tBundle];
+            }
+            
+            if (tBundles.count>0)
+                [tBundlesManager addBundles:tBundles];
+            
+            // The remaining dSYM bundles may be available from the symbol sources
+            
+            NSMutableArray * tMissingBinaryImages=[NSMutableArray array];
+            NSMutableSet * tFoundBinaryUUIDs=[NSMutableSet set];
+            
+            for(CUIBinaryImage * tBinaryImage in inBinaryImages)
+            {
+                if ([tBundlesManager bundleForBinaryUUID:tBinaryImage.UUID]==nil)
+                    [tMissingBinaryImages addObject:tBinaryImage];
+                else
+                    [tFoundBinaryUUIDs addObject:tBinaryImage.UUID];
+            }
+            
+            if (tMissingBinaryImages.count==0)
+            {
+                [self _huntDidFinishForBinaryUUIDs:tFoundBinaryUUIDs];
+                
+                return;
+            }
+            
+            [self->_lock lock];
+            
+            [self->_huntingBundleUUIDs minusSet:tFoundBinaryUUIDs];
+            
+            [self->_lock unlock];
+            
+            [self _fetchBundlesForBinaryImages:tMissingBinaryImages];
+        });
+    });
+}
+
+- (void)_fetchBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages
+{
+    NSSet * tBinaryUUIDs=[NSSet setWithArray:[inBinaryImages WB_arrayByMappingObjectsUsingBlock:^NSString *(CUIBinaryImage * bImage, NSUInteger bIndex) {
+        
+        return bImage.UUID;
+    }]];
+    
+    CUISymbolSourcesManager * tSymbolSourcesManager=[self _symbolSourcesManager];
+    
+    if (tSymbolSourcesManager==nil)
+    {
+        [self _huntDidFinishForBinaryUUIDs:tBinaryUUIDs];
+        
+        return;
+    }
+    
+    [tSymbolSourcesManager fetchdSYMBundlesForBinaryImages:inBinaryImages completionHandler:^(NSArray<NSString *> * bdSYMBundlesPaths) {
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            
+            CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
+            
+            NSMutableArray * tBundles=[NSMutableArray array];
+            
+            for(NSString * tPath in bdSYMBundlesPaths)
+            {
+                CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:tPath];
+                
+                if (tBundle.isDSYMBundle==NO)
+                    continue;
+                
+                if ([tBundlesManager containsBundle:tBundle]==YES)
+                    continue;
+                
+                [tBundles addObject:tBundle];
+            }
+            
+            if (tBundles.count>0)
+                [tBundlesManager addBundles:tBundles];
+            
+            [self _huntDidFinishForBinaryUUIDs:tBinaryUUIDs];
+        });
+    }];
+}
+
+- (void)_huntDidFinishForBinaryUUIDs:(NSSet *)inBinaryUUIDs
+{
+    [_lock lock];
+    
+    [_huntingBundleUUIDs minusSet:inBinaryUUIDs];
+    
+    [_lock unlock];
+    
+    // Post Notification
+    
+    [NSNotificationCenter.defaultCenter postNotificationName:CUIdSYMHunterHuntDidFinishNotification object:nil];
 }
 
 #pragma mark - Notifications
@@ -145,9 +444,7 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
     
     [_lock lock];
     
-    NSSet * tSet=_registry[tKey];
-    
-    [_huntingBundleUUIDs minusSet:tSet];
+    NSArray * tBinaryImages=_registry[tKey];
     
     [_registry removeObjectForKey:tKey];
     
@@ -157,6 +454,8 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
     
     dispatch_async(dispatch_get_main_queue(), ^{
         
+        CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
+        
         [tMetadataQuery enumerateResultsUsingBlock:^(id bResult, NSUInteger idx, BOOL * _Nonnull stop) {
             
             if ([bResult isKindOfClass:NSMetadataItem.class]==YES)
@@ -169,8 +468,6 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
                 
                 if (tdSYMPath!=nil)
                 {
-                    CUIdSYMBundlesManager * tBundlesManager=[CUIdSYMBundlesManager sharedManager];
-                    
                     CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:tdSYMPath];
                     
                     if (tBundle.isDSYMBundle==NO)
@@ -184,12 +481,34 @@ NSString * const CUIdSYMHunterHuntDidFinishNotification=@"CUIdSYMHunterHuntDidFi
             }
         }];
         
-        // Post Notification
+        // The dSYM bundles Spotlight does not know about may be found by the crawler or available from the symbol sources
+        
+        NSMutableArray * tMissingBinaryImages=[NSMutableArray array];
+        NSMutableSet * tFoundBinaryUUIDs=[NSMutableSet set];
+        
+        for(CUIBinaryImage * tBinaryImage in tBinaryImages)
+        {
+            if ([tBundlesManager bundleForBinaryUUID:tBinaryImage.UUID]==nil)
+                [tMissingBinaryImages addObject:tBinaryImage];
+            else
+                [tFoundBinaryUUIDs addObject:tBinaryImage.UUID];
+        }
+        
+        if (tMissingBinaryImages.count==0)
+        {
+            [self _huntDidFinishForBinaryUUIDs:tFoundBinaryUUIDs];
+            
+            return;
+        }
+        
+        [self->_lock lock];
+        
+        [self->_huntingBundleUUIDs minusSet:tFoundBinaryUUIDs];
+        
+        [self->_lock unlock];
         
-        [NSNotificationCenter.defaultCenter postNotificationName:CUIdSYMHunterHuntDidFinishNotification object:nil];
+        [self _crawlForBinaryImages:tMissingBinaryImages];
     });
 }
 
-
-
 @end
@@ -0,0 +1,175 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DWRFArangesCore.h"
+
+#include <string.h>
+
+static uint64_t DWRFArangesReadValue(const uint8_t * inBytes,uint8_t inSize)
+{
+    switch(inSize)
+    {
+        case 1:
+            
+            return *inBytes;
+            
+        case 2:
+        {
+            uint16_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint16_t));
+            
+            return tValue;
+        }
+            
+        case 4:
+        {
+            uint32_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint32_t));
+            
+            return tValue;
+        }
+            
+        default:
+        {
+            uint64_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint64_t));
+            
+            return tValue;
+        }
+    }
+}
+
+BOOL DWRFArangesSetHeaderRead(const uint8_t * inBytes,NSUInteger inLength,NSUInteger inOffset,DWRFArangesSetHeader * outHeader)
+{
+    if (inBytes==NULL || outHeader==NULL || inOffset>inLength || (inLength-inOffset)<4)
+        return NO;
+    
+    NSUInteger tOffset=inOffset;
+    
+    uint64_t tUnitLength=DWRFArangesReadValue(inBytes+tOffset,4);
+    tOffset+=4;
+    
+    BOOL tIs64BitFormat=(tUnitLength==0xffffffff);
+    
+    if (tIs64BitFormat==YES)
+    {
+        if ((inLength-tOffset)<8)
+            return NO;
+        
+        tUnitLength=DWRFArangesReadValue(inBytes+tOffset,8);
+        tOffset+=8;
+    }
+    
+    if (tUnitLength>(inLength-tOffset))
+        return NO;
+    
+    NSUInteger tEndOffset=tOffset+(NSUInteger)tUnitLength;
+    
+    // version, debug_info_offset, address_size, segment_selector_size
+    
+    uint8_t tOffsetSize=(tIs64BitFormat==YES) ? 8 : 4;
+    
+    if ((tEndOffset-tOffset)<(NSUInteger)(2+tOffsetSize+2))
+        return NO;
+    
+    outHeader->unitLength=tUnitLength;
+    
+    outHeader->version=(uint16_t)DWRFArangesReadValue(inBytes+tOffset,2);
+    tOffset+=2;
+    
+    outHeader->debugInfoOffset=DWRFArangesReadValue(inBytes+tOffset,tOffsetSize);
+    tOffset+=tOffsetSize;
+    
+    outHeader->addressSize=inBytes[tOffset];
+    tOffset++;
+    
+    outHeader->segmentSize=inBytes[tOffset];
+    tOffset++;
+    
+    if ((outHeader->addressSize!=4 && outHeader->addressSize!=8) ||
+        (outHeader->segmentSize!=0 && outHeader->segmentSize!=1 && outHeader->segmentSize!=2 && outHeader->segmentSize!=4 && outHeader->segmentSize!=8))
+        return NO;
+    
+    outHeader->is64BitFormat=tIs64BitFormat;
+    
+    // The first descriptor is aligned on the size of a descriptor from the beginning of the set
+    
+    NSUInteger tDescriptorSize=outHeader->segmentSize+2*outHeader->addressSize;
+    NSUInteger tHeaderSize=tOffset-inOffset;
+    
+    outHeader->descriptorsOffset=inOffset+((tHeaderSize+tDescriptorSize-1)/tDescriptorSize)*tDescriptorSize;
+    outHeader->endOffset=tEndOffset;
+    
+    return YES;
+}
+
+BOOL DWRFArangesSetNextDescriptor(const uint8_t * inBytes,const DWRFArangesSetHeader * inHeader,NSUInteger * ioOffset,uint64_t * outLocation,uint64_t * outLength)
+{
+    NSUInteger tOffset=*ioOffset;
+    NSUInteger tDescriptorSize=inHeader->segmentSize+2*inHeader->addressSize;
+    
+    if (tOffset>inHeader->endOffset || (inHeader->endOffset-tOffset)<tDescriptorSize)
+        return NO;
+    
+    uint64_t tSegmentSelector=0;
+    
+    if (inHeader->segmentSize!=0)
+        tSegmentSelector=DWRFArangesReadValue(inBytes+tOffset,inHeader->segmentSize);
+    
+    tOffset+=inHeader->segmentSize;
+    
+    uint64_t tLocation=DWRFArangesReadValue(inBytes+tOffset,inHeader->addressSize);
+    tOffset+=inHeader->addressSize;
+    
+    uint64_t tLength=DWRFArangesReadValue(inBytes+tOffset,inHeader->addressSize);
+    tOffset+=inHeader->addressSize;
+    
+    *ioOffset=tOffset;
+    
+    if (tSegmentSelector==0 && tLocation==0 && tLength==0)
+        return NO;
+    
+    if (outLocation!=NULL)
+        *outLocation=tLocation;
+    
+    if (outLength!=NULL)
+        *outLength=tLength;
+    
+    return YES;
+}
+
+uint64_t DWRFArangesDebugInfoOffsetForAddress(const uint8_t * inBytes,NSUInteger inLength,uint64_t inAddress)
+{
+    NSUInteger tOffset=0;
+    DWRFArangesSetHeader tHeader;
+    
+    while (DWRFArangesSetHeaderRead(inBytes,inLength,tOffset,&tHeader)==YES)
+    {
+        NSUInteger tDescriptorOffset=tHeader.descriptorsOffset;
+        uint64_t tLocation;
+        uint64_t tLength;
+        
+        while (DWRFArangesSetNextDescriptor(inBytes,&tHeader,&tDescriptorOffset,&tLocation,&tLength)==YES)
+        {
+            if (inAddress>=tLocation && (inAddress-tLocation)<tLength)
+                return tHeader.debugInfoOffset;
+        }
+        
+        tOffset=tHeader.endOffset;
+    }
+    
+    return UINT64_MAX;
+}
@@ -0,0 +1,53 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DWRFArangesCore_h
+#define DWRFArangesCore_h
+
+#include "CUIPortableTypes.h"
+
+// Parsing of the sets of the __debug_aranges section without creating intermediate objects.
+// The values are in the byte order of the host (as in the dSYM files of the supported architectures). The bytes are never read beyond the length.
+
+typedef struct
+{
+    uint64_t unitLength;
+    
+    uint16_t version;
+    
+    uint64_t debugInfoOffset;
+    
+    uint8_t addressSize;
+    uint8_t segmentSize;
+    
+    BOOL is64BitFormat;
+    
+    NSUInteger descriptorsOffset;   // First address range descriptor (after the padding)
+    
+    NSUInteger endOffset;           // Next set
+    
+} DWRFArangesSetHeader;
+
+// NO is returned if the set is truncated or uses an unsupported address or segment selector size
+
+BOOL DWRFArangesSetHeaderRead(const uint8_t * inBytes,NSUInteger inLength,NSUInteger inOffset,DWRFArangesSetHeader * outHeader);
+
+// Reads the address range descriptor at *ioOffset. NO is returned at the terminating entry or at the end of the set
+
+BOOL DWRFArangesSetNextDescriptor(const uint8_t * inBytes,const DWRFArangesSetHeader * inHeader,NSUInteger * ioOffset,uint64_t * outLocation,uint64_t * outLength);
+
+// Offset in the __debug_info section of the compilation unit containing the address (UINT64_MAX if there is none)
+
+uint64_t DWRFArangesDebugInfoOffsetForAddress(const uint8_t * inBytes,NSUInteger inLength,uint64_t inAddress);
+
+#endif
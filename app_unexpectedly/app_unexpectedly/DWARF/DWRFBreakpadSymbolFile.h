@@ -0,0 +1,37 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "CUISymbolicationData.h"
+
+// Breakpad symbol file (as written by DWRFBreakpadSymbolFileWriter or dump_syms) loaded in the same sorted structures as the DWARF data.
+// The look ups are thread-safe.
+
+@interface DWRFBreakpadSymbolFile : NSObject
+
+    @property (nonatomic,readonly,copy) NSString * architectureName;
+
+    @property (nonatomic,readonly,copy) NSString * moduleName;
+
+    @property (nonatomic,readonly,copy) NSString * binaryUUID;     // Same format as -[NSUUID UUIDString]
+
+    @property (nonatomic,readonly) uint64_t textAddress;           // 0 when there is no INFO TEXT_VMADDR record
+
+- (instancetype)initWithContentsOfFile:(NSString *)inPath error:(NSError **)outError;
+
+// inAddress is an address of the __TEXT segment as for -[DWRFFileObject lookUpSymbolicationDataForMachineInstructionAddress:completionHandler:]
+
+- (void)lookUpSymbolicationDataForMachineInstructionAddress:(uint64_t)inAddress completionHandler:(void (^)(BOOL bFound,CUISymbolicationData * bSymbolicationData))handler;
+
+@end
@@ -0,0 +1,523 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "DWRFBreakpadSymbolFile.h"
+
+#import "DWRFFunctionRangesCache.h"
+
+typedef struct
+{
+    uint64_t address;       // Relative to the __TEXT segment
+    
+    uint64_t size;          // 0 for PUBLIC records
+    
+    uint64_t value;         // Line number (line records), origin number (INLINE records) or name index (PUBLIC records)
+    
+    uint64_t fileNumber;    // Line records
+    
+} DWRFBreakpadAddressRecord;
+
+static int DWRFBreakpadCompareAddressRecords(const void * inRecord1,const void * inRecord2)
+{
+    uint64_t tAddress1=((const DWRFBreakpadAddressRecord *)inRecord1)->address;
+    uint64_t tAddress2=((const DWRFBreakpadAddressRecord *)inRecord2)->address;
+    
+    if (tAddress1<tAddress2)
+        return -1;
+    
+    return (tAddress1>tAddress2) ? 1 : 0;
+}
+
+// Last record whose address is lower or equal to inAddress
+
+static const DWRFBreakpadAddressRecord * DWRFBreakpadAddressRecordForAddress(NSData * inRecords,uint64_t inAddress)
+{
+    const DWRFBreakpadAddressRecord * tRecords=(const DWRFBreakpadAddressRecord *)inRecords.bytes;
+    
+    NSUInteger tLowerIndex=0;
+    NSUInteger tUpperIndex=inRecords.length/sizeof(DWRFBreakpadAddressRecord);
+    
+    while (tLowerIndex<tUpperIndex)
+    {
+        NSUInteger tMiddleIndex=tLowerIndex+(tUpperIndex-tLowerIndex)/2;
+        
+        if (tRecords[tMiddleIndex].address<=inAddress)
+            tLowerIndex=tMiddleIndex+1;
+        else
+            tUpperIndex=tMiddleIndex;
+    }
+    
+    return (tLowerIndex==0) ? NULL : &tRecords[tLowerIndex-1];
+}
+
+#pragma mark - Parsing
+
+static BOOL DWRFBreakpadHasPrefix(const char * inPtr,const char * inEnd,const char * inPrefix)
+{
+    size_t tLength=strlen(inPrefix);
+    
+    return ((size_t)(inEnd-inPtr)>=tLength && memcmp(inPtr,inPrefix,tLength)==0);
+}
+
+static const char * DWRFBreakpadSkipSpaces(const char * inPtr,const char * inEnd)
+{
+    while (inPtr<inEnd && *inPtr==' ')
+        inPtr++;
+    
+    return inPtr;
+}
+
+static BOOL DWRFBreakpadReadNumber(const char ** ioPtr,const char * inEnd,unsigned int inBase,uint64_t * outValue)
+{
+    const char * tPtr=DWRFBreakpadSkipSpaces(*ioPtr,inEnd);
+    const char * tStart=tPtr;
+    
+    uint64_t tValue=0;
+    
+    while (tPtr<inEnd)
+    {
+        char tCharacter=*tPtr;
+        unsigned int tDigit;
+        
+        if (tCharacter>='0' && tCharacter<='9')
+            tDigit=tCharacter-'0';
+        else if (inBase==16 && tCharacter>='a' && tCharacter<='f')
+            tDigit=tCharacter-'a'+10;
+        else if (inBase==16 && tCharacter>='A' && tCharacter<='F')
+            tDigit=tCharacter-'A'+10;
+        else
+            break;
+        
+        tValue=tValue*inBase+tDigit;
+        
+        tPtr++;
+    }
+    
+    if (tPtr==tStart || (tPtr<inEnd && *tPtr!=' '))
+        return NO;
+    
+    *ioPtr=tPtr;
+    *outValue=tValue;
+    
+    return YES;
+}
+
+static NSString * DWRFBreakpadReadToken(const char ** ioPtr,const char * inEnd)
+{
+    const char * tPtr=DWRFBreakpadSkipSpaces(*ioPtr,inEnd);
+    const char * tStart=tPtr;
+    
+    while (tPtr<inEnd && *tPtr!=' ')
+        tPtr++;
+    
+    if (tPtr==tStart)
+        return nil;
+    
+    *ioPtr=tPtr;
+    
+    return [[NSString alloc] initWithBytes:tStart length:tPtr-tStart encoding:NSUTF8StringEncoding];
+}
+
+static NSString * DWRFBreakpadReadRemainder(const char * inPtr,const char * inEnd)
+{
+    inPtr=DWRFBreakpadSkipSpaces(inPtr,inEnd);
+    
+    if (inPtr==inEnd)
+        return nil;
+    
+    return [[NSString alloc] initWithBytes:inPtr length:inEnd-inPtr encoding:NSUTF8StringEncoding];
+}
+
+@interface DWRFBreakpadSymbolFile ()
+{
+    DWRFFunctionRangesCache * _functionRanges;
+    
+    NSMutableData * _lineRecords;
+    
+    NSMutableData * _inlineRecords;     // Outermost inlined functions only
+    
+    NSMutableData * _publicRecords;
+    
+    NSMutableDictionary<NSNumber *,NSString *> * _filePathsRegistry;
+    
+    NSMutableDictionary<NSNumber *,NSString *> * _originNamesRegistry;
+    
+    NSMutableArray<NSString *> * _publicNames;
+}
+
+- (BOOL)_parseModuleRecord:(const char *)inPtr end:(const char *)inEnd;
+
+- (void)_parseRecord:(const char *)inPtr end:(const char *)inEnd;
+
+@end
+
+@implementation DWRFBreakpadSymbolFile
+
+- (instancetype)initWithContentsOfFile:(NSString *)inPath error:(NSError **)outError
+{
+    if (inPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return nil;
+    }
+    
+    NSData * tData=[NSData dataWithContentsOfFile:inPath options:NSDataReadingMappedIfSafe error:outError];
+    
+    if (tData==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _functionRanges=[DWRFFunctionRangesCache new];
+        
+        _lineRecords=[NSMutableData data];
+        _inlineRecords=[NSMutableData data];
+        _publicRecords=[NSMutableData data];
+        
+        _filePathsRegistry=[NSMutableDictionary dictionary];
+        _originNamesRegistry=[NSMutableDictionary dictionary];
+        _publicNames=[NSMutableArray array];
+        
+        const char * tPtr=(const char *)tData.bytes;
+        const char * tEnd=tPtr+tData.length;
+        
+        BOOL tIsFirstLine=YES;
+        
+        while (tPtr<tEnd)
+        {
+            const char * tLineEnd=memchr(tPtr,'\n',tEnd-tPtr);
+            
+            if (tLineEnd==NULL)
+                tLineEnd=tEnd;
+            
+            const char * tNextLine=(tLineEnd<tEnd) ? tLineEnd+1 : tEnd;
+            
+            if (tLineEnd>tPtr && tLineEnd[-1]=='\r')
+                tLineEnd--;
+            
+            if (tIsFirstLine==YES)
+            {
+                if ([self _parseModuleRecord:tPtr end:tLineEnd]==NO)
+                {
+                    if (outError!=NULL)
+                        *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EFTYPE userInfo:@{NSFilePathErrorKey:inPath}];
+                    
+                    return nil;
+                }
+                
+                tIsFirstLine=NO;
+            }
+            else
+            {
+                [self _parseRecord:tPtr end:tLineEnd];
+            }
+            
+            tPtr=tNextLine;
+        }
+        
+        if (tIsFirstLine==YES)
+        {
+            if (outError!=NULL)
+                *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EFTYPE userInfo:@{NSFilePathErrorKey:inPath}];
+            
+            return nil;
+        }
+        
+        // The records are usually already sorted
+        
+        qsort(_lineRecords.mutableBytes,_lineRecords.length/sizeof(DWRFBreakpadAddressRecord),sizeof(DWRFBreakpadAddressRecord),DWRFBreakpadCompareAddressRecords);
+        qsort(_inlineRecords.mutableBytes,_inlineRecords.length/sizeof(DWRFBreakpadAddressRecord),sizeof(DWRFBreakpadAddressRecord),DWRFBreakpadCompareAddressRecords);
+        qsort(_publicRecords.mutableBytes,_publicRecords.length/sizeof(DWRFBreakpadAddressRecord),sizeof(DWRFBreakpadAddressRecord),DWRFBreakpadCompareAddressRecords);
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (BOOL)_parseModuleRecord:(const char *)inPtr end:(const char *)inEnd
+{
+    // MODULE <os> <architecture> <identifier> <name>
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"MODULE ")==NO)
+        return NO;
+    
+    inPtr+=strlen("MODULE ");
+    
+    NSString * tOperatingSystem=DWRFBreakpadReadToken(&inPtr,inEnd);
+    
+    _architectureName=[DWRFBreakpadReadToken(&inPtr,inEnd) copy];
+    
+    NSString * tIdentifier=DWRFBreakpadReadToken(&inPtr,inEnd);
+    
+    _moduleName=[DWRFBreakpadReadRemainder(inPtr,inEnd) copy];
+    
+    if (tOperatingSystem==nil || _architectureName==nil || tIdentifier.length<32)
+        return NO;
+    
+    // The identifier is the UUID without dashes followed by the age
+    
+    NSString * tHexadecimalUUID=[tIdentifier substringToIndex:32].uppercaseString;
+    
+    _binaryUUID=[NSString stringWithFormat:@"%@-%@-%@-%@-%@",
+                 [tHexadecimalUUID substringWithRange:NSMakeRange(0,8)],
+                 [tHexadecimalUUID substringWithRange:NSMakeRange(8,4)],
+                 [tHexadecimalUUID substringWithRange:NSMakeRange(12,4)],
+                 [tHexadecimalUUID substringWithRange:NSMakeRange(16,4)],
+                 [tHexadecimalUUID substringWithRange:NSMakeRange(20,12)]];
+    
+    return YES;
+}
+
+- (void)_parseRecord:(const char *)inPtr end:(const char *)inEnd
+{
+    if (inPtr==inEnd)
+        return;
+    
+    uint64_t tNumber;
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"FUNC ")==YES)
+    {
+        // FUNC [m] <address> <size> <parameter_size> <name>
+        
+        inPtr+=strlen("FUNC ");
+        
+        if (DWRFBreakpadHasPrefix(inPtr,inEnd,"m ")==YES)
+            inPtr+=strlen("m ");
+        
+        uint64_t tAddress,tSize,tParameterSize;
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tAddress)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tSize)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tParameterSize)==NO ||
+            tSize==0)
+            return;
+        
+        DWRFFunctionRange * tFunctionRange=[DWRFFunctionRange new];
+        
+        tFunctionRange.lowPC=tAddress;
+        tFunctionRange.highPC=tAddress+tSize;
+        tFunctionRange.machineInstructionAddress=tAddress;
+        tFunctionRange.name=DWRFBreakpadReadRemainder(inPtr,inEnd);
+        
+        if (tFunctionRange.name==nil)
+            tFunctionRange.name=@"<name omitted>";
+        
+        tFunctionRange.stackFrameSymbol=tFunctionRange.name;
+        
+        [_functionRanges addFunctionRange:tFunctionRange];
+        
+        return;
+    }
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"FILE ")==YES)
+    {
+        // FILE <number> <path>
+        
+        inPtr+=strlen("FILE ");
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tNumber)==NO)
+            return;
+        
+        NSString * tFilePath=DWRFBreakpadReadRemainder(inPtr,inEnd);
+        
+        if (tFilePath!=nil)
+            _filePathsRegistry[@(tNumber)]=tFilePath;
+        
+        return;
+    }
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"INLINE_ORIGIN ")==YES)
+    {
+        // INLINE_ORIGIN <number> <name>
+        
+        inPtr+=strlen("INLINE_ORIGIN ");
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tNumber)==NO)
+            return;
+        
+        NSString * tName=DWRFBreakpadReadRemainder(inPtr,inEnd);
+        
+        if (tName!=nil)
+            _originNamesRegistry[@(tNumber)]=tName;
+        
+        return;
+    }
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"INLINE ")==YES)
+    {
+        // INLINE <depth> <call_line> <call_file_number> <origin_number> [<address> <size>]+
+        
+        inPtr+=strlen("INLINE ");
+        
+        uint64_t tDepth,tCallLine,tCallFileNumber,tOriginNumber;
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tDepth)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tCallLine)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tCallFileNumber)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tOriginNumber)==NO)
+            return;
+        
+        // The stack frame symbol is the one of the outermost inlined function (as for the DWARF look ups)
+        
+        if (tDepth!=0)
+            return;
+        
+        DWRFBreakpadAddressRecord tRecord={.value=tOriginNumber};
+        
+        while (DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tRecord.address)==YES &&
+               DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tRecord.size)==YES)
+        {
+            if (tRecord.size>0)
+                [_inlineRecords appendBytes:&tRecord length:sizeof(DWRFBreakpadAddressRecord)];
+        }
+        
+        return;
+    }
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"PUBLIC ")==YES)
+    {
+        // PUBLIC [m] <address> <parameter_size> <name>
+        
+        inPtr+=strlen("PUBLIC ");
+        
+        if (DWRFBreakpadHasPrefix(inPtr,inEnd,"m ")==YES)
+            inPtr+=strlen("m ");
+        
+        DWRFBreakpadAddressRecord tRecord={0};
+        uint64_t tParameterSize;
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tRecord.address)==NO ||
+            DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tParameterSize)==NO)
+            return;
+        
+        NSString * tName=DWRFBreakpadReadRemainder(inPtr,inEnd);
+        
+        if (tName==nil)
+            return;
+        
+        tRecord.value=_publicNames.count;
+        
+        [_publicNames addObject:tName];
+        
+        [_publicRecords appendBytes:&tRecord length:sizeof(DWRFBreakpadAddressRecord)];
+        
+        return;
+    }
+    
+    if (DWRFBreakpadHasPrefix(inPtr,inEnd,"INFO TEXT_VMADDR ")==YES)
+    {
+        inPtr+=strlen("INFO TEXT_VMADDR ");
+        
+        if (DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tNumber)==YES)
+            _textAddress=tNumber;
+        
+        return;
+    }
+    
+    // Line record: <address> <size> <line> <file_number>
+    // (other records such as STACK or INFO start with an uppercase letter which is not a valid address)
+    
+    if (*inPtr>='G' && *inPtr<='Z')
+        return;
+    
+    DWRFBreakpadAddressRecord tRecord;
+    
+    if (DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tRecord.address)==NO ||
+        DWRFBreakpadReadNumber(&inPtr,inEnd,16,&tRecord.size)==NO ||
+        DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tRecord.value)==NO ||
+        DWRFBreakpadReadNumber(&inPtr,inEnd,10,&tRecord.fileNumber)==NO ||
+        tRecord.size==0)
+        return;
+    
+    [_lineRecords appendBytes:&tRecord length:sizeof(DWRFBreakpadAddressRecord)];
+}
+
+#pragma mark -
+
+- (void)lookUpSymbolicationDataForMachineInstructionAddress:(uint64_t)inAddress completionHandler:(void (^)(BOOL bFound,CUISymbolicationData * bSymbolicationData))handler
+{
+    if (handler==nil)
+        return;
+    
+    if (inAddress<_textAddress)
+    {
+        handler(NO,nil);
+        
+        return;
+    }
+    
+    uint64_t tAddress=inAddress-_textAddress;
+    
+    DWRFFunctionRange * tFunctionRange=[_functionRanges functionRangeForAddress:tAddress];
+    
+    if (tFunctionRange==nil)
+    {
+        // Less accurate data
+        
+        const DWRFBreakpadAddressRecord * tPublicRecord=DWRFBreakpadAddressRecordForAddress(_publicRecords,tAddress);
+        
+        if (tPublicRecord==NULL)
+        {
+            handler(NO,nil);
+            
+            return;
+        }
+        
+        CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
+        
+        tSymbolicationData.stackFrameSymbol=_publicNames[tPublicRecord->value];
+        tSymbolicationData.byteOffset=tAddress-tPublicRecord->address;
+        tSymbolicationData.sourceFilePath=@"-";
+        
+        handler(YES,tSymbolicationData);
+        
+        return;
+    }
+    
+    CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
+    
+    tSymbolicationData.stackFrameSymbol=tFunctionRange.stackFrameSymbol;
+    tSymbolicationData.byteOffset=tAddress-tFunctionRange.lowPC;
+    tSymbolicationData.sourceFilePath=@"-";
+    
+    const DWRFBreakpadAddressRecord * tInlineRecord=DWRFBreakpadAddressRecordForAddress(_inlineRecords,tAddress);
+    
+    if (tInlineRecord!=NULL && tAddress<(tInlineRecord->address+tInlineRecord->size))
+    {
+        NSString * tOriginName=_originNamesRegistry[@(tInlineRecord->value)];
+        
+        if (tOriginName!=nil)
+            tSymbolicationData.stackFrameSymbol=tOriginName;
+    }
+    
+    const DWRFBreakpadAddressRecord * tLineRecord=DWRFBreakpadAddressRecordForAddress(_lineRecords,tAddress);
+    
+    if (tLineRecord!=NULL && tAddress<(tLineRecord->address+tLineRecord->size))
+    {
+        NSString * tFilePath=_filePathsRegistry[@(tLineRecord->fileNumber)];
+        
+        if (tFilePath!=nil)
+            tSymbolicationData.sourceFilePath=tFilePath;
+        
+        tSymbolicationData.lineNumber=tLineRecord->value;
+    }
+    
+    handler(YES,tSymbolicationData);
+}
+
+@end
@@ -0,0 +1,474 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "DWRFBreakpadSymbolFileWriter.h"
+
+#import "DWRFFileObject.h"
+
+#import "DWRFFunctionRangesCache.h"
+
+#import "MCHSegmentLoadCommand.h"
+
+#import "MCHUUIDLoadCommand.h"
+
+#include <mach/machine.h>
+#include <unistd.h>
+
+@interface DWRFBreakpadFunctionRecord : NSObject
+
+    @property DWRFFunctionRange * functionRange;
+
+    @property DWRFSubProgramEntry * subProgramEntry;
+
+@end
+
+@implementation DWRFBreakpadFunctionRecord
+@end
+
+@interface DWRFBreakpadSymbolFileWriter ()
+{
+    MCHObjectFile * _objectFile;
+    
+    NSString * _architectureName;
+    
+    uint64_t _textAddress;
+    
+    NSMutableDictionary<NSString *,NSNumber *> * _fileNumbersRegistry;
+    
+    NSMutableArray<NSString *> * _filePaths;
+    
+    NSMutableDictionary<NSString *,NSNumber *> * _originNumbersRegistry;
+    
+    NSMutableArray<NSString *> * _originNames;
+}
+
+    @property (nonatomic,readwrite,copy) NSString * moduleName;
+
+    @property (nonatomic,readwrite,copy) NSString * moduleIdentifier;
+
+- (NSUInteger)_numberOfFilePath:(NSString *)inFilePath;
+
+- (NSUInteger)_numberOfOriginName:(NSString *)inName;
+
+- (void)_writeFunctionsOfCompilationUnit:(DWRFDebuggingInformationCompilationUnit *)inCompilationUnit functionRanges:(DWRFFunctionRangesCache *)inFunctionRanges toFile:(FILE *)inFile;
+
+- (void)_writeInlineRecordsOfEntry:(DWRFDebuggingInformationEntry *)inEntry depth:(NSUInteger)inDepth compilationUnit:(DWRFDebuggingInformationCompilationUnit *)inCompilationUnit toFile:(FILE *)inFile;
+
+@end
+
+static NSString * DWRFBreakpadArchitectureName(cpu_type_t inCPUType,cpu_subtype_t inCPUSubType)
+{
+    cpu_subtype_t tCPUSubType=inCPUSubType & ~CPU_SUBTYPE_MASK;
+    
+    switch(inCPUType)
+    {
+        case CPU_TYPE_X86_64:
+            
+            return (tCPUSubType==CPU_SUBTYPE_X86_64_H) ? @"x86_64h" : @"x86_64";
+            
+        case CPU_TYPE_ARM64:
+            
+#ifdef CPU_SUBTYPE_ARM64E
+            if (tCPUSubType==CPU_SUBTYPE_ARM64E)
+                return @"arm64e";
+#endif
+            return @"arm64";
+            
+        case CPU_TYPE_X86:
+            
+            return @"x86";
+            
+        case CPU_TYPE_ARM:
+            
+            return @"arm";
+            
+        case CPU_TYPE_POWERPC:
+            
+            return @"ppc";
+            
+        default:
+            
+            break;
+    }
+    
+    return @"unknown";
+}
+
+static NSString * DWRFBreakpadAbsolutePath(NSString * inFilePath,NSString * inCompilationDirectory)
+{
+    if (inFilePath.length>0 && [inFilePath characterAtIndex:0]!='/' && inCompilationDirectory.length>0)
+        return [inCompilationDirectory stringByAppendingPathComponent:inFilePath];
+    
+    return inFilePath;
+}
+
+@implementation DWRFBreakpadSymbolFileWriter
+
+- (instancetype)initWithMachObjectFile:(MCHObjectFile *)inObjectFile moduleName:(NSString *)inModuleName
+{
+    if (inObjectFile==nil || inModuleName.length==0)
+        return nil;
+    
+    MCHUUIDLoadCommand * tUUIDLoadCommand=(MCHUUIDLoadCommand *)[inObjectFile loadCommandsOfType:LC_UUID].firstObject;
+    
+    NSString * tUUIDString=tUUIDLoadCommand.uuid.UUIDString;
+    
+    if (tUUIDString==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _objectFile=inObjectFile;
+        
+        _moduleName=[inModuleName copy];
+        
+        _moduleIdentifier=[[tUUIDString stringByReplacingOccurrencesOfString:@"-" withString:@""] stringByAppendingString:@"0"];
+        
+        _architectureName=DWRFBreakpadArchitectureName(inObjectFile.cpuType,inObjectFile.cpuSubType);
+        
+        // The dSYM file keeps the load commands of the __TEXT segment
+        
+        NSMutableArray * tSegmentLoadCommands=[NSMutableArray arrayWithArray:[inObjectFile loadCommandsOfType:LC_SEGMENT_64]];
+        
+        [tSegmentLoadCommands addObjectsFromArray:[inObjectFile loadCommandsOfType:LC_SEGMENT]];
+        
+        for(MCHSegmentLoadCommand * tSegmentLoadCommand in tSegmentLoadCommands)
+        {
+            if ([tSegmentLoadCommand.segment.name isEqualToString:@"__TEXT"]==YES)
+            {
+                _textAddress=tSegmentLoadCommand.vmAddress;
+                
+                break;
+            }
+        }
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)_numberOfFilePath:(NSString *)inFilePath
+{
+    NSNumber * tNumber=_fileNumbersRegistry[inFilePath];
+    
+    if (tNumber!=nil)
+        return tNumber.unsignedIntegerValue;
+    
+    NSUInteger tFileNumber=_filePaths.count;
+    
+    [_filePaths addObject:inFilePath];
+    
+    _fileNumbersRegistry[inFilePath]=@(tFileNumber);
+    
+    return tFileNumber;
+}
+
+- (NSUInteger)_numberOfOriginName:(NSString *)inName
+{
+    NSNumber * tNumber=_originNumbersRegistry[inName];
+    
+    if (tNumber!=nil)
+        return tNumber.unsignedIntegerValue;
+    
+    NSUInteger tOriginNumber=_originNames.count;
+    
+    [_originNames addObject:inName];
+    
+    _originNumbersRegistry[inName]=@(tOriginNumber);
+    
+    return tOriginNumber;
+}
+
+#pragma mark -
+
+- (void)_writeInlineRecordsOfEntry:(DWRFDebuggingInformationEntry *)inEntry depth:(NSUInteger)inDepth compilationUnit:(DWRFDebuggingInformationCompilationUnit *)inCompilationUnit toFile:(FILE *)inFile
+{
+    for(DWRFDebuggingInformationEntry * tChild in inEntry.children)
+    {
+        DW_TAG tTag=tChild.tag;
+        
+        if (tTag==DW_TAG_lexical_block)
+        {
+            [self _writeInlineRecordsOfEntry:tChild depth:inDepth compilationUnit:inCompilationUnit toFile:inFile];
+            
+            continue;
+        }
+        
+        if (tTag!=DW_TAG_inlined_subroutine)
+            continue;
+        
+        // Non contiguous ranges (DW_AT_ranges) are not supported
+        
+        DWRFPCRange tPCRange;
+        
+        if ([tChild getPCRange:&tPCRange]==NO || tPCRange.highPC<=tPCRange.lowPC)
+            continue;
+        
+        NSString * tOriginName=nil;
+        
+        NSNumber * tOriginOffset=[tChild objectForAttribute:DW_AT_abstract_origin];
+        
+        if (tOriginOffset!=nil)
+        {
+            DWRFDebuggingInformationEntry * tOriginEntry=[inCompilationUnit entryAtOffset:tOriginOffset.unsignedLongLongValue];
+            
+            if ([tOriginEntry isKindOfClass:[DWRFSubProgramEntry class]]==YES)
+                tOriginName=[(DWRFSubProgramEntry *)tOriginEntry stackFrameSymbolWithLanguage:inCompilationUnit.language];
+            
+            if (tOriginName.length==0)
+                tOriginName=tOriginEntry.name;
+        }
+        
+        if (tOriginName.length==0)
+            tOriginName=@"<name omitted>";
+        
+        NSUInteger tCallFileIndex=[[tChild objectForAttribute:DW_AT_call_file] unsignedIntegerValue];
+        
+        NSString * tCallFilePath=DWRFBreakpadAbsolutePath([inCompilationUnit.lineNumberProgram filePathAtIndex:tCallFileIndex],inCompilationUnit.compilationDirectory);
+        
+        if (tCallFilePath==nil)
+            tCallFilePath=@"-";
+        
+        fprintf(inFile,"INLINE %lu %llu %lu %lu %llx %llx\n",
+                (unsigned long)inDepth,
+                [[tChild objectForAttribute:DW_AT_call_line] unsignedLongLongValue],
+                (unsigned long)[self _numberOfFilePath:tCallFilePath],
+                (unsigned long)[self _numberOfOriginName:tOriginName],
+                tPCRange.lowPC-_textAddress,
+                tPCRange.highPC-tPCRange.lowPC);
+        
+        [self _writeInlineRecordsOfEntry:tChild depth:inDepth+1 compilationUnit:inCompilationUnit toFile:inFile];
+    }
+}
+
+- (void)_writeFunctionsOfCompilationUnit:(DWRFDebuggingInformationCompilationUnit *)inCompilationUnit functionRanges:(DWRFFunctionRangesCache *)inFunctionRanges toFile:(FILE *)inFile
+{
+    DW_LANG tLanguage=inCompilationUnit.language;
+    
+    NSString * tCompilationDirectory=inCompilationUnit.compilationDirectory;
+    
+    // All the sub programs are enumerated first so that the specifications of the abstract origins are resolved
+    
+    NSMutableArray<DWRFBreakpadFunctionRecord *> * tFunctionRecords=[NSMutableArray array];
+    
+    [inCompilationUnit enumerateSubProgramsUsingBlock:^(DWRFSubProgramEntry * bSubProgramEntry, BOOL * bOutStop) {
+        
+        DWRFPCRange tPCRange;
+        
+        if ([bSubProgramEntry getPCRange:&tPCRange]==NO || tPCRange.highPC<=tPCRange.lowPC)
+            return;
+        
+        DWRFFunctionRange * tFunctionRange=[DWRFFunctionRange new];
+        
+        tFunctionRange.lowPC=tPCRange.lowPC;
+        tFunctionRange.highPC=tPCRange.highPC;
+        
+        DWRFBreakpadFunctionRecord * tFunctionRecord=[DWRFBreakpadFunctionRecord new];
+        
+        tFunctionRecord.functionRange=tFunctionRange;
+        tFunctionRecord.subProgramEntry=bSubProgramEntry;
+        
+        [tFunctionRecords addObject:tFunctionRecord];
+    }];
+    
+    if (tFunctionRecords.count==0)
+        return;
+    
+    [tFunctionRecords sortUsingComparator:^NSComparisonResult(DWRFBreakpadFunctionRecord * bFunctionRecord1, DWRFBreakpadFunctionRecord * bFunctionRecord2) {
+        
+        uint64_t tLowPC1=bFunctionRecord1.functionRange.lowPC;
+        uint64_t tLowPC2=bFunctionRecord2.functionRange.lowPC;
+        
+        if (tLowPC1<tLowPC2)
+            return NSOrderedAscending;
+        
+        return (tLowPC1>tLowPC2) ? NSOrderedDescending : NSOrderedSame;
+    }];
+    
+    // Rows of the line number program sorted by address (the sequences are not necessarily sorted)
+    
+    NSArray<DWRFLineNumberProgramLocation *> * tLocations=[inCompilationUnit.lineNumberProgram.allLocations sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(DWRFLineNumberProgramLocation * bLocation1, DWRFLineNumberProgramLocation * bLocation2) {
+        
+        uint64_t tAddress1=bLocation1.machineInstructionAddress;
+        uint64_t tAddress2=bLocation2.machineInstructionAddress;
+        
+        if (tAddress1<tAddress2)
+            return NSOrderedAscending;
+        
+        return (tAddress1>tAddress2) ? NSOrderedDescending : NSOrderedSame;
+    }];
+    
+    NSUInteger tLocationsCount=tLocations.count;
+    
+    NSUInteger tFirstLocationIndex=0;
+    
+    for(DWRFBreakpadFunctionRecord * tFunctionRecord in tFunctionRecords)
+    {
+        DWRFFunctionRange * tFunctionRange=tFunctionRecord.functionRange;
+        
+        // Skip the duplicated or overlapping functions (e.g. same inline function emitted in several compilation units)
+        
+        if ([inFunctionRanges addFunctionRange:tFunctionRange]==NO)
+            continue;
+        
+        DWRFSubProgramEntry * tSubProgramEntry=tFunctionRecord.subProgramEntry;
+        
+        NSString * tName=[tSubProgramEntry stackFrameSymbolWithLanguage:tLanguage];
+        
+        if (tName.length==0)
+            tName=tSubProgramEntry.name;
+        
+        if (tName.length==0)
+            tName=@"<name omitted>";
+        
+        fprintf(inFile,"FUNC %llx %llx 0 %s\n",tFunctionRange.lowPC-_textAddress,tFunctionRange.highPC-tFunctionRange.lowPC,tName.UTF8String);
+        
+        [self _writeInlineRecordsOfEntry:tSubProgramEntry depth:0 compilationUnit:inCompilationUnit toFile:inFile];
+        
+        // Line records
+        
+        while (tFirstLocationIndex+1<tLocationsCount && tLocations[tFirstLocationIndex+1].machineInstructionAddress<=tFunctionRange.lowPC)
+            tFirstLocationIndex++;
+        
+        for(NSUInteger tLocationIndex=tFirstLocationIndex;tLocationIndex+1<tLocationsCount;tLocationIndex++)
+        {
+            DWRFLineNumberProgramLocation * tLocation=tLocations[tLocationIndex];
+            
+            uint64_t tStartAddress=tLocation.machineInstructionAddress;
+            
+            if (tStartAddress>=tFunctionRange.highPC)
+                break;
+            
+            if (tLocation.isEndOfSequence==YES || tLocation.lineNumber==0 || tLocation.fileName==nil)
+                continue;
+            
+            uint64_t tEndAddress=MIN(tLocations[tLocationIndex+1].machineInstructionAddress,tFunctionRange.highPC);
+            
+            tStartAddress=MAX(tStartAddress,tFunctionRange.lowPC);
+            
+            if (tEndAddress<=tStartAddress)
+                continue;
+            
+            NSUInteger tFileNumber=[self _numberOfFilePath:DWRFBreakpadAbsolutePath(tLocation.fileName,tCompilationDirectory)];
+            
+            fprintf(inFile,"%llx %llx %llu %lu\n",tStartAddress-_textAddress,tEndAddress-tStartAddress,tLocation.lineNumber,(unsigned long)tFileNumber);
+        }
+    }
+}
+
+- (BOOL)writeToFile:(NSString *)inPath error:(NSError **)outError
+{
+    if (inPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    DWRFFileObject * tFileObject=[[DWRFFileObject alloc] initWithMachObjectFile:_objectFile];
+    
+    if (tFileObject==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    _fileNumbersRegistry=[NSMutableDictionary dictionary];
+    _filePaths=[NSMutableArray array];
+    
+    _originNumbersRegistry=[NSMutableDictionary dictionary];
+    _originNames=[NSMutableArray array];
+    
+    // The FILE and INLINE_ORIGIN records are only known once all the functions have been written
+    
+    FILE * tFunctionsFile=tmpfile();
+    
+    if (tFunctionsFile==NULL)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{}];
+        
+        return NO;
+    }
+    
+    DWRFFunctionRangesCache * tFunctionRanges=[DWRFFunctionRangesCache new];
+    
+    [tFileObject enumerateCompilationUnitsUsingBlock:^(DWRFDebuggingInformationCompilationUnit * bCompilationUnit, BOOL * bOutStop) {
+        
+        @autoreleasepool
+        {
+            [self _writeFunctionsOfCompilationUnit:bCompilationUnit functionRanges:tFunctionRanges toFile:tFunctionsFile];
+        }
+    }];
+    
+    FILE * tFile=fopen(inPath.fileSystemRepresentation,"w");
+    
+    if (tFile==NULL)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey:inPath}];
+        
+        fclose(tFunctionsFile);
+        
+        return NO;
+    }
+    
+    fprintf(tFile,"MODULE mac %s %s %s\n",_architectureName.UTF8String,_moduleIdentifier.UTF8String,_moduleName.UTF8String);
+    
+    fprintf(tFile,"INFO TEXT_VMADDR %llx\n",_textAddress);
+    
+    [_filePaths enumerateObjectsUsingBlock:^(NSString * bFilePath, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        fprintf(tFile,"FILE %lu %s\n",(unsigned long)bIndex,bFilePath.UTF8String);
+    }];
+    
+    [_originNames enumerateObjectsUsingBlock:^(NSString * bName, NSUInteger bIndex, BOOL * bOutStop) {
+        
+        fprintf(tFile,"INLINE_ORIGIN %lu %s\n",(unsigned long)bIndex,bName.UTF8String);
+    }];
+    
+    rewind(tFunctionsFile);
+    
+    char tBuffer[65536];
+    size_t tReadSize;
+    
+    while ((tReadSize=fread(tBuffer,1,sizeof(tBuffer),tFunctionsFile))>0)
+        fwrite(tBuffer,1,tReadSize,tFile);
+    
+    BOOL tSuccess=(ferror(tFunctionsFile)==0 && ferror(tFile)==0);
+    
+    fclose(tFunctionsFile);
+    
+    if (fclose(tFile)!=0)
+        tSuccess=NO;
+    
+    if (tSuccess==NO)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EIO userInfo:@{NSFilePathErrorKey:inPath}];
+        
+        unlink(inPath.fileSystemRepresentation);
+        
+        return NO;
+    }
+    
+    return YES;
+}
+
+@end
@@ -52,4 +52,12 @@
 
 - (void)lookUpSymbolicationDataForMachineInstructionAddress:(uint64_t)inAddress completionHandler:(void (^)(BOOL bFound,CUISymbolicationData * bSymbolicationData))handler;
 
+// Compilation units listed in the __debug_aranges section
+
+- (void)enumerateCompilationUnitsUsingBlock:(void (^)(DWRFDebuggingInformationCompilationUnit * bCompilationUnit,BOOL * bOutStop))inBlock;
+
+// Parses the sections, the compilation units containing the addresses and their line number programs ahead of the look ups
+
+- (void)prewarmCompilationUnitsForMachineInstructionAddresses:(NSArray<NSNumber *> *)inAddresses;
+
 @end
@@ -15,12 +15,18 @@
 
 #import "MCHSegmentLoadCommand.h"
 
+#import "DWRFFunctionRangesCache.h"
+
+#import "CUISymbolicationMetrics.h"
+
 #include <mach-o/loader.h>
 #include <mach-o/fat.h>
 
 @interface DWRFFileObject ()
 {
     MCHObjectFile * _cachedObjectFile;
+    
+    DWRFFunctionRangesCache * _functionRangesCache;
 }
 
     @property DWRFSection_debug_addr * section_debug_addr;
@@ -37,6 +43,8 @@
 
     @property DWRFSection_debug_aranges * section_debug_aranges;
 
+- (DWRFFunctionRange *)_functionRangeForMachineInstructionAddress:(uint64_t)inAddress compilationUnit:(DWRFDebuggingInformationCompilationUnit **)outCompilationUnit;
+
 @end
 
 @implementation DWRFFileObject
@@ -54,6 +62,8 @@
     if (self!=nil)
     {
         _cachedObjectFile=inObjectFile;
+        
+        _functionRangesCache=[DWRFFunctionRangesCache new];
     }
     
     return self;
@@ -176,6 +186,78 @@
 
 #pragma mark -
 
+- (DWRFFunctionRange *)_functionRangeForMachineInstructionAddress:(uint64_t)inAddress compilationUnit:(DWRFDebuggingInformationCompilationUnit **)outCompilationUnit
+{
+    DWRFFunctionRange * tFunctionRange=[_functionRangesCache functionRangeForAddress:inAddress];
+    
+    if (tFunctionRange!=nil)
+    {
+        // No need to look for the sub program in the compilation unit
+        
+        *outCompilationUnit=[self.section_debug_info compilationUnitAtOffset:tFunctionRange.compilationUnitOffset];
+        
+        return (*outCompilationUnit!=nil) ? tFunctionRange : nil;
+    }
+    
+    CUISymbolicationInterval tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageAddressRangesLookUp);
+    
+    uint64_t tDebugInfoOffset=[self.section_debug_aranges debugInfoOffsetForAddress:inAddress];
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageAddressRangesLookUp,tInterval);
+    
+    if (tDebugInfoOffset==UINT64_MAX)
+        return nil;
+    
+    DWRFDebuggingInformationCompilationUnit * tCompilationUnit=[self.section_debug_info compilationUnitAtOffset:tDebugInfoOffset];
+    
+    if (tCompilationUnit==nil)
+        return nil;
+    
+    // Look for the sub_program with inAddress for its AT_low_pc attribute
+    
+    DWRFPCRange tPCRange;
+    
+    tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageDebuggingInformationEntrySearch);
+    
+    DWRFSubProgramEntry * tSubProgramEntry=[tCompilationUnit subProgramForMachineInstructionAddress:inAddress pcRange:&tPCRange];
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageDebuggingInformationEntrySearch,tInterval);
+    
+    if (tSubProgramEntry==nil)
+        return nil;
+    
+    tFunctionRange=[DWRFFunctionRange new];
+    
+    tFunctionRange.lowPC=tPCRange.lowPC;
+    tFunctionRange.highPC=tPCRange.highPC;
+    tFunctionRange.compilationUnitOffset=tDebugInfoOffset;
+    tFunctionRange.machineInstructionAddress=tSubProgramEntry.machineInstructionAddress;
+    
+    tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageDemangling);
+    
+    tFunctionRange.stackFrameSymbol=[tSubProgramEntry stackFrameSymbolWithLanguage:tCompilationUnit.language];
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageDemangling,tInterval);
+    
+    tFunctionRange.name=tSubProgramEntry.name;
+    tFunctionRange.declarationLine=tSubProgramEntry.line;
+    
+    NSString * tSourceFilePath=nil;
+    
+    NSUInteger tFileIndex=tSubProgramEntry.sourcePathIndex;
+    
+    if (tFileIndex!=0)
+        tSourceFilePath=[tCompilationUnit.lineNumberProgram fileNameAtIndex:tFileIndex];
+    
+    tFunctionRange.declarationFilePath=(tSourceFilePath!=nil) ? tSourceFilePath : @"-";
+    
+    [_functionRangesCache addFunctionRange:tFunctionRange];
+    
+    *outCompilationUnit=tCompilationUnit;
+    
+    return tFunctionRange;
+}
+
 - (void)lookUpSymbolicationDataForMachineInstructionAddress:(uint64_t)inAddress completionHandler:(void (^)(BOOL bFound,CUISymbolicationData * bSymbolicationData))handler
 {
     if (self.section_debug_info==nil)
@@ -189,19 +271,11 @@
         }
     }
     
-    uint64_t tDebugInfoOffset=[self.section_debug_aranges debugInfoOffsetForAddress:inAddress];
+    DWRFDebuggingInformationCompilationUnit * tCompilationUnit=nil;
     
-    if (tDebugInfoOffset==UINT64_MAX)
-    {
-        if (handler!=nil)
-            handler(NO,nil);
-        
-        return;
-    }
+    DWRFFunctionRange * tFunctionRange=[self _functionRangeForMachineInstructionAddress:inAddress compilationUnit:&tCompilationUnit];
     
-    DWRFDebuggingInformationCompilationUnit * tCompilationUnit=[self.section_debug_info compilationUnitAtOffset:tDebugInfoOffset];
-    
-    if (tCompilationUnit==nil)
+    if (tFunctionRange==nil)
     {
         if (handler!=nil)
             handler(NO,nil);
@@ -209,33 +283,20 @@
         return;
     }
     
-    // Look for the sub_program with inAddress for its AT_low_pc attribute
+    // The line number program is run the first time a location is looked for in the compilation unit
     
-    DWRFSubProgramEntry * tSubProgramEntry=[tCompilationUnit subProgramForMachineInstructionAddress:inAddress];
-    
-    if (tSubProgramEntry==nil)
-    {
-        if (handler!=nil)
-            handler(NO,nil);
-        
-        return;
-    }
+    CUISymbolicationInterval tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageLineNumberProgram);
     
     DWRFLineNumberProgramLocation * tLocation=[tCompilationUnit.lineNumberProgram locationForMachineInstructionAddress:inAddress];
     
+    CUISymbolicationIntervalEnd(CUISymbolicationStageLineNumberProgram,tInterval);
+    
     if (tLocation!=nil)
     {
         CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
         
-        tSymbolicationData.stackFrameSymbol=[tSubProgramEntry stackFrameSymbolWithLanguage:tCompilationUnit.language];
-        tSymbolicationData.byteOffset=inAddress-tSubProgramEntry.machineInstructionAddress;
-        
-        NSUInteger tFileIndex=tSubProgramEntry.sourcePathIndex;
-        
-        if (tFileIndex!=0)
-        {
-            // A AMELIORER (path absolu à trouver)
-        }
+        tSymbolicationData.stackFrameSymbol=tFunctionRange.stackFrameSymbol;
+        tSymbolicationData.byteOffset=inAddress-tFunctionRange.machineInstructionAddress;
         
         NSString * tFilePath=tLocation.fileName;
         
@@ -252,47 +313,85 @@
         tSymbolicationData.lineNumber=tLocation.lineNumber;
         tSymbolicationData.columnNumber=tLocation.columnNumber;
         
-        handler(YES,tSymbolicationData);
+        if (handler!=nil)
+            handler(YES,tSymbolicationData);
         
         return;
     }
     
     // Not found, use less accurate data
     
-        NSLog(@"0x%llX -> %@ %@ - %llu %llu",inAddress,tSubProgramEntry.name,tLocation.fileName,tLocation.lineNumber,tLocation.columnNumber);
+    if (handler!=nil)
+    {
+        CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
+        
+        tSymbolicationData.stackFrameSymbol=tFunctionRange.name;
+        tSymbolicationData.byteOffset=inAddress-tFunctionRange.machineInstructionAddress;
+        tSymbolicationData.sourceFilePath=tFunctionRange.declarationFilePath;
+        tSymbolicationData.lineNumber=tFunctionRange.declarationLine;
+        
+        handler(YES,tSymbolicationData);
+    }
+}
+
+- (void)enumerateCompilationUnitsUsingBlock:(void (^)(DWRFDebuggingInformationCompilationUnit * bCompilationUnit,BOOL * bOutStop))inBlock
+{
+    if (inBlock==nil)
+        return;
     
+    if (self.section_debug_info==nil)
+    {
+        if ([self analyze]==NO)
+            return;
+    }
     
-    NSString * tSourceFilePath=@"-";
+    NSMutableSet * tVisitedOffsets=[NSMutableSet set];
     
-    NSUInteger tFileIndex=tSubProgramEntry.sourcePathIndex;
+    BOOL tStop=NO;
     
-    if (tFileIndex!=0)
+    for(DWRFCompilationUnitAddressSpace * tAddressSpace in self.section_debug_aranges.allCompilationUnitsAddressSpaces)
     {
-        DWRFLineNumberProgram * tLineNumberProgram=[tCompilationUnit lineNumberProgram];
-    
-        if (tLineNumberProgram!=nil)
-        {
-            tSourceFilePath=[tLineNumberProgram fileNameAtIndex:tFileIndex];
-            
-            if (tSourceFilePath==nil)
-            {
-                tSourceFilePath=@"-";
-            }
-        }
+        NSNumber * tOffsetNumber=@(tAddressSpace.debugInfoOffset);
+        
+        if ([tVisitedOffsets containsObject:tOffsetNumber]==YES)
+            continue;
+        
+        [tVisitedOffsets addObject:tOffsetNumber];
+        
+        DWRFDebuggingInformationCompilationUnit * tCompilationUnit=[self.section_debug_info compilationUnitAtOffset:tAddressSpace.debugInfoOffset];
+        
+        if (tCompilationUnit==nil)
+            continue;
+        
+        inBlock(tCompilationUnit,&tStop);
+        
+        if (tStop==YES)
+            break;
+    }
+}
+
+- (void)prewarmCompilationUnitsForMachineInstructionAddresses:(NSArray<NSNumber *> *)inAddresses
+{
+    if (self.section_debug_info==nil)
+    {
+        if ([self analyze]==NO)
+            return;
     }
     
-    NSLog(@"0x%llX -> %@ %@ - %llu",inAddress,tSubProgramEntry.name,tSourceFilePath,tSubProgramEntry.line);
-    
-    if (handler!=nil)
+    for(NSNumber * tAddressNumber in inAddresses)
     {
-        CUISymbolicationData * tSymbolicationData=[CUISymbolicationData new];
+        uint64_t tAddress=tAddressNumber.unsignedLongLongValue;
         
-        tSymbolicationData.stackFrameSymbol=tSubProgramEntry.name;
-        tSymbolicationData.byteOffset=inAddress-tSubProgramEntry.machineInstructionAddress;
-        tSymbolicationData.sourceFilePath=tSourceFilePath;
-        tSymbolicationData.lineNumber=tSubProgramEntry.line;
+        uint64_t tDebugInfoOffset=[self.section_debug_aranges debugInfoOffsetForAddress:tAddress];
         
-        handler(YES,tSymbolicationData);
+        if (tDebugInfoOffset==UINT64_MAX)
+            continue;
+        
+        DWRFDebuggingInformationCompilationUnit * tCompilationUnit=[self.section_debug_info compilationUnitAtOffset:tDebugInfoOffset];
+        
+        // The line number program is run the first time a location is looked for in the compilation unit
+        
+        [tCompilationUnit.lineNumberProgram locationForMachineInstructionAddress:tAddress];
     }
 }
 
@@ -0,0 +1,138 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "DWRFFunctionRangesCache.h"
+
+#include <os/lock.h>
+
+@implementation DWRFFunctionRange
+
+- (BOOL)containsAddress:(uint64_t)inAddress
+{
+    return (inAddress>=self.lowPC && inAddress<self.highPC);
+}
+
+#pragma mark -
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"0x%llx - 0x%llx %@",self.lowPC,self.highPC-1,self.stackFrameSymbol];
+}
+
+@end
+
+@interface DWRFFunctionRangesCache ()
+{
+    // Protects _functionRanges (look ups and prewarm jobs fill the cache from different queues)
+    
+    os_unfair_lock _lock;
+    
+    NSMutableArray<DWRFFunctionRange *> * _functionRanges;
+}
+
+// Must be called with the lock held
+
+- (NSUInteger)_insertionIndexForAddress:(uint64_t)inAddress;
+
+@end
+
+@implementation DWRFFunctionRangesCache
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _lock=OS_UNFAIR_LOCK_INIT;
+        
+        _functionRanges=[NSMutableArray array];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)count
+{
+    os_unfair_lock_lock(&_lock);
+    
+    NSUInteger tCount=_functionRanges.count;
+    
+    os_unfair_lock_unlock(&_lock);
+    
+    return tCount;
+}
+
+#pragma mark -
+
+// Index of the first range whose lowPC is greater than inAddress
+
+- (NSUInteger)_insertionIndexForAddress:(uint64_t)inAddress
+{
+    NSUInteger tLowerIndex=0;
+    NSUInteger tUpperIndex=_functionRanges.count;
+    
+    while (tLowerIndex<tUpperIndex)
+    {
+        NSUInteger tMiddleIndex=tLowerIndex+(tUpperIndex-tLowerIndex)/2;
+        
+        if (_functionRanges[tMiddleIndex].lowPC<=inAddress)
+            tLowerIndex=tMiddleIndex+1;
+        else
+            tUpperIndex=tMiddleIndex;
+    }
+    
+    return tLowerIndex;
+}
+
+- (DWRFFunctionRange *)functionRangeForAddress:(uint64_t)inAddress
+{
+    DWRFFunctionRange * tFunctionRange=nil;
+    
+    os_unfair_lock_lock(&_lock);
+    
+    NSUInteger tIndex=[self _insertionIndexForAddress:inAddress];
+    
+    if (tIndex>0)
+        tFunctionRange=_functionRanges[tIndex-1];
+    
+    os_unfair_lock_unlock(&_lock);
+    
+    return ([tFunctionRange containsAddress:inAddress]==YES) ? tFunctionRange : nil;
+}
+
+- (BOOL)addFunctionRange:(DWRFFunctionRange *)inFunctionRange
+{
+    if (inFunctionRange==nil || inFunctionRange.highPC<=inFunctionRange.lowPC)
+        return NO;
+    
+    os_unfair_lock_lock(&_lock);
+    
+    NSUInteger tIndex=[self _insertionIndexForAddress:inFunctionRange.lowPC];
+    
+    // Refuse overlapping ranges
+    
+    BOOL tOverlaps=((tIndex>0 && _functionRanges[tIndex-1].highPC>inFunctionRange.lowPC) ||
+                    (tIndex<_functionRanges.count && _functionRanges[tIndex].lowPC<inFunctionRange.highPC));
+    
+    if (tOverlaps==NO)
+        [_functionRanges insertObject:inFunctionRange atIndex:tIndex];
+    
+    os_unfair_lock_unlock(&_lock);
+    
+    return (tOverlaps==NO);
+}
+
+@end
@@ -0,0 +1,531 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DWRFLineProgramCore.h"
+
+#include "LEB128.h"
+
+#include <string.h>
+
+enum
+{
+    DW_LNS_extended_op = 0x00,
+    
+    DW_LNS_copy = 0x01,
+    DW_LNS_advance_pc = 0x02,
+    DW_LNS_advance_line = 0x03,
+    DW_LNS_set_file = 0x04,
+    DW_LNS_set_column = 0x05,
+    DW_LNS_negate_stmt = 0x06,
+    DW_LNS_set_basic_block = 0x07,
+    DW_LNS_const_add_pc = 0x08,
+    DW_LNS_fixed_advance_pc = 0x09,
+    DW_LNS_set_prologue_end = 0x0a,
+    DW_LNS_set_epilogue_begin = 0x0b,
+    DW_LNS_set_isa = 0x0c
+};
+
+enum
+{
+    DW_LNE_end_sequence = 0x01,
+    DW_LNE_set_address = 0x02,
+    DW_LNE_define_file = 0x03,
+    DW_LNE_set_discriminator = 0x04
+};
+
+static uint64_t DWRFLineProgramReadValue(const uint8_t * inBytes,NSUInteger inSize)
+{
+    switch(inSize)
+    {
+        case 2:
+        {
+            uint16_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint16_t));
+            
+            return tValue;
+        }
+            
+        case 4:
+        {
+            uint32_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint32_t));
+            
+            return tValue;
+        }
+            
+        default:
+        {
+            uint64_t tValue;
+            
+            memcpy(&tValue,inBytes,sizeof(uint64_t));
+            
+            return tValue;
+        }
+    }
+}
+
+// Reads the null-terminated string at *ioOffset. NO is returned if it is not terminated before inEndOffset
+
+static BOOL DWRFLineProgramReadString(const uint8_t * inBytes,NSUInteger inEndOffset,NSUInteger * ioOffset,const char ** outString)
+{
+    NSUInteger tOffset=*ioOffset;
+    
+    if (tOffset>=inEndOffset)
+        return NO;
+    
+    const uint8_t * tTerminator=memchr(inBytes+tOffset,0,inEndOffset-tOffset);
+    
+    if (tTerminator==NULL)
+        return NO;
+    
+    if (outString!=NULL)
+        *outString=(const char *)(inBytes+tOffset);
+    
+    *ioOffset=(NSUInteger)(tTerminator-inBytes)+1;
+    
+    return YES;
+}
+
+static BOOL DWRFLineProgramReadULEB128(const uint8_t * inBytes,NSUInteger inEndOffset,NSUInteger * ioOffset,uint64_t * outValue)
+{
+    const uint8_t * tEnd=DWRF_readBoundedULEB128(inBytes+*ioOffset,inBytes+inEndOffset,outValue);
+    
+    if (tEnd==NULL)
+        return NO;
+    
+    *ioOffset=(NSUInteger)(tEnd-inBytes);
+    
+    return YES;
+}
+
+static BOOL DWRFLineProgramReadFileEntry(const uint8_t * inBytes,NSUInteger inEndOffset,NSUInteger * ioOffset,DWRFLineProgramFileEntry * outEntry)
+{
+    NSUInteger tOffset=*ioOffset;
+    DWRFLineProgramFileEntry tEntry;
+    
+    if (DWRFLineProgramReadString(inBytes,inEndOffset,&tOffset,&tEntry.name)==NO ||
+        DWRFLineProgramReadULEB128(inBytes,inEndOffset,&tOffset,&tEntry.directoryIndex)==NO ||
+        DWRFLineProgramReadULEB128(inBytes,inEndOffset,&tOffset,&tEntry.lastModificationDate)==NO ||
+        DWRFLineProgramReadULEB128(inBytes,inEndOffset,&tOffset,&tEntry.fileSize)==NO)
+        return NO;
+    
+    if (outEntry!=NULL)
+        *outEntry=tEntry;
+    
+    *ioOffset=tOffset;
+    
+    return YES;
+}
+
+BOOL DWRFLineProgramHeaderRead(const uint8_t * inBytes,NSUInteger inLength,NSUInteger inOffset,DWRFLineProgramHeader * outHeader)
+{
+    if (inBytes==NULL || outHeader==NULL || inOffset>inLength || (inLength-inOffset)<4)
+        return NO;
+    
+    NSUInteger tOffset=inOffset;
+    
+    uint64_t tUnitLength=DWRFLineProgramReadValue(inBytes+tOffset,4);
+    tOffset+=4;
+    
+    BOOL tIs64BitFormat=(tUnitLength==0xffffffff);
+    
+    if (tIs64BitFormat==YES)
+    {
+        if ((inLength-tOffset)<8)
+            return NO;
+        
+        tUnitLength=DWRFLineProgramReadValue(inBytes+tOffset,8);
+        tOffset+=8;
+    }
+    
+    if (tUnitLength>(inLength-tOffset))
+        return NO;
+    
+    NSUInteger tEndOffset=tOffset+(NSUInteger)tUnitLength;
+    
+    // version, header_length
+    
+    NSUInteger tOffsetSize=(tIs64BitFormat==YES) ? 8 : 4;
+    
+    if ((tEndOffset-tOffset)<(2+tOffsetSize))
+        return NO;
+    
+    uint16_t tVersion=(uint16_t)DWRFLineProgramReadValue(inBytes+tOffset,2);
+    tOffset+=2;
+    
+    if (tVersion<2 || tVersion>4)
+        return NO;
+    
+    uint64_t tHeaderLength=DWRFLineProgramReadValue(inBytes+tOffset,tOffsetSize);
+    tOffset+=tOffsetSize;
+    
+    if (tHeaderLength>(tEndOffset-tOffset))
+        return NO;
+    
+    NSUInteger tProgramOffset=tOffset+(NSUInteger)tHeaderLength;
+    
+    // minimum_instruction_length, (maximum_operations_per_instruction,) default_is_stmt, line_base, line_range, opcode_base
+    
+    NSUInteger tFieldsSize=(tVersion>=4) ? 6 : 5;
+    
+    if ((tProgramOffset-tOffset)<tFieldsSize)
+        return NO;
+    
+    outHeader->minimumInstructionLength=inBytes[tOffset++];
+    
+    outHeader->maximumOperationsPerInstruction=(tVersion>=4) ? inBytes[tOffset++] : 1;
+    
+    outHeader->defaultIsStmt=(inBytes[tOffset++]!=0);
+    
+    outHeader->lineBase=(int8_t)inBytes[tOffset++];
+    
+    outHeader->lineRange=inBytes[tOffset++];
+    
+    outHeader->opcodeBase=inBytes[tOffset++];
+    
+    if (outHeader->maximumOperationsPerInstruction==0 || outHeader->lineRange==0 || outHeader->opcodeBase==0)
+        return NO;
+    
+    if ((tProgramOffset-tOffset)<(NSUInteger)(outHeader->opcodeBase-1))
+        return NO;
+    
+    outHeader->standardOpcodeLengthsOffset=tOffset;
+    tOffset+=outHeader->opcodeBase-1;
+    
+    // Check the lists so that they can then be enumerated without surprises
+    
+    outHeader->programOffset=tProgramOffset;
+    
+    outHeader->includeDirectoriesOffset=tOffset;
+    
+    while (DWRFLineProgramNextIncludeDirectory(inBytes,outHeader,&tOffset,NULL)==YES)
+        ;
+    
+    if (tOffset>=tProgramOffset || inBytes[tOffset]!=0)
+        return NO;
+    
+    tOffset++;
+    
+    outHeader->fileNamesOffset=tOffset;
+    
+    while (tOffset<tProgramOffset && inBytes[tOffset]!=0)
+    {
+        if (DWRFLineProgramReadFileEntry(inBytes,tProgramOffset,&tOffset,NULL)==NO)
+            return NO;
+    }
+    
+    if (tOffset>=tProgramOffset)
+        return NO;
+    
+    outHeader->unitLength=tUnitLength;
+    outHeader->version=tVersion;
+    outHeader->headerLength=tHeaderLength;
+    outHeader->is64BitFormat=tIs64BitFormat;
+    
+    outHeader->endOffset=tEndOffset;
+    
+    return YES;
+}
+
+BOOL DWRFLineProgramNextIncludeDirectory(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader,NSUInteger * ioOffset,const char ** outPath)
+{
+    NSUInteger tOffset=*ioOffset;
+    
+    if (tOffset>=inHeader->programOffset || inBytes[tOffset]==0)
+        return NO;
+    
+    if (DWRFLineProgramReadString(inBytes,inHeader->programOffset,&tOffset,outPath)==NO)
+        return NO;
+    
+    *ioOffset=tOffset;
+    
+    return YES;
+}
+
+BOOL DWRFLineProgramNextFileEntry(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader,NSUInteger * ioOffset,DWRFLineProgramFileEntry * outEntry)
+{
+    if (*ioOffset>=inHeader->programOffset || inBytes[*ioOffset]==0)
+        return NO;
+    
+    return DWRFLineProgramReadFileEntry(inBytes,inHeader->programOffset,ioOffset,outEntry);
+}
+
+#pragma mark -
+
+static void DWRFLineProgramResetRegisters(DWRFLineProgramRegisters * outRegisters,BOOL inDefaultIsStmt)
+{
+    memset(outRegisters,0,sizeof(DWRFLineProgramRegisters));
+    
+    outRegisters->file=1;
+    outRegisters->line=1;
+    
+    outRegisters->isStmt=inDefaultIsStmt;
+}
+
+NS_INLINE void DWRFLineProgramAdvance(DWRFLineProgramStateMachine * ioStateMachine,uint64_t inOperationAdvance)
+{
+    DWRFLineProgramRegisters * tRegisters=&ioStateMachine->registers;
+    uint64_t tMaximumOperations=ioStateMachine->header.maximumOperationsPerInstruction;
+    
+    tRegisters->address+=ioStateMachine->header.minimumInstructionLength*((tRegisters->opIndex+inOperationAdvance)/tMaximumOperations);
+    
+    tRegisters->opIndex=(tRegisters->opIndex+inOperationAdvance)%tMaximumOperations;
+}
+
+NS_INLINE void DWRFLineProgramDidAppendRow(DWRFLineProgramRegisters * ioRegisters)
+{
+    ioRegisters->basicBlock=NO;
+    ioRegisters->prologueEnd=NO;
+    ioRegisters->epilogueBegin=NO;
+    
+    ioRegisters->discriminator=0;
+}
+
+DWRFLineProgramStateMachine DWRFLineProgramStateMachineMake(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader)
+{
+    DWRFLineProgramStateMachine tStateMachine;
+    
+    memset(&tStateMachine,0,sizeof(DWRFLineProgramStateMachine));
+    
+    tStateMachine.bytes=inBytes;
+    tStateMachine.header=*inHeader;
+    tStateMachine.location=inHeader->programOffset;
+    
+    DWRFLineProgramResetRegisters(&tStateMachine.registers,inHeader->defaultIsStmt);
+    
+    return tStateMachine;
+}
+
+DWRFLineProgramStep DWRFLineProgramStateMachineNext(DWRFLineProgramStateMachine * ioStateMachine)
+{
+    const uint8_t * tBytes=ioStateMachine->bytes;
+    const DWRFLineProgramHeader * tHeader=&ioStateMachine->header;
+    DWRFLineProgramRegisters * tRegisters=&ioStateMachine->registers;
+    NSUInteger tEndOffset=tHeader->endOffset;
+    
+    if (ioStateMachine->rowWasAppended==YES)
+    {
+        // The registers were left untouched so that the caller could read the row
+        
+        if (tRegisters->endSequence==YES)
+            DWRFLineProgramResetRegisters(tRegisters,tHeader->defaultIsStmt);
+        else
+            DWRFLineProgramDidAppendRow(tRegisters);
+        
+        ioStateMachine->rowWasAppended=NO;
+    }
+    
+    while (ioStateMachine->location<tEndOffset)
+    {
+        uint8_t tOpcode=tBytes[ioStateMachine->location++];
+        
+        if (tOpcode>=tHeader->opcodeBase)
+        {
+            // Special opcode
+            
+            tOpcode-=tHeader->opcodeBase;
+            
+            tRegisters->line+=(int64_t)tHeader->lineBase+(tOpcode%tHeader->lineRange);
+            
+            DWRFLineProgramAdvance(ioStateMachine,tOpcode/tHeader->lineRange);
+            
+            ioStateMachine->rowWasAppended=YES;
+            
+            return DWRFLineProgramStepRow;
+        }
+        
+        if (tOpcode!=DW_LNS_extended_op)
+        {
+            // Standard opcode
+            
+            uint64_t tOperand;
+            
+            switch(tOpcode)
+            {
+                case DW_LNS_copy:
+                    
+                    ioStateMachine->rowWasAppended=YES;
+                    
+                    return DWRFLineProgramStepRow;
+                    
+                case DW_LNS_advance_pc:
+                    
+                    if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,&tOperand)==NO)
+                        return DWRFLineProgramStepMalformed;
+                    
+                    DWRFLineProgramAdvance(ioStateMachine,tOperand);
+                    
+                    break;
+                    
+                case DW_LNS_advance_line:
+                {
+                    int64_t tLineAdvance;
+                    const uint8_t * tEnd=DWRF_readBoundedLEB128(tBytes+ioStateMachine->location,tBytes+tEndOffset,&tLineAdvance);
+                    
+                    if (tEnd==NULL)
+                        return DWRFLineProgramStepMalformed;
+                    
+                    ioStateMachine->location=(NSUInteger)(tEnd-tBytes);
+                    
+                    tRegisters->line+=tLineAdvance;
+                    
+                    break;
+                }
+                    
+                case DW_LNS_set_file:
+                    
+                    if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,&tRegisters->file)==NO)
+                        return DWRFLineProgramStepMalformed;
+                    
+                    break;
+                    
+                case DW_LNS_set_column:
+                    
+                    if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,&tRegisters->column)==NO)
+                        return DWRFLineProgramStepMalformed;
+                    
+                    break;
+                    
+                case DW_LNS_negate_stmt:
+                    
+                    tRegisters->isStmt=!tRegisters->isStmt;
+                    
+                    break;
+                    
+                case DW_LNS_set_basic_block:
+                    
+                    tRegisters->basicBlock=YES;
+                    
+                    break;
+                    
+                case DW_LNS_const_add_pc:
+                    
+                    DWRFLineProgramAdvance(ioStateMachine,(255-tHeader->opcodeBase)/tHeader->lineRange);
+                    
+                    break;
+                    
+                case DW_LNS_fixed_advance_pc:
+                    
+                    if ((tEndOffset-ioStateMachine->location)<sizeof(uint16_t))
+                        return DWRFLineProgramStepMalformed;
+                    
+                    tRegisters->address+=DWRFLineProgramReadValue(tBytes+ioStateMachine->location,sizeof(uint16_t));
+                    ioStateMachine->location+=sizeof(uint16_t);
+                    
+                    tRegisters->opIndex=0;
+                    
+                    break;
+                    
+                case DW_LNS_set_prologue_end:
+                    
+                    tRegisters->prologueEnd=YES;
+                    
+                    break;
+                    
+                case DW_LNS_set_epilogue_begin:
+                    
+                    tRegisters->epilogueBegin=YES;
+                    
+                    break;
+                    
+                case DW_LNS_set_isa:
+                    
+                    if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,&tRegisters->isa)==NO)
+                        return DWRFLineProgramStepMalformed;
+                    
+                    break;
+                    
+                default:
+                {
+                    // Unsupported standard opcode: its operands are skipped
+                    
+                    uint8_t tNumberOfOperands=tBytes[tHeader->standardOpcodeLengthsOffset+tOpcode-1];
+                    
+                    for(uint8_t tIndex=0;tIndex<tNumberOfOperands;tIndex++)
+                    {
+                        if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,NULL)==NO)
+                            return DWRFLineProgramStepMalformed;
+                    }
+                    
+                    break;
+                }
+            }
+            
+            continue;
+        }
+        
+        // Extended opcode
+        
+        uint64_t tLength;
+        
+        if (DWRFLineProgramReadULEB128(tBytes,tEndOffset,&ioStateMachine->location,&tLength)==NO)
+            return DWRFLineProgramStepMalformed;
+        
+        if (tLength==0 || tLength>(tEndOffset-ioStateMachine->location))
+            return DWRFLineProgramStepMalformed;
+        
+        NSUInteger tOperandsOffset=ioStateMachine->location+1;
+        NSUInteger tNextOffset=ioStateMachine->location+(NSUInteger)tLength;
+        NSUInteger tOperandsSize=(NSUInteger)tLength-1;
+        
+        uint8_t tExtendedOpcode=tBytes[ioStateMachine->location];
+        
+        ioStateMachine->location=tNextOffset;
+        
+        switch(tExtendedOpcode)
+        {
+            case DW_LNE_end_sequence:
+                
+                tRegisters->endSequence=YES;
+                
+                ioStateMachine->rowWasAppended=YES;
+                
+                return DWRFLineProgramStepRow;
+                
+            case DW_LNE_set_address:
+                
+                if (tOperandsSize!=4 && tOperandsSize!=8)
+                    return DWRFLineProgramStepMalformed;
+                
+                tRegisters->address=DWRFLineProgramReadValue(tBytes+tOperandsOffset,tOperandsSize);
+                
+                tRegisters->opIndex=0;
+                
+                break;
+                
+            case DW_LNE_define_file:
+                
+                if (DWRFLineProgramReadFileEntry(tBytes,tNextOffset,&tOperandsOffset,&ioStateMachine->definedFile)==NO)
+                    return DWRFLineProgramStepMalformed;
+                
+                return DWRFLineProgramStepDefineFile;
+                
+            case DW_LNE_set_discriminator:
+                
+                if (DWRFLineProgramReadULEB128(tBytes,tNextOffset,&tOperandsOffset,&tRegisters->discriminator)==NO)
+                    return DWRFLineProgramStepMalformed;
+                
+                break;
+                
+            default:
+                
+                // Unsupported extended opcode: skipped
+                
+                break;
+        }
+    }
+    
+    return DWRFLineProgramStepEnd;
+}
@@ -0,0 +1,129 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DWRFLineProgramCore_h
+#define DWRFLineProgramCore_h
+
+#include "CUIPortableTypes.h"
+
+// Parsing and execution of the line number programs of the __debug_line section (DWARF 2 to 4) without creating intermediate objects.
+// The values are in the byte order of the host (as in the dSYM files of the supported architectures). The bytes are never read beyond the length.
+
+typedef struct
+{
+    uint64_t unitLength;
+    
+    uint16_t version;
+    
+    uint64_t headerLength;
+    
+    uint8_t minimumInstructionLength;
+    
+    uint8_t maximumOperationsPerInstruction;
+    
+    BOOL defaultIsStmt;
+    
+    int8_t lineBase;
+    
+    uint8_t lineRange;
+    
+    uint8_t opcodeBase;
+    
+    BOOL is64BitFormat;
+    
+    NSUInteger standardOpcodeLengthsOffset;     // opcodeBase-1 lengths
+    
+    NSUInteger includeDirectoriesOffset;
+    
+    NSUInteger fileNamesOffset;
+    
+    NSUInteger programOffset;
+    
+    NSUInteger endOffset;                       // Next program
+    
+} DWRFLineProgramHeader;
+
+typedef struct
+{
+    const char * name;          // Points to the bytes
+    
+    uint64_t directoryIndex;
+    
+    uint64_t lastModificationDate;
+    
+    uint64_t fileSize;
+    
+} DWRFLineProgramFileEntry;
+
+typedef struct
+{
+    uint64_t address;
+    uint64_t opIndex;
+    
+    uint64_t file;
+    uint64_t line;
+    uint64_t column;
+    
+    BOOL isStmt;
+    BOOL basicBlock;
+    BOOL endSequence;
+    BOOL prologueEnd;
+    BOOL epilogueBegin;
+    
+    uint64_t isa;
+    
+    uint64_t discriminator;
+    
+} DWRFLineProgramRegisters;
+
+typedef enum
+{
+    DWRFLineProgramStepEnd=0,
+    DWRFLineProgramStepRow,             // A row was appended to the matrix (see registers, valid until the next step)
+    DWRFLineProgramStepDefineFile,      // DW_LNE_define_file (see definedFile)
+    DWRFLineProgramStepMalformed
+} DWRFLineProgramStep;
+
+typedef struct
+{
+    const uint8_t * bytes;
+    
+    DWRFLineProgramHeader header;
+    
+    NSUInteger location;
+    
+    DWRFLineProgramRegisters registers;
+    
+    DWRFLineProgramFileEntry definedFile;
+    
+    BOOL rowWasAppended;
+    
+} DWRFLineProgramStateMachine;
+
+// NO is returned if the header is truncated or malformed, or if the version is not supported
+
+BOOL DWRFLineProgramHeaderRead(const uint8_t * inBytes,NSUInteger inLength,NSUInteger inOffset,DWRFLineProgramHeader * outHeader);
+
+// The lists start at includeDirectoriesOffset and fileNamesOffset. NO is returned at the end of the list
+
+BOOL DWRFLineProgramNextIncludeDirectory(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader,NSUInteger * ioOffset,const char ** outPath);
+
+BOOL DWRFLineProgramNextFileEntry(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader,NSUInteger * ioOffset,DWRFLineProgramFileEntry * outEntry);
+
+DWRFLineProgramStateMachine DWRFLineProgramStateMachineMake(const uint8_t * inBytes,const DWRFLineProgramHeader * inHeader);
+
+// Runs the program up to the next row or file definition
+
+DWRFLineProgramStep DWRFLineProgramStateMachineNext(DWRFLineProgramStateMachine * ioStateMachine);
+
+#endif
@@ -13,126 +13,7 @@
 
 #import "DWRFSection_debug_aranges.h"
 
-#import "DWRFObject.h"
-
-
-@interface DWRFCompilationUnitAddressSpaceHeader : DWRFObject
-
-    @property uint64_t unitLength;
-
-    @property uint16_t version;
-
-    @property uint64_t debugInfoOffset;
-
-    @property uint8_t addressSize;
-    @property uint8_t segmentSize;
-
-    @property (nonatomic,readonly) size_t headerSize;
-
-    @property (nonatomic,readonly) size_t addressRangeDescriptorSize;
-
-    @property (nonatomic,readonly) size_t paddingSize;
-
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer;
-
-@end
-
-@implementation DWRFCompilationUnitAddressSpaceHeader
-
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer
-{
-    if (inBuffer==NULL)
-        return nil;
-    
-    self=[super init];
-                        
-    if (self!=nil)
-    {
-        uint8_t * tBufferPtr=inBuffer;
-        
-        uint32_t tUnsignedInteger=*((uint32_t *)tBufferPtr);
-        
-        tBufferPtr+=sizeof(uint32_t);
-        
-        if (tUnsignedInteger==0xffffffff)
-        {
-            self.dwarfFormat=DWRF64Format;
-            
-            _unitLength=*((uint64_t *)tBufferPtr);
-            
-            tBufferPtr+=sizeof(uint64_t);
-        }
-        else
-        {
-            self.dwarfFormat=DWRF32Format;
-            
-            _unitLength=tUnsignedInteger;
-        }
-        
-        _version=*((uint16_t *)tBufferPtr);
-        tBufferPtr+=sizeof(uint16_t);
-        
-        if (self.dwarfFormat==DWRF64Format)
-        {
-            _debugInfoOffset=*((uint64_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint64_t);
-        }
-        else
-        {
-            _debugInfoOffset=*((uint32_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint32_t);
-        }
-        
-        _addressSize=*((uint8_t *)tBufferPtr);
-        tBufferPtr+=sizeof(uint8_t);
-        
-        _segmentSize=*((uint8_t *)tBufferPtr);
-        tBufferPtr+=sizeof(uint8_t);
-        
-        if (outBuffer!=NULL)
-            *outBuffer=tBufferPtr;
-    }
-    
-    return self;
-}
-
-#pragma mark -
-
-- (size_t)headerSize
-{
-    switch(self.dwarfFormat)
-    {
-        case DWRF32Format:
-            
-            return 12*sizeof(uint8_t);
-            
-        case DWRF64Format:
-            
-            return 24*sizeof(uint8_t);
-            
-        default:
-            
-            return -1;
-    }
-}
-
-- (size_t)addressRangeDescriptorSize
-{
-    return _segmentSize+2*_addressSize;
-}
-
-- (size_t)paddingSize
-{
-    size_t tDescriptorSize=self.addressRangeDescriptorSize;
-    size_t tHeaderSize=self.headerSize;
-    
-    while (tHeaderSize>tDescriptorSize)
-        tHeaderSize-=tDescriptorSize;
-    
-    return (tDescriptorSize-tHeaderSize);
-}
-
-@end
+#include "DWRFArangesCore.h"
 
 @interface DWRFAddressRangeDescriptor : NSObject
 {
@@ -196,20 +77,20 @@
 
 @interface DWRFCompilationUnitAddressSpace ()
 {
-    DWRFCompilationUnitAddressSpaceHeader * _header;
+    DWRFArangesSetHeader _header;
     
     NSMutableArray<DWRFAddressRangeDescriptor *> * _addressRangeDescriptors;
 }
 
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer;
+- (instancetype)initWithBytes:(const uint8_t *)inBytes length:(NSUInteger)inLength offset:(NSUInteger *)ioOffset;
 
 @end
 
 @implementation DWRFCompilationUnitAddressSpace
 
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer
+- (instancetype)initWithBytes:(const uint8_t *)inBytes length:(NSUInteger)inLength offset:(NSUInteger *)ioOffset
 {
-    if (inBuffer==NULL)
+    if (inBytes==NULL || ioOffset==NULL)
         return nil;
     
     self=[super init];
@@ -217,55 +98,23 @@
     if (self==nil)
         return nil;
     
-    uint8_t * tBufferPtr=inBuffer;
-    
-    _header=[[DWRFCompilationUnitAddressSpaceHeader alloc] initWithBuffer:tBufferPtr outBuffer:NULL];
+    if (DWRFArangesSetHeaderRead(inBytes,inLength,*ioOffset,&_header)==NO)
+        return nil;
     
     _addressRangeDescriptors=[NSMutableArray array];
     
-    tBufferPtr+=_header.addressRangeDescriptorSize*sizeof(uint8_t);
+    NSUInteger tDescriptorOffset=_header.descriptorsOffset;
+    uint64_t tLocation;
+    uint64_t tLength;
     
-    while(1)
+    while (DWRFArangesSetNextDescriptor(inBytes,&_header,&tDescriptorOffset,&tLocation,&tLength)==YES)
     {
-        uint64_t tSegmentSelector=0;
-        
-        if (_header.segmentSize!=0)
-        {
-            // A COMPLETER
-        }
-        
-        uint64_t tLocation;
-        uint64_t tLength;
-        
-        if (_header.addressSize==4)
-        {
-            tLocation=*((uint32_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint32_t);
-            
-            tLength=*((uint32_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint32_t);
-        }
-        else
-        {
-            tLocation=*((uint64_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint64_t);
-            
-            tLength=*((uint64_t *)tBufferPtr);
-            tBufferPtr+=sizeof(uint64_t);
-        }
-        
-        if (tSegmentSelector==0 && tLocation==0 && tLength==0)
-            break;
-        
         DWRFAddressRangeDescriptor * tDescription=[DWRFAddressRangeDescriptor addressRangeDescriptionWithLocation:tLocation length:tLength];
         
         [_addressRangeDescriptors addObject:tDescription];
-        
-        //printf("0x%llX-0x%llX\n",tLocation,tLocation+tLength-1);
     }
     
-    if (outBuffer!=NULL)
-        *outBuffer=tBufferPtr;
+    *ioOffset=_header.endOffset;
     
     return self;
 }
@@ -328,15 +177,22 @@
     {
         _compilationUnitsAddressSpaces=[NSMutableArray array];
         
-        uint8_t * tBufferPtr=(uint8_t *)inData.bytes;
-        uint8_t * tEndBufferPtr=tBufferPtr+inData.length;
+        const uint8_t * tBytes=(const uint8_t *)inData.bytes;
+        NSUInteger tLength=inData.length;
+        NSUInteger tOffset=0;
         
-        while(tBufferPtr<tEndBufferPtr)
+        while (tOffset<tLength)
         {
-            DWRFCompilationUnitAddressSpace * tAddressSpace=[[DWRFCompilationUnitAddressSpace alloc] initWithBuffer:tBufferPtr outBuffer:&tBufferPtr];
+            DWRFCompilationUnitAddressSpace * tAddressSpace=[[DWRFCompilationUnitAddressSpace alloc] initWithBytes:tBytes length:tLength offset:&tOffset];
+            
+            if (tAddressSpace==nil)
+            {
+                // Malformed or truncated set
+                
+                break;
+            }
             
-            if (tAddressSpace!=nil)
-                [_compilationUnitsAddressSpaces addObject:tAddressSpace];
+            [_compilationUnitsAddressSpaces addObject:tAddressSpace];
         }
     }
     
@@ -21,6 +21,13 @@
 
 @class DWRFFileObject;
 
+typedef struct
+{
+    uint64_t lowPC;
+    uint64_t highPC;    // Excluded
+    
+} DWRFPCRange;
+
 @interface DWRFDIEAttribute : NSObject
 
     @property DW_FORM form;
@@ -60,6 +67,8 @@
 
 - (DWRFDebuggingInformationEntry *)entryAtAddress:(uint8_t *)inAddress;
 
+- (BOOL)getPCRange:(DWRFPCRange *)outPCRange;
+
 - (BOOL)pcRangeContainsMachineInstructionAddress:(uint64_t)inMachineInstructionAddress;
 
 @end
@@ -103,8 +112,18 @@
 
 - (DWRFDebuggingInformationEntry *)entryAtAddress:(uint8_t *)inAddress;
 
+// inOffset is relative to the start of the compilation unit (DW_FORM_ref1...DW_FORM_ref_udata)
+
+- (DWRFDebuggingInformationEntry *)entryAtOffset:(uint64_t)inOffset;
+
+- (void)enumerateSubProgramsUsingBlock:(void (^)(DWRFSubProgramEntry * bSubProgramEntry,BOOL * bOutStop))inBlock;
+
 - (DWRFSubProgramEntry *)subProgramForMachineInstructionAddress:(uint64_t)inAddress;
 
+// outPCRange is set to the range of addresses for which the same sub program would be returned (empty if not known)
+
+- (DWRFSubProgramEntry *)subProgramForMachineInstructionAddress:(uint64_t)inAddress pcRange:(DWRFPCRange *)outPCRange;
+
 @end
 
 
@@ -20,6 +20,8 @@
 #import "CUICXXDemangler.h"
 #import "CUISwiftDemangler.h"
 
+#import "CUISymbolicationMetrics.h"
+
 @implementation DWRFDIEAttribute
 
 - (BOOL)isAddress
@@ -180,7 +182,7 @@
     return nil;
 }
 
-- (BOOL)pcRangeContainsMachineInstructionAddress:(uint64_t)inMachineInstructionAddress
+- (BOOL)getPCRange:(DWRFPCRange *)outPCRange
 {
     NSNumber * tNumber=[self objectForAttribute:DW_AT_low_pc];
     
@@ -189,9 +191,6 @@
     
     uint64_t tLowPC=[tNumber unsignedLongLongValue];
     
-    if (inMachineInstructionAddress<tLowPC)
-        return NO;
-    
     DWRFDIEAttribute * tHighPCAttribute=self.attributes[@(DW_AT_high_pc)];
     
     tNumber=tHighPCAttribute.object;
@@ -201,14 +200,26 @@
     
     uint64_t tHighPC=[tNumber unsignedLongLongValue];
     
-    if (tHighPCAttribute.isAddress==YES)    // HighPC is an address
+    if (tHighPCAttribute.isAddress==NO)    // HighPC is an offset from LowPC
+        tHighPC+=tLowPC;
+    
+    if (outPCRange!=NULL)
     {
-        return (inMachineInstructionAddress<tHighPC);
+        outPCRange->lowPC=tLowPC;
+        outPCRange->highPC=tHighPC;
     }
     
-    // HighPC is an offset from LowPC
+    return YES;
+}
+
+- (BOOL)pcRangeContainsMachineInstructionAddress:(uint64_t)inMachineInstructionAddress
+{
+    DWRFPCRange tPCRange;
+    
+    if ([self getPCRange:&tPCRange]==NO)
+        return NO;
     
-    return (inMachineInstructionAddress<(tLowPC+tHighPC));
+    return (inMachineInstructionAddress>=tPCRange.lowPC && inMachineInstructionAddress<tPCRange.highPC);
 }
 
 
@@ -635,6 +646,10 @@
 
 - (DWRFDebuggingInformationEntry *)entryWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer;
 
+- (NSArray<DWRFSubProgramEntry *> *)_allSubProgramEntries;
+
+- (void)_resolveSpecificationOfSubProgramEntry:(DWRFSubProgramEntry *)inSubProgramEntry;
+
 @end
 
 @implementation DWRFDebuggingInformationCompilationUnit
@@ -1339,12 +1354,22 @@
     return [_compileUnitEntry entryAtAddress:inAddress];
 }
 
+- (DWRFDebuggingInformationEntry *)entryAtOffset:(uint64_t)inOffset
+{
+    return [_compileUnitEntry entryAtAddress:_address+inOffset];
+}
+
 - (DWRFLineNumberProgram *)lineNumberProgram
 {
     return [_fileObject.section_debug_line lineNumberProgramAtOffset:_compileUnitEntry.lineNumberProgramOffset];
 }
 
 - (DWRFSubProgramEntry *)subProgramForMachineInstructionAddress:(uint64_t)inMachineInstructionAddress
+{
+    return [self subProgramForMachineInstructionAddress:inMachineInstructionAddress pcRange:NULL];
+}
+
+- (NSArray<DWRFSubProgramEntry *> *)_allSubProgramEntries
 {
     if (_allSubProgramEntities==nil)
     {
@@ -1371,7 +1396,52 @@
         _enumerateNodesRecursively(_compileUnitEntry,_allSubProgramEntities);
     }
     
-    for(DWRFSubProgramEntry * tEntry in _allSubProgramEntities)
+    return _allSubProgramEntities;
+}
+
+- (void)_resolveSpecificationOfSubProgramEntry:(DWRFSubProgramEntry *)inSubProgramEntry
+{
+    if (inSubProgramEntry.name!=nil)
+        return;
+    
+    NSNumber * tReference=[inSubProgramEntry objectForAttribute:DW_AT_specification];
+    
+    if (tReference==nil)
+        return;
+    
+    DWRFDebuggingInformationEntry * tReferencedEntry=[self entryAtOffset:[tReference unsignedIntegerValue]];
+    
+    if ([tReferencedEntry isKindOfClass:[DWRFSubProgramEntry class]]==YES)
+        inSubProgramEntry.referencedEntry=tReferencedEntry;
+}
+
+- (void)enumerateSubProgramsUsingBlock:(void (^)(DWRFSubProgramEntry * bSubProgramEntry,BOOL * bOutStop))inBlock
+{
+    if (inBlock==nil)
+        return;
+    
+    BOOL tStop=NO;
+    
+    for(DWRFSubProgramEntry * tSubProgramEntry in [self _allSubProgramEntries])
+    {
+        [self _resolveSpecificationOfSubProgramEntry:tSubProgramEntry];
+        
+        inBlock(tSubProgramEntry,&tStop);
+        
+        if (tStop==YES)
+            break;
+    }
+}
+
+- (DWRFSubProgramEntry *)subProgramForMachineInstructionAddress:(uint64_t)inMachineInstructionAddress pcRange:(DWRFPCRange *)outPCRange
+{
+    if (outPCRange!=NULL)
+    {
+        outPCRange->lowPC=0;
+        outPCRange->highPC=0;
+    }
+    
+    for(DWRFSubProgramEntry * tEntry in [self _allSubProgramEntries])
     {
         if (tEntry.tag==DW_TAG_subprogram)
         {
@@ -1383,13 +1453,20 @@
                     continue;
                 
                 // Look for inlined subroutines
-                        
+                
+                BOOL tHasInlinedSubroutines=NO;
+                
                 for(DWRFDebuggingInformationEntry * tChild in tSubProgramEntry.children)
                 {
                     if (tChild.tag==DW_TAG_inlined_subroutine)
                     {
+                        tHasInlinedSubroutines=YES;
+                        
                         if ([tChild pcRangeContainsMachineInstructionAddress:inMachineInstructionAddress]==YES)
                         {
+                            if (outPCRange!=NULL)
+                                [tChild getPCRange:outPCRange];
+                            
                             NSNumber * tNumber=[tChild objectForAttribute:DW_AT_abstract_origin];
                             
                             if (tNumber!=nil)
@@ -1409,22 +1486,12 @@
                     }
                 }
                 
-                if (tSubProgramEntry.name==nil)
-                {
-                    NSNumber * tReference=[tSubProgramEntry objectForAttribute:DW_AT_specification];
-                    
-                    if (tReference!=nil)
-                    {
-                        DWRFDebuggingInformationEntry * tReferencedEntry=[self entryAtAddress:_address+[tReference unsignedIntegerValue]];
-                        
-                        if ([tReferencedEntry isKindOfClass:[DWRFSubProgramEntry class]]==YES)
-                        {
-                            tSubProgramEntry.referencedEntry=tReferencedEntry;
-                        }
-                        
-                        
-                    }
-                }
+                // The range of the sub program is only uniform when it does not contain inlined subroutines
+                
+                if (tHasInlinedSubroutines==NO && outPCRange!=NULL)
+                    [tSubProgramEntry getPCRange:outPCRange];
+                
+                [self _resolveSpecificationOfSubProgramEntry:tSubProgramEntry];
                 
                 return tSubProgramEntry;
             }
@@ -1481,12 +1548,15 @@
     
     tBufferPtr=tBufferPtr+inOffset;
     
+    CUISymbolicationInterval tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageCompilationUnitParsing);
+    
     tCompilationUnit=[[DWRFDebuggingInformationCompilationUnit alloc] initWithBuffer:tBufferPtr fileObject:self.fileObject outBuffer:&tBufferPtr];
     
+    CUISymbolicationIntervalEnd(CUISymbolicationStageCompilationUnitParsing,tInterval);
+    
     if (tCompilationUnit!=nil)
         _compilationUnits[@(inOffset)]=tCompilationUnit;
     
-    
     return tCompilationUnit;
 }
 
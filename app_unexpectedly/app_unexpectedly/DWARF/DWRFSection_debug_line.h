@@ -23,14 +23,24 @@
 
     @property (readonly) uint64_t columnNumber;
 
+    @property (readonly,getter=isEndOfSequence) BOOL endOfSequence;    // First address after the sequence
+
 @end
 
 @interface DWRFLineNumberProgram : NSObject
 
 - (NSString *)fileNameAtIndex:(NSUInteger)inIndex;
 
+// File name prefixed with its include directory
+
+- (NSString *)filePathAtIndex:(NSUInteger)inIndex;
+
 - (DWRFLineNumberProgramLocation *)locationForMachineInstructionAddress:(uint64_t)inMachineInstructionAddress;
 
+// Rows of the matrix in the order they were emitted by the program
+
+- (NSArray<DWRFLineNumberProgramLocation *> *)allLocations;
+
 @end
 
 @interface DWRFSection_debug_line : NSObject
@@ -13,37 +13,7 @@
 
 #import "DWRFSection_debug_line.h"
 
-#include "LEB128.h"
-
-#import "DWRFObject.h"
-
-typedef NS_ENUM(uint8_t, DW_LNS)
-{
-    DW_LNS_extended_op = 0x00,
-    
-    DW_LNS_copy = 0x01,
-    DW_LNS_advance_pc = 0x02,
-    DW_LNS_advance_line = 0x03,
-    DW_LNS_set_file = 0x04,
-    DW_LNS_set_column = 0x05,
-    DW_LNS_negate_stmt = 0x06,
-    DW_LNS_set_basic_block = 0x07,
-    DW_LNS_const_add_pc = 0x08,
-    DW_LNS_fixed_advance_pc = 0x09,
-    DW_LNS_set_prologue_end = 0x0a,
-    DW_LNS_set_epilogue_begin = 0x0b,
-    DW_LNS_set_isa = 0x0c
-};
-
-typedef NS_ENUM(NSUInteger, DW_LNE)
-{
-    DW_LNE_end_sequence = 0x01,
-    DW_LNE_set_address = 0x02,
-    DW_LNE_define_file = 0x03,
-    DW_LNE_set_discriminator = 0x04,
-    DW_LNE_lo_user = 0x80,
-    DW_LNE_hi_user = 0xff
-};
+#include "DWRFLineProgramCore.h"
 
 @interface DWRFLineNumberProgramLocation ()
 
@@ -55,75 +25,11 @@ typedef NS_ENUM(NSUInteger, DW_LNE)
 
     @property uint64_t columnNumber;
 
-@end
-
-@implementation DWRFLineNumberProgramLocation
+    @property (getter=isEndOfSequence) BOOL endOfSequence;
 
 @end
 
-@interface DWRFLineNumberProgramStateMachine : NSObject
-
-    @property uint64_t address;
-
-    @property uint64_t op_index;
-
-    @property uint64_t file;
-
-    @property uint64_t line;
-
-    @property uint64_t column;
-
-    @property BOOL is_stmt;
-
-    @property BOOL basic_block;
-
-    @property BOOL end_sequence;
-
-    @property BOOL prologue_end;
-
-    @property BOOL epilogue_begin;
-
-    @property uint64_t xisa;
-
-    @property uint64_t discriminator;
-
-@end
-
-@implementation DWRFLineNumberProgramStateMachine
-
-- (instancetype)initWithStmt:(BOOL)inStmt;
-{
-    self=[super init];
-    
-    if (self!=nil)
-    {
-        _address=0;
-        
-        _op_index=0;
-        
-        _file=1;
-        
-        _line=1;
-        
-        _column=0;
-        
-        _is_stmt=inStmt;
-        
-        _basic_block=NO;
-        
-        _end_sequence=NO;
-        
-        _prologue_end=NO;
-        
-        _epilogue_begin=NO;
-        
-        _xisa=0;
-        
-        _discriminator=0;
-    }
-    
-    return self;
-}
+@implementation DWRFLineNumberProgramLocation
 
 @end
 
@@ -145,227 +51,134 @@ typedef NS_ENUM(NSUInteger, DW_LNE)
 @end
 
 
+@interface DWRFLineNumberProgram ()
+{
+    NSData * _data;
+    
+    DWRFLineProgramHeader _header;
+    
+    NSMutableArray<NSString *> * _includeDirectories;
+    
+    NSMutableArray<DWRFLineNumberProgramHeaderFileNameEntry *> * _fileEntries;
+    
+    NSMutableArray * _locationsAddresses;
+    
+    NSMutableDictionary<NSNumber *,DWRFLineNumberProgramLocation *> * _locationsRegistry;
+}
 
++ (DWRFLineNumberProgramHeaderFileNameEntry *)fileNameEntryWithEntry:(const DWRFLineProgramFileEntry *)inEntry;
 
-@interface DWRFLineNumberProgramHeader : DWRFObject
-
-    @property uint64_t unitLength;    // 4 bytes DWARF-32 / 12 bytes DWARF-64
-    @property uint16_t version;
-
-    @property uint64_t headerLength;  // 4 bytes DWARF-32 / 8 bytes DWARF-64
-
-    @property uint8_t minimumInstructionLength;
-
-    @property uint8_t maximumOperationsPerInstruction;
-
-    @property uint8_t defaultIsStmt;
-
-    @property int8_t lineBase;
-
-    @property uint8_t lineRange;
-
-    @property int8_t opcodeBase;
-
-    @property uint8_t * standardOpcodeLengths;    // opcodeBase count
-
-    @property NSMutableArray * includeDirectories;
-
-    @property NSMutableArray * fileEntries;
+- (instancetype)initWithData:(NSData *)inData offset:(NSUInteger)inOffset;
 
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer;
+- (DWRFLineNumberProgramLocation *)locationFromRegisters:(const DWRFLineProgramRegisters *)inRegisters;
 
 @end
 
-@implementation DWRFLineNumberProgramHeader
+@implementation DWRFLineNumberProgram
 
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer outBuffer:(uint8_t **)outBuffer
++ (DWRFLineNumberProgramHeaderFileNameEntry *)fileNameEntryWithEntry:(const DWRFLineProgramFileEntry *)inEntry
 {
-    if (inBuffer==NULL)
+    NSString * tString=[NSString stringWithCString:inEntry->name encoding:NSUTF8StringEncoding];
+    
+    if (tString==nil)
+        return nil;
+    
+    DWRFLineNumberProgramHeaderFileNameEntry * tEntry=[DWRFLineNumberProgramHeaderFileNameEntry new];
+    
+    tEntry.filePath=tString;
+    tEntry.directoryIndex=inEntry->directoryIndex;
+    tEntry.lastModificationDate=inEntry->lastModificationDate;
+    tEntry.fileSize=inEntry->fileSize;
+    
+    return tEntry;
+}
+
+- (instancetype)initWithData:(NSData *)inData offset:(NSUInteger)inOffset
+{
+    if (inData==nil)
         return nil;
     
     self=[super init];
     
     if (self!=nil)
     {
-        uint32_t tUnsignedInteger;
-        
-        tUnsignedInteger=*((uint32_t *)inBuffer);
-        inBuffer+=sizeof(uint32_t);
-        
-        if (tUnsignedInteger==0xffffffff)
-        {
-            self.dwarfFormat=DWRF64Format;
-            
-            _unitLength=*((uint64_t *)inBuffer);
-            inBuffer+=sizeof(uint64_t);
-        }
-        else
-        {
-            _unitLength=tUnsignedInteger;
-        }
+        _data=inData;
         
-        _version=*((uint16_t *)inBuffer);
-        inBuffer+=sizeof(uint16_t);
+        const uint8_t * tBytes=(const uint8_t *)_data.bytes;
         
-        if (self.dwarfFormat==DWRF64Format)
+        if (DWRFLineProgramHeaderRead(tBytes,_data.length,inOffset,&_header)==NO)
         {
-            _headerLength=*((uint64_t *)inBuffer);
-            inBuffer+=sizeof(uint64_t);
-            
-            _headerLength+=18;
-        }
-        else
-        {
-            _headerLength=*((uint32_t *)inBuffer);
-            inBuffer+=sizeof(uint32_t);
+            NSLog(@"Error unarchiving Line Number Program Header");
             
-            _headerLength+=10;
-        }
-        
-        
-        
-        _minimumInstructionLength=*((uint8_t *)inBuffer);
-        inBuffer+=sizeof(uint8_t);
-        
-        
-        if (_version>=4)
-        {
-            _maximumOperationsPerInstruction=*((uint8_t *)inBuffer);
-            inBuffer+=sizeof(uint8_t);
-        }
-        else
-        {
-            _maximumOperationsPerInstruction=1;
+            return nil;
         }
         
-        _defaultIsStmt=*((uint8_t *)inBuffer);
-        inBuffer+=sizeof(uint8_t);
-        
-        _lineBase=*((int8_t *)inBuffer);
-        inBuffer+=sizeof(int8_t);
-        
-        _lineRange=*((uint8_t *)inBuffer);
-        inBuffer+=sizeof(uint8_t);
-        
-        _opcodeBase=*((int8_t *)inBuffer);
-        inBuffer+=sizeof(int8_t);
-        
-        
-        _standardOpcodeLengths=malloc(_opcodeBase*sizeof(uint8_t));
-        
-        for(size_t tIndex=0;tIndex<(_opcodeBase-1);tIndex++)
-            _standardOpcodeLengths[tIndex]=DWRF_readLEB128(inBuffer, &inBuffer);
-        
         _includeDirectories=[NSMutableArray array];
         
-        while((*inBuffer)!=0)
+        NSUInteger tOffset=_header.includeDirectoriesOffset;
+        const char * tPath;
+        
+        while (DWRFLineProgramNextIncludeDirectory(tBytes,&_header,&tOffset,&tPath)==YES)
         {
-            size_t tLength=strlen((char *)inBuffer);
+            NSString * tString=[NSString stringWithCString:tPath encoding:NSUTF8StringEncoding];
             
-            NSString * tString=[NSString stringWithCString:(char *)inBuffer encoding:NSUTF8StringEncoding];
+            // Keep the indexes right
             
-            if (tString!=nil)
-                [_includeDirectories addObject:tString];
-            
-            inBuffer+=(tLength+1);
+            [_includeDirectories addObject:(tString!=nil) ? tString : @""];
         }
         
-        inBuffer++;
-        
-        
-        
         _fileEntries=[NSMutableArray array];
         
-        while((*inBuffer)!=0)
+        tOffset=_header.fileNamesOffset;
+        DWRFLineProgramFileEntry tFileEntry;
+        
+        while (DWRFLineProgramNextFileEntry(tBytes,&_header,&tOffset,&tFileEntry)==YES)
         {
-            DWRFLineNumberProgramHeaderFileNameEntry * tEntry=[DWRFLineNumberProgramHeaderFileNameEntry new];
-            
-            size_t tLength=strlen((char *)inBuffer);
-            
-            NSString * tString=[NSString stringWithCString:(char *)inBuffer encoding:NSUTF8StringEncoding];
+            DWRFLineNumberProgramHeaderFileNameEntry * tEntry=[DWRFLineNumberProgram fileNameEntryWithEntry:&tFileEntry];
             
-            if (tString==nil)
+            if (tEntry==nil)
+            {
+                NSLog(@"Error unarchiving Line Number Program Header");
+                
                 return nil;
-            
-            inBuffer+=(tLength+1);
-            
-            tEntry.filePath=tString;
-            tEntry.directoryIndex=DWRF_readULEB128(inBuffer, &inBuffer);
-            tEntry.lastModificationDate=DWRF_readULEB128(inBuffer, &inBuffer);
-            tEntry.fileSize=DWRF_readULEB128(inBuffer, &inBuffer);
+            }
             
             [_fileEntries addObject:tEntry];
         }
-        
-        inBuffer++;
     }
     
-    if (outBuffer!=NULL)
-        *outBuffer=inBuffer;
-    
     return self;
 }
 
-@end
-
+#pragma mark -
 
-@interface DWRFLineNumberProgram ()
+- (NSString *)fileNameAtIndex:(NSUInteger)inIndex
 {
-    DWRFLineNumberProgramHeader * _header;
-    
-    uint8_t * _programBufferStart;
-    uint8_t * _programBufferEnd;
+    if (inIndex==0 || inIndex>_fileEntries.count)
+        return nil;
     
-    NSMutableArray * _locationsAddresses;
+    DWRFLineNumberProgramHeaderFileNameEntry * tEntry=_fileEntries[inIndex-1];
     
-    NSMutableDictionary<NSNumber *,DWRFLineNumberProgramLocation *> * _locationsRegistry;
+    return tEntry.filePath;
 }
 
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer;
-
-- (DWRFLineNumberProgramLocation *)locationFromStateMachine:(DWRFLineNumberProgramStateMachine *)inStateMachine;
-
-@end
-
-@implementation DWRFLineNumberProgram
-
-- (instancetype)initWithBuffer:(uint8_t *)inBuffer
+- (NSString *)filePathAtIndex:(NSUInteger)inIndex
 {
-    if (inBuffer==NULL)
+    if (inIndex==0 || inIndex>_fileEntries.count)
         return nil;
     
-    self=[super init];
+    DWRFLineNumberProgramHeaderFileNameEntry * tEntry=_fileEntries[inIndex-1];
     
-    if (self!=nil)
+    NSString * tFileName=tEntry.filePath;
+    
+    if (tEntry.directoryIndex>0 && tEntry.directoryIndex<=_includeDirectories.count)
     {
-        uint8_t * tBuffer=inBuffer;
+        NSString * tDirectoryPath=_includeDirectories[tEntry.directoryIndex-1];
         
-        _header=[[DWRFLineNumberProgramHeader alloc] initWithBuffer:tBuffer outBuffer:&tBuffer];
-        
-        if (_header==nil)
-        {
-            NSLog(@"Error unarchiving Line Number Program Header");
-            
-            return nil;
-        }
-        
-        _programBufferStart=inBuffer+_header.headerLength;
-        _programBufferEnd=inBuffer+_header.unitLength;
+        tFileName=[tDirectoryPath stringByAppendingPathComponent:tFileName];
     }
     
-    return self;
-}
-
-#pragma mark -
-
-- (NSString *)fileNameAtIndex:(NSUInteger)inIndex
-{
-    if (inIndex>_header.fileEntries.count)
-        return nil;
-    
-    DWRFLineNumberProgramHeaderFileNameEntry * tEntry=_header.fileEntries[inIndex-1];
-    
-    return tEntry.filePath;
+    return tFileName;
 }
 
 - (BOOL)runProgram
@@ -373,261 +186,45 @@ typedef NS_ENUM(NSUInteger, DW_LNE)
     _locationsAddresses=[NSMutableArray array];
     _locationsRegistry=[NSMutableDictionary dictionary];
     
-    DWRFLineNumberProgramStateMachine * tStateMachine=[[DWRFLineNumberProgramStateMachine alloc] initWithStmt:_header.defaultIsStmt];
+    DWRFLineProgramStateMachine tStateMachine=DWRFLineProgramStateMachineMake((const uint8_t *)_data.bytes,&_header);
+    DWRFLineProgramStep tStep;
     
-    BOOL tDone=NO;
-    
-    uint8_t * tBuffer=_programBufferStart;
-    
-    while (tBuffer<_programBufferEnd && tDone==NO)
+    while ((tStep=DWRFLineProgramStateMachineNext(&tStateMachine))!=DWRFLineProgramStepEnd)
     {
-        uint8_t tOpcode=*tBuffer;
-        tBuffer+=sizeof(uint8_t);
-        
-        if (tOpcode>=_header.opcodeBase)
-        {
-            // Special Opcode
-            
-            tOpcode-=_header.opcodeBase;
-            
-            uint8_t tOperationAdvance=tOpcode/_header.lineRange;
-            
-            tStateMachine.line+=_header.lineBase+ (tOpcode % _header.lineRange);
-            
-            tStateMachine.address+=_header.minimumInstructionLength*((tStateMachine.op_index+tOperationAdvance)/_header.maximumOperationsPerInstruction);
-            
-            tStateMachine.op_index=(tStateMachine.op_index+tOperationAdvance)%_header.maximumOperationsPerInstruction;
-            
-            tStateMachine.basic_block=NO;
-            tStateMachine.prologue_end=NO;
-            tStateMachine.epilogue_begin=NO;
-            
-            tStateMachine.discriminator=0;
-            
-            // Add a row to the matrix
-            
-            DWRFLineNumberProgramLocation * tLocation=[self locationFromStateMachine:tStateMachine];
-            
-            NSNumber * tKey=@(tStateMachine.address);
-            
-            [_locationsAddresses addObject:tKey];
-            
-            _locationsRegistry[tKey]=tLocation;
-
-            continue;
-        }
-        
-        if (tOpcode!=DW_LNS_extended_op)
+        switch(tStep)
         {
-            // Standard Opcode
-            
-            switch(tOpcode)
+            case DWRFLineProgramStepRow:
             {
-                case DW_LNS_copy:
-                {
-                    DWRFLineNumberProgramLocation * tLocation=[self locationFromStateMachine:tStateMachine];
-                    
-                    NSNumber * tKey=@(tStateMachine.address);
-                    
-                    [_locationsAddresses addObject:tKey];
-                    
-                    _locationsRegistry[tKey]=tLocation;
-                    
-                    tStateMachine.discriminator=0;
-                    
-                    tStateMachine.basic_block=NO;
-                    tStateMachine.prologue_end=NO;
-                    tStateMachine.epilogue_begin=NO;
-                    
-                    break;
-                }
-                case DW_LNS_advance_pc:
-                {
-                    uint64_t tOperationAdvance=DWRF_readULEB128(tBuffer, &tBuffer);
-                    
-                    tStateMachine.address+=_header.minimumInstructionLength*((tStateMachine.op_index+tOperationAdvance)/_header.maximumOperationsPerInstruction);
-                    
-                    tStateMachine.op_index=(tStateMachine.op_index+tOperationAdvance)%_header.maximumOperationsPerInstruction;
-                    
-                    break;
-                    
-                }
-                    
-                case DW_LNS_advance_line:
-                    
-                    tStateMachine.line+=DWRF_readLEB128(tBuffer, &tBuffer);
-                    
-                    break;
-                    
-                    
-                case DW_LNS_set_file:
-                    
-                    tStateMachine.file=DWRF_readULEB128(tBuffer, &tBuffer);
-                    
-                    break;
-                    
-                case DW_LNS_set_column:
-                    
-                    tStateMachine.column=DWRF_readULEB128(tBuffer, &tBuffer);
-                    
-                    break;
-                    
-                case DW_LNS_negate_stmt:
-                    
-                    tStateMachine.is_stmt=!tStateMachine.is_stmt;
-                    
-                    break;
-                    
-                case DW_LNS_set_basic_block:
-                    
-                    tStateMachine.basic_block=YES;
-                    
-                    break;
-                    
-                case DW_LNS_const_add_pc:
-                {
-                    uint64_t tOperationAdvance=(255 - _header.opcodeBase) / _header.lineRange;
-                    
-                    tStateMachine.address+=_header.minimumInstructionLength*((tStateMachine.op_index+tOperationAdvance)/_header.maximumOperationsPerInstruction);
-                    
-                    tStateMachine.op_index=(tStateMachine.op_index+tOperationAdvance)%_header.maximumOperationsPerInstruction;
-                    
-                    break;
-                }
-                case DW_LNS_fixed_advance_pc:
-                {
-                    uint16_t tAdvance=*((uint16_t *)tBuffer);
-                    tBuffer+=sizeof(uint16_t);
-                    
-                    
-                    tStateMachine.address+=tAdvance;
-                    
-                    tStateMachine.op_index=0;
-                    
-                    break;
-                }
-                case DW_LNS_set_prologue_end:
-                    
-                    tStateMachine.prologue_end=YES;
-                    
-                    break;
-                    
-                case DW_LNS_set_epilogue_begin:
-                    
-                    tStateMachine.epilogue_begin=YES;
-                    
-                    break;
-                    
-                    
-                case DW_LNS_set_isa:
-                    
-                    tStateMachine.xisa=DWRF_readULEB128(tBuffer, &tBuffer);
-                    
-                    break;
-                    
-                default:
-                {
-                    // Unsupported standard opcode
-                    
-                    uint8_t tArgumentsCount=_header.standardOpcodeLengths[tOpcode-1];
-                    
-                    while(tArgumentsCount>0)
-                    {
-                        DWRF_readULEB128(tBuffer, &tBuffer);
-                        
-                        tArgumentsCount--;
-                    }
-                    
-                    break;
-                }
-            }
-            
-            continue;
-            
-        }
-        
-        // Extended Opcode
-        
-        uint64_t tLength=DWRF_readULEB128(tBuffer, &tBuffer);
-        
-        if (tLength==0)
-        {
-            NSLog(@"Unexpected 0 value for extended opcode length");
-        }
-        
-        uint8_t tExtendedOpcode=*tBuffer;
-        tBuffer+=sizeof(uint8_t);
-        
-        tLength-=1;
-        
-        switch(tExtendedOpcode)
-        {
-            case DW_LNE_end_sequence:
-            {
-                tStateMachine.end_sequence=YES;
-                
                 // Add a row to the matrix
                 
-                DWRFLineNumberProgramLocation * tLocation=[self locationFromStateMachine:tStateMachine];
+                DWRFLineNumberProgramLocation * tLocation=[self locationFromRegisters:&tStateMachine.registers];
                 
-                NSNumber * tKey=@(tStateMachine.address);
+                NSNumber * tKey=@(tStateMachine.registers.address);
                 
                 [_locationsAddresses addObject:tKey];
                 
                 _locationsRegistry[tKey]=tLocation;
                 
-                tStateMachine=[[DWRFLineNumberProgramStateMachine alloc] initWithStmt:_header.defaultIsStmt];
-                
                 break;
             }
                 
-            case DW_LNE_set_address:
+            case DWRFLineProgramStepDefineFile:
             {
-                if (tLength==4) // 32 bits
-                {
-                    tStateMachine.address=*((uint32_t *)tBuffer);
-                    tBuffer+=sizeof(uint32_t);
-                }
-                else    // 64 bits
-                {
-                    tStateMachine.address=*((uint64_t *)tBuffer);
-                    tBuffer+=sizeof(uint64_t);
-                }
+                DWRFLineNumberProgramHeaderFileNameEntry * tEntry=[DWRFLineNumberProgram fileNameEntryWithEntry:&tStateMachine.definedFile];
                 
-                tStateMachine.op_index=0;
+                if (tEntry!=nil)
+                    [_fileEntries addObject:tEntry];
                 
                 break;
             }
-            case DW_LNE_define_file:
-            {
-                DWRFLineNumberProgramHeaderFileNameEntry * tFileNameEntry=[DWRFLineNumberProgramHeaderFileNameEntry new];
-                
-                tFileNameEntry.filePath=[NSString stringWithUTF8String:(const char *)tBuffer];
-                
-                tFileNameEntry.directoryIndex=DWRF_readULEB128(tBuffer, &tBuffer);
-                
-                tFileNameEntry.lastModificationDate=DWRF_readULEB128(tBuffer, &tBuffer);
-                
-                tFileNameEntry.fileSize=DWRF_readULEB128(tBuffer, &tBuffer);
-                
-                
-                [_header.fileEntries addObject:tFileNameEntry];
-                
-                break;
-            }
-            case DW_LNE_set_discriminator:
-                
-                tStateMachine.discriminator=DWRF_readULEB128(tBuffer, &tBuffer);
-                
-                break;
                 
             default:
                 
-                // Unsupported Extended opcode
+                // Keep the rows found so far
                 
-                tBuffer+=tLength;
+                NSLog(@"Malformed Line Number Program");
                 
-                break;
+                return YES;
         }
     }
     
@@ -671,31 +268,31 @@ typedef NS_ENUM(NSUInteger, DW_LNE)
     return tLocation;
 }
 
+- (NSArray<DWRFLineNumberProgramLocation *> *)allLocations
+{
+    if (_locationsAddresses==nil)
+    {
+        if ([self runProgram]==NO)
+            return nil;
+    }
+    
+    // When several rows share the same address, the last one wins (as in -locationForMachineInstructionAddress:)
+    
+    return [_locationsRegistry objectsForKeys:_locationsAddresses notFoundMarker:[NSNull null]];
+}
+
 
 
-- (DWRFLineNumberProgramLocation *)locationFromStateMachine:(DWRFLineNumberProgramStateMachine *)inStateMachine
+- (DWRFLineNumberProgramLocation *)locationFromRegisters:(const DWRFLineProgramRegisters *)inRegisters
 {
     DWRFLineNumberProgramLocation * tLocation=[DWRFLineNumberProgramLocation new];
     
-    tLocation.machineInstructionAddress=inStateMachine.address;
-    
-    DWRFLineNumberProgramHeaderFileNameEntry * tEntry=_header.fileEntries[inStateMachine.file-1];
-    
-    NSString * tFileName=tEntry.filePath;
-    
-    if (tEntry.directoryIndex==0)
-    {
-    }
-    else
-    {
-        NSString * tDirectoryPath=_header.includeDirectories[tEntry.directoryIndex-1];
-        
-        tFileName=[tDirectoryPath stringByAppendingPathComponent:tFileName];
-    }
+    tLocation.machineInstructionAddress=inRegisters->address;
     
-    tLocation.fileName=[tFileName copy];
-    tLocation.lineNumber=inStateMachine.line;
-    tLocation.columnNumber=inStateMachine.column;
+    tLocation.fileName=[[self filePathAtIndex:(NSUInteger)inRegisters->file] copy];
+    tLocation.lineNumber=inRegisters->line;
+    tLocation.columnNumber=inRegisters->column;
+    tLocation.endOfSequence=inRegisters->endSequence;
     
     return tLocation;
 }
@@ -739,9 +336,7 @@ typedef NS_ENUM(NSUInteger, DW_LNE)
     if (tLineNumberProgram!=nil)
         return tLineNumberProgram;
     
-    uint8_t * tBufferPtr=(uint8_t *)_cachedData.bytes;
-    
-    tLineNumberProgram=[[DWRFLineNumberProgram alloc] initWithBuffer:tBufferPtr+inOffset /*fileObject:self.fileObject outBuffer:&tBufferPtr*/];
+    tLineNumberProgram=[[DWRFLineNumberProgram alloc] initWithData:_cachedData offset:(NSUInteger)inOffset];
     
     if (tLineNumberProgram!=nil)
         _cachedLineNumberPrograms[@(inOffset)]=tLineNumberProgram;
@@ -29,7 +29,7 @@ uint64_t DWRF_readULEB128(uint8_t * inBufferPtr,uint8_t ** outBufferPtr)
             break;
         }
         
-        tResult += (tByte & 0x7f) << tShift;
+        tResult += (uint64_t)(tByte & 0x7f) << tShift;
         tShift += 7;
     }
     
@@ -52,14 +52,14 @@ int64_t DWRF_readLEB128(uint8_t * inBufferPtr,uint8_t ** outBufferPtr)
         if (tByte < 0x80)
         {
             if (tByte & 0x40)
-                tResult -= (0x80 - tByte) << tShift;
+                tResult -= (int64_t)(0x80 - tByte) << tShift;
             else
-                tResult += (tByte & 0x3f) << tShift;
+                tResult += (int64_t)(tByte & 0x3f) << tShift;
 
             break;
         }
     
-        tResult += (tByte & 0x7f) << tShift;
+        tResult += (uint64_t)(tByte & 0x7f) << tShift;
         tShift += 7;
     }
     
@@ -68,3 +68,62 @@ int64_t DWRF_readLEB128(uint8_t * inBufferPtr,uint8_t ** outBufferPtr)
     
     return tResult;
 }
+
+const uint8_t * DWRF_readBoundedULEB128(const uint8_t * inBufferPtr,const uint8_t * inBufferEndPtr,uint64_t * outValue)
+{
+    uint64_t tResult=0;
+    unsigned int tShift=0;
+    
+    while (inBufferPtr<inBufferEndPtr)
+    {
+        uint8_t tByte=*inBufferPtr;
+        inBufferPtr++;
+        
+        if (tShift<64)
+            tResult|=(uint64_t)(tByte & 0x7f) << tShift;
+        
+        tShift+=7;
+        
+        if (tByte < 0x80)
+        {
+            if (outValue!=NULL)
+                *outValue=tResult;
+            
+            return inBufferPtr;
+        }
+    }
+    
+    return NULL;
+}
+
+const uint8_t * DWRF_readBoundedLEB128(const uint8_t * inBufferPtr,const uint8_t * inBufferEndPtr,int64_t * outValue)
+{
+    uint64_t tResult=0;
+    unsigned int tShift=0;
+    
+    while (inBufferPtr<inBufferEndPtr)
+    {
+        uint8_t tByte=*inBufferPtr;
+        inBufferPtr++;
+        
+        if (tShift<64)
+            tResult|=(uint64_t)(tByte & 0x7f) << tShift;
+        
+        tShift+=7;
+        
+        if (tByte < 0x80)
+        {
+            // Sign extension
+            
+            if (tShift<64 && (tByte & 0x40)!=0)
+                tResult|=~(uint64_t)0 << tShift;
+            
+            if (outValue!=NULL)
+                *outValue=(int64_t)tResult;
+            
+            return inBufferPtr;
+        }
+    }
+    
+    return NULL;
+}
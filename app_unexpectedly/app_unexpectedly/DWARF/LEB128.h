@@ -21,4 +21,11 @@ uint64_t DWRF_readULEB128(uint8_t * inBufferPtr,uint8_t ** outBufferPtr);
 
 int64_t DWRF_readLEB128(uint8_t * inBufferPtr,uint8_t ** outBufferPtr);
 
+// Bounds checked versions: the returned pointer is the one after the value, NULL if the value goes beyond inBufferEndPtr.
+// The bits beyond the 64th one are ignored.
+
+const uint8_t * DWRF_readBoundedULEB128(const uint8_t * inBufferPtr,const uint8_t * inBufferEndPtr,uint64_t * outValue);
+
+const uint8_t * DWRF_readBoundedLEB128(const uint8_t * inBufferPtr,const uint8_t * inBufferEndPtr,int64_t * outValue);
+
 #endif
@@ -34,7 +34,9 @@
 {
 	if (inPath!=nil)
 	{
-		_cachedData=[NSData dataWithContentsOfFile:inPath];
+		// Mapped so that the pages of a large dSYM file can be reclaimed by the system
+		
+		_cachedData=[NSData dataWithContentsOfFile:inPath options:NSDataReadingMappedIfSafe error:NULL];
 	
 		if (_cachedData!=nil)
 			return [self initWithBytes:_cachedData.bytes length:_cachedData.length swap:NO];
@@ -47,7 +49,7 @@
 {
 	if (inURL!=nil)
 	{
-		NSData * _cachedData=[NSData dataWithContentsOfURL:inURL];
+		_cachedData=[NSData dataWithContentsOfURL:inURL options:NSDataReadingMappedIfSafe error:NULL];
 		
 		if (_cachedData!=nil)
 			return [self initWithBytes:_cachedData.bytes length:_cachedData.length swap:NO];
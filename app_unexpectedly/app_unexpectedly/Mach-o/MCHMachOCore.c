@@ -0,0 +1,157 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MCHMachOCore.h"
+
+#include <string.h>
+
+#define MCHMachHeaderSize       28      // sizeof(struct mach_header)
+#define MCHMachHeader64Size     32      // sizeof(struct mach_header_64)
+
+#define MCHLoadCommandSize      8       // sizeof(struct load_command)
+#define MCHUUIDCommandSize      24      // sizeof(struct uuid_command)
+
+NS_INLINE uint32_t MCHReadUInt32(const uint8_t * inBytes,BOOL inSwap)
+{
+    uint32_t tValue;
+    
+    memcpy(&tValue,inBytes,sizeof(uint32_t));
+    
+    return (inSwap==YES) ? __builtin_bswap32(tValue) : tValue;
+}
+
+BOOL MCHMachHeaderIdentify(const uint8_t * inBytes,NSUInteger inLength,BOOL * outIs64Bit,BOOL * outSwap)
+{
+    if (inBytes==NULL || inLength<sizeof(uint32_t))
+        return NO;
+    
+    BOOL tIs64Bit;
+    BOOL tSwap;
+    
+    switch(MCHReadUInt32(inBytes,NO))
+    {
+        case MH_MAGIC:
+            
+            tIs64Bit=NO;
+            tSwap=NO;
+            break;
+            
+        case MH_CIGAM:
+            
+            tIs64Bit=NO;
+            tSwap=YES;
+            break;
+            
+        case MH_MAGIC_64:
+            
+            tIs64Bit=YES;
+            tSwap=NO;
+            break;
+            
+        case MH_CIGAM_64:
+            
+            tIs64Bit=YES;
+            tSwap=YES;
+            break;
+            
+        default:
+            
+            return NO;
+    }
+    
+    if (outIs64Bit!=NULL)
+        *outIs64Bit=tIs64Bit;
+    
+    if (outSwap!=NULL)
+        *outSwap=tSwap;
+    
+    return YES;
+}
+
+BOOL MCHMachHeaderRead(const uint8_t * inBytes,NSUInteger inLength,BOOL inIs64Bit,BOOL inSwap,MCHMachHeader * outHeader)
+{
+    NSUInteger tHeaderSize=(inIs64Bit==YES) ? MCHMachHeader64Size : MCHMachHeaderSize;
+    
+    if (inBytes==NULL || outHeader==NULL || inLength<tHeaderSize)
+        return NO;
+    
+    // magic, cputype, cpusubtype, filetype, ncmds, sizeofcmds, flags (, reserved)
+    
+    outHeader->cpuType=(int32_t)MCHReadUInt32(inBytes+4,inSwap);
+    outHeader->cpuSubType=(int32_t)MCHReadUInt32(inBytes+8,inSwap);
+    outHeader->fileType=MCHReadUInt32(inBytes+12,inSwap);
+    outHeader->numberOfLoadCommands=MCHReadUInt32(inBytes+16,inSwap);
+    outHeader->sizeOfLoadCommands=MCHReadUInt32(inBytes+20,inSwap);
+    outHeader->flags=MCHReadUInt32(inBytes+24,inSwap);
+    
+    outHeader->is64Bit=inIs64Bit;
+    outHeader->swap=inSwap;
+    
+    outHeader->headerSize=tHeaderSize;
+    
+    return YES;
+}
+
+MCHLoadCommandsIterator MCHLoadCommandsIteratorMake(const uint8_t * inBytes,NSUInteger inLength,const MCHMachHeader * inHeader)
+{
+    MCHLoadCommandsIterator tIterator={inBytes,inLength,inHeader->swap,inHeader->numberOfLoadCommands,inHeader->headerSize,NO};
+    
+    return tIterator;
+}
+
+BOOL MCHLoadCommandsIteratorNext(MCHLoadCommandsIterator * ioIterator,MCHLoadCommandInfo * outLoadCommand)
+{
+    if (ioIterator->remainingCount==0 || ioIterator->malformed==YES)
+        return NO;
+    
+    NSUInteger tLocation=ioIterator->location;
+    
+    if (tLocation>ioIterator->length || (ioIterator->length-tLocation)<MCHLoadCommandSize)
+    {
+        ioIterator->malformed=YES;
+        
+        return NO;
+    }
+    
+    uint32_t tType=MCHReadUInt32(ioIterator->bytes+tLocation,ioIterator->swap);
+    uint32_t tSize=MCHReadUInt32(ioIterator->bytes+tLocation+4,ioIterator->swap);
+    
+    if (tSize<MCHLoadCommandSize || tSize>(ioIterator->length-tLocation))
+    {
+        ioIterator->malformed=YES;
+        
+        return NO;
+    }
+    
+    if (outLoadCommand!=NULL)
+    {
+        outLoadCommand->type=tType;
+        outLoadCommand->size=tSize;
+        outLoadCommand->offset=tLocation;
+    }
+    
+    ioIterator->location=tLocation+tSize;
+    ioIterator->remainingCount--;
+    
+    return YES;
+}
+
+BOOL MCHUUIDLoadCommandRead(const uint8_t * inBytes,NSUInteger inLength,uint8_t outUUID[16])
+{
+    if (inBytes==NULL || inLength<MCHUUIDCommandSize)
+        return NO;
+    
+    memcpy(outUUID,inBytes+MCHLoadCommandSize,16);
+    
+    return YES;
+}
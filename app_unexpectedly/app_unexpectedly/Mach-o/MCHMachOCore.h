@@ -0,0 +1,101 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MCHMachOCore_h
+#define MCHMachOCore_h
+
+#include "CUIPortableTypes.h"
+
+#if defined(__APPLE__)
+
+#include <mach-o/loader.h>
+
+#else
+
+#define MH_MAGIC        0xfeedface
+#define MH_CIGAM        0xcefaedfe
+#define MH_MAGIC_64     0xfeedfacf
+#define MH_CIGAM_64     0xcffaedfe
+
+#define LC_SEGMENT      0x1
+#define LC_SEGMENT_64   0x19
+#define LC_UUID         0x1b
+
+#endif
+
+// Parsing of the Mach-O header and load commands without creating intermediate objects.
+// The bytes do not need to be aligned and are never read beyond the length.
+
+typedef struct
+{
+    int32_t cpuType;
+    int32_t cpuSubType;
+    
+    uint32_t fileType;
+    
+    uint32_t numberOfLoadCommands;
+    uint32_t sizeOfLoadCommands;
+    
+    uint32_t flags;
+    
+    BOOL is64Bit;
+    BOOL swap;
+    
+    NSUInteger headerSize;      // Offset of the first load command
+    
+} MCHMachHeader;
+
+typedef struct
+{
+    uint32_t type;
+    uint32_t size;
+    
+    NSUInteger offset;
+    
+} MCHLoadCommandInfo;
+
+typedef struct
+{
+    const uint8_t * bytes;
+    
+    NSUInteger length;
+    
+    BOOL swap;
+    
+    uint32_t remainingCount;
+    
+    NSUInteger location;
+    
+    BOOL malformed;             // Set when a load command is too small or goes beyond the end of the bytes
+    
+} MCHLoadCommandsIterator;
+
+// NO is returned if the bytes do not start with a Mach-O magic number
+
+BOOL MCHMachHeaderIdentify(const uint8_t * inBytes,NSUInteger inLength,BOOL * outIs64Bit,BOOL * outSwap);
+
+// NO is returned if the bytes are too small for the header
+
+BOOL MCHMachHeaderRead(const uint8_t * inBytes,NSUInteger inLength,BOOL inIs64Bit,BOOL inSwap,MCHMachHeader * outHeader);
+
+MCHLoadCommandsIterator MCHLoadCommandsIteratorMake(const uint8_t * inBytes,NSUInteger inLength,const MCHMachHeader * inHeader);
+
+// NO is returned after the last load command or when the load commands are malformed
+
+BOOL MCHLoadCommandsIteratorNext(MCHLoadCommandsIterator * ioIterator,MCHLoadCommandInfo * outLoadCommand);
+
+// The bytes are the ones of the load command. NO is returned if they are too small for a uuid_command
+
+BOOL MCHUUIDLoadCommandRead(const uint8_t * inBytes,NSUInteger inLength,uint8_t outUUID[16]);
+
+#endif
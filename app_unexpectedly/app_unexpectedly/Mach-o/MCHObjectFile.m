@@ -15,6 +15,8 @@
 
 #import "MCHSegmentLoadCommand.h"
 
+#include "MCHMachOCore.h"
+
 @interface MCHObjectFile ()
 {
 	NSMutableArray *_loadCommandsArray;
@@ -38,105 +40,28 @@
 	
 	if (self!=nil)
 	{
-		NSUInteger tFutureBufferOffset=0;
-		
-		uint32_t tLoadCommandsNumber;
-		//uint32_t tLoadCommandsTotalSize;
+		MCHMachHeader tHeader;
 		
-		if (inArchitecture==MCHArchitecture32)
+		if (inArchitecture!=MCHArchitecture32 && inArchitecture!=MCHArchitecture64)
 		{
-			if (self.bufferSize<sizeof(struct mach_header))
-			{
-				// Buffer not big enough
-				
-				return nil;
-			}
-			
-			struct mach_header * tMach32HeaderPtr=(struct mach_header *)self.buffer;
-			
-			_cpuType=tMach32HeaderPtr->cputype;
-			
-			if (self.shouldSwap==YES)
-				_cpuType=OSSwapBigToHostInt32(_cpuType);
-			
-			_cpuSubType=tMach32HeaderPtr->cpusubtype;
-			
-			if (self.shouldSwap==YES)
-				_cpuSubType=OSSwapBigToHostInt32(_cpuSubType);
-			
-			_fileType=tMach32HeaderPtr->filetype;
-			
-			if (self.shouldSwap==YES)
-				_fileType=OSSwapBigToHostInt32(_fileType);
-			
-			_flags=tMach32HeaderPtr->flags;
-			
-			if (self.shouldSwap==YES)
-				_flags=OSSwapBigToHostInt32(_flags);
-			
-			tLoadCommandsNumber=tMach32HeaderPtr->ncmds;
-			
-			if (self.shouldSwap==YES)
-				tLoadCommandsNumber=OSSwapBigToHostInt32(tLoadCommandsNumber);
-			
-			/*tLoadCommandsTotalSize=tMach32HeaderPtr->sizeofcmds;
-			
-			if (self.shouldSwap==YES)
-				tLoadCommandsTotalSize=OSSwapBigToHostInt32(tLoadCommandsTotalSize);*/
-			
-			tFutureBufferOffset=sizeof(struct mach_header);
-		}
-		else if (inArchitecture==MCHArchitecture64)
-		{
-			if (self.bufferSize<sizeof(struct mach_header_64))
-			{
-				// Buffer not big enough
-				
-				return nil;
-			}
-			
-			struct mach_header_64 * tMach64HeaderPtr=(struct mach_header_64 *)self.buffer;
-			
-			_cpuType=tMach64HeaderPtr->cputype;
-			
-			if (self.shouldSwap==YES)
-				_cpuType=OSSwapBigToHostInt32(_cpuType);
-			
-			_cpuSubType=tMach64HeaderPtr->cpusubtype;
-			
-			if (self.shouldSwap==YES)
-				_cpuSubType=OSSwapBigToHostInt32(_cpuSubType);
-			
-			_fileType=tMach64HeaderPtr->filetype;
-			
-			if (self.shouldSwap==YES)
-				_fileType=OSSwapBigToHostInt32(_fileType);
-			
-			_flags=tMach64HeaderPtr->flags;
-			
-			if (self.shouldSwap==YES)
-				_flags=OSSwapBigToHostInt32(_flags);
-			
-			tLoadCommandsNumber=tMach64HeaderPtr->ncmds;
-			
-			if (self.shouldSwap==YES)
-				tLoadCommandsNumber=OSSwapBigToHostInt32(tLoadCommandsNumber);
-			
-			/*tLoadCommandsTotalSize=tMach64HeaderPtr->sizeofcmds;
-			
-			if (self.shouldSwap==YES)
-				tLoadCommandsTotalSize=OSSwapBigToHostInt32(tLoadCommandsTotalSize);*/
+			// Unknow architecture
 			
-			tFutureBufferOffset=sizeof(struct mach_header_64);
+			return nil;
 		}
-		else
+		
+		if (MCHMachHeaderRead((const uint8_t *)self.buffer,self.bufferSize,(inArchitecture==MCHArchitecture64),self.shouldSwap,&tHeader)==NO)
 		{
-			// Unknow architecture
+			// Buffer not big enough
 			
 			return nil;
 		}
 		
-		if (tLoadCommandsNumber>0)
+		_cpuType=tHeader.cpuType;
+		_cpuSubType=tHeader.cpuSubType;
+		_fileType=tHeader.fileType;
+		_flags=tHeader.flags;
+		
+		if (tHeader.numberOfLoadCommands>0)
 		{
 			_loadCommandsArray=[NSMutableArray array];
 			
@@ -144,30 +69,14 @@
 			
 			_segmentsIndex=[NSMutableDictionary dictionary];
 			
-			for(uint32_t tLoadCommandIndex=0;tLoadCommandIndex<tLoadCommandsNumber;tLoadCommandIndex++)
+			MCHLoadCommandsIterator tIterator=MCHLoadCommandsIteratorMake((const uint8_t *)self.buffer,self.bufferSize,&tHeader);
+			MCHLoadCommandInfo tLoadCommandInfo;
+			
+			while (MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommandInfo)==YES)
 			{
-				tFutureBufferOffset+=sizeof(struct load_command);
-				
-				if (tFutureBufferOffset>=self.bufferSize)
-				{
-					// Buffer too small
-					
-					return nil;
-				}
-				
-				tFutureBufferOffset-=sizeof(struct load_command);
-				
-				struct load_command * tLoadCommandPtr=(struct load_command *)(self.buffer+tFutureBufferOffset);
-				
-				uint32_t tLoadCommandType=tLoadCommandPtr->cmd;
-				
-				if (self.shouldSwap==YES)
-					tLoadCommandType=OSSwapBigToHostInt32(tLoadCommandType);
-				
-				uint32_t tLoadCommandSize=tLoadCommandPtr->cmdsize;
-				
-				if (self.shouldSwap==YES)
-					tLoadCommandSize=OSSwapBigToHostInt32(tLoadCommandSize);
+				uint32_t tLoadCommandType=tLoadCommandInfo.type;
+				uint32_t tLoadCommandSize=tLoadCommandInfo.size;
+				NSUInteger tFutureBufferOffset=tLoadCommandInfo.offset;
 				
 				switch(tLoadCommandType)
 				{
@@ -251,8 +160,6 @@
 							NSLog(@"Error initialization load command 0x%04x (0x%08x,%u)",tLoadCommandType,(uint32_t)tFutureBufferOffset,(uint32_t)tLoadCommandSize);
 						}
 						
-						tFutureBufferOffset+=tLoadCommandSize;
-						
 						break;
 					}
 						
@@ -262,11 +169,16 @@
 						
 						NSLog(@"Unknow load command: %d",tLoadCommandType);
 						
-						tFutureBufferOffset+=tLoadCommandSize;
-						
 						break;
 				}
 			}
+			
+			if (tIterator.malformed==YES)
+			{
+				// Buffer too small
+				
+				return nil;
+			}
 		}
 	}
 	
@@ -275,35 +187,11 @@
 
 - (instancetype)initWithBytes:(const char *)inBytes length:(NSUInteger)inLength
 {
-	if (inBytes!=nil && inLength>sizeof(uint32_t))
-	{
-		uint32_t tMagicNumber=*((uint32_t *)inBytes);
-		
-		switch(tMagicNumber)
-		{
-			case MH_MAGIC:
-				
-				return [self initWithBytes:inBytes length:inLength swap:NO architecture:MCHArchitecture32];
-				
-			case MH_CIGAM:
-				
-				return [self initWithBytes:inBytes length:inLength swap:YES architecture:MCHArchitecture32];
-				
-			case MH_MAGIC_64:
-				
-				return [self initWithBytes:inBytes length:inLength swap:NO architecture:MCHArchitecture64];
-				
-			case MH_CIGAM_64:
-				
-				return [self initWithBytes:inBytes length:inLength swap:NO architecture:MCHArchitecture64];
-				
-			default:
-		
-				// Unknown architecture
-				
-				break;
-		}
-	}
+	BOOL tIs64Bit;
+	BOOL tSwap;
+	
+	if (MCHMachHeaderIdentify((const uint8_t *)inBytes,inLength,&tIs64Bit,&tSwap)==YES)
+		return [self initWithBytes:inBytes length:inLength swap:tSwap architecture:(tIs64Bit==YES) ? MCHArchitecture64 : MCHArchitecture32];
 	
 	return nil;
 }
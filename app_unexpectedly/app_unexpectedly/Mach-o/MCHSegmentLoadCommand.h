@@ -21,4 +21,6 @@
 
 @property (readonly) uint32_t flags;
 
+@property (readonly) uint64_t vmAddress;
+
 @end
@@ -36,6 +36,7 @@
 			NSString * tSegmentName=nil;
 			MCHMemoryBufferWrapper * tMemoryBufferWrapper=nil;
 			uint32_t tFlags=0;
+			uint64_t tVMAddress=0;
 			uint32_t tNumberOfSections=0;
 			const char * tReadBuffer=NULL;
 		
@@ -54,6 +55,10 @@
 				if (self.shouldSwap==YES)
 					tSize=OSSwapBigToHostInt32(tSize);
 				
+				tVMAddress=tSegmentCommand32Ptr->vmaddr;
+				if (self.shouldSwap==YES)
+					tVMAddress=OSSwapBigToHostInt32((uint32_t)tVMAddress);
+				
 				tFlags=tSegmentCommand32Ptr->flags;
 				if (self.shouldSwap==YES)
 					tFlags=OSSwapBigToHostInt32(tFlags);
@@ -81,6 +86,10 @@
 				if (self.shouldSwap==YES)
 					tSize=OSSwapBigToHostInt64(tSize);
 				
+				tVMAddress=tSegmentCommand64Ptr->vmaddr;
+				if (self.shouldSwap==YES)
+					tVMAddress=OSSwapBigToHostInt64(tVMAddress);
+				
 				tFlags=tSegmentCommand64Ptr->flags;
 				if (self.shouldSwap==YES)
 					tFlags=OSSwapBigToHostInt32(tFlags);
@@ -102,6 +111,8 @@
 			
 			_flags=tFlags;
 			
+			_vmAddress=tVMAddress;
+			
 			NSMutableArray * tMutableArray=[NSMutableArray array];
 			
 			if (tNumberOfSections>0)
@@ -13,23 +13,21 @@
 
 #import "MCHUUIDLoadCommand.h"
 
-#include <mach-o/loader.h>
+#include "MCHMachOCore.h"
 
 @implementation MCHUUIDLoadCommand
 
 - (id)initWithBytes:(const char *)inBytes length:(NSUInteger)inLength swap:(BOOL)inSwap architecture:(MCHArchitecture)inArchitecture objectFile:(MCHObjectFile *)inObjectFile
 {
-	if (inLength<sizeof(struct uuid_command))
+	uuid_t tUUIDBytes;
+    
+    if (MCHUUIDLoadCommandRead((const uint8_t *)inBytes,inLength,tUUIDBytes)==NO)
         return nil;
     
     self=[super initWithBytes:inBytes length:inLength swap:inSwap architecture:inArchitecture];
     
     if (self!=nil)
-    {
-        struct uuid_command * tUUIDCommandPtr=(struct uuid_command *)inBytes;
-        
-        _uuid=[[NSUUID alloc] initWithUUIDBytes:tUUIDCommandPtr->uuid];
-    }
+        _uuid=[[NSUUID alloc] initWithUUIDBytes:tUUIDBytes];
     
     return self;
 }
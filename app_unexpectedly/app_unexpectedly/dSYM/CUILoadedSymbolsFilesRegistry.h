@@ -0,0 +1,51 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol CUILoadedSymbolsFilesOwner <NSObject>
+
+// Called without any lock of the registry held. Returns NO when the symbols file is in use (it is then kept).
+
+- (BOOL)unloadSymbolsFileForBinaryUUID:(NSString *)inBinaryUUID;
+
+@end
+
+// Process-wide budget for the symbols files loaded for look ups. When the budget is exceeded,
+// the least recently used files are unloaded by their owners. They are loaded again on the next look up.
+
+@interface CUILoadedSymbolsFilesRegistry : NSObject
+
+    // In bytes. 0 means no limit. Default: 1 GB
+
+    @property unsigned long long budget;
+
+    @property (readonly) unsigned long long residentSize;
+
++ (CUILoadedSymbolsFilesRegistry *)sharedRegistry;
+
+// The files are identified by their owner and binary UUID. The owner is not retained
+
+- (void)symbolsFileWasUsedForBinaryUUID:(NSString *)inBinaryUUID size:(unsigned long long)inSize owner:(id<CUILoadedSymbolsFilesOwner>)inOwner;
+
+// Must be called by the owner whenever it unloads a symbols file
+
+- (void)symbolsFileWasUnloadedForBinaryUUID:(NSString *)inBinaryUUID owner:(id<CUILoadedSymbolsFilesOwner>)inOwner;
+
+// Binary UUID -> size in bytes of the loaded symbols file (diagnostics)
+
+- (NSDictionary<NSString *,NSNumber *> *)residency;
+
+- (NSString *)report;
+
+@end
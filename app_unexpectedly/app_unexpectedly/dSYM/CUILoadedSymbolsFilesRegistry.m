@@ -0,0 +1,259 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "CUILoadedSymbolsFilesRegistry.h"
+
+#define CUILoadedSymbolsFilesRegistryDefaultBudget     (1024ULL*1024*1024)
+
+@interface CUILoadedSymbolsFile : NSObject
+
+    @property (copy) NSString * binaryUUID;
+
+    @property unsigned long long size;
+
+    @property (weak) id<CUILoadedSymbolsFilesOwner> owner;
+
+@end
+
+@implementation CUILoadedSymbolsFile
+@end
+
+@interface CUILoadedSymbolsFilesRegistry ()
+{
+    // Binary UUID -> Loaded files (one per owner as several bundles can provide the same UUID)
+    
+    NSMutableDictionary<NSString *,NSMutableArray<CUILoadedSymbolsFile *> *> * _loadedFilesRegistry;
+    
+    // From the least recently used to the most recently used
+    
+    NSMutableOrderedSet<CUILoadedSymbolsFile *> * _recentlyUsedFiles;
+    
+    NSLock * _lock;
+}
+
+    @property unsigned long long residentSize;
+
+- (CUILoadedSymbolsFile *)_loadedFileForBinaryUUID:(NSString *)inBinaryUUID owner:(id<CUILoadedSymbolsFilesOwner>)inOwner;
+
+- (void)_addLoadedFile:(CUILoadedSymbolsFile *)inLoadedFile;
+
+- (void)_removeLoadedFile:(CUILoadedSymbolsFile *)inLoadedFile;
+
+@end
+
+@implementation CUILoadedSymbolsFilesRegistry
+
++ (CUILoadedSymbolsFilesRegistry *)sharedRegistry
+{
+    static CUILoadedSymbolsFilesRegistry * sRegistry=nil;
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        sRegistry=[CUILoadedSymbolsFilesRegistry new];
+    });
+    
+    return sRegistry;
+}
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _budget=CUILoadedSymbolsFilesRegistryDefaultBudget;
+        
+        _loadedFilesRegistry=[NSMutableDictionary dictionary];
+        
+        _recentlyUsedFiles=[NSMutableOrderedSet orderedSet];
+        
+        _lock=[NSLock new];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+// The lock must be held
+
+- (CUILoadedSymbolsFile *)_loadedFileForBinaryUUID:(NSString *)inBinaryUUID owner:(id<CUILoadedSymbolsFilesOwner>)inOwner
+{
+    NSMutableArray<CUILoadedSymbolsFile *> * tLoadedFiles=_loadedFilesRegistry[inBinaryUUID];
+    
+    for(CUILoadedSymbolsFile * tLoadedFile in tLoadedFiles)
+    {
+        if (tLoadedFile.owner==inOwner)
+            return tLoadedFile;
+    }
+    
+    return nil;
+}
+
+- (void)_addLoadedFile:(CUILoadedSymbolsFile *)inLoadedFile
+{
+    NSMutableArray<CUILoadedSymbolsFile *> * tLoadedFiles=_loadedFilesRegistry[inLoadedFile.binaryUUID];
+    
+    if (tLoadedFiles==nil)
+    {
+        tLoadedFiles=[NSMutableArray array];
+        
+        _loadedFilesRegistry[inLoadedFile.binaryUUID]=tLoadedFiles;
+    }
+    
+    [tLoadedFiles addObject:inLoadedFile];
+    
+    [_recentlyUsedFiles addObject:inLoadedFile];
+    
+    _residentSize+=inLoadedFile.size;
+}
+
+- (void)_removeLoadedFile:(CUILoadedSymbolsFile *)inLoadedFile
+{
+    NSMutableArray<CUILoadedSymbolsFile *> * tLoadedFiles=_loadedFilesRegistry[inLoadedFile.binaryUUID];
+    
+    [tLoadedFiles removeObjectIdenticalTo:inLoadedFile];
+    
+    if (tLoadedFiles.count==0)
+        [_loadedFilesRegistry removeObjectForKey:inLoadedFile.binaryUUID];
+    
+    [_recentlyUsedFiles removeObject:inLoadedFile];
+    
+    _residentSize-=inLoadedFile.size;
+}
+
+#pragma mark -
+
+- (void)symbolsFileWasUsedForBinaryUUID:(NSString *)inBinaryUUID size:(unsigned long long)inSize owner:(id<CUILoadedSymbolsFilesOwner>)inOwner
+{
+    if (inBinaryUUID==nil || inOwner==nil)
+        return;
+    
+    NSMutableArray<CUILoadedSymbolsFile *> * tEvictedFiles=[NSMutableArray array];
+    
+    [_lock lock];
+    
+    CUILoadedSymbolsFile * tLoadedFile=[self _loadedFileForBinaryUUID:inBinaryUUID owner:inOwner];
+    
+    if (tLoadedFile==nil)
+    {
+        tLoadedFile=[CUILoadedSymbolsFile new];
+        tLoadedFile.binaryUUID=inBinaryUUID;
+        tLoadedFile.size=inSize;
+        tLoadedFile.owner=inOwner;
+        
+        [self _addLoadedFile:tLoadedFile];
+    }
+    else
+    {
+        [_recentlyUsedFiles removeObject:tLoadedFile];
+        [_recentlyUsedFiles addObject:tLoadedFile];
+    }
+    
+    // The file that has just been used is never evicted
+    
+    while (_budget>0 && _residentSize>_budget && _recentlyUsedFiles.count>1)
+    {
+        CUILoadedSymbolsFile * tEvictedFile=_recentlyUsedFiles.firstObject;
+        
+        [self _removeLoadedFile:tEvictedFile];
+        
+        [tEvictedFiles addObject:tEvictedFile];
+    }
+    
+    [_lock unlock];
+    
+    // The owners are called without the lock held as they may be registering a file at the same time
+    
+    for(CUILoadedSymbolsFile * tEvictedFile in tEvictedFiles)
+    {
+        id<CUILoadedSymbolsFilesOwner> tOwner=tEvictedFile.owner;
+        
+        // The owner is gone and so is its file
+        
+        if (tOwner==nil)
+            continue;
+        
+        if ([tOwner unloadSymbolsFileForBinaryUUID:tEvictedFile.binaryUUID]==YES)
+            continue;
+        
+        // The file is in use, it will be evicted later
+        
+        [_lock lock];
+        
+        if ([self _loadedFileForBinaryUUID:tEvictedFile.binaryUUID owner:tOwner]==nil)
+            [self _addLoadedFile:tEvictedFile];
+        
+        [_lock unlock];
+    }
+}
+
+- (void)symbolsFileWasUnloadedForBinaryUUID:(NSString *)inBinaryUUID owner:(id<CUILoadedSymbolsFilesOwner>)inOwner
+{
+    if (inBinaryUUID==nil || inOwner==nil)
+        return;
+    
+    [_lock lock];
+    
+    CUILoadedSymbolsFile * tLoadedFile=[self _loadedFileForBinaryUUID:inBinaryUUID owner:inOwner];
+    
+    if (tLoadedFile!=nil)
+        [self _removeLoadedFile:tLoadedFile];
+    
+    [_lock unlock];
+}
+
+#pragma mark -
+
+- (NSDictionary<NSString *,NSNumber *> *)residency
+{
+    NSMutableDictionary * tResidency=[NSMutableDictionary dictionary];
+    
+    [_lock lock];
+    
+    [_loadedFilesRegistry enumerateKeysAndObjectsUsingBlock:^(NSString * bBinaryUUID, NSArray<CUILoadedSymbolsFile *> * bLoadedFiles, BOOL * bOutStop) {
+        
+        unsigned long long tSize=0;
+        
+        for(CUILoadedSymbolsFile * tLoadedFile in bLoadedFiles)
+            tSize+=tLoadedFile.size;
+        
+        tResidency[bBinaryUUID]=@(tSize);
+    }];
+    
+    [_lock unlock];
+    
+    return tResidency;
+}
+
+- (NSString *)report
+{
+    NSMutableString * tReport=[NSMutableString string];
+    
+    [_lock lock];
+    
+    [tReport appendFormat:@"Loaded symbols files: %lu (%llu bytes, budget: %llu bytes)\n",(unsigned long)_recentlyUsedFiles.count,_residentSize,_budget];
+    
+    // Most recently used first
+    
+    for(CUILoadedSymbolsFile * tLoadedFile in _recentlyUsedFiles.reverseObjectEnumerator)
+        [tReport appendFormat:@"  %@ %llu\n",tLoadedFile.binaryUUID,tLoadedFile.size];
+    
+    [_lock unlock];
+    
+    return tReport;
+}
+
+@end
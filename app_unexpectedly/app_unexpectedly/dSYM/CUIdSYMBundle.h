@@ -15,6 +15,10 @@
 
 #import "CUISymbolicationData.h"
 
+#import "CUISymbolicationDataStore.h"
+
+@class DWRFBreakpadSymbolFileWriter;
+
 @interface CUIdSYMBundle : NSBundle
 
     @property (nonatomic,readonly) NSString * displayName;
@@ -25,6 +29,32 @@
 
     @property (nonatomic,readonly) NSArray * binaryUUIDs;
 
-- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+    @property (nonatomic,readonly) CUISymbolsFileSignature symbolsFileSignature;
+
+    @property (nonatomic,readonly,copy) NSString * symbolsFilePath;
+
+// The binary UUIDs and the signature are trusted (e.g. they come from an index that has just been revalidated).
+// The symbols file is only parsed when a look up needs it.
+
+- (instancetype)initWithPath:(NSString *)inPath binaryUUIDs:(NSArray *)inBinaryUUIDs symbolsFileSignature:(CUISymbolsFileSignature)inSignature;
+
+// Synchronous look up. Must be called from the symbolication queue (see CUISymbolicationManager)
+// The loaded symbols files are accounted in the budget of CUILoadedSymbolsFilesRegistry
+
+- (CUISymbolicationDataLookUpResult)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData;
+
+// Maps the symbols file of the binary UUID and parses the compilation units containing the addresses (if any) so that
+// the first look ups do not have to. Can be called from any queue, the work is interleaved with the look ups.
+// The cancellation block (optional) is checked before each compilation unit is parsed.
+
+- (void)prewarmSymbolsFileForBinaryUUID:(NSString *)inBinaryUUID machineInstructionAddresses:(NSArray<NSNumber *> *)inAddresses isCancelled:(BOOL (^)(void))inIsCancelled;
+
+// Exporter of the DWARF data of a binary UUID to a Breakpad symbol file. Must be used from the same queue as the look ups
+
+- (DWRFBreakpadSymbolFileWriter *)breakpadSymbolFileWriterForBinaryUUID:(NSString *)inBinaryUUID;
+
+// Unloads all the symbols files (e.g. when the bundle is removed). They are loaded again by the next look up.
+
+- (void)unloadSymbolsFiles;
 
 @end
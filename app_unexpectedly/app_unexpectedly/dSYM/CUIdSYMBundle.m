@@ -22,19 +22,37 @@
 #include <mach-o/loader.h>
 #include <mach-o/fat.h>
 
+#include <sys/stat.h>
+
+#include <os/lock.h>
+
 #import "DWRFFileObject.h"
 
+#import "DWRFBreakpadSymbolFileWriter.h"
+
 #import "CUISymbolicationDataCache.h"
 
+#import "CUISymbolicationNegativeCache.h"
 
+#import "CUILoadedSymbolsFilesRegistry.h"
 
-@interface CUIdSYMBundle ()
+@interface CUIdSYMBundle () <CUILoadedSymbolsFilesOwner>
 {
+    // Protects the Mach-O file and the DWARF file objects which can be unloaded from another thread
+    
+    os_unfair_lock _symbolsFileLock;
+    
     NSArray * _cachedBinaryUUIDs;
     
     NSDictionary<NSString *,MCHObjectFile *> * _machObjectFilesRegistry;
     
     NSMutableDictionary<NSString *,DWRFFileObject *> * _cachedWARFFileObjectsRegistry;
+    
+    // Computed on first use with the symbols file lock held (the bundle is used from several queues)
+    
+    CUISymbolsFileSignature _symbolsFileSignature;
+    
+    BOOL _symbolsFileSignatureAvailable;
 }
 
 @property (nonatomic) NSString * displayName;
@@ -45,12 +63,40 @@
 
 @property (nonatomic,copy) NSString * symbolsFilePath;
 
-- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID queue:(dispatch_queue_t)inQueue completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+- (void)_loadMachObjectFiles;
+
+- (CUISymbolsFileSignature)_symbolsFileSignature;
+
+- (DWRFFileObject *)_fileObjectForBinaryUUID:(NSString *)inBinaryUUID loadedSize:(unsigned long long *)outLoadedSize;
+
+- (CUISymbolicationDataLookUpResult)_lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData loadedSize:(unsigned long long *)outLoadedSize;
 
 @end
 
 @implementation CUIdSYMBundle
 
+- (instancetype)initWithPath:(NSString *)inPath binaryUUIDs:(NSArray *)inBinaryUUIDs symbolsFileSignature:(CUISymbolsFileSignature)inSignature
+{
+    if (inBinaryUUIDs.count==0)
+        return nil;
+    
+    self=[super initWithPath:inPath];
+    
+    // NSBundle can return an instance created earlier for the same path
+    
+    if (self!=nil && _cachedBinaryUUIDs==nil)
+    {
+        _cachedBinaryUUIDs=[inBinaryUUIDs copy];
+        
+        _symbolsFileSignature=inSignature;
+        _symbolsFileSignatureAvailable=YES;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
 - (NSString *)displayName
 {
     if (_displayName==nil)
@@ -168,18 +214,15 @@
     return NO;
 }
 
-- (NSArray *)binaryUUIDs
+- (void)_loadMachObjectFiles
 {
-    if (_cachedBinaryUUIDs!=nil)
-        return _cachedBinaryUUIDs;
-    
     NSMutableArray * tMutableArray=[NSMutableArray array];
     NSMutableDictionary * tMutableDictionary=[NSMutableDictionary dictionary];
     
     MCHMachBinary * tBinary=self.machBinary;
     
     if (tBinary==nil)
-        return nil;
+        return;
     
     [[tBinary allObjectFiles] enumerateObjectsUsingBlock:^(MCHObjectFile * bObjectFile, NSUInteger bIndex, BOOL * bOutStop) {
         
@@ -200,110 +243,269 @@
         }
     }];
     
-    _cachedBinaryUUIDs=[tMutableArray copy];
+    if (_cachedBinaryUUIDs==nil)
+        _cachedBinaryUUIDs=[tMutableArray copy];
     
     _machObjectFilesRegistry=[tMutableDictionary copy];
-    
-    return _cachedBinaryUUIDs;
 }
 
-#pragma mark -
-
-
+- (NSArray *)binaryUUIDs
+{
+    os_unfair_lock_lock(&_symbolsFileLock);
+    
+    if (_cachedBinaryUUIDs==nil)
+        [self _loadMachObjectFiles];
+    
+    NSArray * tBinaryUUIDs=_cachedBinaryUUIDs;
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    return tBinaryUUIDs;
+}
 
-- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+- (CUISymbolsFileSignature)symbolsFileSignature
 {
-    [self lookUpSymbolicationDataForMachineInstructionAddress:inAddress binaryUUID:inBinaryUUID queue:dispatch_get_main_queue() completionHandler:handler];
+    os_unfair_lock_lock(&_symbolsFileLock);
+    
+    CUISymbolsFileSignature tSignature=[self _symbolsFileSignature];
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    return tSignature;
 }
 
-- (void)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID queue:(dispatch_queue_t)inQueue completionHandler:(void (^)(CUISymbolicationDataLookUpResult bLookUpResult,CUISymbolicationData * bSymbolicationData))handler;
+- (CUISymbolsFileSignature)_symbolsFileSignature
 {
-    if (handler==nil)
+    if (_symbolsFileSignatureAvailable==NO)
     {
-        // A COMPLETER
+        struct stat tStat;
         
-        return;
-    }
-    
-    if (inBinaryUUID==nil)
-    {
-        handler(CUISymbolicationDataLookUpResultError,nil);
+        NSString * tPath=self.symbolsFilePath;
         
-        return;
+        if (tPath!=nil && stat(tPath.fileSystemRepresentation,&tStat)==0)
+        {
+            _symbolsFileSignature.modificationTime=(uint64_t)tStat.st_mtimespec.tv_sec*NSEC_PER_SEC+(uint64_t)tStat.st_mtimespec.tv_nsec;
+            _symbolsFileSignature.size=(uint64_t)tStat.st_size;
+        }
+        
+        _symbolsFileSignatureAvailable=YES;
     }
+    
+    return _symbolsFileSignature;
+}
 
+#pragma mark -
+
+- (DWRFFileObject *)_fileObjectForBinaryUUID:(NSString *)inBinaryUUID loadedSize:(unsigned long long *)outLoadedSize
+{
     // Try to find it as it was the first time
     
     if (_machObjectFilesRegistry==nil)
     {
-        [self binaryUUIDs];
+        [self _loadMachObjectFiles];
         
         if (_machObjectFilesRegistry.count==0)
-        {
-            handler(CUISymbolicationDataLookUpResultError,nil);
-            
-            return;
-        }
+            return nil;
     }
     
+    MCHObjectFile * tMachObjectFile=_machObjectFilesRegistry[inBinaryUUID];
+    
+    if (tMachObjectFile==nil)
+        return nil;
+    
     DWRFFileObject * tFileObject=_cachedWARFFileObjectsRegistry[inBinaryUUID];
     
     if (tFileObject==nil)
     {
-        MCHObjectFile * tMachObjectFile=_machObjectFilesRegistry[inBinaryUUID];
-        
-        if (tMachObjectFile==nil)
-        {
-            handler(CUISymbolicationDataLookUpResultError,nil);
-            
-            return;
-        }
-        
         if (_cachedWARFFileObjectsRegistry==nil)
             _cachedWARFFileObjectsRegistry=[NSMutableDictionary dictionary];
         
         tFileObject=[[DWRFFileObject alloc] initWithMachObjectFile:tMachObjectFile];
         
         if (tFileObject==nil)
+            return nil;
+        
+        _cachedWARFFileObjectsRegistry[inBinaryUUID]=tFileObject;
+    }
+    
+    *outLoadedSize=tMachObjectFile.bufferSize;
+    
+    return tFileObject;
+}
+
+- (CUISymbolicationDataLookUpResult)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData
+{
+    unsigned long long tLoadedSize=0;
+    
+    os_unfair_lock_lock(&_symbolsFileLock);
+    
+    CUISymbolicationDataLookUpResult tLookUpResult=[self _lookUpSymbolicationDataForMachineInstructionAddress:inAddress binaryUUID:inBinaryUUID symbolicationData:outSymbolicationData loadedSize:&tLoadedSize];
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    // The registry may ask other bundles to unload their files so it must not be called with the lock held
+    
+    if (tLoadedSize>0)
+        [[CUILoadedSymbolsFilesRegistry sharedRegistry] symbolsFileWasUsedForBinaryUUID:inBinaryUUID size:tLoadedSize owner:self];
+    
+    return tLookUpResult;
+}
+
+- (CUISymbolicationDataLookUpResult)_lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData loadedSize:(unsigned long long *)outLoadedSize
+{
+    if (outSymbolicationData!=NULL)
+        *outSymbolicationData=nil;
+    
+    if (inBinaryUUID==nil)
+        return CUISymbolicationDataLookUpResultError;
+
+    DWRFFileObject * tFileObject=[self _fileObjectForBinaryUUID:inBinaryUUID loadedSize:outLoadedSize];
+    
+    if (tFileObject==nil)
+        return CUISymbolicationDataLookUpResultError;
+    
+    CUISymbolsFileSignature tSignature=[self _symbolsFileSignature];
+    
+    __block CUISymbolicationDataLookUpResult tLookUpResult=CUISymbolicationDataLookUpResultNotFound;
+    __block CUISymbolicationData * tSymbolicationData=nil;
+    
+    [tFileObject lookUpSymbolicationDataForMachineInstructionAddress:inAddress completionHandler:^(BOOL bFound, CUISymbolicationData * bSymbolicationData) {
+        
+        // Update Cache (the caches are thread-safe so there's no need to wait for the completion queue)
+        
+        if (bFound==NO)
         {
-            handler(CUISymbolicationDataLookUpResultError,nil);
+            [[CUISymbolicationNegativeCache sharedCache] setAddressUnresolvable:inAddress binary:inBinaryUUID symbolsFileSignature:tSignature];
             
             return;
         }
         
-        _cachedWARFFileObjectsRegistry[inBinaryUUID]=tFileObject;
-    }
+        [[CUISymbolicationDataCache sharedCache] setSymbolicationData:bSymbolicationData forAddress:inAddress binary:inBinaryUUID];
+        
+        [[CUISymbolicationDataStore sharedStore] setSymbolicationData:bSymbolicationData forAddress:inAddress binary:inBinaryUUID symbolsFileSignature:tSignature];
+        
+        tLookUpResult=CUISymbolicationDataLookUpResultFound;
+        tSymbolicationData=bSymbolicationData;
+    }];
     
-    static dispatch_queue_t sSearchSerialQueue=nil;
+    if (outSymbolicationData!=NULL)
+        *outSymbolicationData=tSymbolicationData;
     
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
+    return tLookUpResult;
+}
+
+- (void)prewarmSymbolsFileForBinaryUUID:(NSString *)inBinaryUUID machineInstructionAddresses:(NSArray<NSNumber *> *)inAddresses isCancelled:(BOOL (^)(void))inIsCancelled
+{
+    if (inBinaryUUID==nil)
+        return;
+    
+    unsigned long long tLoadedSize=0;
+    
+    os_unfair_lock_lock(&_symbolsFileLock);
+    
+    DWRFFileObject * tFileObject=[self _fileObjectForBinaryUUID:inBinaryUUID loadedSize:&tLoadedSize];
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    if (tFileObject==nil)
+        return;
+    
+    [[CUILoadedSymbolsFilesRegistry sharedRegistry] symbolsFileWasUsedForBinaryUUID:inBinaryUUID size:tLoadedSize owner:self];
+    
+    // One compilation unit at a time so that a look up does not wait for the whole prewarm.
+    // The file object is fetched again each time as it may have been unloaded in the meantime.
+    
+    for(NSNumber * tAddressNumber in inAddresses)
+    {
+        if (inIsCancelled!=nil && inIsCancelled()==YES)
+            return;
+        
+        os_unfair_lock_lock(&_symbolsFileLock);
         
-        sSearchSerialQueue=dispatch_queue_create("fr.whitebox.unexpectedly.searchqueue", DISPATCH_QUEUE_SERIAL);
+        tFileObject=[self _fileObjectForBinaryUUID:inBinaryUUID loadedSize:&tLoadedSize];
+        
+        [tFileObject prewarmCompilationUnitsForMachineInstructionAddresses:@[tAddressNumber]];
+        
+        os_unfair_lock_unlock(&_symbolsFileLock);
+        
+        if (tFileObject==nil)
+            return;
         
-    });
+        [[CUILoadedSymbolsFilesRegistry sharedRegistry] symbolsFileWasUsedForBinaryUUID:inBinaryUUID size:tLoadedSize owner:self];
+    }
+}
+
+- (DWRFBreakpadSymbolFileWriter *)breakpadSymbolFileWriterForBinaryUUID:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return nil;
+    
+    os_unfair_lock_lock(&_symbolsFileLock);
+    
+    if (_machObjectFilesRegistry==nil)
+        [self _loadMachObjectFiles];
+    
+    MCHObjectFile * tMachObjectFile=_machObjectFilesRegistry[inBinaryUUID];
+    
+    MCHMachBinary * tMachBinary=_machBinary;
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    if (tMachObjectFile==nil)
+        return nil;
+    
+    DWRFBreakpadSymbolFileWriter * tWriter=[[DWRFBreakpadSymbolFileWriter alloc] initWithMachObjectFile:tMachObjectFile moduleName:self.symbolsFilePath.lastPathComponent];
+    
+    // The Mach-O file stays mapped as long as the writer is alive even if the bundle unloads it
+    
+    tWriter.bufferOwner=tMachBinary;
+    
+    return tWriter;
+}
+
+- (void)unloadSymbolsFiles
+{
+    os_unfair_lock_lock(&_symbolsFileLock);
     
-    dispatch_async(sSearchSerialQueue, ^{
+    NSArray<NSString *> * tBinaryUUIDs=_cachedWARFFileObjectsRegistry.allKeys;
+    
+    [_cachedWARFFileObjectsRegistry removeAllObjects];
+    
+    _machObjectFilesRegistry=nil;
+    
+    _machBinary=nil;
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    for(NSString * tBinaryUUID in tBinaryUUIDs)
+        [[CUILoadedSymbolsFilesRegistry sharedRegistry] symbolsFileWasUnloadedForBinaryUUID:tBinaryUUID owner:self];
+}
+
+#pragma mark - CUILoadedSymbolsFilesOwner
+
+- (BOOL)unloadSymbolsFileForBinaryUUID:(NSString *)inBinaryUUID
+{
+    if (os_unfair_lock_trylock(&_symbolsFileLock)==false)
+        return NO;
+    
+    [_cachedWARFFileObjectsRegistry removeObjectForKey:inBinaryUUID];
+    
+    // The Mach-O file is unmapped when none of its object files is used. It is mapped again by the next look up.
+    
+    if (_cachedWARFFileObjectsRegistry.count==0)
+    {
+        _machObjectFilesRegistry=nil;
         
-        [tFileObject lookUpSymbolicationDataForMachineInstructionAddress:inAddress completionHandler:^(BOOL bFound, CUISymbolicationData * bSymbolicationData) {
-            
-            dispatch_async(inQueue, ^{
-                
-                if (bFound==NO)
-                {
-                    handler(CUISymbolicationDataLookUpResultNotFound,nil);
-                    
-                    return;
-                }
-                
-                // Update Cache
-                
-                [[CUISymbolicationDataCache sharedCache] setSymbolicationData:bSymbolicationData forAddress:inAddress binary:inBinaryUUID];
-                
-                handler(CUISymbolicationDataLookUpResultFound,bSymbolicationData);
-            });
-        }];
-    });
+        _machBinary=nil;
+    }
+    
+    os_unfair_lock_unlock(&_symbolsFileLock);
+    
+    // The file may have been used (and registered again) since the registry asked for its eviction
+    
+    [[CUILoadedSymbolsFilesRegistry sharedRegistry] symbolsFileWasUnloadedForBinaryUUID:inBinaryUUID owner:self];
+    
+    return YES;
 }
 
 @end
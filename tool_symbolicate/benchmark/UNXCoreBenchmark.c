@@ -0,0 +1,578 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Benchmark of the plain C sources of UnexpectedlyCore (see CMakeLists.txt). Builds on macOS and Linux.
+
+#include "CUIUTF8ScannerCore.h"
+
+#include "LEB128.h"
+
+#include "MCHMachOCore.h"
+
+#include "DWRFArangesCore.h"
+
+#include "DWRFLineProgramCore.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+static void usage(void)
+{
+    fprintf(stderr,"usage: symbolicate-core-benchmark [-z buffer_size] [-r iterations] [-s seed]\n");
+    
+    exit(1);
+}
+
+static unsigned long long unsignedIntegerArgument(const char * inArgument)
+{
+    char * tEnd=NULL;
+    
+    unsigned long long tValue=strtoull(inArgument,&tEnd,0);
+    
+    if (tEnd==inArgument || *tEnd!='\0')
+        usage();
+    
+    return tValue;
+}
+
+static uint64_t UNXNanoseconds(void)
+{
+    struct timespec tTime;
+    
+    clock_gettime(CLOCK_MONOTONIC,&tTime);
+    
+    return (uint64_t)tTime.tv_sec*1000000000ULL+(uint64_t)tTime.tv_nsec;
+}
+
+// xorshift64*, so that the fixtures are the same from one run to another
+
+static uint64_t UNXNextRandomNumber(uint64_t * ioState)
+{
+    uint64_t tState=*ioState;
+    
+    tState^=tState>>12;
+    tState^=tState<<25;
+    tState^=tState>>27;
+    
+    *ioState=tState;
+    
+    return tState*0x2545F4914F6CDD1DULL;
+}
+
+static int UNXCompareDurations(const void * inFirst,const void * inSecond)
+{
+    uint64_t tFirst=*(const uint64_t *)inFirst;
+    uint64_t tSecond=*(const uint64_t *)inSecond;
+    
+    return (tFirst<tSecond) ? -1 : ((tFirst>tSecond) ? 1 : 0);
+}
+
+static void UNXPrintDurationsSummary(const char * inName,uint64_t * inDurations,size_t inCount,size_t inSize,int inIsLast)
+{
+    qsort(inDurations,inCount,sizeof(uint64_t),UNXCompareDurations);
+    
+    uint64_t tMedian=inDurations[inCount/2];
+    
+    printf("  \"%s\" : {\n    \"min\" : %llu,\n    \"median\" : %llu,\n    \"megabytesPerSecond\" : %.1f\n  }%s\n",
+           inName,
+           (unsigned long long)inDurations[0],
+           (unsigned long long)tMedian,
+           (tMedian>0) ? ((double)inSize/(1024*1024))*1e9/(double)tMedian : 0,
+           (inIsLast!=0) ? "" : ",");
+}
+
+#pragma mark -
+
+// Lines like the ones of the backtraces of a textual crash log
+
+static size_t UNXWriteStackFrameLines(char * inBuffer,size_t inSize,uint64_t * ioState)
+{
+    static const char * sBinaryNames[]={"libsystem_kernel.dylib","libsystem_pthread.dylib","com.example.Foo","AppKit","CoreFoundation"};
+    
+    size_t tLength=0;
+    
+    for(unsigned int tFrameIndex=0;;tFrameIndex++)
+    {
+        char tLine[256];
+        
+        uint64_t tRandom=UNXNextRandomNumber(ioState);
+        
+        int tLineLength=snprintf(tLine,sizeof(tLine),"%-4u%-30s\t0x%016llx _function_%llu + %llu\n",
+                                 tFrameIndex%64,
+                                 sBinaryNames[tRandom%5],
+                                 (unsigned long long)(0x7fff20000000ULL+(tRandom&0xFFFFFF)),
+                                 (unsigned long long)(tRandom>>40),
+                                 (unsigned long long)(tRandom&0x3FF));
+        
+        if ((tLength+(size_t)tLineLength)>inSize)
+            break;
+        
+        memcpy(inBuffer+tLength,tLine,(size_t)tLineLength);
+        
+        tLength+=(size_t)tLineLength;
+    }
+    
+    return tLength;
+}
+
+// Same steps as -[CUIStackFrame initWithUTF8Bytes:length:error:]
+
+static uint64_t UNXScanStackFrameLines(const uint8_t * inBytes,size_t inLength)
+{
+    uint64_t tChecksum=0;
+    size_t tLineStart=0;
+    
+    while (tLineStart<inLength)
+    {
+        const uint8_t * tLineEnd=memchr(inBytes+tLineStart,'\n',inLength-tLineStart);
+        size_t tLineLength=(tLineEnd!=NULL) ? (size_t)(tLineEnd-(inBytes+tLineStart)) : inLength-tLineStart;
+        
+        CUIUTF8Scanner tScanner=CUIUTF8ScannerMake(inBytes+tLineStart,tLineLength);
+        NSInteger tIndex=0;
+        unsigned long long tAddress=0;
+        NSRange tRange;
+        
+        if (CUIUTF8ScannerScanInteger(&tScanner,&tIndex)==YES)
+            tChecksum+=(uint64_t)tIndex;
+        
+        if (CUIUTF8ScannerScanUpToString(&tScanner,"0x",&tRange)==YES)
+        {
+            tRange=CUIUTF8TrimmedRange(tScanner.bytes,tRange);
+            
+            tChecksum+=tRange.length;
+        }
+        
+        if (CUIUTF8ScannerScanHexLongLong(&tScanner,&tAddress)==YES)
+            tChecksum+=tAddress;
+        
+        CUIUTF8ScannerSkipWhitespaces(&tScanner);
+        
+        if (CUIUTF8ScannerScanUpToString(&tScanner," + ",&tRange)==YES)
+            tChecksum+=tRange.length;
+        
+        tLineStart+=tLineLength+1;
+    }
+    
+    return tChecksum;
+}
+
+static size_t UNXWriteULEB128Values(uint8_t * inBuffer,size_t inSize,uint64_t * ioState,size_t * outCount)
+{
+    size_t tLength=0;
+    size_t tCount=0;
+    
+    while ((tLength+10)<=inSize)
+    {
+        // Mostly small values, as in the DWARF sections
+        
+        uint64_t tRandom=UNXNextRandomNumber(ioState);
+        unsigned int tNumberOfBits=1+(unsigned int)(tRandom%36);
+        uint64_t tValue=tRandom>>(64-tNumberOfBits);
+        
+        do
+        {
+            uint8_t tByte=tValue & 0x7F;
+            
+            tValue>>=7;
+            
+            if (tValue!=0)
+                tByte|=0x80;
+            
+            inBuffer[tLength++]=tByte;
+        }
+        while (tValue!=0);
+        
+        tCount++;
+    }
+    
+    *outCount=tCount;
+    
+    return tLength;
+}
+
+static size_t UNXWriteUInt32(uint8_t * inBuffer,size_t inOffset,uint32_t inValue)
+{
+    memcpy(inBuffer+inOffset,&inValue,sizeof(uint32_t));
+    
+    return inOffset+sizeof(uint32_t);
+}
+
+static size_t UNXWriteUInt64(uint8_t * inBuffer,size_t inOffset,uint64_t inValue)
+{
+    memcpy(inBuffer+inOffset,&inValue,sizeof(uint64_t));
+    
+    return inOffset+sizeof(uint64_t);
+}
+
+// 64-bit Mach-O header followed by load commands of random sizes
+
+static size_t UNXWriteMachOFile(uint8_t * inBuffer,size_t inSize,uint64_t * ioState)
+{
+    size_t tLength=32;
+    uint32_t tNumberOfLoadCommands=0;
+    
+    memset(inBuffer,0,tLength);
+    
+    while (1)
+    {
+        uint64_t tRandom=UNXNextRandomNumber(ioState);
+        uint32_t tLoadCommandSize=8*(uint32_t)(1+tRandom%32);
+        
+        if ((tLength+tLoadCommandSize)>inSize)
+            break;
+        
+        UNXWriteUInt32(inBuffer,tLength,(tRandom>>32)%2==0 ? LC_SEGMENT_64 : LC_UUID);
+        UNXWriteUInt32(inBuffer,tLength+4,tLoadCommandSize);
+        memset(inBuffer+tLength+8,(int)(tRandom>>40),tLoadCommandSize-8);
+        
+        tLength+=tLoadCommandSize;
+        tNumberOfLoadCommands++;
+    }
+    
+    UNXWriteUInt32(inBuffer,0,MH_MAGIC_64);
+    UNXWriteUInt32(inBuffer,16,tNumberOfLoadCommands);
+    UNXWriteUInt32(inBuffer,20,(uint32_t)(tLength-32));
+    
+    return tLength;
+}
+
+// Same steps as -[MCHObjectFile initWithBytes:length:]
+
+static uint64_t UNXParseMachOFile(const uint8_t * inBytes,size_t inLength)
+{
+    uint64_t tChecksum=0;
+    BOOL tIs64Bit;
+    BOOL tSwap;
+    MCHMachHeader tHeader;
+    
+    if (MCHMachHeaderIdentify(inBytes,inLength,&tIs64Bit,&tSwap)==NO ||
+        MCHMachHeaderRead(inBytes,inLength,tIs64Bit,tSwap,&tHeader)==NO)
+        return 0;
+    
+    MCHLoadCommandsIterator tIterator=MCHLoadCommandsIteratorMake(inBytes,inLength,&tHeader);
+    MCHLoadCommandInfo tLoadCommand;
+    uint8_t tUUID[16];
+    
+    while (MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES)
+    {
+        tChecksum+=tLoadCommand.size;
+        
+        if (tLoadCommand.type==LC_UUID && MCHUUIDLoadCommandRead(inBytes+tLoadCommand.offset,tLoadCommand.size,tUUID)==YES)
+            tChecksum+=tUUID[0];
+    }
+    
+    return tChecksum;
+}
+
+// Sets of 1 to 64 address ranges (8-byte addresses), as in the dSYM files
+
+static size_t UNXWriteArangesSection(uint8_t * inBuffer,size_t inSize,uint64_t * ioState)
+{
+    size_t tLength=0;
+    uint64_t tAddress=0x100000000ULL;
+    uint32_t tDebugInfoOffset=0;
+    
+    while (1)
+    {
+        uint64_t tRandom=UNXNextRandomNumber(ioState);
+        size_t tNumberOfRanges=1+(size_t)(tRandom%64);
+        size_t tSetSize=16+(tNumberOfRanges+1)*16;
+        
+        if ((tLength+tSetSize)>inSize)
+            break;
+        
+        size_t tOffset=UNXWriteUInt32(inBuffer,tLength,(uint32_t)(tSetSize-4));
+        
+        inBuffer[tOffset++]=2;
+        inBuffer[tOffset++]=0;
+        tOffset=UNXWriteUInt32(inBuffer,tOffset,tDebugInfoOffset);
+        inBuffer[tOffset++]=8;
+        inBuffer[tOffset++]=0;
+        tOffset=UNXWriteUInt32(inBuffer,tOffset,0);
+        
+        for(size_t tIndex=0;tIndex<tNumberOfRanges;tIndex++)
+        {
+            uint64_t tRangeLength=16+(UNXNextRandomNumber(ioState)%4096);
+            
+            tOffset=UNXWriteUInt64(inBuffer,tOffset,tAddress);
+            tOffset=UNXWriteUInt64(inBuffer,tOffset,tRangeLength);
+            
+            tAddress+=tRangeLength;
+        }
+        
+        tOffset=UNXWriteUInt64(inBuffer,tOffset,0);
+        tOffset=UNXWriteUInt64(inBuffer,tOffset,0);
+        
+        tLength=tOffset;
+        tDebugInfoOffset+=(uint32_t)(tRandom>>48);
+    }
+    
+    return tLength;
+}
+
+// A single line number program made of sequences of random opcodes
+
+static size_t UNXWriteLineProgram(uint8_t * inBuffer,size_t inSize,uint64_t * ioState)
+{
+    static const uint8_t sHeader[]={
+        1,1,1,(uint8_t)-5,14,13,
+        0,1,1,1,1,0,0,0,1,0,0,1,
+        's','r','c',0,0,
+        'a','.','c',0,1,0,0,
+        0
+    };
+    
+    if (inSize<(10+sizeof(sHeader)))
+        return 0;
+    
+    size_t tLength=10;
+    
+    memcpy(inBuffer+tLength,sHeader,sizeof(sHeader));
+    tLength+=sizeof(sHeader);
+    
+    uint64_t tAddress=0x100000000ULL;
+    
+    while ((tLength+16)<=inSize)
+    {
+        uint64_t tRandom=UNXNextRandomNumber(ioState);
+        
+        switch(tRandom%16)
+        {
+            case 0:
+                
+                // DW_LNE_set_address
+                
+                inBuffer[tLength++]=0x00;
+                inBuffer[tLength++]=0x09;
+                inBuffer[tLength++]=0x02;
+                tLength=UNXWriteUInt64(inBuffer,tLength,tAddress);
+                
+                tAddress+=0x1000;
+                break;
+                
+            case 1:
+                
+                // DW_LNE_end_sequence
+                
+                inBuffer[tLength++]=0x00;
+                inBuffer[tLength++]=0x01;
+                inBuffer[tLength++]=0x01;
+                break;
+                
+            case 2:
+                
+                // DW_LNS_advance_pc
+                
+                inBuffer[tLength++]=0x02;
+                inBuffer[tLength++]=(uint8_t)((tRandom>>8)&0x7F);
+                break;
+                
+            case 3:
+                
+                // DW_LNS_advance_line
+                
+                inBuffer[tLength++]=0x03;
+                inBuffer[tLength++]=(uint8_t)((tRandom>>8)&0x7F);
+                break;
+                
+            case 4:
+                
+                // DW_LNS_set_column
+                
+                inBuffer[tLength++]=0x05;
+                inBuffer[tLength++]=(uint8_t)((tRandom>>8)&0x3F);
+                break;
+                
+            case 5:
+                
+                // DW_LNS_copy
+                
+                inBuffer[tLength++]=0x01;
+                break;
+                
+            default:
+                
+                // Special opcode
+                
+                inBuffer[tLength++]=(uint8_t)(13+(tRandom>>8)%(256-13));
+                break;
+        }
+    }
+    
+    UNXWriteUInt32(inBuffer,0,(uint32_t)(tLength-4));
+    inBuffer[4]=4;
+    inBuffer[5]=0;
+    UNXWriteUInt32(inBuffer,6,(uint32_t)sizeof(sHeader));
+    
+    return tLength;
+}
+
+// Same steps as -[DWRFLineNumberProgram runProgram]
+
+static uint64_t UNXRunLineProgram(const uint8_t * inBytes,size_t inLength)
+{
+    uint64_t tChecksum=0;
+    DWRFLineProgramHeader tHeader;
+    
+    if (DWRFLineProgramHeaderRead(inBytes,inLength,0,&tHeader)==NO)
+        return 0;
+    
+    DWRFLineProgramStateMachine tStateMachine=DWRFLineProgramStateMachineMake(inBytes,&tHeader);
+    DWRFLineProgramStep tStep;
+    
+    while ((tStep=DWRFLineProgramStateMachineNext(&tStateMachine))==DWRFLineProgramStepRow || tStep==DWRFLineProgramStepDefineFile)
+        tChecksum+=tStateMachine.registers.address+tStateMachine.registers.line;
+    
+    return tChecksum;
+}
+
+int main(int argc, const char * argv[])
+{
+    size_t tSize=20000000;
+    unsigned long long tNumberOfIterations=10;
+    uint64_t tSeed=0x5EED;
+    int tCharacter;
+    
+    while ((tCharacter=getopt(argc,(char * const *)argv,"z:r:s:"))!=-1)
+    {
+        switch(tCharacter)
+        {
+            case 'z':
+                
+                tSize=(size_t)unsignedIntegerArgument(optarg);
+                break;
+                
+            case 'r':
+                
+                tNumberOfIterations=unsignedIntegerArgument(optarg);
+                break;
+                
+            case 's':
+                
+                tSeed=unsignedIntegerArgument(optarg);
+                break;
+                
+            default:
+                
+                usage();
+        }
+    }
+    
+    if (tSize==0 || tNumberOfIterations==0 || tSeed==0)
+        usage();
+    
+    uint8_t * tBuffer=malloc(tSize);
+    uint64_t * tDurations=malloc(tNumberOfIterations*sizeof(uint64_t));
+    
+    if (tBuffer==NULL || tDurations==NULL)
+    {
+        fprintf(stderr,"error: could not allocate the buffers\n");
+        
+        return 1;
+    }
+    
+    uint64_t tState=tSeed;
+    volatile uint64_t tChecksum=0;
+    
+    printf("{\n");
+    
+    // Stack frame lines scanning
+    
+    size_t tLength=UNXWriteStackFrameLines((char *)tBuffer,tSize,&tState);
+    
+    for(unsigned long long tIteration=0;tIteration<tNumberOfIterations;tIteration++)
+    {
+        uint64_t tStartTime=UNXNanoseconds();
+        
+        tChecksum+=UNXScanStackFrameLines(tBuffer,tLength);
+        
+        tDurations[tIteration]=UNXNanoseconds()-tStartTime;
+    }
+    
+    UNXPrintDurationsSummary("stackFramesScanning",tDurations,(size_t)tNumberOfIterations,tLength,0);
+    
+    // ULEB128 decoding
+    
+    size_t tCount=0;
+    
+    tLength=UNXWriteULEB128Values(tBuffer,tSize,&tState,&tCount);
+    
+    for(unsigned long long tIteration=0;tIteration<tNumberOfIterations;tIteration++)
+    {
+        uint64_t tStartTime=UNXNanoseconds();
+        
+        uint8_t * tBufferPtr=tBuffer;
+        
+        for(size_t tIndex=0;tIndex<tCount;tIndex++)
+            tChecksum+=DWRF_readULEB128(tBufferPtr,&tBufferPtr);
+        
+        tDurations[tIteration]=UNXNanoseconds()-tStartTime;
+    }
+    
+    UNXPrintDurationsSummary("ULEB128Decoding",tDurations,(size_t)tNumberOfIterations,tLength,0);
+    
+    // Mach-O load commands parsing
+    
+    tLength=UNXWriteMachOFile(tBuffer,tSize,&tState);
+    
+    for(unsigned long long tIteration=0;tIteration<tNumberOfIterations;tIteration++)
+    {
+        uint64_t tStartTime=UNXNanoseconds();
+        
+        tChecksum+=UNXParseMachOFile(tBuffer,tLength);
+        
+        tDurations[tIteration]=UNXNanoseconds()-tStartTime;
+    }
+    
+    UNXPrintDurationsSummary("machOLoadCommandsParsing",tDurations,(size_t)tNumberOfIterations,tLength,0);
+    
+    // __debug_aranges look up (the address is not found so all the sets are parsed)
+    
+    tLength=UNXWriteArangesSection(tBuffer,tSize,&tState);
+    
+    for(unsigned long long tIteration=0;tIteration<tNumberOfIterations;tIteration++)
+    {
+        uint64_t tStartTime=UNXNanoseconds();
+        
+        tChecksum+=DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0x10);
+        
+        tDurations[tIteration]=UNXNanoseconds()-tStartTime;
+    }
+    
+    UNXPrintDurationsSummary("arangesLookUp",tDurations,(size_t)tNumberOfIterations,tLength,0);
+    
+    // Line number program execution
+    
+    tLength=UNXWriteLineProgram(tBuffer,tSize,&tState);
+    
+    for(unsigned long long tIteration=0;tIteration<tNumberOfIterations;tIteration++)
+    {
+        uint64_t tStartTime=UNXNanoseconds();
+        
+        tChecksum+=UNXRunLineProgram(tBuffer,tLength);
+        
+        tDurations[tIteration]=UNXNanoseconds()-tStartTime;
+    }
+    
+    UNXPrintDurationsSummary("lineProgramExecution",tDurations,(size_t)tNumberOfIterations,tLength,1);
+    
+    printf("}\n");
+    
+    free(tDurations);
+    free(tBuffer);
+    
+    return 0;
+}
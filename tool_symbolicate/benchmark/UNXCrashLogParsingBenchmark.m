@@ -0,0 +1,290 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXCrashLogParsingBenchmark.h"
+
+#import "CUICrashLog.h"
+
+#import "CUICrashLogSectionsDetector.h"
+
+#import "CUICrashLogHeader.h"
+
+#import "CUICrashLogExceptionInformation.h"
+
+#import "CUIIPSReportIndex.h"
+
+#include <mach/mach_time.h>
+
+#include <sys/resource.h>
+
+static uint64_t UNXNanosecondsSince(uint64_t inStartTime)
+{
+    static mach_timebase_info_data_t sTimebaseInfo;
+    
+    if (sTimebaseInfo.denom==0)
+        mach_timebase_info(&sTimebaseInfo);
+    
+    return (mach_absolute_time()-inStartTime)*sTimebaseInfo.numer/sTimebaseInfo.denom;
+}
+
+static uint64_t UNXPeakResidentSetSize(void)
+{
+    struct rusage tUsage;
+    
+    if (getrusage(RUSAGE_SELF,&tUsage)!=0)
+        return 0;
+    
+    return (uint64_t)tUsage.ru_maxrss;     // bytes on macOS
+}
+
+static NSDictionary * UNXDurationsSummary(NSMutableArray<NSNumber *> * inDurations,NSUInteger inSize)
+{
+    [inDurations sortUsingSelector:@selector(compare:)];
+    
+    uint64_t tMedian=[inDurations[inDurations.count/2] unsignedLongLongValue];
+    
+    return @{
+             @"min":inDurations.firstObject,
+             @"median":@(tMedian),
+             @"megabytesPerSecond":@((tMedian>0) ? ((double)inSize/(1024*1024))*NSEC_PER_SEC/tMedian : 0)
+             };
+}
+
+@interface UNXCrashLogParsingBenchmark ()
+{
+    NSString * _filePath;
+}
+
+- (NSDictionary *)_runWithIPSReportData:(NSData *)inData;
+
+@end
+
+@implementation UNXCrashLogParsingBenchmark
+
+- (instancetype)initWithFilePath:(NSString *)inPath
+{
+    if (inPath==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _filePath=[inPath copy];
+        
+        _numberOfIterations=10;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSDictionary *)run
+{
+    NSData * tData=[NSData dataWithContentsOfFile:_filePath options:NSDataReadingMappedIfSafe error:NULL];
+    
+    if (tData==nil)
+        return nil;
+    
+    if (tData.length>0 && ((const char *)tData.bytes)[0]=='{')
+        return [self _runWithIPSReportData:tData];
+    
+    NSUInteger tCount=MAX(self.numberOfIterations,1);
+    
+    NSMutableDictionary * tResults=[NSMutableDictionary dictionary];
+    
+    tResults[@"parameters"]=@{
+                              @"iterations":@(tCount)
+                              };
+    
+    tResults[@"fileSize"]=@(tData.length);
+    
+    // Lines table and sections detection
+    
+    NSMutableArray<NSNumber *> * tLinesDurations=[NSMutableArray array];
+    NSMutableArray<NSNumber *> * tDurations=[NSMutableArray array];
+    NSUInteger tNumberOfLines=0;
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            CUICrashLogTextLines * tLines=[[CUICrashLogTextLines alloc] initWithData:tData];
+            
+            [tLinesDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            tStartTime=mach_absolute_time();
+            
+            CUICrashLogSectionsDetector * tDetector=[[CUICrashLogSectionsDetector alloc] initWithLines:tLines];
+            
+            if ([tDetector detectSections:NULL]==NO)
+                NSLog(@"Sections detection failed for \"%@\"",_filePath);
+            
+            [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            tNumberOfLines=tLines.count;
+        }
+    }
+    
+    tResults[@"numberOfLines"]=@(tNumberOfLines);
+    
+    tResults[@"linesTable"]=UNXDurationsSummary(tLinesDurations,tData.length);
+    
+    tResults[@"sectionsDetection"]=UNXDurationsSummary(tDurations,tData.length);
+    
+    // Crash log parsing (what is done when a crash log is listed, then when it is displayed)
+    
+    NSMutableArray<NSNumber *> * tFinalizationDurations=[NSMutableArray array];
+    
+    [tDurations removeAllObjects];
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            CUICrashLog * tCrashLog=[[CUICrashLog alloc] initWithData:tData error:NULL];
+            
+            [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            if (tCrashLog==nil)
+                return nil;
+            
+            tStartTime=mach_absolute_time();
+            
+            [tCrashLog finalizeParsing];
+            
+            [tFinalizationDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+        }
+    }
+    
+    tResults[@"crashLogParsing"]=UNXDurationsSummary(tDurations,tData.length);
+    
+    tResults[@"crashLogFinalization"]=UNXDurationsSummary(tFinalizationDurations,tData.length);
+    
+    tResults[@"peakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    return [tResults copy];
+}
+
+- (NSDictionary *)_runWithIPSReportData:(NSData *)inData
+{
+    NSUInteger tCount=MAX(self.numberOfIterations,1);
+    
+    NSMutableDictionary * tResults=[NSMutableDictionary dictionary];
+    
+    tResults[@"parameters"]=@{
+                              @"iterations":@(tCount)
+                              };
+    
+    tResults[@"fileSize"]=@(inData.length);
+    
+    // Structural index, header and exception information (what is done when an IPS report is listed), frames
+    
+    NSMutableArray<NSNumber *> * tIndexDurations=[NSMutableArray array];
+    NSMutableArray<NSNumber *> * tHeaderDurations=[NSMutableArray array];
+    NSMutableArray<NSNumber *> * tFramesDurations=[NSMutableArray array];
+    NSUInteger tNumberOfFrames=0;
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            CUIIPSReportIndex * tReportIndex=[[CUIIPSReportIndex alloc] initWithData:inData];
+            
+            [tIndexDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            if (tReportIndex==nil)
+                return nil;
+            
+            tStartTime=mach_absolute_time();
+            
+            CUICrashLogHeader * tHeader=[[CUICrashLogHeader alloc] initWithIPSReportIndex:tReportIndex error:NULL];
+            
+            CUICrashLogExceptionInformation * tExceptionInformation=[[CUICrashLogExceptionInformation alloc] initWithIPSReportIndex:tReportIndex error:NULL];
+            
+            [tHeaderDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            if (tHeader==nil || tExceptionInformation==nil)
+                NSLog(@"Header parsing failed for \"%@\"",_filePath);
+            
+            tStartTime=mach_absolute_time();
+            
+            NSUInteger tThreadsCount=tReportIndex.threads.count;
+            uint64_t tChecksum=0;
+            
+            tNumberOfFrames=0;
+            
+            for(NSUInteger tThreadIndex=0;tThreadIndex<tThreadsCount;tThreadIndex++)
+            {
+                for(CUIJSONValue * tFrame in [tReportIndex framesOfThreadAtIndex:tThreadIndex])
+                {
+                    tChecksum+=[tFrame valueForMemberName:@"imageOffset"].unsignedLongLongValue+[tFrame valueForMemberName:@"imageIndex"].unsignedLongLongValue;
+                    
+                    tNumberOfFrames++;
+                }
+            }
+            
+            [tFramesDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            if (tChecksum==0)
+                NSLog(@"No frames found in \"%@\"",_filePath);
+        }
+    }
+    
+    tResults[@"numberOfFrames"]=@(tNumberOfFrames);
+    
+    tResults[@"structuralIndex"]=UNXDurationsSummary(tIndexDurations,inData.length);
+    
+    tResults[@"headerDecoding"]=UNXDurationsSummary(tHeaderDurations,inData.length);
+    
+    tResults[@"framesDecoding"]=UNXDurationsSummary(tFramesDurations,inData.length);
+    
+    tResults[@"structuralIndexPeakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    // The whole incident as a property list graph (for comparison)
+    
+    NSUInteger tIncidentOffset=[inData rangeOfData:[NSData dataWithBytes:"\n" length:1] options:0 range:NSMakeRange(0,inData.length)].location+1;
+    NSData * tIncidentData=[inData subdataWithRange:NSMakeRange(tIncidentOffset,inData.length-tIncidentOffset)];
+    
+    NSMutableArray<NSNumber *> * tDurations=[NSMutableArray array];
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            id tIncident=[NSJSONSerialization JSONObjectWithData:tIncidentData options:0 error:NULL];
+            
+            [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            if (tIncident==nil)
+                return nil;
+        }
+    }
+    
+    tResults[@"JSONSerialization"]=UNXDurationsSummary(tDurations,inData.length);
+    
+    tResults[@"peakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    return [tResults copy];
+}
+
+@end
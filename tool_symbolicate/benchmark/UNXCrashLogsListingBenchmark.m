@@ -0,0 +1,216 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXCrashLogsListingBenchmark.h"
+
+#import "CUICrashLogsProvider.h"
+
+#include <mach/mach_time.h>
+
+#include <sys/resource.h>
+
+static uint64_t UNXNanosecondsSince(uint64_t inStartTime)
+{
+    static mach_timebase_info_data_t sTimebaseInfo;
+    
+    if (sTimebaseInfo.denom==0)
+        mach_timebase_info(&sTimebaseInfo);
+    
+    return (mach_absolute_time()-inStartTime)*sTimebaseInfo.numer/sTimebaseInfo.denom;
+}
+
+static uint64_t UNXPeakResidentSetSize(void)
+{
+    struct rusage tUsage;
+    
+    if (getrusage(RUSAGE_SELF,&tUsage)!=0)
+        return 0;
+    
+    return (uint64_t)tUsage.ru_maxrss;     // bytes on macOS
+}
+
+static NSDictionary * UNXDurationsSummary(NSMutableArray<NSNumber *> * inDurations,NSUInteger inCount)
+{
+    [inDurations sortUsingSelector:@selector(compare:)];
+    
+    uint64_t tMedian=[inDurations[inDurations.count/2] unsignedLongLongValue];
+    
+    return @{
+             @"min":inDurations.firstObject,
+             @"median":@(tMedian),
+             @"crashLogsPerSecond":@((tMedian>0) ? ((double)inCount)*NSEC_PER_SEC/tMedian : 0)
+             };
+}
+
+@interface UNXCrashLogsListingBenchmark ()
+{
+    NSString * _directoryPath;
+}
+
+@end
+
+@implementation UNXCrashLogsListingBenchmark
+
+- (instancetype)initWithDirectoryPath:(NSString *)inPath
+{
+    if (inPath==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _directoryPath=[inPath copy];
+        
+        _numberOfIterations=10;
+        
+        _numberOfSelections=100;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSDictionary *)run
+{
+    NSArray * tComponents=[[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directoryPath error:NULL];
+    
+    NSMutableArray<NSString *> * tFilePaths=[NSMutableArray array];
+    unsigned long long tTotalSize=0;
+    
+    for(NSString * tComponent in tComponents)
+    {
+        NSString * tExtension=tComponent.pathExtension;
+        
+        if ([tExtension caseInsensitiveCompare:@"crash"]!=NSOrderedSame &&
+            [tExtension caseInsensitiveCompare:@"ips"]!=NSOrderedSame)
+            continue;
+        
+        NSString * tFilePath=[_directoryPath stringByAppendingPathComponent:tComponent];
+        
+        [tFilePaths addObject:tFilePath];
+        
+        tTotalSize+=[[NSFileManager defaultManager] attributesOfItemAtPath:tFilePath error:NULL].fileSize;
+    }
+    
+    if (tFilePaths.count==0)
+        return nil;
+    
+    NSUInteger tCount=MAX(self.numberOfIterations,1);
+    
+    NSMutableDictionary * tResults=[NSMutableDictionary dictionary];
+    
+    tResults[@"parameters"]=@{
+                              @"iterations":@(tCount),
+                              @"selections":@(self.numberOfSelections)
+                              };
+    
+    tResults[@"numberOfFiles"]=@(tFilePaths.count);
+    
+    tResults[@"totalSize"]=@(tTotalSize);
+    
+    // Header-only listing (what is done when the crash logs list is populated)
+    // It is run first so that the peak resident set size is not the one of the full listing
+    
+    NSMutableArray<NSNumber *> * tDurations=[NSMutableArray array];
+    NSUInteger tNumberOfCrashLogs=0;
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            NSArray * tCrashLogs=[[CUICrashLogsProvider defaultProvider] crashLogsForDirectory:_directoryPath error:NULL];
+            
+            [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            
+            tNumberOfCrashLogs=tCrashLogs.count;
+        }
+    }
+    
+    tResults[@"numberOfCrashLogs"]=@(tNumberOfCrashLogs);
+    
+    tResults[@"headerOnlyListing"]=UNXDurationsSummary(tDurations,tFilePaths.count);
+    
+    tResults[@"headerOnlyListingPeakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    // Selection of crash logs listed from their header (the contents are read and parsed)
+    
+    NSUInteger tNumberOfSelections=MIN(self.numberOfSelections,tFilePaths.count);
+    
+    if (tNumberOfSelections>0)
+    {
+        [tDurations removeAllObjects];
+        
+        @autoreleasepool
+        {
+            NSArray * tCrashLogs=[[CUICrashLogsProvider defaultProvider] crashLogsForDirectory:_directoryPath error:NULL];
+            
+            tNumberOfSelections=MIN(tNumberOfSelections,tCrashLogs.count);
+            
+            for(NSUInteger tIndex=0;tIndex<tNumberOfSelections;tIndex++)
+            {
+                CUIRawCrashLog * tCrashLog=tCrashLogs[tIndex];
+                
+                uint64_t tStartTime=mach_absolute_time();
+                
+                [tCrashLog readContentsIfNeeded];
+                
+                if (tCrashLog.isFullyParsed==NO)
+                    [tCrashLog finalizeParsing];
+                
+                [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+            }
+        }
+        
+        if (tDurations.count>0)
+            tResults[@"selection"]=UNXDurationsSummary(tDurations,1);
+    }
+    
+    // Full listing (every file is read and parsed as before)
+    
+    [tDurations removeAllObjects];
+    
+    for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+    {
+        @autoreleasepool
+        {
+            uint64_t tStartTime=mach_absolute_time();
+            
+            NSMutableArray * tCrashLogs=[NSMutableArray array];
+            
+            for(NSString * tFilePath in tFilePaths)
+            {
+                CUIRawCrashLog * tCrashLog=[[CUICrashLog alloc] initWithContentsOfFile:tFilePath error:NULL];
+                
+                if (tCrashLog==nil)
+                    tCrashLog=[[CUIRawCrashLog alloc] initWithContentsOfFile:tFilePath error:NULL];
+                
+                if (tCrashLog!=nil)
+                    [tCrashLogs addObject:tCrashLog];
+            }
+            
+            [tDurations addObject:@(UNXNanosecondsSince(tStartTime))];
+        }
+    }
+    
+    tResults[@"fullListing"]=UNXDurationsSummary(tDurations,tFilePaths.count);
+    
+    tResults[@"peakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    return [tResults copy];
+}
+
+@end
@@ -0,0 +1,229 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXSymbolicationBenchmark.h"
+
+#import "MCHMachBinary.h"
+
+#import "DWRFFileObject.h"
+
+#include <mach/mach_time.h>
+
+#include <sys/resource.h>
+
+static uint64_t UNXNanosecondsSince(uint64_t inStartTime)
+{
+    static mach_timebase_info_data_t sTimebaseInfo;
+    
+    if (sTimebaseInfo.denom==0)
+        mach_timebase_info(&sTimebaseInfo);
+    
+    return (mach_absolute_time()-inStartTime)*sTimebaseInfo.numer/sTimebaseInfo.denom;
+}
+
+// xorshift64*, so that the batch addresses are the same from one run to another
+
+static uint64_t UNXNextRandomNumber(uint64_t * ioState)
+{
+    uint64_t tState=*ioState;
+    
+    tState^=tState>>12;
+    tState^=tState<<25;
+    tState^=tState>>27;
+    
+    *ioState=tState;
+    
+    return tState*0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t UNXPeakResidentSetSize(void)
+{
+    struct rusage tUsage;
+    
+    if (getrusage(RUSAGE_SELF,&tUsage)!=0)
+        return 0;
+    
+    return (uint64_t)tUsage.ru_maxrss;     // bytes on macOS
+}
+
+@interface UNXSymbolicationBenchmark ()
+{
+    NSString * _filePath;
+    
+    UNXSyntheticDWARFFileGenerator * _generator;
+    
+    // The object files only reference the buffer of the binary
+    
+    MCHMachBinary * _machBinary;
+    
+    DWRFFileObject * _fileObject;
+}
+
+- (BOOL)_lookUpMachineInstructionAddress:(uint64_t)inAddress;
+
+@end
+
+@implementation UNXSymbolicationBenchmark
+
+- (instancetype)initWithFilePath:(NSString *)inPath generator:(UNXSyntheticDWARFFileGenerator *)inGenerator
+{
+    if (inPath==nil || inGenerator==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _filePath=[inPath copy];
+        
+        _generator=inGenerator;
+        
+        _numberOfWarmLookUps=1000;
+        _numberOfBatchLookUps=10000;
+        _seed=0x756E657870656374ULL;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (BOOL)_lookUpMachineInstructionAddress:(uint64_t)inAddress
+{
+    __block BOOL tFound=NO;
+    
+    [_fileObject lookUpSymbolicationDataForMachineInstructionAddress:inAddress completionHandler:^(BOOL bFound, CUISymbolicationData * bSymbolicationData) {
+        
+        tFound=bFound;
+    }];
+    
+    return tFound;
+}
+
+- (NSDictionary *)run
+{
+    NSMutableDictionary * tResults=[NSMutableDictionary dictionary];
+    
+    tResults[@"parameters"]=@{
+                              @"compilationUnits":@(_generator.numberOfCompilationUnits),
+                              @"functionsPerCompilationUnit":@(_generator.numberOfFunctionsPerCompilationUnit),
+                              @"inliningDepth":@(_generator.inliningDepth),
+                              @"lineRowsPerFunction":@(_generator.numberOfLineRowsPerFunction),
+                              @"warmLookUps":@(self.numberOfWarmLookUps),
+                              @"batchLookUps":@(self.numberOfBatchLookUps),
+                              @"seed":@(self.seed)
+                              };
+    
+    NSDictionary * tAttributes=[[NSFileManager defaultManager] attributesOfItemAtPath:_filePath error:NULL];
+    
+    tResults[@"fileSize"]=@(tAttributes.fileSize);
+    
+    tResults[@"peakResidentSetSizeBeforeOpen"]=@(UNXPeakResidentSetSize());
+    
+    // Cold open
+    
+    uint64_t tStartTime=mach_absolute_time();
+    
+    _machBinary=[[MCHMachBinary alloc] initWithContentsOfFile:_filePath];
+    
+    for(MCHObjectFile * tObjectFile in _machBinary.allObjectFiles)
+    {
+        _fileObject=[[DWRFFileObject alloc] initWithMachObjectFile:tObjectFile];
+        
+        if (_fileObject!=nil)
+            break;
+    }
+    
+    if (_fileObject==nil)
+        return nil;
+    
+    tResults[@"coldOpen"]=@(UNXNanosecondsSince(tStartTime));
+    
+    // First look up (sections analysis, compilation unit parsing and line number program run)
+    
+    NSUInteger tMiddleFunctionIndex=_generator.numberOfFunctions/2;
+    uint64_t tAddress=[_generator lowPCOfFunctionAtIndex:tMiddleFunctionIndex]+[_generator sizeOfFunctionAtIndex:tMiddleFunctionIndex]/2;
+    
+    tStartTime=mach_absolute_time();
+    
+    BOOL tFound=[self _lookUpMachineInstructionAddress:tAddress];
+    
+    tResults[@"firstLookUp"]=@(UNXNanosecondsSince(tStartTime));
+    
+    if (tFound==NO)
+        NSLog(@"First look up failed for address 0x%llx",tAddress);
+    
+    // Warm look up (same address)
+    
+    NSUInteger tCount=self.numberOfWarmLookUps;
+    
+    if (tCount>0)
+    {
+        tStartTime=mach_absolute_time();
+        
+        for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+        {
+            @autoreleasepool
+            {
+                [self _lookUpMachineInstructionAddress:tAddress];
+            }
+        }
+        
+        tResults[@"warmLookUp"]=@(UNXNanosecondsSince(tStartTime)/tCount);
+    }
+    
+    // Batch look up (random addresses in all the functions)
+    
+    tCount=self.numberOfBatchLookUps;
+    
+    if (tCount>0)
+    {
+        uint64_t tRandomState=(self.seed!=0) ? self.seed : 1;
+        uint64_t tTextBaseAddress=_generator.textBaseAddress;
+        uint64_t tTextSize=_generator.textSize;
+        
+        uint64_t * tAddresses=malloc(tCount*sizeof(uint64_t));
+        
+        for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+            tAddresses[tIndex]=tTextBaseAddress+(UNXNextRandomNumber(&tRandomState)%tTextSize);
+        
+        NSUInteger tFoundCount=0;
+        
+        tStartTime=mach_absolute_time();
+        
+        for(NSUInteger tIndex=0;tIndex<tCount;tIndex++)
+        {
+            @autoreleasepool
+            {
+                if ([self _lookUpMachineInstructionAddress:tAddresses[tIndex]]==YES)
+                    tFoundCount++;
+            }
+        }
+        
+        uint64_t tDuration=UNXNanosecondsSince(tStartTime);
+        
+        free(tAddresses);
+        
+        tResults[@"batchLookUp"]=@{
+                                   @"duration":@(tDuration),
+                                   @"lookUpsPerSecond":@((tDuration>0) ? (double)tCount*NSEC_PER_SEC/tDuration : 0),
+                                   @"found":@(tFoundCount)
+                                   };
+    }
+    
+    tResults[@"peakResidentSetSize"]=@(UNXPeakResidentSetSize());
+    
+    return [tResults copy];
+}
+
+@end
@@ -0,0 +1,271 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXSyntheticCrashLogGenerator.h"
+
+// xorshift64*, so that the crash log is the same from one run to another
+
+static uint64_t UNXNextRandomNumber(uint64_t * ioState)
+{
+    uint64_t tState=*ioState;
+    
+    tState^=tState>>12;
+    tState^=tState<<25;
+    tState^=tState>>27;
+    
+    *ioState=tState;
+    
+    return tState*0x2545F4914F6CDD1DULL;
+}
+
+#define UNXSyntheticBinaryImageBaseAddress  0x7ff800000000ULL
+#define UNXSyntheticBinaryImageSize         0x100000ULL
+
+@implementation UNXSyntheticCrashLogGenerator
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _size=20*1024*1024;
+        _numberOfFramesPerThread=128;
+        _numberOfBinaryImages=600;
+        _seed=0x756E657870656374ULL;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSString *)crashLogString
+{
+    NSUInteger tNumberOfBinaryImages=MAX(self.numberOfBinaryImages,1);
+    NSUInteger tNumberOfFramesPerThread=MAX(self.numberOfFramesPerThread,1);
+    
+    uint64_t tRandomState=(self.seed!=0) ? self.seed : 1;
+    
+    NSMutableString * tCrashLog=[NSMutableString stringWithCapacity:self.size+tNumberOfBinaryImages*160];
+    
+    // Header and exception information
+    
+    [tCrashLog appendString:@"Process:               Synthetic [4242]\n"
+                            @"Path:                  /Applications/Synthetic.app/Contents/MacOS/Synthetic\n"
+                            @"Identifier:            fr.whitebox.synthetic\n"
+                            @"Version:               1.0 (1)\n"
+                            @"Code Type:             X86-64 (Native)\n"
+                            @"Parent Process:        launchd [1]\n"
+                            @"Responsible:           Synthetic [4242]\n"
+                            @"User ID:               501\n"
+                            @"\n"
+                            @"Date/Time:             2026-01-01 12:00:00.000 +0100\n"
+                            @"OS Version:            macOS 13.0 (22A380)\n"
+                            @"Report Version:        12\n"
+                            @"Anonymous UUID:        00000000-0000-0000-0000-000000000000\n"
+                            @"\n"
+                            @"Time Awake Since Boot: 1000 seconds\n"
+                            @"\n"
+                            @"Crashed Thread:        0  Dispatch queue: com.apple.main-thread\n"
+                            @"\n"
+                            @"Exception Type:        EXC_BAD_ACCESS (SIGSEGV)\n"
+                            @"Exception Codes:       KERN_INVALID_ADDRESS at 0x0000000000000000\n"
+                            @"\n"
+                            @"Termination Reason:    Namespace SIGNAL, Code 11 Segmentation fault: 11\n"
+                            @"Terminating Process:   exc handler [4242]\n"
+                            @"\n"
+                            @"VM Region Info: 0 is not in any region.  Bytes before following region: 4294967296\n"
+                            @"\n"];
+    
+    // Backtraces (until the requested size is reached)
+    
+    NSUInteger tThreadNumber=0;
+    
+    while (tCrashLog.length<self.size || tThreadNumber==0)
+    {
+        if (tThreadNumber==0)
+            [tCrashLog appendString:@"Thread 0 Crashed:: Dispatch queue: com.apple.main-thread\n"];
+        else
+            [tCrashLog appendFormat:@"Thread %lu:\n",(unsigned long)tThreadNumber];
+        
+        for(NSUInteger tFrameIndex=0;tFrameIndex<tNumberOfFramesPerThread;tFrameIndex++)
+        {
+            NSUInteger tImageIndex=UNXNextRandomNumber(&tRandomState)%tNumberOfBinaryImages;
+            uint64_t tOffset=UNXNextRandomNumber(&tRandomState)%UNXSyntheticBinaryImageSize;
+            
+            NSString * tImageName=[NSString stringWithFormat:@"libsynthetic%lu.dylib",(unsigned long)tImageIndex];
+            
+            [tCrashLog appendFormat:@"%-4lu%-30s\t0x%016llx function_%llu + %llu\n",(unsigned long)tFrameIndex,tImageName.UTF8String,UNXSyntheticBinaryImageBaseAddress+tImageIndex*UNXSyntheticBinaryImageSize+tOffset,tOffset>>4,tOffset&0xF];
+        }
+        
+        [tCrashLog appendString:@"\n"];
+        
+        tThreadNumber++;
+    }
+    
+    // Thread state
+    
+    [tCrashLog appendString:@"Thread 0 crashed with X86 Thread State (64-bit):\n"
+                            @"  rax: 0x0000000000000000  rbx: 0x0000000000000001  rcx: 0x0000000000000002  rdx: 0x0000000000000003\n"
+                            @"  rdi: 0x0000000000000004  rsi: 0x0000000000000005  rbp: 0x0000000000000006  rsp: 0x0000000000000007\n"
+                            @"   r8: 0x0000000000000008   r9: 0x0000000000000009  r10: 0x000000000000000a  r11: 0x000000000000000b\n"
+                            @"  r12: 0x000000000000000c  r13: 0x000000000000000d  r14: 0x000000000000000e  r15: 0x000000000000000f\n"
+                            @"  rip: 0x00007ff800000010  rfl: 0x0000000000000246  cr2: 0x0000000000000000\n"
+                            @"\n"];
+    
+    // Binary images
+    
+    [tCrashLog appendString:@"Binary Images:\n"];
+    
+    for(NSUInteger tImageIndex=0;tImageIndex<tNumberOfBinaryImages;tImageIndex++)
+    {
+        uint64_t tLoadAddress=UNXSyntheticBinaryImageBaseAddress+tImageIndex*UNXSyntheticBinaryImageSize;
+        
+        [tCrashLog appendFormat:@"    0x%llx -     0x%llx libsynthetic%lu.dylib (1.0) <%08X-0000-0000-0000-%012llX> /usr/lib/libsynthetic%lu.dylib\n",
+                                tLoadAddress,tLoadAddress+UNXSyntheticBinaryImageSize-1,(unsigned long)tImageIndex,(unsigned int)tImageIndex,UNXNextRandomNumber(&tRandomState)&0xFFFFFFFFFFFFULL,(unsigned long)tImageIndex];
+    }
+    
+    return [tCrashLog copy];
+}
+
+- (NSString *)ipsReportString
+{
+    NSUInteger tNumberOfBinaryImages=MAX(self.numberOfBinaryImages,1);
+    NSUInteger tNumberOfFramesPerThread=MAX(self.numberOfFramesPerThread,1);
+    
+    uint64_t tRandomState=(self.seed!=0) ? self.seed : 1;
+    
+    NSMutableString * tReport=[NSMutableString stringWithCapacity:self.size+tNumberOfBinaryImages*256];
+    
+    // Summary and header
+    
+    [tReport appendString:@"{\"app_name\":\"Synthetic\",\"timestamp\":\"2026-01-01 12:00:00.00 +0100\",\"app_version\":\"1.0\",\"slice_uuid\":\"00000000-0000-0000-0000-000000000000\",\"build_version\":\"1\",\"platform\":1,\"bundleID\":\"fr.whitebox.synthetic\",\"share_with_app_devs\":0,\"is_first_party\":0,\"bug_type\":\"309\",\"os_version\":\"macOS 13.0 (22A380)\",\"roots_installed\":0,\"name\":\"Synthetic\",\"incident_id\":\"00000000-0000-0000-0000-000000000000\"}\n"
+                          @"{\n"
+                          @"  \"uptime\" : 1000,\n"
+                          @"  \"procRole\" : \"Foreground\",\n"
+                          @"  \"version\" : 2,\n"
+                          @"  \"userID\" : 501,\n"
+                          @"  \"deployVersion\" : 210,\n"
+                          @"  \"modelCode\" : \"Mac14,2\",\n"
+                          @"  \"captureTime\" : \"2026-01-01 12:00:00.0000 +0100\",\n"
+                          @"  \"incident\" : \"00000000-0000-0000-0000-000000000000\",\n"
+                          @"  \"pid\" : 4242,\n"
+                          @"  \"translated\" : false,\n"
+                          @"  \"cpuType\" : \"X86-64\",\n"
+                          @"  \"procName\" : \"Synthetic\",\n"
+                          @"  \"procPath\" : \"\\/Applications\\/Synthetic.app\\/Contents\\/MacOS\\/Synthetic\",\n"
+                          @"  \"bundleInfo\" : {\"CFBundleShortVersionString\":\"1.0\",\"CFBundleVersion\":\"1\",\"CFBundleIdentifier\":\"fr.whitebox.synthetic\"},\n"
+                          @"  \"osVersion\" : {\"train\":\"macOS 13.0\",\"build\":\"22A380\",\"releaseType\":\"User\"},\n"
+                          @"  \"crashReporterKey\" : \"00000000-0000-0000-0000-000000000000\",\n"
+                          @"  \"sip\" : \"enabled\",\n"
+                          @"  \"parentPid\" : 1,\n"
+                          @"  \"parentProc\" : \"launchd\",\n"
+                          @"  \"responsiblePid\" : 4242,\n"
+                          @"  \"responsibleProc\" : \"Synthetic\",\n"
+                          @"  \"exception\" : {\"codes\":\"0x0000000000000001, 0x0000000000000000\",\"rawCodes\":[1,0],\"type\":\"EXC_BAD_ACCESS\",\"signal\":\"SIGSEGV\",\"subtype\":\"KERN_INVALID_ADDRESS at 0x0000000000000000\"},\n"
+                          @"  \"termination\" : {\"flags\":0,\"code\":11,\"namespace\":\"SIGNAL\",\"indicator\":\"Segmentation fault: 11\",\"byProc\":\"exc handler\",\"byPid\":4242},\n"
+                          @"  \"faultingThread\" : 0,\n"
+                          @"  \"threads\" : ["];
+    
+    // Threads (until the requested size is reached)
+    
+    NSUInteger tThreadNumber=0;
+    
+    while (tReport.length<self.size || tThreadNumber==0)
+    {
+        if (tThreadNumber>0)
+            [tReport appendString:@","];
+        
+        if (tThreadNumber==0)
+            [tReport appendString:@"{\"triggered\":true,\"id\":1,\"queue\":\"com.apple.main-thread\",\"frames\":["];
+        else
+            [tReport appendFormat:@"{\"id\":%lu,\"frames\":[",(unsigned long)tThreadNumber+1];
+        
+        for(NSUInteger tFrameIndex=0;tFrameIndex<tNumberOfFramesPerThread;tFrameIndex++)
+        {
+            NSUInteger tImageIndex=UNXNextRandomNumber(&tRandomState)%tNumberOfBinaryImages;
+            uint64_t tOffset=UNXNextRandomNumber(&tRandomState)%UNXSyntheticBinaryImageSize;
+            
+            [tReport appendFormat:@"%@{\"imageOffset\":%llu,\"symbol\":\"function_%llu\",\"symbolLocation\":%llu,\"imageIndex\":%lu}",(tFrameIndex>0) ? @"," : @"",tOffset,tOffset>>4,tOffset&0xF,(unsigned long)tImageIndex];
+        }
+        
+        [tReport appendString:@"]}"];
+        
+        tThreadNumber++;
+    }
+    
+    // Binary images
+    
+    [tReport appendString:@"],\n  \"usedImages\" : ["];
+    
+    for(NSUInteger tImageIndex=0;tImageIndex<tNumberOfBinaryImages;tImageIndex++)
+    {
+        uint64_t tLoadAddress=UNXSyntheticBinaryImageBaseAddress+tImageIndex*UNXSyntheticBinaryImageSize;
+        
+        [tReport appendFormat:@"%@{\"source\":\"P\",\"arch\":\"x86_64\",\"base\":%llu,\"size\":%llu,\"uuid\":\"%08x-0000-0000-0000-%012llx\",\"path\":\"\\/usr\\/lib\\/libsynthetic%lu.dylib\",\"name\":\"libsynthetic%lu.dylib\"}",
+                              (tImageIndex>0) ? @"," : @"",tLoadAddress,UNXSyntheticBinaryImageSize,(unsigned int)tImageIndex,UNXNextRandomNumber(&tRandomState)&0xFFFFFFFFFFFFULL,(unsigned long)tImageIndex,(unsigned long)tImageIndex];
+    }
+    
+    [tReport appendString:@"],\n  \"legacyInfo\" : {\"threadTriggered\":{\"queue\":\"com.apple.main-thread\"}}\n}"];
+    
+    return [tReport copy];
+}
+
+- (BOOL)writeToFile:(NSString *)inPath error:(NSError **)outError
+{
+    if (inPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    NSString * tString=(self.isIPSReport==YES) ? [self ipsReportString] : [self crashLogString];
+    
+    return [tString writeToFile:inPath atomically:YES encoding:NSUTF8StringEncoding error:outError];
+}
+
+- (BOOL)writeCrashLogs:(NSUInteger)inCount toDirectory:(NSString *)inPath error:(NSError **)outError
+{
+    if (inPath==nil)
+    {
+        if (outError!=NULL)
+            *outError=[NSError errorWithDomain:NSPOSIXErrorDomain code:EINVAL userInfo:@{}];
+        
+        return NO;
+    }
+    
+    if ([[NSFileManager defaultManager] createDirectoryAtPath:inPath withIntermediateDirectories:YES attributes:nil error:outError]==NO)
+        return NO;
+    
+    uint64_t tSeed=self.seed;
+    BOOL tWritten=YES;
+    
+    for(NSUInteger tIndex=0;tIndex<inCount && tWritten==YES;tIndex++)
+    {
+        @autoreleasepool
+        {
+            self.seed=tSeed+tIndex;
+            
+            tWritten=[self writeToFile:[inPath stringByAppendingPathComponent:[NSString stringWithFormat:@"Synthetic_%06lu.%@",(unsigned long)tIndex,(self.isIPSReport==YES) ? @"ips" : @"crash"]] error:outError];
+        }
+    }
+    
+    self.seed=tSeed;
+    
+    return tWritten;
+}
+
+@end
@@ -0,0 +1,46 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+// Generates a MH_DSYM Mach-O file with DWARF 4 debug information that looks like the one
+// of a real binary: one __debug_info compilation unit per source file, concrete sub programs
+// with chains of inlined subroutines, a line number program per compilation unit and the
+// matching __debug_aranges entries.
+
+@interface UNXSyntheticDWARFFileGenerator : NSObject
+
+    @property NSUInteger numberOfCompilationUnits;
+
+    @property NSUInteger numberOfFunctionsPerCompilationUnit;
+
+    // Number of nested inlined subroutines in each function (0 for none)
+
+    @property NSUInteger inliningDepth;
+
+    @property NSUInteger numberOfLineRowsPerFunction;
+
+
+    @property (readonly) uint64_t textBaseAddress;
+
+    @property (readonly) uint64_t textSize;
+
+    @property (readonly) NSUInteger numberOfFunctions;
+
+- (uint64_t)lowPCOfFunctionAtIndex:(NSUInteger)inIndex;
+
+- (uint64_t)sizeOfFunctionAtIndex:(NSUInteger)inIndex;
+
+- (BOOL)writeToFile:(NSString *)inPath error:(NSError **)outError;
+
+@end
@@ -0,0 +1,620 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXSyntheticDWARFFileGenerator.h"
+
+#import "DWRFEnums.h"
+
+#include <mach-o/loader.h>
+
+#define UNXSyntheticTextBaseAddress         0x100001000ULL
+
+#define UNXSyntheticInstructionSize         4
+
+#define UNXSyntheticMinimumNumberOfRows     4
+
+#define UNXSyntheticSegmentAlignment        0x1000
+
+#define UNXSyntheticFunctionFirstLine       10
+
+enum
+{
+    UNXAbbreviationCodeCompileUnit=1,
+    UNXAbbreviationCodeSubProgram,
+    UNXAbbreviationCodeLeafSubProgram,
+    UNXAbbreviationCodeAbstractSubProgram,
+    UNXAbbreviationCodeInlinedSubroutine,
+    UNXAbbreviationCodeLeafInlinedSubroutine
+};
+
+// Line number program settings (same as the ones used by clang)
+
+enum
+{
+    UNX_DW_LNS_copy=0x01,
+    UNX_DW_LNS_advance_pc=0x02,
+    UNX_DW_LNS_advance_line=0x03,
+    UNX_DW_LNE_end_sequence=0x01,
+    UNX_DW_LNE_set_address=0x02
+};
+
+#define UNXLineBase         -5
+#define UNXLineRange        14
+#define UNXOpcodeBase       13
+
+#define UNX_DW_INL_inlined  1
+
+static void UNXAppendUInt8(NSMutableData * inData,uint8_t inValue)
+{
+    [inData appendBytes:&inValue length:sizeof(uint8_t)];
+}
+
+static void UNXAppendUInt16(NSMutableData * inData,uint16_t inValue)
+{
+    [inData appendBytes:&inValue length:sizeof(uint16_t)];
+}
+
+static void UNXAppendUInt32(NSMutableData * inData,uint32_t inValue)
+{
+    [inData appendBytes:&inValue length:sizeof(uint32_t)];
+}
+
+static void UNXAppendUInt64(NSMutableData * inData,uint64_t inValue)
+{
+    [inData appendBytes:&inValue length:sizeof(uint64_t)];
+}
+
+static void UNXAppendULEB128(NSMutableData * inData,uint64_t inValue)
+{
+    do
+    {
+        uint8_t tByte=inValue & 0x7f;
+        
+        inValue>>=7;
+        
+        if (inValue!=0)
+            tByte|=0x80;
+        
+        UNXAppendUInt8(inData,tByte);
+    }
+    while (inValue!=0);
+}
+
+static void UNXAppendLEB128(NSMutableData * inData,int64_t inValue)
+{
+    BOOL tMore=YES;
+    
+    while (tMore==YES)
+    {
+        uint8_t tByte=inValue & 0x7f;
+        
+        inValue>>=7;
+        
+        if ((inValue==0 && (tByte & 0x40)==0) ||
+            (inValue==-1 && (tByte & 0x40)!=0))
+            tMore=NO;
+        else
+            tByte|=0x80;
+        
+        UNXAppendUInt8(inData,tByte);
+    }
+}
+
+static void UNXAppendCString(NSMutableData * inData,const char * inString)
+{
+    [inData appendBytes:inString length:strlen(inString)+1];
+}
+
+static void UNXPatchUInt32(NSMutableData * inData,NSUInteger inOffset,uint32_t inValue)
+{
+    [inData replaceBytesInRange:NSMakeRange(inOffset,sizeof(uint32_t)) withBytes:&inValue];
+}
+
+static void UNXAppendSubProgramAbbreviation(NSMutableData * inData,uint64_t inCode,BOOL inHasChildren)
+{
+    UNXAppendULEB128(inData,inCode);
+    UNXAppendULEB128(inData,DW_TAG_subprogram);
+    UNXAppendUInt8(inData,(inHasChildren==YES) ? 1 : 0);
+    
+    UNXAppendULEB128(inData,DW_AT_low_pc);      UNXAppendULEB128(inData,DW_FORM_addr);
+    UNXAppendULEB128(inData,DW_AT_high_pc);     UNXAppendULEB128(inData,DW_FORM_data4);
+    UNXAppendULEB128(inData,DW_AT_name);        UNXAppendULEB128(inData,DW_FORM_strp);
+    UNXAppendULEB128(inData,DW_AT_decl_file);   UNXAppendULEB128(inData,DW_FORM_data1);
+    UNXAppendULEB128(inData,DW_AT_decl_line);   UNXAppendULEB128(inData,DW_FORM_data4);
+    UNXAppendULEB128(inData,0);                 UNXAppendULEB128(inData,0);
+}
+
+static void UNXAppendInlinedSubroutineAbbreviation(NSMutableData * inData,uint64_t inCode,BOOL inHasChildren)
+{
+    UNXAppendULEB128(inData,inCode);
+    UNXAppendULEB128(inData,DW_TAG_inlined_subroutine);
+    UNXAppendUInt8(inData,(inHasChildren==YES) ? 1 : 0);
+    
+    UNXAppendULEB128(inData,DW_AT_abstract_origin); UNXAppendULEB128(inData,DW_FORM_ref4);
+    UNXAppendULEB128(inData,DW_AT_low_pc);          UNXAppendULEB128(inData,DW_FORM_addr);
+    UNXAppendULEB128(inData,DW_AT_high_pc);         UNXAppendULEB128(inData,DW_FORM_data4);
+    UNXAppendULEB128(inData,DW_AT_call_file);       UNXAppendULEB128(inData,DW_FORM_data1);
+    UNXAppendULEB128(inData,DW_AT_call_line);       UNXAppendULEB128(inData,DW_FORM_data4);
+    UNXAppendULEB128(inData,0);                     UNXAppendULEB128(inData,0);
+}
+
+@interface UNXSyntheticDWARFFileGenerator ()
+{
+    NSMutableData * _debug_abbrev;
+    
+    NSMutableData * _debug_info;
+    
+    NSMutableData * _debug_line;
+    
+    NSMutableData * _debug_aranges;
+    
+    NSMutableData * _debug_str;
+    
+    NSMutableDictionary<NSString *,NSNumber *> * _stringsOffsets;
+}
+
+- (NSUInteger)_effectiveNumberOfLineRowsPerFunction;
+
+- (uint32_t)_offsetOfString:(NSString *)inString;
+
+- (void)_writeAbbreviations;
+
+- (void)_writeCompilationUnitAtIndex:(NSUInteger)inIndex;
+
+- (void)_writeLineNumberProgramOfCompilationUnitAtIndex:(NSUInteger)inIndex;
+
+- (void)_writeAddressRangesOfCompilationUnitAtIndex:(NSUInteger)inIndex debugInfoOffset:(uint32_t)inDebugInfoOffset;
+
+- (NSData *)_machObjectFileData;
+
+@end
+
+@implementation UNXSyntheticDWARFFileGenerator
+
+- (instancetype)init
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _numberOfCompilationUnits=100;
+        _numberOfFunctionsPerCompilationUnit=100;
+        _inliningDepth=2;
+        _numberOfLineRowsPerFunction=16;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (uint64_t)textBaseAddress
+{
+    return UNXSyntheticTextBaseAddress;
+}
+
+- (uint64_t)textSize
+{
+    return self.numberOfFunctions*[self sizeOfFunctionAtIndex:0];
+}
+
+- (NSUInteger)numberOfFunctions
+{
+    return self.numberOfCompilationUnits*self.numberOfFunctionsPerCompilationUnit;
+}
+
+- (NSUInteger)_effectiveNumberOfLineRowsPerFunction
+{
+    return MAX(self.numberOfLineRowsPerFunction,UNXSyntheticMinimumNumberOfRows);
+}
+
+- (uint64_t)lowPCOfFunctionAtIndex:(NSUInteger)inIndex
+{
+    return UNXSyntheticTextBaseAddress+inIndex*[self sizeOfFunctionAtIndex:inIndex];
+}
+
+- (uint64_t)sizeOfFunctionAtIndex:(NSUInteger)inIndex
+{
+    return [self _effectiveNumberOfLineRowsPerFunction]*UNXSyntheticInstructionSize;
+}
+
+#pragma mark -
+
+- (uint32_t)_offsetOfString:(NSString *)inString
+{
+    NSNumber * tNumber=_stringsOffsets[inString];
+    
+    if (tNumber!=nil)
+        return tNumber.unsignedIntValue;
+    
+    uint32_t tOffset=(uint32_t)_debug_str.length;
+    
+    UNXAppendCString(_debug_str,inString.UTF8String);
+    
+    _stringsOffsets[inString]=@(tOffset);
+    
+    return tOffset;
+}
+
+- (void)_writeAbbreviations
+{
+    // The abbreviation codes must be consecutive, the parser uses them as indexes
+    
+    UNXAppendULEB128(_debug_abbrev,UNXAbbreviationCodeCompileUnit);
+    UNXAppendULEB128(_debug_abbrev,DW_TAG_compile_unit);
+    UNXAppendUInt8(_debug_abbrev,1);
+    
+    UNXAppendULEB128(_debug_abbrev,DW_AT_producer);     UNXAppendULEB128(_debug_abbrev,DW_FORM_strp);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_language);     UNXAppendULEB128(_debug_abbrev,DW_FORM_data2);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_name);         UNXAppendULEB128(_debug_abbrev,DW_FORM_strp);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_stmt_list);    UNXAppendULEB128(_debug_abbrev,DW_FORM_sec_offset);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_comp_dir);     UNXAppendULEB128(_debug_abbrev,DW_FORM_strp);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_low_pc);       UNXAppendULEB128(_debug_abbrev,DW_FORM_addr);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_high_pc);      UNXAppendULEB128(_debug_abbrev,DW_FORM_data4);
+    UNXAppendULEB128(_debug_abbrev,0);                  UNXAppendULEB128(_debug_abbrev,0);
+    
+    UNXAppendSubProgramAbbreviation(_debug_abbrev,UNXAbbreviationCodeSubProgram,YES);
+    UNXAppendSubProgramAbbreviation(_debug_abbrev,UNXAbbreviationCodeLeafSubProgram,NO);
+    
+    UNXAppendULEB128(_debug_abbrev,UNXAbbreviationCodeAbstractSubProgram);
+    UNXAppendULEB128(_debug_abbrev,DW_TAG_subprogram);
+    UNXAppendUInt8(_debug_abbrev,0);
+    
+    UNXAppendULEB128(_debug_abbrev,DW_AT_name);         UNXAppendULEB128(_debug_abbrev,DW_FORM_strp);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_decl_file);    UNXAppendULEB128(_debug_abbrev,DW_FORM_data1);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_decl_line);    UNXAppendULEB128(_debug_abbrev,DW_FORM_data4);
+    UNXAppendULEB128(_debug_abbrev,DW_AT_inline);       UNXAppendULEB128(_debug_abbrev,DW_FORM_data1);
+    UNXAppendULEB128(_debug_abbrev,0);                  UNXAppendULEB128(_debug_abbrev,0);
+    
+    UNXAppendInlinedSubroutineAbbreviation(_debug_abbrev,UNXAbbreviationCodeInlinedSubroutine,YES);
+    UNXAppendInlinedSubroutineAbbreviation(_debug_abbrev,UNXAbbreviationCodeLeafInlinedSubroutine,NO);
+    
+    UNXAppendULEB128(_debug_abbrev,0);
+}
+
+- (void)_writeCompilationUnitAtIndex:(NSUInteger)inIndex
+{
+    NSUInteger tFunctionsCount=self.numberOfFunctionsPerCompilationUnit;
+    NSUInteger tFirstFunctionIndex=inIndex*tFunctionsCount;
+    uint64_t tFunctionSize=[self sizeOfFunctionAtIndex:tFirstFunctionIndex];
+    
+    uint32_t tDebugInfoOffset=(uint32_t)_debug_info.length;
+    uint32_t tLineNumberProgramOffset=(uint32_t)_debug_line.length;
+    
+    [self _writeLineNumberProgramOfCompilationUnitAtIndex:inIndex];
+    
+    [self _writeAddressRangesOfCompilationUnitAtIndex:inIndex debugInfoOffset:tDebugInfoOffset];
+    
+    // Header (the unit length is patched at the end)
+    
+    UNXAppendUInt32(_debug_info,0);
+    UNXAppendUInt16(_debug_info,4);
+    UNXAppendUInt32(_debug_info,0);
+    UNXAppendUInt8(_debug_info,sizeof(uint64_t));
+    
+    // Compile unit
+    
+    UNXAppendULEB128(_debug_info,UNXAbbreviationCodeCompileUnit);
+    UNXAppendUInt32(_debug_info,[self _offsetOfString:@"Synthetic clang version"]);
+    UNXAppendUInt16(_debug_info,DW_LANG_C99);
+    UNXAppendUInt32(_debug_info,[self _offsetOfString:[NSString stringWithFormat:@"Sources/file_%lu.c",(unsigned long)inIndex]]);
+    UNXAppendUInt32(_debug_info,tLineNumberProgramOffset);
+    UNXAppendUInt32(_debug_info,[self _offsetOfString:@"/tmp/synthetic"]);
+    UNXAppendUInt64(_debug_info,[self lowPCOfFunctionAtIndex:tFirstFunctionIndex]);
+    UNXAppendUInt32(_debug_info,(uint32_t)(tFunctionsCount*tFunctionSize));
+    
+    // Abstract instances of the inlined functions (references are relative to the unit header)
+    
+    NSUInteger tInliningDepth=self.inliningDepth;
+    uint32_t * tAbstractSubProgramsOffsets=(tInliningDepth>0) ? malloc(tInliningDepth*sizeof(uint32_t)) : NULL;
+    
+    for(NSUInteger tDepth=0;tDepth<tInliningDepth;tDepth++)
+    {
+        tAbstractSubProgramsOffsets[tDepth]=(uint32_t)(_debug_info.length-tDebugInfoOffset);
+        
+        UNXAppendULEB128(_debug_info,UNXAbbreviationCodeAbstractSubProgram);
+        UNXAppendUInt32(_debug_info,[self _offsetOfString:[NSString stringWithFormat:@"inlined_function_%lu_%lu",(unsigned long)inIndex,(unsigned long)tDepth]]);
+        UNXAppendUInt8(_debug_info,1);
+        UNXAppendUInt32(_debug_info,(uint32_t)(tDepth+1));
+        UNXAppendUInt8(_debug_info,UNX_DW_INL_inlined);
+    }
+    
+    // Concrete functions
+    
+    for(NSUInteger tFunctionIndex=tFirstFunctionIndex;tFunctionIndex<(tFirstFunctionIndex+tFunctionsCount);tFunctionIndex++)
+    {
+        uint64_t tLowPC=[self lowPCOfFunctionAtIndex:tFunctionIndex];
+        uint32_t tDeclarationLine=(uint32_t)((tFunctionIndex-tFirstFunctionIndex)*([self _effectiveNumberOfLineRowsPerFunction]+UNXSyntheticFunctionFirstLine)+UNXSyntheticFunctionFirstLine);
+        
+        // Each inlined subroutine covers the middle half of its parent
+        
+        NSUInteger tNestingLevel=0;
+        uint64_t tInlinedSize=tFunctionSize;
+        
+        while (tNestingLevel<tInliningDepth && tInlinedSize>=2*UNXSyntheticInstructionSize)
+        {
+            tInlinedSize=(tInlinedSize/2) & ~(uint64_t)(UNXSyntheticInstructionSize-1);
+            
+            tNestingLevel++;
+        }
+        
+        UNXAppendULEB128(_debug_info,(tNestingLevel>0) ? UNXAbbreviationCodeSubProgram : UNXAbbreviationCodeLeafSubProgram);
+        UNXAppendUInt64(_debug_info,tLowPC);
+        UNXAppendUInt32(_debug_info,(uint32_t)tFunctionSize);
+        UNXAppendUInt32(_debug_info,[self _offsetOfString:[NSString stringWithFormat:@"function_%lu",(unsigned long)tFunctionIndex]]);
+        UNXAppendUInt8(_debug_info,1);
+        UNXAppendUInt32(_debug_info,tDeclarationLine);
+        
+        uint64_t tInlinedLowPC=tLowPC;
+        
+        tInlinedSize=tFunctionSize;
+        
+        for(NSUInteger tDepth=0;tDepth<tNestingLevel;tDepth++)
+        {
+            tInlinedLowPC+=(tInlinedSize/4) & ~(uint64_t)(UNXSyntheticInstructionSize-1);
+            tInlinedSize=(tInlinedSize/2) & ~(uint64_t)(UNXSyntheticInstructionSize-1);
+            
+            UNXAppendULEB128(_debug_info,(tDepth<(tNestingLevel-1)) ? UNXAbbreviationCodeInlinedSubroutine : UNXAbbreviationCodeLeafInlinedSubroutine);
+            UNXAppendUInt32(_debug_info,tAbstractSubProgramsOffsets[tDepth]);
+            UNXAppendUInt64(_debug_info,tInlinedLowPC);
+            UNXAppendUInt32(_debug_info,(uint32_t)tInlinedSize);
+            UNXAppendUInt8(_debug_info,1);
+            UNXAppendUInt32(_debug_info,tDeclarationLine+1+(uint32_t)tDepth);
+        }
+        
+        // End of the children of the inlined subroutines and of the sub program
+        
+        for(NSUInteger tLevel=0;tLevel<tNestingLevel;tLevel++)
+            UNXAppendULEB128(_debug_info,0);
+    }
+    
+    free(tAbstractSubProgramsOffsets);
+    
+    // End of the children of the compile unit
+    
+    UNXAppendULEB128(_debug_info,0);
+    
+    UNXPatchUInt32(_debug_info,tDebugInfoOffset,(uint32_t)(_debug_info.length-tDebugInfoOffset-sizeof(uint32_t)));
+}
+
+- (void)_writeLineNumberProgramOfCompilationUnitAtIndex:(NSUInteger)inIndex
+{
+    NSUInteger tFunctionsCount=self.numberOfFunctionsPerCompilationUnit;
+    NSUInteger tFirstFunctionIndex=inIndex*tFunctionsCount;
+    NSUInteger tRowsCount=[self _effectiveNumberOfLineRowsPerFunction];
+    
+    NSUInteger tUnitOffset=_debug_line.length;
+    
+    // Header
+    
+    UNXAppendUInt32(_debug_line,0);
+    UNXAppendUInt16(_debug_line,4);
+    
+    NSUInteger tHeaderLengthOffset=_debug_line.length;
+    
+    UNXAppendUInt32(_debug_line,0);
+    
+    UNXAppendUInt8(_debug_line,1);     // minimum_instruction_length
+    UNXAppendUInt8(_debug_line,1);     // maximum_operations_per_instruction
+    UNXAppendUInt8(_debug_line,1);     // default_is_stmt
+    UNXAppendUInt8(_debug_line,(uint8_t)UNXLineBase);
+    UNXAppendUInt8(_debug_line,UNXLineRange);
+    UNXAppendUInt8(_debug_line,UNXOpcodeBase);
+    
+    static uint8_t sStandardOpcodeLengths[UNXOpcodeBase-1]={0,1,1,1,1,0,0,0,1,0,0,1};
+    
+    [_debug_line appendBytes:sStandardOpcodeLengths length:sizeof(sStandardOpcodeLengths)];
+    
+    UNXAppendCString(_debug_line,"Sources");
+    UNXAppendUInt8(_debug_line,0);
+    
+    UNXAppendCString(_debug_line,[NSString stringWithFormat:@"file_%lu.c",(unsigned long)inIndex].UTF8String);
+    UNXAppendULEB128(_debug_line,1);
+    UNXAppendULEB128(_debug_line,0);
+    UNXAppendULEB128(_debug_line,0);
+    UNXAppendUInt8(_debug_line,0);
+    
+    UNXPatchUInt32(_debug_line,tHeaderLengthOffset,(uint32_t)(_debug_line.length-tHeaderLengthOffset-sizeof(uint32_t)));
+    
+    // Program
+    
+    UNXAppendUInt8(_debug_line,0);
+    UNXAppendULEB128(_debug_line,1+sizeof(uint64_t));
+    UNXAppendUInt8(_debug_line,UNX_DW_LNE_set_address);
+    UNXAppendUInt64(_debug_line,[self lowPCOfFunctionAtIndex:tFirstFunctionIndex]);
+    
+    int64_t tCurrentLine=1;
+    
+    // One row per instruction: line+1, address+UNXSyntheticInstructionSize
+    
+    uint8_t tSpecialOpcode=(1-UNXLineBase)+UNXLineRange*UNXSyntheticInstructionSize+UNXOpcodeBase;
+    
+    for(NSUInteger tFunctionIndex=tFirstFunctionIndex;tFunctionIndex<(tFirstFunctionIndex+tFunctionsCount);tFunctionIndex++)
+    {
+        int64_t tFirstLine=(int64_t)((tFunctionIndex-tFirstFunctionIndex)*(tRowsCount+UNXSyntheticFunctionFirstLine)+UNXSyntheticFunctionFirstLine+1);
+        
+        if (tFunctionIndex>tFirstFunctionIndex)
+        {
+            UNXAppendUInt8(_debug_line,UNX_DW_LNS_advance_pc);
+            UNXAppendULEB128(_debug_line,UNXSyntheticInstructionSize);
+        }
+        
+        UNXAppendUInt8(_debug_line,UNX_DW_LNS_advance_line);
+        UNXAppendLEB128(_debug_line,tFirstLine-tCurrentLine);
+        UNXAppendUInt8(_debug_line,UNX_DW_LNS_copy);
+        
+        tCurrentLine=tFirstLine;
+        
+        for(NSUInteger tRow=1;tRow<tRowsCount;tRow++)
+        {
+            UNXAppendUInt8(_debug_line,tSpecialOpcode);
+            
+            tCurrentLine++;
+        }
+    }
+    
+    UNXAppendUInt8(_debug_line,UNX_DW_LNS_advance_pc);
+    UNXAppendULEB128(_debug_line,UNXSyntheticInstructionSize);
+    
+    UNXAppendUInt8(_debug_line,0);
+    UNXAppendULEB128(_debug_line,1);
+    UNXAppendUInt8(_debug_line,UNX_DW_LNE_end_sequence);
+    
+    UNXPatchUInt32(_debug_line,tUnitOffset,(uint32_t)(_debug_line.length-tUnitOffset-sizeof(uint32_t)));
+}
+
+- (void)_writeAddressRangesOfCompilationUnitAtIndex:(NSUInteger)inIndex debugInfoOffset:(uint32_t)inDebugInfoOffset
+{
+    NSUInteger tFunctionsCount=self.numberOfFunctionsPerCompilationUnit;
+    NSUInteger tFirstFunctionIndex=inIndex*tFunctionsCount;
+    
+    NSUInteger tUnitOffset=_debug_aranges.length;
+    
+    UNXAppendUInt32(_debug_aranges,0);
+    UNXAppendUInt16(_debug_aranges,2);
+    UNXAppendUInt32(_debug_aranges,inDebugInfoOffset);
+    UNXAppendUInt8(_debug_aranges,sizeof(uint64_t));
+    UNXAppendUInt8(_debug_aranges,0);
+    
+    // The tuples are aligned on twice the address size
+    
+    UNXAppendUInt32(_debug_aranges,0);
+    
+    UNXAppendUInt64(_debug_aranges,[self lowPCOfFunctionAtIndex:tFirstFunctionIndex]);
+    UNXAppendUInt64(_debug_aranges,tFunctionsCount*[self sizeOfFunctionAtIndex:tFirstFunctionIndex]);
+    
+    UNXAppendUInt64(_debug_aranges,0);
+    UNXAppendUInt64(_debug_aranges,0);
+    
+    UNXPatchUInt32(_debug_aranges,tUnitOffset,(uint32_t)(_debug_aranges.length-tUnitOffset-sizeof(uint32_t)));
+}
+
+- (NSData *)_machObjectFileData
+{
+    NSArray<NSString *> * tSectionsNames=@[@"__debug_line",@"__debug_aranges",@"__debug_info",@"__debug_abbrev",@"__debug_str"];
+    NSArray<NSData *> * tSectionsData=@[_debug_line,_debug_aranges,_debug_info,_debug_abbrev,_debug_str];
+    
+    uint32_t tNumberOfSections=(uint32_t)tSectionsNames.count;
+    uint32_t tLoadCommandsSize=sizeof(struct uuid_command)+sizeof(struct segment_command_64)+tNumberOfSections*sizeof(struct section_64);
+    
+    uint64_t tSegmentFileOffset=(sizeof(struct mach_header_64)+tLoadCommandsSize+UNXSyntheticSegmentAlignment-1) & ~(uint64_t)(UNXSyntheticSegmentAlignment-1);
+    uint64_t tSegmentFileSize=0;
+    
+    for(NSData * tData in tSectionsData)
+        tSegmentFileSize+=tData.length;
+    
+    NSMutableData * tMutableData=[NSMutableData dataWithCapacity:(NSUInteger)(tSegmentFileOffset+tSegmentFileSize)];
+    
+    struct mach_header_64 tHeader={0};
+    
+    tHeader.magic=MH_MAGIC_64;
+    tHeader.cputype=CPU_TYPE_ARM64;
+    tHeader.cpusubtype=CPU_SUBTYPE_ARM64_ALL;
+    tHeader.filetype=MH_DSYM;
+    tHeader.ncmds=2;
+    tHeader.sizeofcmds=tLoadCommandsSize;
+    
+    [tMutableData appendBytes:&tHeader length:sizeof(struct mach_header_64)];
+    
+    struct uuid_command tUUIDCommand={0};
+    
+    tUUIDCommand.cmd=LC_UUID;
+    tUUIDCommand.cmdsize=sizeof(struct uuid_command);
+    [[NSUUID UUID] getUUIDBytes:tUUIDCommand.uuid];
+    
+    [tMutableData appendBytes:&tUUIDCommand length:sizeof(struct uuid_command)];
+    
+    struct segment_command_64 tSegmentCommand={0};
+    
+    tSegmentCommand.cmd=LC_SEGMENT_64;
+    tSegmentCommand.cmdsize=sizeof(struct segment_command_64)+tNumberOfSections*sizeof(struct section_64);
+    strncpy(tSegmentCommand.segname,"__DWARF",sizeof(tSegmentCommand.segname));
+    tSegmentCommand.vmaddr=UNXSyntheticTextBaseAddress+self.textSize;
+    tSegmentCommand.vmsize=tSegmentFileSize;
+    tSegmentCommand.fileoff=tSegmentFileOffset;
+    tSegmentCommand.filesize=tSegmentFileSize;
+    tSegmentCommand.maxprot=VM_PROT_READ|VM_PROT_WRITE|VM_PROT_EXECUTE;
+    tSegmentCommand.initprot=VM_PROT_READ|VM_PROT_WRITE;
+    tSegmentCommand.nsects=tNumberOfSections;
+    
+    [tMutableData appendBytes:&tSegmentCommand length:sizeof(struct segment_command_64)];
+    
+    uint64_t tSectionOffset=tSegmentFileOffset;
+    
+    for(uint32_t tIndex=0;tIndex<tNumberOfSections;tIndex++)
+    {
+        struct section_64 tSection={0};
+        
+        strncpy(tSection.sectname,tSectionsNames[tIndex].UTF8String,sizeof(tSection.sectname));
+        strncpy(tSection.segname,"__DWARF",sizeof(tSection.segname));
+        tSection.addr=tSegmentCommand.vmaddr+(tSectionOffset-tSegmentFileOffset);
+        tSection.size=tSectionsData[tIndex].length;
+        tSection.offset=(uint32_t)tSectionOffset;
+        tSection.flags=S_REGULAR|S_ATTR_DEBUG;
+        
+        [tMutableData appendBytes:&tSection length:sizeof(struct section_64)];
+        
+        tSectionOffset+=tSection.size;
+    }
+    
+    tMutableData.length=(NSUInteger)tSegmentFileOffset;
+    
+    for(NSData * tData in tSectionsData)
+        [tMutableData appendData:tData];
+    
+    return tMutableData;
+}
+
+#pragma mark -
+
+- (BOOL)writeToFile:(NSString *)inPath error:(NSError **)outError
+{
+    if (inPath==nil)
+        return NO;
+    
+    _debug_abbrev=[NSMutableData data];
+    _debug_info=[NSMutableData data];
+    _debug_line=[NSMutableData data];
+    _debug_aranges=[NSMutableData data];
+    _debug_str=[NSMutableData data];
+    
+    _stringsOffsets=[NSMutableDictionary dictionary];
+    
+    // The offset 0 of __debug_str is the empty string
+    
+    [self _offsetOfString:@""];
+    
+    [self _writeAbbreviations];
+    
+    for(NSUInteger tIndex=0;tIndex<self.numberOfCompilationUnits;tIndex++)
+    {
+        @autoreleasepool
+        {
+            [self _writeCompilationUnitAtIndex:tIndex];
+        }
+    }
+    
+    NSData * tData=[self _machObjectFileData];
+    
+    _debug_abbrev=nil;
+    _debug_info=nil;
+    _debug_line=nil;
+    _debug_aranges=nil;
+    _debug_str=nil;
+    
+    _stringsOffsets=nil;
+    
+    return [tData writeToFile:inPath options:NSDataWritingAtomic error:outError];
+}
+
+@end
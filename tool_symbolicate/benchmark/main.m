@@ -0,0 +1,334 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#include <getopt.h>
+
+#import "UNXSyntheticDWARFFileGenerator.h"
+
+#import "UNXSymbolicationBenchmark.h"
+
+#import "UNXSyntheticCrashLogGenerator.h"
+
+#import "UNXCrashLogParsingBenchmark.h"
+
+#import "UNXCrashLogsListingBenchmark.h"
+
+static void usage(void)
+{
+    fprintf(stderr,"usage: symbolicate-benchmark [-c compilation_units] [-n functions_per_unit] [-i inlining_depth] [-l line_rows_per_function]\n"
+                   "                             [-w warm_lookups] [-b batch_lookups] [-s seed] [-g fixture_path | -f fixture_path] [-o results_path]\n"
+                   "       symbolicate-benchmark -p [-j] [-z crash_log_size] [-r iterations] [-s seed] [-g fixture_path | -f fixture_path] [-o results_path]\n"
+                   "       symbolicate-benchmark -t crash_logs_count [-j] [-z crash_log_size] [-r iterations] [-s seed] [-g directory_path | -f directory_path] [-o results_path]\n");
+    
+    exit(1);
+}
+
+static NSUInteger unsignedIntegerArgument(const char * inArgument)
+{
+    char * tEnd=NULL;
+    
+    unsigned long long tValue=strtoull(inArgument,&tEnd,0);
+    
+    if (tEnd==inArgument || *tEnd!='\0')
+        usage();
+    
+    return (NSUInteger)tValue;
+}
+
+int main(int argc, const char * argv[])
+{
+    @autoreleasepool
+    {
+        UNXSyntheticDWARFFileGenerator * tGenerator=[UNXSyntheticDWARFFileGenerator new];
+        NSUInteger tNumberOfWarmLookUps=1000;
+        NSUInteger tNumberOfBatchLookUps=10000;
+        uint64_t tSeed=0;
+        NSString * tFixturePath=nil;
+        BOOL tGenerateOnly=NO;
+        NSString * tResultsPath=nil;
+        BOOL tCrashLogParsing=NO;
+        UNXSyntheticCrashLogGenerator * tCrashLogGenerator=[UNXSyntheticCrashLogGenerator new];
+        NSUInteger tNumberOfIterations=10;
+        NSUInteger tNumberOfListedCrashLogs=0;
+        BOOL tCrashLogSizeSet=NO;
+        
+        static struct option sLongOptions[] =
+        {
+            {"compilation-units",   required_argument,  NULL,   'c'},
+            {"functions",           required_argument,  NULL,   'n'},
+            {"inlining-depth",      required_argument,  NULL,   'i'},
+            {"line-rows",           required_argument,  NULL,   'l'},
+            {"warm-lookups",        required_argument,  NULL,   'w'},
+            {"batch-lookups",       required_argument,  NULL,   'b'},
+            {"seed",                required_argument,  NULL,   's'},
+            {"generate",            required_argument,  NULL,   'g'},
+            {"fixture",             required_argument,  NULL,   'f'},
+            {"output",              required_argument,  NULL,   'o'},
+            {"crash-log",           no_argument,        NULL,   'p'},
+            {"crash-log-size",      required_argument,  NULL,   'z'},
+            {"iterations",          required_argument,  NULL,   'r'},
+            {"listing",             required_argument,  NULL,   't'},
+            {"ips",                 no_argument,        NULL,   'j'},
+            {"help",                no_argument,        NULL,   'h'},
+            {NULL,                  0,                  NULL,   0}
+        };
+        
+        int tOption;
+        
+        while ((tOption=getopt_long(argc,(char * const *)argv,"c:n:i:l:w:b:s:g:f:o:pz:r:t:jh",sLongOptions,NULL))!=-1)
+        {
+            switch(tOption)
+            {
+                case 'c':
+                    
+                    tGenerator.numberOfCompilationUnits=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'n':
+                    
+                    tGenerator.numberOfFunctionsPerCompilationUnit=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'i':
+                    
+                    tGenerator.inliningDepth=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'l':
+                    
+                    tGenerator.numberOfLineRowsPerFunction=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'w':
+                    
+                    tNumberOfWarmLookUps=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'b':
+                    
+                    tNumberOfBatchLookUps=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 's':
+                    
+                    tSeed=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 'g':
+                    
+                    tGenerateOnly=YES;
+                    
+                    // Fall through
+                    
+                case 'f':
+                    
+                    if (tFixturePath!=nil)
+                        usage();
+                    
+                    tFixturePath=[NSString stringWithUTF8String:optarg].stringByStandardizingPath;
+                    
+                    break;
+                    
+                case 'o':
+                    
+                    tResultsPath=[NSString stringWithUTF8String:optarg].stringByStandardizingPath;
+                    
+                    break;
+                    
+                case 'p':
+                    
+                    tCrashLogParsing=YES;
+                    
+                    break;
+                    
+                case 'z':
+                    
+                    tCrashLogGenerator.size=unsignedIntegerArgument(optarg);
+                    
+                    tCrashLogSizeSet=YES;
+                    
+                    break;
+                    
+                case 'r':
+                    
+                    tNumberOfIterations=unsignedIntegerArgument(optarg);
+                    
+                    break;
+                    
+                case 't':
+                    
+                    tNumberOfListedCrashLogs=unsignedIntegerArgument(optarg);
+                    
+                    if (tNumberOfListedCrashLogs==0)
+                        usage();
+                    
+                    break;
+                    
+                case 'j':
+                    
+                    tCrashLogGenerator.ipsReport=YES;
+                    
+                    break;
+                    
+                case 'h':
+                default:
+                    
+                    usage();
+                    
+                    break;
+            }
+        }
+        
+        if (optind<argc)
+            usage();
+        
+        BOOL tCrashLogsListing=(tNumberOfListedCrashLogs>0);
+        
+        if (tCrashLogsListing==YES)
+        {
+            if (tCrashLogParsing==YES)
+                usage();
+            
+            // The size of a typical crash log
+            
+            if (tCrashLogSizeSet==NO)
+                tCrashLogGenerator.size=64*1024;
+            
+            tCrashLogParsing=YES;
+        }
+        
+        if (tCrashLogParsing==NO && tCrashLogGenerator.isIPSReport==YES)
+            usage();
+        
+        if (tCrashLogParsing==NO && (tGenerator.numberOfCompilationUnits==0 || tGenerator.numberOfFunctionsPerCompilationUnit==0))
+            usage();
+        
+        // Fixture
+        
+        BOOL tRemoveFixture=NO;
+        
+        if (tFixturePath==nil)
+        {
+            tFixturePath=[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"symbolicate-benchmark-%@.%@",[NSUUID UUID].UUIDString,(tCrashLogsListing==YES) ? @"crashlogs" : ((tCrashLogParsing==YES) ? ((tCrashLogGenerator.isIPSReport==YES) ? @"ips" : @"crash") : @"dwarf")]];
+            
+            tRemoveFixture=YES;
+        }
+        
+        if (tRemoveFixture==YES || tGenerateOnly==YES)
+        {
+            NSError * tError=nil;
+            BOOL tWritten;
+            
+            // The generation buffers must not be accounted for in the peak resident set size
+            
+            @autoreleasepool
+            {
+                if (tCrashLogParsing==YES)
+                {
+                    if (tSeed!=0)
+                        tCrashLogGenerator.seed=tSeed;
+                    
+                    if (tCrashLogsListing==YES)
+                        tWritten=[tCrashLogGenerator writeCrashLogs:tNumberOfListedCrashLogs toDirectory:tFixturePath error:&tError];
+                    else
+                        tWritten=[tCrashLogGenerator writeToFile:tFixturePath error:&tError];
+                }
+                else
+                {
+                    tWritten=[tGenerator writeToFile:tFixturePath error:&tError];
+                }
+            }
+            
+            if (tWritten==NO)
+            {
+                fprintf(stderr,"error: could not write \"%s\": %s\n",tFixturePath.fileSystemRepresentation,tError.localizedDescription.UTF8String);
+                
+                return 1;
+            }
+            
+            if (tGenerateOnly==YES)
+                return 0;
+        }
+        
+        // Benchmark
+        
+        NSDictionary * tResults=nil;
+        
+        if (tCrashLogsListing==YES)
+        {
+            UNXCrashLogsListingBenchmark * tBenchmark=[[UNXCrashLogsListingBenchmark alloc] initWithDirectoryPath:tFixturePath];
+            
+            tBenchmark.numberOfIterations=tNumberOfIterations;
+            
+            tResults=[tBenchmark run];
+        }
+        else if (tCrashLogParsing==YES)
+        {
+            UNXCrashLogParsingBenchmark * tBenchmark=[[UNXCrashLogParsingBenchmark alloc] initWithFilePath:tFixturePath];
+            
+            tBenchmark.numberOfIterations=tNumberOfIterations;
+            
+            tResults=[tBenchmark run];
+        }
+        else
+        {
+            UNXSymbolicationBenchmark * tBenchmark=[[UNXSymbolicationBenchmark alloc] initWithFilePath:tFixturePath generator:tGenerator];
+            
+            tBenchmark.numberOfWarmLookUps=tNumberOfWarmLookUps;
+            tBenchmark.numberOfBatchLookUps=tNumberOfBatchLookUps;
+            
+            if (tSeed!=0)
+                tBenchmark.seed=tSeed;
+            
+            tResults=[tBenchmark run];
+        }
+        
+        if (tRemoveFixture==YES)
+            [[NSFileManager defaultManager] removeItemAtPath:tFixturePath error:NULL];
+        
+        if (tResults==nil)
+        {
+            fprintf(stderr,"error: could not open \"%s\" as a %s\n",tFixturePath.fileSystemRepresentation,(tCrashLogsListing==YES) ? "crash logs directory" : ((tCrashLogParsing==YES) ? "crash log" : "dSYM file"));
+            
+            return 1;
+        }
+        
+        NSData * tData=[NSJSONSerialization dataWithJSONObject:tResults options:NSJSONWritingPrettyPrinted|NSJSONWritingSortedKeys error:NULL];
+        
+        if (tResultsPath!=nil)
+        {
+            if ([tData writeToFile:tResultsPath atomically:YES]==NO)
+            {
+                fprintf(stderr,"error: could not write \"%s\"\n",tResultsPath.fileSystemRepresentation);
+                
+                return 1;
+            }
+        }
+        else
+        {
+            fwrite(tData.bytes,1,tData.length,stdout);
+            fputc('\n',stdout);
+        }
+        
+        return 0;
+    }
+}
@@ -0,0 +1,365 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXBatchSymbolicator.h"
+
+#import "CUICrashLogsProvider.h"
+
+#import "CUICrashLog.h"
+
+#import "CUISymbolicationDataFormatter.h"
+
+@interface UNXBatchSymbolicator ()
+{
+    UNXdSYMBundlesRegistry * _bundlesRegistry;
+    
+    NSUInteger _numberOfProcessedCrashLogs;
+    
+    NSUInteger _numberOfFailedCrashLogs;
+    
+    NSUInteger _numberOfStackFrames;
+    
+    NSUInteger _numberOfSymbolicatedStackFrames;
+}
+
+- (BOOL)_symbolicateCrashLogAtPath:(NSString *)inPath;
+
+- (CUIBinaryImage *)_binaryImageForStackFrame:(CUIStackFrame *)inStackFrame crashLog:(CUICrashLog *)inCrashLog;
+
+- (NSString *)_textualRepresentationOfThreads:(NSArray *)inThreads crashLogPath:(NSString *)inPath;
+
+- (NSData *)_JSONRepresentationOfThreads:(NSArray *)inThreads crashLog:(CUICrashLog *)inCrashLog crashLogPath:(NSString *)inPath;
+
+@end
+
+@implementation UNXBatchSymbolicator
+
+- (instancetype)initWithBundlesRegistry:(UNXdSYMBundlesRegistry *)inBundlesRegistry
+{
+    if (inBundlesRegistry==nil)
+        return nil;
+    
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _bundlesRegistry=inBundlesRegistry;
+        
+        _outputFormat=UNXBatchSymbolicatorOutputFormatText;
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)numberOfProcessedCrashLogs
+{
+    return __atomic_load_n(&_numberOfProcessedCrashLogs,__ATOMIC_RELAXED);
+}
+
+- (NSUInteger)numberOfFailedCrashLogs
+{
+    return __atomic_load_n(&_numberOfFailedCrashLogs,__ATOMIC_RELAXED);
+}
+
+- (NSUInteger)numberOfStackFrames
+{
+    return __atomic_load_n(&_numberOfStackFrames,__ATOMIC_RELAXED);
+}
+
+- (NSUInteger)numberOfSymbolicatedStackFrames
+{
+    return __atomic_load_n(&_numberOfSymbolicatedStackFrames,__ATOMIC_RELAXED);
+}
+
+#pragma mark -
+
+- (void)symbolicateCrashLogsAtPaths:(NSArray<NSString *> *)inPaths
+{
+    dispatch_semaphore_t tSemaphore=NULL;
+    
+    if (self.maximumNumberOfConcurrentJobs>0)
+        tSemaphore=dispatch_semaphore_create(self.maximumNumberOfConcurrentJobs);
+    
+    dispatch_apply(inPaths.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED,0), ^(size_t bIndex) {
+        
+        if (tSemaphore!=NULL)
+            dispatch_semaphore_wait(tSemaphore, DISPATCH_TIME_FOREVER);
+        
+        @autoreleasepool
+        {
+            if ([self _symbolicateCrashLogAtPath:inPaths[bIndex]]==NO)
+                __atomic_fetch_add(&self->_numberOfFailedCrashLogs,1,__ATOMIC_RELAXED);
+            
+            __atomic_fetch_add(&self->_numberOfProcessedCrashLogs,1,__ATOMIC_RELAXED);
+        }
+        
+        if (tSemaphore!=NULL)
+            dispatch_semaphore_signal(tSemaphore);
+    });
+}
+
+- (BOOL)_symbolicateCrashLogAtPath:(NSString *)inPath
+{
+    NSError * tError=nil;
+    
+    CUICrashLog * tCrashLog=[[CUICrashLogsProvider defaultProvider] crashLogWithContentsOfFile:inPath error:&tError];
+    
+    if ([tCrashLog isKindOfClass:CUICrashLog.class]==NO)
+    {
+        fprintf(stderr,"error: \"%s\" could not be parsed as a crash log\n",inPath.fileSystemRepresentation);
+        
+        return NO;
+    }
+    
+    if (tCrashLog.isFullyParsed==NO)
+        [tCrashLog finalizeParsing];
+    
+    NSArray<CUIThread *> * tThreads=tCrashLog.backtraces.threads;
+    
+    NSUInteger tNumberOfStackFrames=0;
+    NSUInteger tNumberOfSymbolicatedStackFrames=0;
+    
+    for(CUIThread * tThread in tThreads)
+    {
+        for(CUIStackFrame * tStackFrame in tThread.callStackBacktrace.stackFrames)
+        {
+            tNumberOfStackFrames+=1;
+            
+            if (tStackFrame.symbolicationData!=nil)
+            {
+                tNumberOfSymbolicatedStackFrames+=1;
+                continue;
+            }
+            
+            CUIBinaryImage * tBinaryImage=[self _binaryImageForStackFrame:tStackFrame crashLog:tCrashLog];
+            
+            if ([_bundlesRegistry containsBinaryUUID:tBinaryImage.UUID]==NO)
+                continue;
+            
+            CUISymbolicationData * tSymbolicationData=nil;
+            
+            switch([_bundlesRegistry lookUpSymbolicationDataForMachineInstructionAddress:tStackFrame.machineInstructionAddress-tBinaryImage.binaryImageOffset
+                                                                             binaryUUID:tBinaryImage.UUID
+                                                                      symbolicationData:&tSymbolicationData])
+            {
+                case CUISymbolicationDataLookUpResultFound:
+                case CUISymbolicationDataLookUpResultFoundInCache:
+                    
+                    tStackFrame.symbolicationData=tSymbolicationData;
+                    
+                    tNumberOfSymbolicatedStackFrames+=1;
+                    
+                    break;
+                    
+                default:
+                    
+                    break;
+            }
+        }
+    }
+    
+    __atomic_fetch_add(&_numberOfStackFrames,tNumberOfStackFrames,__ATOMIC_RELAXED);
+    __atomic_fetch_add(&_numberOfSymbolicatedStackFrames,tNumberOfSymbolicatedStackFrames,__ATOMIC_RELAXED);
+    
+    NSData * tData=nil;
+    
+    switch(self.outputFormat)
+    {
+        case UNXBatchSymbolicatorOutputFormatText:
+            
+            tData=[[self _textualRepresentationOfThreads:tThreads crashLogPath:inPath] dataUsingEncoding:NSUTF8StringEncoding];
+            
+            break;
+            
+        case UNXBatchSymbolicatorOutputFormatJSON:
+            
+            tData=[self _JSONRepresentationOfThreads:tThreads crashLog:tCrashLog crashLogPath:inPath];
+            
+            break;
+    }
+    
+    if (tData==nil)
+    {
+        fprintf(stderr,"error: could not create the output for \"%s\"\n",inPath.fileSystemRepresentation);
+        
+        return NO;
+    }
+    
+    if (self.outputDirectoryPath==nil)
+    {
+        @synchronized(self)
+        {
+            fwrite(tData.bytes,1,tData.length,stdout);
+            
+            if (self.outputFormat==UNXBatchSymbolicatorOutputFormatJSON)
+                fputc('\n',stdout);
+        }
+        
+        return YES;
+    }
+    
+    NSString * tExtension=(self.outputFormat==UNXBatchSymbolicatorOutputFormatJSON) ? @"json" : @"txt";
+    
+    NSString * tOutputPath=[self.outputDirectoryPath stringByAppendingPathComponent:[inPath.lastPathComponent stringByAppendingPathExtension:tExtension]];
+    
+    if ([tData writeToFile:tOutputPath options:NSDataWritingAtomic error:&tError]==NO)
+    {
+        fprintf(stderr,"error: could not write \"%s\": %s\n",tOutputPath.fileSystemRepresentation,tError.localizedDescription.UTF8String);
+        
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (CUIBinaryImage *)_binaryImageForStackFrame:(CUIStackFrame *)inStackFrame crashLog:(CUICrashLog *)inCrashLog
+{
+    NSString * tBinaryImageIdentifier=inStackFrame.binaryImageIdentifier;
+    
+    if (tBinaryImageIdentifier==nil)
+        return nil;
+    
+    CUIBinaryImage * tBinaryImage=[inCrashLog.binaryImages binaryImageWithIdentifier:tBinaryImageIdentifier];
+    
+    if (tBinaryImage==nil)
+    {
+        NSString * tAlternateIdentifier=[inCrashLog.binaryImages binaryImageIdentifierForName:tBinaryImageIdentifier];
+        
+        if (tAlternateIdentifier!=nil)
+            tBinaryImage=[inCrashLog.binaryImages binaryImageWithIdentifier:tAlternateIdentifier];
+    }
+    
+    return tBinaryImage;
+}
+
+#pragma mark - Output
+
+- (NSString *)_textualRepresentationOfThreads:(NSArray *)inThreads crashLogPath:(NSString *)inPath
+{
+    CUISymbolicationDataFormatter * tFormatter=[CUISymbolicationDataFormatter new];
+    
+    NSMutableString * tMutableString=[NSMutableString stringWithFormat:@"==> %@ <==\n\n",inPath];
+    
+    for(CUIThread * tThread in inThreads)
+    {
+        if (tThread.isApplicationSpecificBacktrace==YES)
+        {
+            [tMutableString appendFormat:@"%@:\n",tThread.name];
+        }
+        else
+        {
+            [tMutableString appendFormat:@"Thread %lu%@:",(unsigned long)tThread.number,(tThread.isCrashed==YES) ? @" Crashed" : @""];
+            
+            if (tThread.name.length>0)
+                [tMutableString appendFormat:@": %@",tThread.name];
+            
+            [tMutableString appendString:@"\n"];
+        }
+        
+        for(CUIStackFrame * tStackFrame in tThread.callStackBacktrace.stackFrames)
+        {
+            NSString * tSymbol=nil;
+            
+            if (tStackFrame.symbolicationData!=nil)
+                tSymbol=[tFormatter stringForObjectValue:tStackFrame.symbolicationData];
+            else
+                tSymbol=[NSString stringWithFormat:@"%@ + %lu",tStackFrame.symbol,(unsigned long)tStackFrame.byteOffset];
+            
+            NSString * tBinaryImageIdentifier=(tStackFrame.binaryImageIdentifier!=nil) ? tStackFrame.binaryImageIdentifier : @"???";
+            
+            [tMutableString appendFormat:@"%-4lu%-34s0x%016lx %@\n",(unsigned long)tStackFrame.index,tBinaryImageIdentifier.UTF8String,(unsigned long)tStackFrame.machineInstructionAddress,tSymbol];
+        }
+        
+        [tMutableString appendString:@"\n"];
+    }
+    
+    return [tMutableString copy];
+}
+
+- (NSData *)_JSONRepresentationOfThreads:(NSArray *)inThreads crashLog:(CUICrashLog *)inCrashLog crashLogPath:(NSString *)inPath
+{
+    NSMutableArray * tThreadsArray=[NSMutableArray array];
+    
+    for(CUIThread * tThread in inThreads)
+    {
+        NSMutableArray * tFramesArray=[NSMutableArray array];
+        
+        for(CUIStackFrame * tStackFrame in tThread.callStackBacktrace.stackFrames)
+        {
+            NSMutableDictionary * tFrameDictionary=[NSMutableDictionary dictionary];
+            
+            tFrameDictionary[@"index"]=@(tStackFrame.index);
+            tFrameDictionary[@"address"]=@(tStackFrame.machineInstructionAddress);
+            
+            if (tStackFrame.binaryImageIdentifier!=nil)
+                tFrameDictionary[@"image"]=tStackFrame.binaryImageIdentifier;
+            
+            CUISymbolicationData * tSymbolicationData=tStackFrame.symbolicationData;
+            
+            tFrameDictionary[@"symbolicated"]=@(tSymbolicationData!=nil);
+            
+            if (tSymbolicationData!=nil)
+            {
+                if (tSymbolicationData.stackFrameSymbol!=nil)
+                    tFrameDictionary[@"symbol"]=tSymbolicationData.stackFrameSymbol;
+                
+                tFrameDictionary[@"offset"]=@(tSymbolicationData.byteOffset);
+                
+                if (tSymbolicationData.sourceFilePath!=nil)
+                    tFrameDictionary[@"sourceFile"]=tSymbolicationData.sourceFilePath;
+                
+                if (tSymbolicationData.lineNumber!=0)
+                    tFrameDictionary[@"line"]=@(tSymbolicationData.lineNumber);
+            }
+            else
+            {
+                if (tStackFrame.symbol!=nil)
+                    tFrameDictionary[@"symbol"]=tStackFrame.symbol;
+                
+                tFrameDictionary[@"offset"]=@(tStackFrame.byteOffset);
+            }
+            
+            [tFramesArray addObject:tFrameDictionary];
+        }
+        
+        NSMutableDictionary * tThreadDictionary=[NSMutableDictionary dictionary];
+        
+        if (tThread.isApplicationSpecificBacktrace==NO)
+            tThreadDictionary[@"number"]=@(tThread.number);
+        
+        if (tThread.name!=nil)
+            tThreadDictionary[@"name"]=tThread.name;
+        
+        tThreadDictionary[@"crashed"]=@(tThread.isCrashed);
+        tThreadDictionary[@"frames"]=tFramesArray;
+        
+        [tThreadsArray addObject:tThreadDictionary];
+    }
+    
+    NSMutableDictionary * tDictionary=[NSMutableDictionary dictionary];
+    
+    tDictionary[@"path"]=inPath;
+    
+    if (inCrashLog.processName!=nil)
+        tDictionary[@"process"]=inCrashLog.processName;
+    
+    tDictionary[@"threads"]=tThreadsArray;
+    
+    NSJSONWritingOptions tOptions=(self.outputDirectoryPath!=nil) ? NSJSONWritingPrettyPrinted : 0;
+    
+    return [NSJSONSerialization dataWithJSONObject:tDictionary options:tOptions error:NULL];
+}
+
+@end
@@ -0,0 +1,46 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "CUISymbolicationData.h"
+
+#import "CUISymbolSourcesManager.h"
+
+@interface UNXdSYMBundlesRegistry : NSObject
+
+    @property (nonatomic,readonly) NSUInteger numberOfBundles;
+
+    @property (nonatomic,readonly) NSUInteger numberOfBinaryUUIDs;
+
+    @property (nonatomic,readonly) NSUInteger numberOfSymbolFiles;
+
+// The search paths can contain dSYM bundles and Breakpad symbol files (.sym). A dSYM bundle takes precedence over a symbol file for the same UUID.
+
+- (instancetype)initWithSearchPaths:(NSArray<NSString *> *)inSearchPaths;
+
+- (BOOL)containsBinaryUUID:(NSString *)inBinaryUUID;
+
+// Synchronous. Fetches and registers the dSYM bundles of the binary images with unknown UUIDs. Must be called before any look up. Returns the number of registered bundles
+
+- (NSUInteger)fetchMissingBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages symbolSourcesManager:(CUISymbolSourcesManager *)inSymbolSourcesManager;
+
+// Thread-safe. The look ups for the same dSYM bundle are serialized so that the DWARF data of a UUID is shared by all the callers
+
+- (CUISymbolicationDataLookUpResult)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData;
+
+// Writes a Breakpad symbol file for each binary UUID of the dSYM bundles (<directory>/<module>/<identifier>/<module>.sym). Returns the number of files written
+
+- (NSUInteger)exportBreakpadSymbolFilesToDirectory:(NSString *)inDirectoryPath;
+
+@end
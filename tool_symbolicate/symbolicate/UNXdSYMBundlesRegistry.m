@@ -0,0 +1,378 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "UNXdSYMBundlesRegistry.h"
+
+#import "CUIdSYMBundle.h"
+
+#import "DWRFBreakpadSymbolFile.h"
+
+#import "DWRFBreakpadSymbolFileWriter.h"
+
+#import "CUISymbolicationDataCache.h"
+
+#import "CUISymbolicationNegativeCache.h"
+
+#import "CUISymbolicationMetrics.h"
+
+#import "NSArray+WBExtensions.h"
+
+@interface UNXdSYMBundlesRegistry ()
+{
+    // The registries are only modified before the first look up (see -fetchMissingBundlesForBinaryImages:symbolSourcesManager:)
+    
+    NSMutableDictionary<NSString *,CUIdSYMBundle *> * _bundlesRegistry;
+    
+    NSMutableDictionary<NSString *,DWRFBreakpadSymbolFile *> * _symbolFilesRegistry;
+    
+    // One serial queue per dSYM bundle
+    
+    NSMapTable<CUIdSYMBundle *,dispatch_queue_t> * _bundlesQueues;
+    
+    CUISymbolicationDataCache * _cache;
+    
+    CUISymbolicationNegativeCache * _negativeCache;
+}
+
+    @property (nonatomic) NSUInteger numberOfBundles;
+
+- (void)_collectBundlesAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry symbolFilesRegistry:(NSMutableDictionary *)inSymbolFilesRegistry;
+
+- (void)_registerBundleAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry;
+
+- (void)_registerSymbolFileAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry;
+
+@end
+
+@implementation UNXdSYMBundlesRegistry
+
+- (instancetype)initWithSearchPaths:(NSArray<NSString *> *)inSearchPaths
+{
+    self=[super init];
+    
+    if (self!=nil)
+    {
+        _bundlesRegistry=[NSMutableDictionary dictionary];
+        _symbolFilesRegistry=[NSMutableDictionary dictionary];
+        
+        _bundlesQueues=[NSMapTable strongToStrongObjectsMapTable];
+        
+        for(NSString * tSearchPath in inSearchPaths)
+            [self _collectBundlesAtPath:tSearchPath.stringByStandardizingPath registry:_bundlesRegistry symbolFilesRegistry:_symbolFilesRegistry];
+        
+        [_symbolFilesRegistry removeObjectsForKeys:_bundlesRegistry.allKeys];
+        
+        _cache=[CUISymbolicationDataCache sharedCache];
+        
+        _negativeCache=[CUISymbolicationNegativeCache sharedCache];
+    }
+    
+    return self;
+}
+
+#pragma mark -
+
+- (NSUInteger)numberOfBinaryUUIDs
+{
+    return _bundlesRegistry.count+_symbolFilesRegistry.count;
+}
+
+- (NSUInteger)numberOfSymbolFiles
+{
+    return _symbolFilesRegistry.count;
+}
+
+#pragma mark -
+
+- (void)_collectBundlesAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry symbolFilesRegistry:(NSMutableDictionary *)inSymbolFilesRegistry
+{
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    if ([inPath.pathExtension caseInsensitiveCompare:@"dSYM"]==NSOrderedSame)
+    {
+        [self _registerBundleAtPath:inPath registry:inRegistry];
+        
+        return;
+    }
+    
+    if ([inPath.pathExtension caseInsensitiveCompare:@"sym"]==NSOrderedSame)
+    {
+        [self _registerSymbolFileAtPath:inPath registry:inSymbolFilesRegistry];
+        
+        return;
+    }
+    
+    NSDirectoryEnumerator * tDirectoryEnumerator=[tFileManager enumeratorAtPath:inPath];
+    
+    if (tDirectoryEnumerator==nil)
+    {
+        fprintf(stderr,"warning: could not browse \"%s\"\n",inPath.fileSystemRepresentation);
+        
+        return;
+    }
+    
+    for(NSString * tRelativePath in tDirectoryEnumerator)
+    {
+        if ([tRelativePath.pathExtension caseInsensitiveCompare:@"sym"]==NSOrderedSame)
+        {
+            [self _registerSymbolFileAtPath:[inPath stringByAppendingPathComponent:tRelativePath] registry:inSymbolFilesRegistry];
+            
+            continue;
+        }
+        
+        if ([tRelativePath.pathExtension caseInsensitiveCompare:@"dSYM"]!=NSOrderedSame)
+            continue;
+        
+        // No need to look inside the bundle
+        
+        [tDirectoryEnumerator skipDescendants];
+        
+        [self _registerBundleAtPath:[inPath stringByAppendingPathComponent:tRelativePath] registry:inRegistry];
+    }
+}
+
+- (void)_registerBundleAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry
+{
+    CUIdSYMBundle * tBundle=[[CUIdSYMBundle alloc] initWithPath:inPath];
+    
+    if (tBundle==nil || tBundle.isDSYMBundle==NO)
+        return;
+    
+    NSArray * tBinaryUUIDs=tBundle.binaryUUIDs;
+    
+    if (tBinaryUUIDs.count==0)
+        return;
+    
+    BOOL tRegistered=NO;
+    
+    for(NSString * tBinaryUUID in tBinaryUUIDs)
+    {
+        if (inRegistry[tBinaryUUID]!=nil)
+            continue;
+        
+        inRegistry[tBinaryUUID]=tBundle;
+        
+        tRegistered=YES;
+    }
+    
+    if (tRegistered==NO)
+        return;
+    
+    NSString * tLabel=[NSString stringWithFormat:@"fr.whitebox.unexpectedly.symbolicate.%lu",(unsigned long)self.numberOfBundles];
+    
+    [_bundlesQueues setObject:dispatch_queue_create(tLabel.UTF8String, DISPATCH_QUEUE_SERIAL) forKey:tBundle];
+    
+    self.numberOfBundles+=1;
+}
+
+- (void)_registerSymbolFileAtPath:(NSString *)inPath registry:(NSMutableDictionary *)inRegistry
+{
+    NSError * tError=nil;
+    
+    DWRFBreakpadSymbolFile * tSymbolFile=[[DWRFBreakpadSymbolFile alloc] initWithContentsOfFile:inPath error:&tError];
+    
+    if (tSymbolFile==nil)
+    {
+        fprintf(stderr,"warning: could not read the symbol file \"%s\": %s\n",inPath.fileSystemRepresentation,tError.localizedDescription.UTF8String);
+        
+        return;
+    }
+    
+    if (inRegistry[tSymbolFile.binaryUUID]!=nil)
+        return;
+    
+    inRegistry[tSymbolFile.binaryUUID]=tSymbolFile;
+}
+
+#pragma mark -
+
+- (BOOL)containsBinaryUUID:(NSString *)inBinaryUUID
+{
+    if (inBinaryUUID==nil)
+        return NO;
+    
+    return (_bundlesRegistry[inBinaryUUID]!=nil || _symbolFilesRegistry[inBinaryUUID]!=nil);
+}
+
+- (NSUInteger)fetchMissingBundlesForBinaryImages:(NSArray<CUIBinaryImage *> *)inBinaryImages symbolSourcesManager:(CUISymbolSourcesManager *)inSymbolSourcesManager
+{
+    if (inSymbolSourcesManager==nil)
+        return 0;
+    
+    NSArray<CUIBinaryImage *> * tMissingBinaryImages=[inBinaryImages WB_filteredArrayUsingBlock:^BOOL(CUIBinaryImage * bBinaryImage, NSUInteger bIndex) {
+        
+        return (bBinaryImage.UUID!=nil && [self containsBinaryUUID:bBinaryImage.UUID]==NO);
+    }];
+    
+    if (tMissingBinaryImages.count==0)
+        return 0;
+    
+    __block NSArray<NSString *> * tBundlesPaths=nil;
+    
+    dispatch_semaphore_t tSemaphore=dispatch_semaphore_create(0);
+    
+    [inSymbolSourcesManager fetchdSYMBundlesForBinaryImages:tMissingBinaryImages completionHandler:^(NSArray<NSString *> * bdSYMBundlesPaths) {
+        
+        tBundlesPaths=bdSYMBundlesPaths;
+        
+        dispatch_semaphore_signal(tSemaphore);
+    }];
+    
+    dispatch_semaphore_wait(tSemaphore, DISPATCH_TIME_FOREVER);
+    
+    NSUInteger tNumberOfBundles=self.numberOfBundles;
+    
+    for(NSString * tBundlePath in tBundlesPaths)
+        [self _registerBundleAtPath:tBundlePath registry:_bundlesRegistry];
+    
+    return self.numberOfBundles-tNumberOfBundles;
+}
+
+- (CUISymbolicationDataLookUpResult)lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)inAddress binaryUUID:(NSString *)inBinaryUUID symbolicationData:(CUISymbolicationData **)outSymbolicationData
+{
+    if (outSymbolicationData!=NULL)
+        *outSymbolicationData=nil;
+    
+    if (inBinaryUUID==nil)
+        return CUISymbolicationDataLookUpResultError;
+    
+    __block CUISymbolicationData * tSymbolicationData=[_cache symbolicationDataForAddress:inAddress binary:inBinaryUUID];
+    
+    if (tSymbolicationData!=nil)
+    {
+        if (outSymbolicationData!=NULL)
+            *outSymbolicationData=tSymbolicationData;
+        
+        return CUISymbolicationDataLookUpResultFoundInCache;
+    }
+    
+    CUISymbolicationInterval tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageBundleLookUp);
+    
+    CUIdSYMBundle * tBundle=_bundlesRegistry[inBinaryUUID];
+    
+    CUISymbolicationIntervalEnd(CUISymbolicationStageBundleLookUp,tInterval);
+    
+    if (tBundle==nil)
+    {
+        // The symbol files are immutable once loaded so there's no need to serialize the look ups
+        
+        DWRFBreakpadSymbolFile * tSymbolFile=_symbolFilesRegistry[inBinaryUUID];
+        
+        if (tSymbolFile==nil)
+            return CUISymbolicationDataLookUpResultNotFound;
+        
+        __block CUISymbolicationDataLookUpResult tLookUpResult=CUISymbolicationDataLookUpResultNotFound;
+        
+        [tSymbolFile lookUpSymbolicationDataForMachineInstructionAddress:inAddress completionHandler:^(BOOL bFound, CUISymbolicationData * bSymbolicationData) {
+            
+            if (bFound==NO)
+                return;
+            
+            [self->_cache setSymbolicationData:bSymbolicationData forAddress:inAddress binary:inBinaryUUID];
+            
+            tSymbolicationData=bSymbolicationData;
+            
+            tLookUpResult=CUISymbolicationDataLookUpResultFound;
+        }];
+        
+        if (outSymbolicationData!=NULL)
+            *outSymbolicationData=tSymbolicationData;
+        
+        return tLookUpResult;
+    }
+    
+    if ([_negativeCache isAddressUnresolvable:inAddress binary:inBinaryUUID symbolsFileSignature:tBundle.symbolsFileSignature]==YES)
+        return CUISymbolicationDataLookUpResultNotFound;
+    
+    // The registry is not modified once the look ups have started so there's no need to lock it
+    
+    dispatch_queue_t tQueue=[_bundlesQueues objectForKey:tBundle];
+    
+    __block CUISymbolicationDataLookUpResult tLookUpResult=CUISymbolicationDataLookUpResultError;
+    
+    tInterval=CUISymbolicationIntervalBegin(CUISymbolicationStageQueueWait);
+    
+    dispatch_sync(tQueue, ^{
+        
+        CUISymbolicationIntervalEnd(CUISymbolicationStageQueueWait,tInterval);
+        
+        CUISymbolicationData * tFoundSymbolicationData=nil;
+        
+        // Another worker may have looked it up in the meantime
+        
+        tFoundSymbolicationData=[self->_cache symbolicationDataForAddress:inAddress binary:inBinaryUUID];
+        
+        if (tFoundSymbolicationData!=nil)
+        {
+            tLookUpResult=CUISymbolicationDataLookUpResultFoundInCache;
+        }
+        else
+        {
+            tLookUpResult=[tBundle lookUpSymbolicationDataForMachineInstructionAddress:inAddress binaryUUID:inBinaryUUID symbolicationData:&tFoundSymbolicationData];
+        }
+        
+        tSymbolicationData=tFoundSymbolicationData;
+    });
+    
+    if (outSymbolicationData!=NULL)
+        *outSymbolicationData=tSymbolicationData;
+    
+    return tLookUpResult;
+}
+
+#pragma mark -
+
+- (NSUInteger)exportBreakpadSymbolFilesToDirectory:(NSString *)inDirectoryPath
+{
+    NSArray<NSString *> * tBinaryUUIDs=_bundlesRegistry.allKeys;
+    
+    __block NSUInteger tNumberOfWrittenFiles=0;
+    
+    dispatch_apply(tBinaryUUIDs.count, dispatch_get_global_queue(QOS_CLASS_UTILITY,0), ^(size_t bIndex) {
+        
+        NSString * tBinaryUUID=tBinaryUUIDs[bIndex];
+        
+        CUIdSYMBundle * tBundle=self->_bundlesRegistry[tBinaryUUID];
+        
+        dispatch_sync([self->_bundlesQueues objectForKey:tBundle], ^{
+            
+            @autoreleasepool
+            {
+                DWRFBreakpadSymbolFileWriter * tWriter=[tBundle breakpadSymbolFileWriterForBinaryUUID:tBinaryUUID];
+                
+                if (tWriter==nil)
+                    return;
+                
+                NSString * tFolderPath=[[inDirectoryPath stringByAppendingPathComponent:tWriter.moduleName] stringByAppendingPathComponent:tWriter.moduleIdentifier];
+                
+                NSString * tFilePath=[tFolderPath stringByAppendingPathComponent:[tWriter.moduleName stringByAppendingPathExtension:@"sym"]];
+                
+                NSError * tError=nil;
+                
+                if ([[NSFileManager defaultManager] createDirectoryAtPath:tFolderPath withIntermediateDirectories:YES attributes:nil error:&tError]==NO ||
+                    [tWriter writeToFile:tFilePath error:&tError]==NO)
+                {
+                    fprintf(stderr,"error: could not write \"%s\": %s\n",tFilePath.fileSystemRepresentation,tError.localizedDescription.UTF8String);
+                    
+                    return;
+                }
+                
+                __atomic_fetch_add(&tNumberOfWrittenFiles,1,__ATOMIC_RELAXED);
+            }
+        });
+    });
+    
+    return tNumberOfWrittenFiles;
+}
+
+@end
@@ -0,0 +1,295 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#include <getopt.h>
+
+#include <mach/mach_time.h>
+
+#import "UNXdSYMBundlesRegistry.h"
+
+#import "UNXBatchSymbolicator.h"
+
+#import "CUISymbolicationMetrics.h"
+
+#import "CUILoadedSymbolsFilesRegistry.h"
+
+#import "CUICrashLogsProvider.h"
+
+#import "CUICrashLog.h"
+
+static void usage(void)
+{
+    fprintf(stderr,"usage: symbolicate [-d dsym_search_path]... [-s symbol_source]... [-C symbols_cache_directory] [-f text|json] [-o output_directory] [-j jobs] [-m] file_or_directory ...\n");
+    fprintf(stderr,"       symbolicate [-d dsym_search_path]... -x breakpad_symbols_directory\n");
+    
+    exit(1);
+}
+
+static double elapsedSeconds(uint64_t inStartTime)
+{
+    static mach_timebase_info_data_t sTimebaseInfo;
+    
+    if (sTimebaseInfo.denom==0)
+        mach_timebase_info(&sTimebaseInfo);
+    
+    return (double)((mach_absolute_time()-inStartTime)*sTimebaseInfo.numer/sTimebaseInfo.denom)/NSEC_PER_SEC;
+}
+
+static NSArray<CUIBinaryImage *> * userCodeBinaryImages(NSArray<NSString *> * inCrashLogsPaths)
+{
+    NSMutableArray * tBinaryImages=[NSMutableArray array];
+    
+    dispatch_apply(inCrashLogsPaths.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED,0), ^(size_t bIndex) {
+        
+        @autoreleasepool
+        {
+            CUICrashLog * tCrashLog=[[CUICrashLogsProvider defaultProvider] crashLogWithContentsOfFile:inCrashLogsPaths[bIndex] error:NULL];
+            
+            if ([tCrashLog isKindOfClass:CUICrashLog.class]==NO)
+                return;
+            
+            if (tCrashLog.isFullyParsed==NO)
+                [tCrashLog finalizeParsing];
+            
+            NSArray * tUserCodeBinaryImages=tCrashLog.binaryImages.userCodeBinaryImages;
+            
+            @synchronized(tBinaryImages)
+            {
+                [tBinaryImages addObjectsFromArray:tUserCodeBinaryImages];
+            }
+        }
+    });
+    
+    return tBinaryImages;
+}
+
+int main(int argc, const char * argv[])
+{
+    @autoreleasepool
+    {
+        NSMutableArray * tSearchPaths=[NSMutableArray array];
+        UNXBatchSymbolicatorOutputFormat tOutputFormat=UNXBatchSymbolicatorOutputFormatText;
+        NSString * tOutputDirectoryPath=nil;
+        NSUInteger tMaximumNumberOfConcurrentJobs=0;
+        BOOL tShowMetrics=NO;
+        NSString * tBreakpadSymbolsDirectoryPath=nil;
+        NSMutableArray * tSymbolSources=[NSMutableArray array];
+        NSString * tSymbolsCacheDirectoryPath=[CUISymbolsFilesCache defaultDirectoryPath];
+        
+        static struct option sLongOptions[] =
+        {
+            {"dsym-path",   required_argument,  NULL,   'd'},
+            {"format",      required_argument,  NULL,   'f'},
+            {"output",      required_argument,  NULL,   'o'},
+            {"jobs",        required_argument,  NULL,   'j'},
+            {"metrics",     no_argument,        NULL,   'm'},
+            {"export-breakpad", required_argument,  NULL,   'x'},
+            {"symbol-source",   required_argument,  NULL,   's'},
+            {"symbols-cache",   required_argument,  NULL,   'C'},
+            {"help",        no_argument,        NULL,   'h'},
+            {NULL,          0,                  NULL,   0}
+        };
+        
+        int tOption;
+        
+        while ((tOption=getopt_long(argc,(char * const *)argv,"d:f:o:j:mx:s:C:h",sLongOptions,NULL))!=-1)
+        {
+            switch(tOption)
+            {
+                case 'd':
+                    
+                    [tSearchPaths addObject:[NSString stringWithUTF8String:optarg]];
+                    
+                    break;
+                    
+                case 'f':
+                    
+                    if (strcmp(optarg,"text")==0)
+                        tOutputFormat=UNXBatchSymbolicatorOutputFormatText;
+                    else if (strcmp(optarg,"json")==0)
+                        tOutputFormat=UNXBatchSymbolicatorOutputFormatJSON;
+                    else
+                        usage();
+                    
+                    break;
+                    
+                case 'o':
+                    
+                    tOutputDirectoryPath=[NSString stringWithUTF8String:optarg].stringByStandardizingPath;
+                    
+                    break;
+                    
+                case 'j':
+                    
+                    tMaximumNumberOfConcurrentJobs=(NSUInteger)strtoul(optarg,NULL,10);
+                    
+                    break;
+                    
+                case 'm':
+                    
+                    tShowMetrics=YES;
+                    
+                    break;
+                    
+                case 'x':
+                    
+                    tBreakpadSymbolsDirectoryPath=[NSString stringWithUTF8String:optarg].stringByStandardizingPath;
+                    
+                    break;
+                    
+                case 's':
+                {
+                    CUISymbolSource * tSymbolSource=[CUISymbolSource symbolSourceWithLocation:[NSString stringWithUTF8String:optarg]];
+                    
+                    if (tSymbolSource==nil)
+                        usage();
+                    
+                    [tSymbolSources addObject:tSymbolSource];
+                    
+                    break;
+                }
+                    
+                case 'C':
+                    
+                    tSymbolsCacheDirectoryPath=[NSString stringWithUTF8String:optarg].stringByStandardizingPath;
+                    
+                    break;
+                    
+                case 'h':
+                default:
+                    
+                    usage();
+                    
+                    break;
+            }
+        }
+        
+        if (optind>=argc && tBreakpadSymbolsDirectoryPath==nil)
+            usage();
+        
+        // Crash logs
+        
+        NSFileManager * tFileManager=[NSFileManager defaultManager];
+        NSMutableArray * tCrashLogsPaths=[NSMutableArray array];
+        
+        for(int tIndex=optind;tIndex<argc;tIndex++)
+        {
+            NSString * tPath=[NSString stringWithUTF8String:argv[tIndex]].stringByStandardizingPath;
+            BOOL tIsDirectory=NO;
+            
+            if ([tFileManager fileExistsAtPath:tPath isDirectory:&tIsDirectory]==NO)
+            {
+                fprintf(stderr,"warning: \"%s\" does not exist\n",tPath.fileSystemRepresentation);
+                continue;
+            }
+            
+            if (tIsDirectory==NO)
+            {
+                [tCrashLogsPaths addObject:tPath];
+                continue;
+            }
+            
+            for(NSString * tComponent in [tFileManager contentsOfDirectoryAtPath:tPath error:NULL])
+            {
+                NSString * tExtension=tComponent.pathExtension;
+                
+                if ([tExtension caseInsensitiveCompare:@"crash"]==NSOrderedSame ||
+                    [tExtension caseInsensitiveCompare:@"ips"]==NSOrderedSame)
+                    [tCrashLogsPaths addObject:[tPath stringByAppendingPathComponent:tComponent]];
+            }
+        }
+        
+        if (tOutputDirectoryPath!=nil && [tFileManager createDirectoryAtPath:tOutputDirectoryPath withIntermediateDirectories:YES attributes:nil error:NULL]==NO)
+        {
+            fprintf(stderr,"error: could not create \"%s\"\n",tOutputDirectoryPath.fileSystemRepresentation);
+            
+            return 1;
+        }
+        
+        // dSYM bundles
+        
+        uint64_t tStartTime=mach_absolute_time();
+        
+        UNXdSYMBundlesRegistry * tBundlesRegistry=[[UNXdSYMBundlesRegistry alloc] initWithSearchPaths:tSearchPaths];
+        
+        fprintf(stderr,"Found %lu dSYM bundles and %lu symbol files (%lu binary UUIDs) in %.2fs\n",(unsigned long)tBundlesRegistry.numberOfBundles,(unsigned long)tBundlesRegistry.numberOfSymbolFiles,(unsigned long)tBundlesRegistry.numberOfBinaryUUIDs,elapsedSeconds(tStartTime));
+        
+        // Breakpad symbol files
+        
+        if (tBreakpadSymbolsDirectoryPath!=nil)
+        {
+            tStartTime=mach_absolute_time();
+            
+            NSUInteger tNumberOfSymbolFiles=[tBundlesRegistry exportBreakpadSymbolFilesToDirectory:tBreakpadSymbolsDirectoryPath];
+            
+            fprintf(stderr,"Exported %lu symbol files in %.2fs\n",(unsigned long)tNumberOfSymbolFiles,elapsedSeconds(tStartTime));
+            
+            return (tNumberOfSymbolFiles==tBundlesRegistry.numberOfBinaryUUIDs-tBundlesRegistry.numberOfSymbolFiles) ? 0 : 2;
+        }
+        
+        // Symbol sources
+        
+        if (tSymbolSources.count>0)
+        {
+            tStartTime=mach_absolute_time();
+            
+            CUISymbolSourcesManager * tSymbolSourcesManager=[[CUISymbolSourcesManager alloc] initWithSources:tSymbolSources
+                                                                                                       cache:[[CUISymbolsFilesCache alloc] initWithDirectoryPath:tSymbolsCacheDirectoryPath]];
+            
+            NSUInteger tNumberOfFetchedBundles=[tBundlesRegistry fetchMissingBundlesForBinaryImages:userCodeBinaryImages(tCrashLogsPaths) symbolSourcesManager:tSymbolSourcesManager];
+            
+            fprintf(stderr,"Found %lu dSYM bundles in the symbol sources in %.2fs\n",(unsigned long)tNumberOfFetchedBundles,elapsedSeconds(tStartTime));
+        }
+        
+        // Symbolication
+        
+        UNXBatchSymbolicator * tSymbolicator=[[UNXBatchSymbolicator alloc] initWithBundlesRegistry:tBundlesRegistry];
+        
+        tSymbolicator.outputFormat=tOutputFormat;
+        tSymbolicator.outputDirectoryPath=tOutputDirectoryPath;
+        tSymbolicator.maximumNumberOfConcurrentJobs=tMaximumNumberOfConcurrentJobs;
+        
+        tStartTime=mach_absolute_time();
+        
+        [tSymbolicator symbolicateCrashLogsAtPaths:tCrashLogsPaths];
+        
+        double tDuration=elapsedSeconds(tStartTime);
+        
+        if (tDuration<=0)
+            tDuration=DBL_EPSILON;
+        
+        fflush(stdout);
+        
+        fprintf(stderr,"Processed %lu crash logs (%lu failed) in %.2fs: %.1f logs/s\n",
+                (unsigned long)tSymbolicator.numberOfProcessedCrashLogs,
+                (unsigned long)tSymbolicator.numberOfFailedCrashLogs,
+                tDuration,
+                tSymbolicator.numberOfProcessedCrashLogs/tDuration);
+        
+        fprintf(stderr,"Symbolicated %lu of %lu stack frames: %.1f frames/s\n",
+                (unsigned long)tSymbolicator.numberOfSymbolicatedStackFrames,
+                (unsigned long)tSymbolicator.numberOfStackFrames,
+                tSymbolicator.numberOfStackFrames/tDuration);
+        
+        if (tShowMetrics==YES)
+        {
+            fprintf(stderr,"\n%s",[[CUISymbolicationMetrics sharedMetrics] report].UTF8String);
+            
+            fprintf(stderr,"\n%s",[[CUILoadedSymbolsFilesRegistry sharedRegistry] report].UTF8String);
+        }
+        
+        return (tSymbolicator.numberOfFailedCrashLogs==0) ? 0 : 2;
+    }
+}
@@ -0,0 +1,334 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "CUISymbolicationManager.h"
+
+#import "CUIdSYMBundlesManager.h"
+
+#import "UNXSyntheticDWARFFileGenerator.h"
+
+#define UNXNumberOfFramesInLog    1000
+
+#define UNXNumberOfBacklogFrames    64
+
+@interface CUISymbolicationManagerTests : XCTestCase
+{
+    NSString * _temporaryDirectoryPath;
+    
+    CUIdSYMBundle * _bundle;
+    
+    NSString * _binaryUUID;
+    
+    NSArray<NSNumber *> * _functionAddresses;
+    
+    // Addresses of all the instructions of the functions
+    
+    NSArray<NSNumber *> * _instructionAddresses;
+    
+    NSUInteger _numberOfUsedInstructionAddresses;
+}
+
+- (NSArray<NSNumber *> *)_unusedInstructionAddresses:(NSUInteger)inCount;
+
+@end
+
+@implementation CUISymbolicationManagerTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    _temporaryDirectoryPath=[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    
+    NSString * tBundlePath=[_temporaryDirectoryPath stringByAppendingPathComponent:@"Foo.app.dSYM"];
+    NSString * tDWARFFolderPath=[tBundlePath stringByAppendingPathComponent:@"Contents/Resources/DWARF"];
+    
+    NSError * tError=nil;
+    
+    XCTAssertTrue([tFileManager createDirectoryAtPath:tDWARFFolderPath withIntermediateDirectories:YES attributes:nil error:&tError],@"%@",tError);
+    
+    // The UUID of the generated file is random so the results of a previous run are neither in the caches nor in the store
+    
+    UNXSyntheticDWARFFileGenerator * tGenerator=[UNXSyntheticDWARFFileGenerator new];
+    
+    tGenerator.numberOfCompilationUnits=8;
+    tGenerator.numberOfFunctionsPerCompilationUnit=32;
+    tGenerator.numberOfLineRowsPerFunction=4;
+    
+    XCTAssertTrue([tGenerator writeToFile:[tDWARFFolderPath stringByAppendingPathComponent:@"Foo"] error:&tError],@"%@",tError);
+    
+    NSMutableArray * tFunctionAddresses=[NSMutableArray array];
+    NSMutableArray * tInstructionAddresses=[NSMutableArray array];
+    
+    for(NSUInteger tIndex=0;tIndex<tGenerator.numberOfFunctions;tIndex++)
+    {
+        uint64_t tLowPC=[tGenerator lowPCOfFunctionAtIndex:tIndex];
+        uint64_t tSize=[tGenerator sizeOfFunctionAtIndex:tIndex];
+        
+        [tFunctionAddresses addObject:@(tLowPC)];
+        
+        for(uint64_t tOffset=0;tOffset<tSize;tOffset+=4)
+            [tInstructionAddresses addObject:@(tLowPC+tOffset)];
+    }
+    
+    _functionAddresses=[tFunctionAddresses copy];
+    
+    _instructionAddresses=[tInstructionAddresses copy];
+    
+    _numberOfUsedInstructionAddresses=0;
+    
+    _bundle=[[CUIdSYMBundle alloc] initWithPath:tBundlePath];
+    
+    _binaryUUID=_bundle.binaryUUIDs.firstObject;
+    
+    XCTAssertNotNil(_binaryUUID);
+    
+    XCTAssertTrue([[CUIdSYMBundlesManager sharedManager] addBundle:_bundle]);
+}
+
+- (void)tearDown
+{
+    [[CUIdSYMBundlesManager sharedManager] removeBundle:_bundle];
+    
+    [[NSFileManager defaultManager] removeItemAtPath:_temporaryDirectoryPath error:NULL];
+    
+    [super tearDown];
+}
+
+#pragma mark -
+
+- (NSArray<NSNumber *> *)_unusedInstructionAddresses:(NSUInteger)inCount
+{
+    // The results of the look ups are cached, the addresses are not reused
+    
+    NSArray * tAddresses=[_instructionAddresses subarrayWithRange:NSMakeRange(_numberOfUsedInstructionAddresses,inCount)];
+    
+    _numberOfUsedInstructionAddresses+=inCount;
+    
+    return tAddresses;
+}
+
+#pragma mark -
+
+- (void)testLogIssuesEachUniqueLookUpOnce
+{
+    CUISymbolicationManager * tManager=[CUISymbolicationManager new];
+    
+    // A log with 1,000 frames spread over the functions of the binary, most of them repeated
+    
+    NSMutableArray<NSNumber *> * tFrameAddresses=[NSMutableArray array];
+    
+    for(NSUInteger tFrameIndex=0;tFrameIndex<UNXNumberOfFramesInLog;tFrameIndex++)
+    {
+        NSUInteger tFunctionIndex=(tFrameIndex*37)%_functionAddresses.count;
+        
+        [tFrameAddresses addObject:@(_functionAddresses[tFunctionIndex].unsignedLongLongValue+(tFrameIndex%2)*4)];
+    }
+    
+    NSUInteger tNumberOfUniqueAddresses=[NSSet setWithArray:tFrameAddresses].count;
+    
+    XCTAssertLessThan(tNumberOfUniqueAddresses,UNXNumberOfFramesInLog);
+    
+    XCTestExpectation * tExpectation=[self expectationWithDescription:@"All frames symbolicated"];
+    tExpectation.expectedFulfillmentCount=UNXNumberOfFramesInLog;
+    
+    __block NSUInteger tNumberOfFoundFrames=0;
+    
+    __block BOOL tIssuingRequests=YES;
+    
+    __block NSUInteger tNumberOfCacheHits=0;
+    
+    // The results are delivered on the main queue so a look up stays pending until the last request is made.
+    // The bundle can however cache a result before it is delivered: a later request for the same address is
+    // then answered synchronously from the cache instead of being attached to the look up.
+    
+    for(NSNumber * tAddress in tFrameAddresses)
+    {
+        [tManager lookUpSymbolicationDataForMachineInstructionAddress:tAddress.unsignedIntegerValue
+                                                           binaryUUID:_binaryUUID
+                                                             priority:CUISymbolicationPriorityVisibleFrames
+                                                    cancellationToken:self
+                                                    completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                        
+                                                        if (tIssuingRequests==YES)
+                                                            tNumberOfCacheHits+=1;
+                                                        
+                                                        if (bSymbolicationData!=nil)
+                                                            tNumberOfFoundFrames+=1;
+                                                        
+                                                        [tExpectation fulfill];
+                                                    }];
+    }
+    
+    tIssuingRequests=NO;
+    
+    XCTAssertEqual(tManager.issuedLookUpsCount,tNumberOfUniqueAddresses);
+    XCTAssertEqual(tManager.issuedLookUpsCount+tManager.coalescedLookUpsCount+tNumberOfCacheHits,UNXNumberOfFramesInLog);
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+    
+    XCTAssertEqual(tNumberOfFoundFrames,UNXNumberOfFramesInLog);
+    
+    // Displaying the log again only hits the cache
+    
+    __block NSUInteger tNumberOfCachedFrames=0;
+    
+    for(NSNumber * tAddress in tFrameAddresses)
+    {
+        [tManager lookUpSymbolicationDataForMachineInstructionAddress:tAddress.unsignedIntegerValue
+                                                           binaryUUID:_binaryUUID
+                                                             priority:CUISymbolicationPriorityVisibleFrames
+                                                    cancellationToken:self
+                                                    completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                        
+                                                        if (bLookUpResult==CUISymbolicationDataLookUpResultFoundInCache)
+                                                            tNumberOfCachedFrames+=1;
+                                                    }];
+    }
+    
+    XCTAssertEqual(tNumberOfCachedFrames,UNXNumberOfFramesInLog);
+    XCTAssertEqual(tManager.issuedLookUpsCount,tNumberOfUniqueAddresses);
+}
+
+- (void)testLookUpWithoutCompletionHandlerIsIssued
+{
+    CUISymbolicationManager * tManager=[CUISymbolicationManager new];
+    
+    NSUInteger tAddress=_functionAddresses.firstObject.unsignedIntegerValue;
+    
+    [tManager lookUpSymbolicationDataForMachineInstructionAddress:tAddress binaryUUID:_binaryUUID priority:CUISymbolicationPriorityPrefetch cancellationToken:nil completionHandler:nil];
+    
+    XCTAssertEqual(tManager.issuedLookUpsCount,1);
+    
+    // A request with a completion handler is attached to the look up in progress
+    
+    XCTestExpectation * tExpectation=[self expectationWithDescription:@"Frame symbolicated"];
+    
+    [tManager lookUpSymbolicationDataForMachineInstructionAddress:tAddress
+                                                       binaryUUID:_binaryUUID
+                                                         priority:CUISymbolicationPriorityVisibleFrames
+                                                cancellationToken:nil
+                                                completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                    
+                                                    XCTAssertNotNil(bSymbolicationData);
+                                                    
+                                                    [tExpectation fulfill];
+                                                }];
+    
+    XCTAssertEqual(tManager.issuedLookUpsCount,1);
+    XCTAssertEqual(tManager.coalescedLookUpsCount,1);
+    
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+}
+
+- (void)testCancellingAPresentationKeepsTheLookUpsOfTheOthers
+{
+    CUISymbolicationManager * tManager=[CUISymbolicationManager new];
+    
+    // The same crash log displayed in two windows
+    
+    id tFirstPresentationToken=[NSObject new];
+    id tSecondPresentationToken=[NSObject new];
+    
+    NSArray<NSNumber *> * tAddresses=[self _unusedInstructionAddresses:2];
+    
+    NSUInteger tSharedAddress=tAddresses[0].unsignedIntegerValue;
+    NSUInteger tFirstPresentationAddress=tAddresses[1].unsignedIntegerValue;
+    
+    __block BOOL tFirstPresentationCalled=NO;
+    
+    void (^tFirstPresentationHandler)(CUISymbolicationDataLookUpResult,CUISymbolicationData *)=^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+        
+        tFirstPresentationCalled=YES;
+    };
+    
+    [tManager lookUpSymbolicationDataForMachineInstructionAddress:tSharedAddress binaryUUID:_binaryUUID priority:CUISymbolicationPriorityVisibleFrames cancellationToken:tFirstPresentationToken completionHandler:tFirstPresentationHandler];
+    
+    [tManager lookUpSymbolicationDataForMachineInstructionAddress:tFirstPresentationAddress binaryUUID:_binaryUUID priority:CUISymbolicationPriorityVisibleFrames cancellationToken:tFirstPresentationToken completionHandler:tFirstPresentationHandler];
+    
+    XCTestExpectation * tExpectation=[self expectationWithDescription:@"Frame of the second window symbolicated"];
+    
+    [tManager lookUpSymbolicationDataForMachineInstructionAddress:tSharedAddress
+                                                       binaryUUID:_binaryUUID
+                                                         priority:CUISymbolicationPriorityVisibleFrames
+                                                cancellationToken:tSecondPresentationToken
+                                                completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                    
+                                                    XCTAssertNotNil(bSymbolicationData);
+                                                    
+                                                    [tExpectation fulfill];
+                                                }];
+    
+    // The first window displays another crash log
+    
+    [tManager cancelLookUpsWithCancellationToken:tFirstPresentationToken];
+    
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    
+    // Let the look up of the other address complete if it was already running
+    
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    
+    XCTAssertFalse(tFirstPresentationCalled);
+}
+
+- (void)testTimeToFirstVisibleFrame
+{
+    // Headless version of a window opening a crash log: the frames of the rest of the log are requested
+    // before the first visible frame which must not wait for all of them.
+    
+    [self measureMetrics:@[XCTPerformanceMetric_WallClockTime] automaticallyStartMeasuring:NO forBlock:^{
+        
+        CUISymbolicationManager * tManager=[CUISymbolicationManager new];
+        
+        id tPresentationToken=[NSObject new];
+        
+        NSArray<NSNumber *> * tBacklogAddresses=[self _unusedInstructionAddresses:UNXNumberOfBacklogFrames];
+        
+        for(NSNumber * tAddress in tBacklogAddresses)
+            [tManager lookUpSymbolicationDataForMachineInstructionAddress:tAddress.unsignedIntegerValue binaryUUID:self->_binaryUUID priority:CUISymbolicationPriorityRestOfLog cancellationToken:tPresentationToken completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+            }];
+        
+        NSUInteger tVisibleFrameAddress=[self _unusedInstructionAddresses:1].firstObject.unsignedIntegerValue;
+        
+        XCTestExpectation * tExpectation=[self expectationWithDescription:@"First visible frame symbolicated"];
+        
+        [self startMeasuring];
+        
+        [tManager lookUpSymbolicationDataForMachineInstructionAddress:tVisibleFrameAddress
+                                                           binaryUUID:self->_binaryUUID
+                                                             priority:CUISymbolicationPriorityVisibleFrames
+                                                    cancellationToken:tPresentationToken
+                                                    completionHandler:^(CUISymbolicationDataLookUpResult bLookUpResult, CUISymbolicationData * bSymbolicationData) {
+                                                        
+                                                        XCTAssertNotNil(bSymbolicationData);
+                                                        
+                                                        [tExpectation fulfill];
+                                                    }];
+        
+        [self waitForExpectationsWithTimeout:10.0 handler:nil];
+        
+        [self stopMeasuring];
+        
+        // The window is closed
+        
+        [tManager cancelLookUpsWithCancellationToken:tPresentationToken];
+    }];
+}
+
+@end
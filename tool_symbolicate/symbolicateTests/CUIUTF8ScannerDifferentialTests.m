@@ -0,0 +1,548 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "CUIStackFrame.h"
+
+#import "CUIBinaryImage.h"
+
+// Differential tests of the UTF-8 byte scanners of CUIStackFrame and CUIBinaryImage against the NSScanner code they replaced.
+// The lines are the ones of StackFrameLines.txt and BinaryImageLines.txt and deterministic mutations of them.
+//
+// The NSScanner code raised NSRangeException for:
+// - a stack frame line with no '(' after the byte offset. The stack frame is now kept without a source file.
+// - a binary image line ending right after the version. The line is now rejected.
+
+#define UNXNumberOfMutatedLines    20000
+
+#pragma mark - NSScanner reference
+
+static NSDictionary * UNXReferenceStackFrameFields(NSString * inString)
+{
+    NSMutableDictionary * tFields=[NSMutableDictionary dictionary];
+    
+    NSUInteger tLength=inString.length;
+    NSCharacterSet * tWhitespaceCharacterSet=[NSCharacterSet whitespaceCharacterSet];
+    
+    NSScanner * tScanner=[NSScanner scannerWithString:inString];
+    
+    tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+    
+    NSInteger tInteger=-1;
+    
+    if ([tScanner scanInteger:&tInteger]==NO)
+        return nil;
+    
+    tFields[@"index"]=@((NSUInteger)tInteger);
+    
+    tScanner.charactersToBeSkipped=[NSCharacterSet characterSetWithCharactersInString:@"\t"];
+    
+    NSString * tString=nil;
+    
+    NSUInteger tCurrentScanLocation=tScanner.scanLocation;
+    
+    if ([tScanner scanUpToString:@"0x" intoString:&tString]==NO)
+        return nil;
+    
+    if (tScanner.scanLocation==tLength)
+    {
+        tScanner.scanLocation=tCurrentScanLocation;
+        
+        if ([tScanner scanUpToString:@"\t" intoString:&tString]==NO)
+            return nil;
+    }
+    
+    tFields[@"binaryImageIdentifier"]=[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+    
+    tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+    
+    unsigned long long tHexaValue=0;
+    
+    if ([tScanner scanHexLongLong:&tHexaValue]==NO)
+        return nil;
+    
+    tFields[@"machineInstructionAddress"]=@((NSUInteger)tHexaValue);
+    
+    if ([tScanner scanUpToString:@" +" intoString:&tString]==NO)
+        return nil;
+    
+    tFields[@"symbol"]=tString;
+    
+    if ([tScanner scanInteger:&tInteger]==NO)
+    {
+        if ([tString isEqualToString:@"???"]==NO)
+            return nil;
+        
+        tInteger=0;
+    }
+    
+    tFields[@"byteOffset"]=@((NSUInteger)tInteger);
+    
+    if (tScanner.scanLocation<(tLength-3))
+    {
+        tScanner.charactersToBeSkipped=nil;
+        
+        if ([tScanner scanUpToString:@"(" intoString:NULL]==YES)
+        {
+            tScanner.scanLocation+=1;
+            
+            NSString * tFileReference=nil;
+            
+            if ([tScanner scanUpToString:@")" intoString:&tFileReference]==YES)
+            {
+                NSRange tRange=[tFileReference rangeOfString:@":" options:NSBackwardsSearch];
+                
+                if (tRange.location==NSNotFound)
+                {
+                    tFields[@"sourceFile"]=[tFileReference copy];
+                }
+                else
+                {
+                    tFields[@"sourceFile"]=[tFileReference substringToIndex:tRange.location];
+                    
+                    NSInteger tLineNumber=[[tFileReference substringFromIndex:tRange.location+1] integerValue];
+                    
+                    if (tLineNumber!=0)
+                        tFields[@"lineNumber"]=@((NSUInteger)tLineNumber);
+                }
+            }
+        }
+    }
+    
+    return tFields;
+}
+
+static NSDictionary * UNXReferenceBinaryImageFields(NSString * inString,NSUInteger inReportVersion)
+{
+    NSMutableDictionary * tFields=[NSMutableDictionary dictionary];
+    
+    NSCharacterSet * tWhitespaceCharacterSet=[NSCharacterSet whitespaceCharacterSet];
+    NSScanner * tScanner=[NSScanner scannerWithString:inString];
+    
+    tScanner.charactersToBeSkipped=tWhitespaceCharacterSet;
+    
+    unsigned long long tAddressRangeStart=0;
+    
+    if ([tScanner scanHexLongLong:&tAddressRangeStart]==NO)
+        return nil;
+    
+    if ([tScanner scanUpToString:@"0" intoString:NULL]==NO)
+        return nil;
+    
+    unsigned long long tAddressRangeEnd=0;
+    
+    if ([tScanner scanHexLongLong:&tAddressRangeEnd]==NO)
+        return nil;
+    
+    tFields[@"loadAddress"]=@((NSUInteger)tAddressRangeStart);
+    tFields[@"length"]=@((NSUInteger)(tAddressRangeEnd-tAddressRangeStart+1));
+    
+    NSString * tString;
+    NSString * tOriginalString;
+    
+    BOOL tIsMissingVersion=NO;
+    
+    NSUInteger tSavedScannerScanLocation=tScanner.scanLocation;
+    
+    if ([tScanner scanUpToString:@"(" intoString:&tOriginalString]==NO)
+        return nil;
+    
+    if (tScanner.scanLocation==inString.length)
+    {
+        tScanner.scanLocation=tSavedScannerScanLocation;
+        
+        if ([tScanner scanUpToString:@"<" intoString:&tOriginalString]==NO)
+            return nil;
+        
+        tIsMissingVersion=YES;
+    }
+    
+    if (inReportVersion==6)
+    {
+        NSUInteger tLength=tOriginalString.length;
+        
+        NSRange tRange=[tOriginalString rangeOfCharacterFromSet:tWhitespaceCharacterSet options:NSBackwardsSearch range:NSMakeRange(0,tLength-1)];
+        
+        if (tRange.location==NSNotFound)
+            return nil;
+        
+        tString=[tOriginalString substringToIndex:tRange.location];
+    }
+    else
+    {
+        tString=tOriginalString;
+    }
+    
+    if ([tString hasPrefix:@"+"]==YES && tString.length>1)
+    {
+        tFields[@"userCode"]=@YES;
+        
+        tString=[tString substringFromIndex:1];
+    }
+    
+    tFields[@"identifier"]=[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+    
+    if (tScanner.scanLocation>=inString.length)
+        return nil;
+    
+    if (tIsMissingVersion==NO)
+    {
+        if (inReportVersion==6)
+        {
+            NSUInteger tLength=tOriginalString.length;
+            
+            NSRange tRange=[tOriginalString rangeOfCharacterFromSet:tWhitespaceCharacterSet options:NSBackwardsSearch range:NSMakeRange(0,tLength-1)];
+            
+            tFields[@"version"]=[[tOriginalString substringFromIndex:tRange.location] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+            
+            tScanner.scanLocation+=1;
+            
+            if ([tScanner scanUpToString:@")" intoString:&tString]==NO)
+                return nil;
+            
+            tFields[@"buildNumber"]=[tString stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+        }
+        else
+        {
+            tScanner.scanLocation+=1;
+            
+            if ([tScanner scanUpToString:@")" intoString:&tString]==NO)
+                return nil;
+            
+            NSArray * tVersions=[tString componentsSeparatedByString:@" - "];
+            
+            switch(tVersions.count)
+            {
+                case 2:
+                    
+                    tFields[@"buildNumber"]=[tVersions[1] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+                    
+                case 1:
+                    
+                    tFields[@"version"]=[tVersions.firstObject stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+                    
+                    break;
+            }
+        }
+        
+        tScanner.scanLocation+=2;
+    }
+    else
+    {
+        tFields[@"version"]=@"???";
+        tFields[@"buildNumber"]=@"???";
+    }
+    
+    if ([inString characterAtIndex:tScanner.scanLocation]=='<')
+    {
+        if ([tScanner scanUpToString:@">" intoString:&tString]==NO)
+            return nil;
+        
+        tFields[@"UUID"]=[tString substringFromIndex:1];
+    }
+    else
+    {
+        tScanner.scanLocation-=2;
+    }
+    
+    if ([tScanner scanUpToString:@"/" intoString:NULL]==NO)
+        return nil;
+    
+    tFields[@"path"]=[[inString substringFromIndex:tScanner.scanLocation] stringByTrimmingCharactersInSet:tWhitespaceCharacterSet];
+    
+    return tFields;
+}
+
+#pragma mark - Byte scanners
+
+static NSDictionary * UNXStackFrameFields(CUIStackFrame * inStackFrame)
+{
+    NSMutableDictionary * tFields=[NSMutableDictionary dictionary];
+    
+    tFields[@"index"]=@(inStackFrame.index);
+    tFields[@"binaryImageIdentifier"]=inStackFrame.binaryImageIdentifier;
+    tFields[@"machineInstructionAddress"]=@(inStackFrame.machineInstructionAddress);
+    tFields[@"symbol"]=inStackFrame.symbol;
+    tFields[@"byteOffset"]=@(inStackFrame.byteOffset);
+    tFields[@"sourceFile"]=inStackFrame.sourceFile;
+    
+    if (inStackFrame.lineNumber!=0)
+        tFields[@"lineNumber"]=@(inStackFrame.lineNumber);
+    
+    return tFields;
+}
+
+static NSDictionary * UNXBinaryImageFields(CUIBinaryImage * inBinaryImage)
+{
+    NSMutableDictionary * tFields=[NSMutableDictionary dictionary];
+    
+    tFields[@"loadAddress"]=@(inBinaryImage.addressesRange.loadAddress);
+    tFields[@"length"]=@(inBinaryImage.addressesRange.length);
+    tFields[@"identifier"]=inBinaryImage.identifier;
+    tFields[@"version"]=inBinaryImage.version;
+    tFields[@"buildNumber"]=inBinaryImage.buildNumber;
+    tFields[@"UUID"]=inBinaryImage.UUID;
+    tFields[@"path"]=inBinaryImage.path;
+    
+    return tFields;
+}
+
+// xorshift64*, so that the mutated lines are the same from one run to another
+
+static uint64_t UNXNextRandomNumber(uint64_t * ioState)
+{
+    uint64_t tState=*ioState;
+    
+    tState^=tState>>12;
+    tState^=tState<<25;
+    tState^=tState>>27;
+    
+    *ioState=tState;
+    
+    return tState*0x2545F4914F6CDD1DULL;
+}
+
+@interface CUIUTF8ScannerDifferentialTests : XCTestCase
+
+- (NSArray<NSString *> *)_linesOfResource:(NSString *)inName;
+
+- (NSArray<NSString *> *)_mutatedLinesOfLines:(NSArray<NSString *> *)inLines seed:(uint64_t)inSeed;
+
+- (void)_compareStackFrameLine:(NSString *)inLine;
+
+- (void)_compareBinaryImageLine:(NSString *)inLine reportVersion:(NSUInteger)inReportVersion;
+
+@end
+
+@implementation CUIUTF8ScannerDifferentialTests
+
+- (NSArray<NSString *> *)_linesOfResource:(NSString *)inName
+{
+    NSString * tPath=[[NSBundle bundleForClass:self.class] pathForResource:inName ofType:@"txt"];
+    
+    NSString * tContents=[NSString stringWithContentsOfFile:tPath encoding:NSUTF8StringEncoding error:NULL];
+    
+    XCTAssertNotNil(tContents,@"%@",inName);
+    
+    return [[tContents componentsSeparatedByString:@"\n"] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length>0"]];
+}
+
+- (NSArray<NSString *> *)_mutatedLinesOfLines:(NSArray<NSString *> *)inLines seed:(uint64_t)inSeed
+{
+    // The mutations work on composed characters so that the lines remain valid UTF-8
+    
+    NSArray * tAlphabet=@[@" ",@"\t",@"0",@"x",@"+",@"-",@"(",@")",@"<",@">",@"/",@":",@"?",@"a",@"b",@"c",@"F",@"1",@"9",@"é",@" ",@"　",@"\U0001F600"];
+    
+    NSMutableArray * tMutatedLines=[NSMutableArray arrayWithCapacity:UNXNumberOfMutatedLines];
+    uint64_t tState=inSeed;
+    
+    for(NSUInteger tIndex=0;tIndex<UNXNumberOfMutatedLines;tIndex++)
+    {
+        NSString * tLine=inLines[UNXNextRandomNumber(&tState)%inLines.count];
+        
+        NSMutableArray * tCharacters=[NSMutableArray array];
+        
+        [tLine enumerateSubstringsInRange:NSMakeRange(0,tLine.length) options:NSStringEnumerationByComposedCharacterSequences usingBlock:^(NSString * bCharacter, NSRange bRange, NSRange bEnclosingRange, BOOL * bOutStop) {
+            
+            [tCharacters addObject:bCharacter];
+        }];
+        
+        NSUInteger tNumberOfMutations=UNXNextRandomNumber(&tState)%5;
+        
+        for(NSUInteger tMutationIndex=0;tMutationIndex<tNumberOfMutations;tMutationIndex++)
+        {
+            NSUInteger tCount=tCharacters.count;
+            
+            switch(UNXNextRandomNumber(&tState)%4)
+            {
+                case 0:
+                    
+                    if (tCount>0)
+                        [tCharacters removeObjectAtIndex:UNXNextRandomNumber(&tState)%tCount];
+                    
+                    break;
+                    
+                case 1:
+                    
+                    [tCharacters insertObject:tAlphabet[UNXNextRandomNumber(&tState)%tAlphabet.count] atIndex:UNXNextRandomNumber(&tState)%(tCount+1)];
+                    
+                    break;
+                    
+                case 2:
+                    
+                    if (tCount>0)
+                        tCharacters[UNXNextRandomNumber(&tState)%tCount]=tAlphabet[UNXNextRandomNumber(&tState)%tAlphabet.count];
+                    
+                    break;
+                    
+                case 3:
+                    
+                {
+                    // Truncation
+                    
+                    NSUInteger tLength=UNXNextRandomNumber(&tState)%(tCount+1);
+                    
+                    [tCharacters removeObjectsInRange:NSMakeRange(tLength,tCount-tLength)];
+                    
+                    break;
+                }
+            }
+        }
+        
+        [tMutatedLines addObject:[tCharacters componentsJoinedByString:@""]];
+    }
+    
+    return tMutatedLines;
+}
+
+- (void)_compareStackFrameLine:(NSString *)inLine
+{
+    NSDictionary * tExpectedFields=nil;
+    BOOL tRaised=NO;
+    
+    @try
+    {
+        tExpectedFields=UNXReferenceStackFrameFields(inLine);
+    }
+    @catch (NSException * bException)
+    {
+        XCTAssertEqualObjects(bException.name,NSRangeException,@"\"%@\"",inLine);
+        
+        tRaised=YES;
+    }
+    
+    NSData * tData=[inLine dataUsingEncoding:NSUTF8StringEncoding];
+    
+    CUIStackFrame * tStackFrame=[[CUIStackFrame alloc] initWithUTF8Bytes:tData.bytes length:tData.length error:NULL];
+    
+    if (tRaised==YES)
+    {
+        XCTAssertNotNil(tStackFrame,@"\"%@\"",inLine);
+        XCTAssertNil(tStackFrame.sourceFile,@"\"%@\"",inLine);
+        
+        return;
+    }
+    
+    if (tExpectedFields==nil)
+    {
+        XCTAssertNil(tStackFrame,@"\"%@\"",inLine);
+        
+        return;
+    }
+    
+    XCTAssertEqualObjects(UNXStackFrameFields(tStackFrame),tExpectedFields,@"\"%@\"",inLine);
+    
+    // The string initializer goes through the same scanners
+    
+    XCTAssertEqualObjects(UNXStackFrameFields([[CUIStackFrame alloc] initWithString:inLine error:NULL]),tExpectedFields,@"\"%@\"",inLine);
+}
+
+- (void)_compareBinaryImageLine:(NSString *)inLine reportVersion:(NSUInteger)inReportVersion
+{
+    NSDictionary * tExpectedFields=nil;
+    BOOL tRaised=NO;
+    
+    @try
+    {
+        tExpectedFields=UNXReferenceBinaryImageFields(inLine,inReportVersion);
+    }
+    @catch (NSException * bException)
+    {
+        XCTAssertEqualObjects(bException.name,NSRangeException,@"\"%@\"",inLine);
+        
+        tRaised=YES;
+    }
+    
+    NSData * tData=[inLine dataUsingEncoding:NSUTF8StringEncoding];
+    
+    CUIBinaryImage * tBinaryImage=[[CUIBinaryImage alloc] initWithUTF8Bytes:tData.bytes length:tData.length reportVersion:inReportVersion error:NULL];
+    
+    if (tRaised==YES || tExpectedFields==nil)
+    {
+        XCTAssertNil(tBinaryImage,@"\"%@\" (%lu)",inLine,(unsigned long)inReportVersion);
+        
+        return;
+    }
+    
+    XCTAssertNotNil(tBinaryImage,@"\"%@\" (%lu)",inLine,(unsigned long)inReportVersion);
+    
+    if ([tExpectedFields[@"userCode"] boolValue]==YES)
+        XCTAssertTrue(tBinaryImage.isUserCode,@"\"%@\"",inLine);
+    
+    NSMutableDictionary * tFields=[tExpectedFields mutableCopy];
+    
+    [tFields removeObjectForKey:@"userCode"];
+    
+    XCTAssertEqualObjects(UNXBinaryImageFields(tBinaryImage),tFields,@"\"%@\" (%lu)",inLine,(unsigned long)inReportVersion);
+    
+    XCTAssertEqualObjects(UNXBinaryImageFields([[CUIBinaryImage alloc] initWithString:inLine reportVersion:inReportVersion error:NULL]),tFields,@"\"%@\" (%lu)",inLine,(unsigned long)inReportVersion);
+}
+
+#pragma mark -
+
+- (void)testStackFrameLines
+{
+    NSArray * tLines=[self _linesOfResource:@"StackFrameLines"];
+    
+    for(NSString * tLine in tLines)
+        [self _compareStackFrameLine:tLine];
+    
+    for(NSString * tLine in [self _mutatedLinesOfLines:tLines seed:0x5EED])
+        [self _compareStackFrameLine:tLine];
+}
+
+- (void)testBinaryImageLines
+{
+    NSArray * tLines=[self _linesOfResource:@"BinaryImageLines"];
+    
+    for(NSNumber * tReportVersion in @[@6,@10])
+    {
+        for(NSString * tLine in tLines)
+            [self _compareBinaryImageLine:tLine reportVersion:tReportVersion.unsignedIntegerValue];
+        
+        for(NSString * tLine in [self _mutatedLinesOfLines:tLines seed:0x5EED+tReportVersion.unsignedIntegerValue])
+            [self _compareBinaryImageLine:tLine reportVersion:tReportVersion.unsignedIntegerValue];
+    }
+}
+
+#pragma mark - Behavior changes
+
+- (void)testStackFrameLineWithoutParenthesisAfterByteOffset
+{
+    NSString * tLine=@"10  Foo 0x1 foo + 2 [inlined]";
+    
+    XCTAssertThrowsSpecificNamed(UNXReferenceStackFrameFields(tLine),NSException,NSRangeException);
+    
+    CUIStackFrame * tStackFrame=[[CUIStackFrame alloc] initWithString:tLine error:NULL];
+    
+    XCTAssertNotNil(tStackFrame);
+    XCTAssertEqual(tStackFrame.index,10);
+    XCTAssertEqualObjects(tStackFrame.binaryImageIdentifier,@"Foo");
+    XCTAssertEqual(tStackFrame.machineInstructionAddress,0x1);
+    XCTAssertEqualObjects(tStackFrame.symbol,@"foo");
+    XCTAssertEqual(tStackFrame.byteOffset,2);
+    XCTAssertNil(tStackFrame.sourceFile);
+    XCTAssertEqual(tStackFrame.lineNumber,0);
+}
+
+- (void)testBinaryImageLineEndingAfterVersion
+{
+    NSString * tLine=@"0x1000 - 0x1fff com.foo (1.0 - 2)";
+    
+    XCTAssertThrowsSpecificNamed(UNXReferenceBinaryImageFields(tLine,10),NSException,NSRangeException);
+    
+    XCTAssertNil([[CUIBinaryImage alloc] initWithString:tLine reportVersion:10 error:NULL]);
+}
+
+@end
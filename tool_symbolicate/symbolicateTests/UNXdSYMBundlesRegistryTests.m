@@ -0,0 +1,167 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "UNXdSYMBundlesRegistry.h"
+
+#import "UNXSyntheticDWARFFileGenerator.h"
+
+#import "CUISymbolSourceDirectory.h"
+
+#import "CUIdSYMBundle.h"
+
+@interface UNXdSYMBundlesRegistryTests : XCTestCase
+{
+    NSString * _temporaryDirectoryPath;
+    
+    // Stand-in for a build-artifact store: <UUID>/Foo.app.dSYM
+    
+    NSString * _symbolSourcePath;
+    
+    NSString * _binaryUUID;
+    
+    uint64_t _functionAddress;
+}
+
+- (CUIBinaryImage *)_binaryImageWithUUID:(NSString *)inBinaryUUID;
+
+- (CUISymbolSourcesManager *)_symbolSourcesManager;
+
+@end
+
+@implementation UNXdSYMBundlesRegistryTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSFileManager * tFileManager=[NSFileManager defaultManager];
+    
+    _temporaryDirectoryPath=[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    
+    _symbolSourcePath=[_temporaryDirectoryPath stringByAppendingPathComponent:@"Source"];
+    
+    // Build the dSYM bundle from a synthetic DWARF file
+    
+    NSString * tBundlePath=[_temporaryDirectoryPath stringByAppendingPathComponent:@"Foo.app.dSYM"];
+    NSString * tDWARFFolderPath=[tBundlePath stringByAppendingPathComponent:@"Contents/Resources/DWARF"];
+    
+    NSError * tError=nil;
+    
+    XCTAssertTrue([tFileManager createDirectoryAtPath:tDWARFFolderPath withIntermediateDirectories:YES attributes:nil error:&tError],@"%@",tError);
+    
+    UNXSyntheticDWARFFileGenerator * tGenerator=[UNXSyntheticDWARFFileGenerator new];
+    
+    tGenerator.numberOfCompilationUnits=2;
+    tGenerator.numberOfFunctionsPerCompilationUnit=4;
+    tGenerator.numberOfLineRowsPerFunction=4;
+    
+    XCTAssertTrue([tGenerator writeToFile:[tDWARFFolderPath stringByAppendingPathComponent:@"Foo"] error:&tError],@"%@",tError);
+    
+    _functionAddress=[tGenerator lowPCOfFunctionAtIndex:0];
+    
+    XCTAssertTrue([CUISymbolSource writeInfoPropertyListOfdSYMBundleAtPath:tBundlePath binaryName:@"Foo" error:&tError],@"%@",tError);
+    
+    _binaryUUID=[[CUIdSYMBundle alloc] initWithPath:tBundlePath].binaryUUIDs.firstObject;
+    
+    XCTAssertNotNil(_binaryUUID);
+    
+    NSString * tFolderPath=[_symbolSourcePath stringByAppendingPathComponent:_binaryUUID];
+    
+    XCTAssertTrue([tFileManager createDirectoryAtPath:tFolderPath withIntermediateDirectories:YES attributes:nil error:&tError],@"%@",tError);
+    
+    XCTAssertTrue([tFileManager moveItemAtPath:tBundlePath toPath:[tFolderPath stringByAppendingPathComponent:tBundlePath.lastPathComponent] error:&tError],@"%@",tError);
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:_temporaryDirectoryPath error:NULL];
+    
+    [super tearDown];
+}
+
+#pragma mark -
+
+- (CUIBinaryImage *)_binaryImageWithUUID:(NSString *)inBinaryUUID
+{
+    NSString * tLine=[NSString stringWithFormat:@"       0x100000000 -        0x100ffffff +com.example.foo (1.0 - 1) <%@> /Applications/Foo.app/Contents/MacOS/Foo",inBinaryUUID];
+    
+    return [[CUIBinaryImage alloc] initWithString:tLine reportVersion:12 error:NULL];
+}
+
+- (CUISymbolSourcesManager *)_symbolSourcesManager
+{
+    CUISymbolsFilesCache * tCache=[[CUISymbolsFilesCache alloc] initWithDirectoryPath:[_temporaryDirectoryPath stringByAppendingPathComponent:@"Cache"]];
+    
+    return [[CUISymbolSourcesManager alloc] initWithSources:@[[[CUISymbolSourceDirectory alloc] initWithPath:_symbolSourcePath]]
+                                                      cache:tCache];
+}
+
+#pragma mark -
+
+- (void)testFetchMissingBundlesRegistersTheFetchedBundles
+{
+    UNXdSYMBundlesRegistry * tRegistry=[[UNXdSYMBundlesRegistry alloc] initWithSearchPaths:@[]];
+    
+    XCTAssertFalse([tRegistry containsBinaryUUID:_binaryUUID]);
+    
+    CUIBinaryImage * tBinaryImage=[self _binaryImageWithUUID:_binaryUUID];
+    
+    XCTAssertNotNil(tBinaryImage);
+    
+    NSUInteger tNumberOfFetchedBundles=[tRegistry fetchMissingBundlesForBinaryImages:@[tBinaryImage,tBinaryImage] symbolSourcesManager:[self _symbolSourcesManager]];
+    
+    XCTAssertEqual(tNumberOfFetchedBundles,1);
+    XCTAssertEqual(tRegistry.numberOfBundles,1);
+    XCTAssertTrue([tRegistry containsBinaryUUID:_binaryUUID]);
+    
+    // The look ups find the fetched bundle
+    
+    CUISymbolicationData * tSymbolicationData=nil;
+    
+    CUISymbolicationDataLookUpResult tResult=[tRegistry lookUpSymbolicationDataForMachineInstructionAddress:(NSUInteger)_functionAddress binaryUUID:_binaryUUID symbolicationData:&tSymbolicationData];
+    
+    XCTAssertTrue(tResult==CUISymbolicationDataLookUpResultFound || tResult==CUISymbolicationDataLookUpResultFoundInCache);
+    XCTAssertNotNil(tSymbolicationData);
+    
+    // A registered UUID is not fetched again
+    
+    XCTAssertEqual([tRegistry fetchMissingBundlesForBinaryImages:@[tBinaryImage] symbolSourcesManager:[self _symbolSourcesManager]],0);
+    XCTAssertEqual(tRegistry.numberOfBundles,1);
+}
+
+- (void)testFetchMissingBundlesSkipsTheUnknownUUIDs
+{
+    UNXdSYMBundlesRegistry * tRegistry=[[UNXdSYMBundlesRegistry alloc] initWithSearchPaths:@[]];
+    
+    CUIBinaryImage * tBinaryImage=[self _binaryImageWithUUID:[NSUUID UUID].UUIDString];
+    
+    XCTAssertEqual([tRegistry fetchMissingBundlesForBinaryImages:@[tBinaryImage] symbolSourcesManager:[self _symbolSourcesManager]],0);
+    XCTAssertEqual(tRegistry.numberOfBundles,0);
+    
+    XCTAssertEqual([tRegistry fetchMissingBundlesForBinaryImages:@[] symbolSourcesManager:[self _symbolSourcesManager]],0);
+    XCTAssertEqual([tRegistry fetchMissingBundlesForBinaryImages:@[tBinaryImage] symbolSourcesManager:nil],0);
+}
+
+- (void)testSearchPathsBundleIsNotFetched
+{
+    UNXdSYMBundlesRegistry * tRegistry=[[UNXdSYMBundlesRegistry alloc] initWithSearchPaths:@[_symbolSourcePath]];
+    
+    XCTAssertEqual(tRegistry.numberOfBundles,1);
+    
+    XCTAssertEqual([tRegistry fetchMissingBundlesForBinaryImages:@[[self _binaryImageWithUUID:_binaryUUID]] symbolSourcesManager:[self _symbolSourcesManager]],0);
+    XCTAssertEqual(tRegistry.numberOfBundles,1);
+}
+
+@end
@@ -0,0 +1,725 @@
+/*
+ Copyright (c) 2026, Stephane Sudre
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ 
+ - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ - Neither the name of the WhiteBox nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Unit tests of the plain C sources of UnexpectedlyCore (see CMakeLists.txt)
+
+#include "CUIUTF8ScannerCore.h"
+
+#include "LEB128.h"
+
+#include "MCHMachOCore.h"
+
+#include "DWRFArangesCore.h"
+
+#include "DWRFLineProgramCore.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned long sNumberOfFailures=0;
+
+#define UNXAssert(inCondition) \
+    do \
+    { \
+        if (!(inCondition)) \
+        { \
+            fprintf(stderr,"%s:%d: assertion failed: %s\n",__FILE__,__LINE__,#inCondition); \
+            sNumberOfFailures++; \
+        } \
+    } while (0)
+
+static CUIUTF8Scanner UNXScannerWithString(const char * inString)
+{
+    return CUIUTF8ScannerMake((const uint8_t *)inString,strlen(inString));
+}
+
+// Fixtures writing
+
+static size_t UNXWriteBytes(uint8_t * inBuffer,size_t inOffset,const void * inBytes,size_t inLength)
+{
+    memcpy(inBuffer+inOffset,inBytes,inLength);
+    
+    return inOffset+inLength;
+}
+
+static size_t UNXWriteUInt16(uint8_t * inBuffer,size_t inOffset,uint16_t inValue)
+{
+    return UNXWriteBytes(inBuffer,inOffset,&inValue,sizeof(uint16_t));
+}
+
+static size_t UNXWriteUInt32(uint8_t * inBuffer,size_t inOffset,uint32_t inValue,BOOL inSwap)
+{
+    if (inSwap==YES)
+        inValue=__builtin_bswap32(inValue);
+    
+    return UNXWriteBytes(inBuffer,inOffset,&inValue,sizeof(uint32_t));
+}
+
+static size_t UNXWriteUInt64(uint8_t * inBuffer,size_t inOffset,uint64_t inValue)
+{
+    return UNXWriteBytes(inBuffer,inOffset,&inValue,sizeof(uint64_t));
+}
+
+// xorshift64*, so that the corrupted fixtures are the same from one run to another
+
+static uint64_t UNXNextRandomNumber(uint64_t * ioState)
+{
+    uint64_t tState=*ioState;
+    
+    tState^=tState>>12;
+    tState^=tState<<25;
+    tState^=tState>>27;
+    
+    *ioState=tState;
+    
+    return tState*0x2545F4914F6CDD1DULL;
+}
+
+#pragma mark - LEB128
+
+static void UNXTestULEB128(void)
+{
+    // DWARF specification, Figure 22
+    
+    static const struct
+    {
+        uint64_t value;
+        uint8_t bytes[3];
+        size_t length;
+    } sExamples[]={
+        {2,{0x02},1},
+        {127,{0x7F},1},
+        {128,{0x80,0x01},2},
+        {129,{0x81,0x01},2},
+        {130,{0x82,0x01},2},
+        {12857,{0xB9,0x64},2}
+    };
+    
+    for(size_t tIndex=0;tIndex<sizeof(sExamples)/sizeof(sExamples[0]);tIndex++)
+    {
+        uint8_t * tBytes=(uint8_t *)sExamples[tIndex].bytes;
+        uint8_t * tEnd=NULL;
+        
+        UNXAssert(DWRF_readULEB128(tBytes,&tEnd)==sExamples[tIndex].value);
+        UNXAssert(tEnd==tBytes+sExamples[tIndex].length);
+    }
+    
+    uint8_t tLargeValue[]={0xFF,0xFF,0xFF,0xFF,0x0F};
+    
+    UNXAssert(DWRF_readULEB128(tLargeValue,NULL)==0xFFFFFFFFULL);
+}
+
+static void UNXTestLEB128(void)
+{
+    // DWARF specification, Figure 23
+    
+    static const struct
+    {
+        int64_t value;
+        uint8_t bytes[3];
+        size_t length;
+    } sExamples[]={
+        {2,{0x02},1},
+        {-2,{0x7E},1},
+        {127,{0xFF,0x00},2},
+        {-127,{0x81,0x7F},2},
+        {128,{0x80,0x01},2},
+        {-128,{0x80,0x7F},2},
+        {129,{0x81,0x01},2},
+        {-129,{0xFF,0x7E},2}
+    };
+    
+    for(size_t tIndex=0;tIndex<sizeof(sExamples)/sizeof(sExamples[0]);tIndex++)
+    {
+        uint8_t * tBytes=(uint8_t *)sExamples[tIndex].bytes;
+        uint8_t * tEnd=NULL;
+        
+        UNXAssert(DWRF_readLEB128(tBytes,&tEnd)==sExamples[tIndex].value);
+        UNXAssert(tEnd==tBytes+sExamples[tIndex].length);
+    }
+}
+
+static void UNXTestBoundedLEB128(void)
+{
+    const uint8_t tBytes[]={0xB9,0x64,0x80,0x7F,0x80};
+    uint64_t tUnsignedValue=0;
+    int64_t tValue=0;
+    
+    UNXAssert(DWRF_readBoundedULEB128(tBytes,tBytes+5,&tUnsignedValue)==tBytes+2 && tUnsignedValue==12857);
+    UNXAssert(DWRF_readBoundedLEB128(tBytes+2,tBytes+5,&tValue)==tBytes+4 && tValue==-128);
+    
+    // Truncated values
+    
+    UNXAssert(DWRF_readBoundedULEB128(tBytes,tBytes+1,&tUnsignedValue)==NULL);
+    UNXAssert(DWRF_readBoundedLEB128(tBytes+4,tBytes+5,&tValue)==NULL);
+    UNXAssert(DWRF_readBoundedULEB128(tBytes,tBytes,NULL)==NULL);
+    
+    // The bits beyond the 64th one are ignored
+    
+    const uint8_t tLongValue[]={0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x01};
+    
+    UNXAssert(DWRF_readBoundedULEB128(tLongValue,tLongValue+sizeof(tLongValue),&tUnsignedValue)==tLongValue+sizeof(tLongValue) && tUnsignedValue==UINT64_MAX);
+}
+
+#pragma mark - Mach-O
+
+// 64-bit header, LC_SEGMENT_64 (without sections), LC_UUID
+
+static size_t UNXWriteMachOFile(uint8_t * inBuffer,BOOL inSwap)
+{
+    size_t tOffset=0;
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,MH_MAGIC_64,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0x0100000c,inSwap);     // CPU_TYPE_ARM64
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0xa,inSwap);            // MH_DSYM
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,2,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,72+24,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,inSwap);
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,LC_SEGMENT_64,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,72,inSwap);
+    memset(inBuffer+tOffset,0,64);
+    memcpy(inBuffer+tOffset,"__DWARF",7);
+    tOffset+=64;
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,LC_UUID,inSwap);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,24,inSwap);
+    
+    for(uint8_t tIndex=0;tIndex<16;tIndex++)
+        inBuffer[tOffset++]=tIndex;
+    
+    return tOffset;
+}
+
+static void UNXTestMachOHeader(void)
+{
+    uint8_t tBuffer[256];
+    
+    for(int tSwapIndex=0;tSwapIndex<2;tSwapIndex++)
+    {
+        BOOL tSwap=(tSwapIndex==1);
+        size_t tLength=UNXWriteMachOFile(tBuffer,tSwap);
+        BOOL tIs64Bit=NO;
+        BOOL tShouldSwap=!tSwap;
+        MCHMachHeader tHeader;
+        
+        UNXAssert(MCHMachHeaderIdentify(tBuffer,tLength,&tIs64Bit,&tShouldSwap)==YES && tIs64Bit==YES && tShouldSwap==tSwap);
+        
+        UNXAssert(MCHMachHeaderRead(tBuffer,tLength,tIs64Bit,tShouldSwap,&tHeader)==YES);
+        UNXAssert(tHeader.cpuType==0x0100000c && tHeader.fileType==0xa && tHeader.numberOfLoadCommands==2 && tHeader.headerSize==32);
+        
+        MCHLoadCommandsIterator tIterator=MCHLoadCommandsIteratorMake(tBuffer,tLength,&tHeader);
+        MCHLoadCommandInfo tLoadCommand;
+        
+        UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES && tLoadCommand.type==LC_SEGMENT_64 && tLoadCommand.size==72 && tLoadCommand.offset==32);
+        UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES && tLoadCommand.type==LC_UUID && tLoadCommand.offset==104);
+        
+        uint8_t tUUID[16];
+        
+        UNXAssert(MCHUUIDLoadCommandRead(tBuffer+tLoadCommand.offset,tLoadCommand.size,tUUID)==YES && tUUID[0]==0 && tUUID[15]==15);
+        UNXAssert(MCHUUIDLoadCommandRead(tBuffer+tLoadCommand.offset,23,tUUID)==NO);
+        
+        UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==NO && tIterator.malformed==NO);
+    }
+    
+    UNXAssert(MCHMachHeaderIdentify((const uint8_t *)"\x7f""ELF",4,NULL,NULL)==NO);
+    UNXAssert(MCHMachHeaderIdentify(tBuffer,3,NULL,NULL)==NO);
+}
+
+static void UNXTestMachOMalformedLoadCommands(void)
+{
+    uint8_t tBuffer[256];
+    size_t tLength=UNXWriteMachOFile(tBuffer,NO);
+    MCHMachHeader tHeader;
+    MCHLoadCommandInfo tLoadCommand;
+    
+    UNXAssert(MCHMachHeaderRead(tBuffer,31,YES,NO,&tHeader)==NO);
+    
+    // Truncated LC_UUID
+    
+    UNXAssert(MCHMachHeaderRead(tBuffer,tLength-1,YES,NO,&tHeader)==YES);
+    
+    MCHLoadCommandsIterator tIterator=MCHLoadCommandsIteratorMake(tBuffer,tLength-1,&tHeader);
+    
+    UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES);
+    UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==NO && tIterator.malformed==YES);
+    
+    // cmdsize smaller than a load_command
+    
+    UNXWriteUInt32(tBuffer,36,4,NO);
+    
+    tIterator=MCHLoadCommandsIteratorMake(tBuffer,tLength,&tHeader);
+    
+    UNXAssert(MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==NO && tIterator.malformed==YES);
+    
+    // More load commands than bytes
+    
+    UNXWriteUInt32(tBuffer,36,72,NO);
+    
+    tHeader.numberOfLoadCommands=3;
+    
+    tIterator=MCHLoadCommandsIteratorMake(tBuffer,tLength,&tHeader);
+    
+    while (MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES)
+        ;
+    
+    UNXAssert(tIterator.malformed==YES && tIterator.remainingCount==1);
+}
+
+#pragma mark - __debug_aranges
+
+// Two sets: 8-byte addresses (4 bytes of padding), 4-byte addresses (4 bytes of padding)
+
+static size_t UNXWriteArangesSection(uint8_t * inBuffer)
+{
+    size_t tOffset=0;
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,16+3*16-4,NO);
+    tOffset=UNXWriteUInt16(inBuffer,tOffset,2);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0x10,NO);
+    inBuffer[tOffset++]=8;
+    inBuffer[tOffset++]=0;
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,NO);
+    
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0x1000);
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0x100);
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0x2000);
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0x10);
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0);
+    tOffset=UNXWriteUInt64(inBuffer,tOffset,0);
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,16+2*8-4,NO);
+    tOffset=UNXWriteUInt16(inBuffer,tOffset,2);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0x80,NO);
+    inBuffer[tOffset++]=4;
+    inBuffer[tOffset++]=0;
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,NO);
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0x3000,NO);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0x20,NO);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,NO);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,0,NO);
+    
+    return tOffset;
+}
+
+static void UNXTestAranges(void)
+{
+    uint8_t tBuffer[256];
+    size_t tLength=UNXWriteArangesSection(tBuffer);
+    DWRFArangesSetHeader tHeader;
+    
+    UNXAssert(DWRFArangesSetHeaderRead(tBuffer,tLength,0,&tHeader)==YES);
+    UNXAssert(tHeader.version==2 && tHeader.debugInfoOffset==0x10 && tHeader.addressSize==8 && tHeader.descriptorsOffset==16 && tHeader.endOffset==64);
+    
+    NSUInteger tOffset=tHeader.descriptorsOffset;
+    uint64_t tLocation;
+    uint64_t tRangeLength;
+    
+    UNXAssert(DWRFArangesSetNextDescriptor(tBuffer,&tHeader,&tOffset,&tLocation,&tRangeLength)==YES && tLocation==0x1000 && tRangeLength==0x100);
+    UNXAssert(DWRFArangesSetNextDescriptor(tBuffer,&tHeader,&tOffset,&tLocation,&tRangeLength)==YES && tLocation==0x2000);
+    UNXAssert(DWRFArangesSetNextDescriptor(tBuffer,&tHeader,&tOffset,&tLocation,&tRangeLength)==NO);
+    
+    UNXAssert(DWRFArangesSetHeaderRead(tBuffer,tLength,tHeader.endOffset,&tHeader)==YES);
+    UNXAssert(tHeader.addressSize==4 && tHeader.descriptorsOffset==64+16 && tHeader.endOffset==tLength);
+    
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0x1000)==0x10);
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0x10FF)==0x10);
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0x1100)==UINT64_MAX);
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0x3010)==0x80);
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength,0)==UINT64_MAX);
+    
+    // Truncated second set
+    
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength-1,0x3010)==UINT64_MAX);
+    UNXAssert(DWRFArangesDebugInfoOffsetForAddress(tBuffer,tLength-1,0x2000)==0x10);
+    
+    // Unsupported address size
+    
+    tBuffer[10]=3;
+    
+    UNXAssert(DWRFArangesSetHeaderRead(tBuffer,tLength,0,&tHeader)==NO);
+}
+
+#pragma mark - Line number program
+
+static size_t UNXWriteLineProgram(uint8_t * inBuffer)
+{
+    static const uint8_t sHeader[]={
+        1,1,1,(uint8_t)-5,14,13,                // minimum_instruction_length ... opcode_base
+        0,1,1,1,1,0,0,0,1,0,0,1,                // standard_opcode_lengths
+        's','r','c',0,0,                        // include_directories
+        'a','.','c',0,1,0,0,                    // file_names
+        'b','.','c',0,0,0,0,
+        0
+    };
+    
+    static const uint8_t sProgram[]={
+        0x00,0x09,0x02,0x00,0x10,0,0,0,0,0,0,   // DW_LNE_set_address 0x1000
+        0x03,0x09,                              // DW_LNS_advance_line 9
+        0x01,                                   // DW_LNS_copy
+        47,                                     // Special opcode: address+2, line+1
+        0x04,0x02,                              // DW_LNS_set_file 2
+        0x02,0x04,                              // DW_LNS_advance_pc 4
+        0x03,0x7D,                              // DW_LNS_advance_line -3
+        0x00,0x08,0x03,'c','.','c',0,0,0,0,     // DW_LNE_define_file c.c
+        0x05,0x05,                              // DW_LNS_set_column 5
+        0x01,                                   // DW_LNS_copy
+        0x09,0x10,0x00,                         // DW_LNS_fixed_advance_pc 16
+        0x00,0x01,0x01,                         // DW_LNE_end_sequence
+        0x01                                    // DW_LNS_copy
+    };
+    
+    size_t tOffset=0;
+    
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,(uint32_t)(2+4+sizeof(sHeader)+sizeof(sProgram)),NO);
+    tOffset=UNXWriteUInt16(inBuffer,tOffset,4);
+    tOffset=UNXWriteUInt32(inBuffer,tOffset,sizeof(sHeader),NO);
+    tOffset=UNXWriteBytes(inBuffer,tOffset,sHeader,sizeof(sHeader));
+    tOffset=UNXWriteBytes(inBuffer,tOffset,sProgram,sizeof(sProgram));
+    
+    return tOffset;
+}
+
+static void UNXTestLineProgramHeader(void)
+{
+    uint8_t tBuffer[256];
+    size_t tLength=UNXWriteLineProgram(tBuffer);
+    DWRFLineProgramHeader tHeader;
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength,0,&tHeader)==YES);
+    UNXAssert(tHeader.version==4 && tHeader.lineBase==-5 && tHeader.lineRange==14 && tHeader.opcodeBase==13 && tHeader.defaultIsStmt==YES);
+    UNXAssert(tHeader.programOffset==10+38 && tHeader.endOffset==tLength);
+    
+    NSUInteger tOffset=tHeader.includeDirectoriesOffset;
+    const char * tPath=NULL;
+    
+    UNXAssert(DWRFLineProgramNextIncludeDirectory(tBuffer,&tHeader,&tOffset,&tPath)==YES && strcmp(tPath,"src")==0);
+    UNXAssert(DWRFLineProgramNextIncludeDirectory(tBuffer,&tHeader,&tOffset,&tPath)==NO);
+    
+    tOffset=tHeader.fileNamesOffset;
+    DWRFLineProgramFileEntry tEntry;
+    
+    UNXAssert(DWRFLineProgramNextFileEntry(tBuffer,&tHeader,&tOffset,&tEntry)==YES && strcmp(tEntry.name,"a.c")==0 && tEntry.directoryIndex==1);
+    UNXAssert(DWRFLineProgramNextFileEntry(tBuffer,&tHeader,&tOffset,&tEntry)==YES && strcmp(tEntry.name,"b.c")==0 && tEntry.directoryIndex==0);
+    UNXAssert(DWRFLineProgramNextFileEntry(tBuffer,&tHeader,&tOffset,&tEntry)==NO);
+    
+    // Truncated unit, unsupported version, header_length too small for the file names
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength-1,0,&tHeader)==NO);
+    
+    UNXWriteUInt16(tBuffer,4,5);
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength,0,&tHeader)==NO);
+    
+    UNXWriteUInt16(tBuffer,4,4);
+    UNXWriteUInt32(tBuffer,6,30,NO);
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength,0,&tHeader)==NO);
+}
+
+static void UNXTestLineProgramRun(void)
+{
+    uint8_t tBuffer[256];
+    size_t tLength=UNXWriteLineProgram(tBuffer);
+    DWRFLineProgramHeader tHeader;
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength,0,&tHeader)==YES);
+    
+    DWRFLineProgramStateMachine tStateMachine=DWRFLineProgramStateMachineMake(tBuffer,&tHeader);
+    const DWRFLineProgramRegisters * tRegisters=&tStateMachine.registers;
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepRow);
+    UNXAssert(tRegisters->address==0x1000 && tRegisters->file==1 && tRegisters->line==10 && tRegisters->column==0);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepRow);
+    UNXAssert(tRegisters->address==0x1002 && tRegisters->line==11);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepDefineFile);
+    UNXAssert(strcmp(tStateMachine.definedFile.name,"c.c")==0);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepRow);
+    UNXAssert(tRegisters->address==0x1006 && tRegisters->file==2 && tRegisters->line==8 && tRegisters->column==5 && tRegisters->endSequence==NO);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepRow);
+    UNXAssert(tRegisters->address==0x1016 && tRegisters->endSequence==YES);
+    
+    // The registers are reset after the end of a sequence
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepRow);
+    UNXAssert(tRegisters->address==0 && tRegisters->file==1 && tRegisters->line==1 && tRegisters->column==0 && tRegisters->endSequence==NO);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepEnd);
+    
+    // Program cut in the middle of DW_LNE_set_address
+    
+    UNXWriteUInt32(tBuffer,0,(uint32_t)(tHeader.programOffset-4+5),NO);
+    
+    UNXAssert(DWRFLineProgramHeaderRead(tBuffer,tLength,0,&tHeader)==YES);
+    
+    tStateMachine=DWRFLineProgramStateMachineMake(tBuffer,&tHeader);
+    
+    UNXAssert(DWRFLineProgramStateMachineNext(&tStateMachine)==DWRFLineProgramStepMalformed);
+}
+
+#pragma mark - Corrupted inputs
+
+// The parsers must neither read beyond the bytes nor loop forever, whatever the bytes
+
+static void UNXTestCorruptedInputs(void)
+{
+    uint8_t tFixtures[3][256];
+    size_t tLengths[3];
+    
+    tLengths[0]=UNXWriteMachOFile(tFixtures[0],NO);
+    tLengths[1]=UNXWriteArangesSection(tFixtures[1]);
+    tLengths[2]=UNXWriteLineProgram(tFixtures[2]);
+    
+    uint64_t tState=0x5EED;
+    
+    for(unsigned int tIteration=0;tIteration<30000;tIteration++)
+    {
+        unsigned int tFixtureIndex=tIteration%3;
+        size_t tLength=tLengths[tFixtureIndex];
+        
+        // Copied at the end of a heap block so that the out of bounds reads are caught by the sanitizers
+        
+        uint8_t * tBytes=malloc(tLength);
+        
+        memcpy(tBytes,tFixtures[tFixtureIndex],tLength);
+        
+        unsigned int tNumberOfCorruptions=1+(unsigned int)(UNXNextRandomNumber(&tState)%4);
+        
+        for(unsigned int tIndex=0;tIndex<tNumberOfCorruptions;tIndex++)
+        {
+            uint64_t tRandom=UNXNextRandomNumber(&tState);
+            
+            tBytes[tRandom%tLength]=(uint8_t)(tRandom>>32);
+        }
+        
+        size_t tCorruptedLength=tLength-(size_t)(UNXNextRandomNumber(&tState)%8);
+        
+        switch(tFixtureIndex)
+        {
+            case 0:
+            {
+                BOOL tIs64Bit;
+                BOOL tSwap;
+                MCHMachHeader tHeader;
+                
+                if (MCHMachHeaderIdentify(tBytes,tCorruptedLength,&tIs64Bit,&tSwap)==YES &&
+                    MCHMachHeaderRead(tBytes,tCorruptedLength,tIs64Bit,tSwap,&tHeader)==YES)
+                {
+                    MCHLoadCommandsIterator tIterator=MCHLoadCommandsIteratorMake(tBytes,tCorruptedLength,&tHeader);
+                    MCHLoadCommandInfo tLoadCommand;
+                    uint8_t tUUID[16];
+                    
+                    while (MCHLoadCommandsIteratorNext(&tIterator,&tLoadCommand)==YES)
+                    {
+                        UNXAssert(NSMaxRange(NSMakeRange(tLoadCommand.offset,tLoadCommand.size))<=tCorruptedLength);
+                        
+                        if (tLoadCommand.type==LC_UUID)
+                            MCHUUIDLoadCommandRead(tBytes+tLoadCommand.offset,tLoadCommand.size,tUUID);
+                    }
+                }
+                
+                break;
+            }
+                
+            case 1:
+                
+                DWRFArangesDebugInfoOffsetForAddress(tBytes,tCorruptedLength,0x1000);
+                
+                break;
+                
+            default:
+            {
+                DWRFLineProgramHeader tHeader;
+                
+                if (DWRFLineProgramHeaderRead(tBytes,tCorruptedLength,0,&tHeader)==YES)
+                {
+                    UNXAssert(tHeader.endOffset<=tCorruptedLength);
+                    
+                    DWRFLineProgramStateMachine tStateMachine=DWRFLineProgramStateMachineMake(tBytes,&tHeader);
+                    unsigned int tNumberOfSteps=0;
+                    DWRFLineProgramStep tStep;
+                    
+                    while ((tStep=DWRFLineProgramStateMachineNext(&tStateMachine))!=DWRFLineProgramStepEnd && tStep!=DWRFLineProgramStepMalformed)
+                        tNumberOfSteps++;
+                    
+                    UNXAssert(tNumberOfSteps<=tCorruptedLength);
+                }
+                
+                break;
+            }
+        }
+        
+        free(tBytes);
+    }
+}
+
+#pragma mark - UTF-8 scanner
+
+static void UNXTestUTF8Characters(void)
+{
+    UNXAssert(CUIUTF8BytesAreASCII((const uint8_t *)"0x1 - 0x2 +com.example.foo",26)==YES);
+    UNXAssert(CUIUTF8BytesAreASCII((const uint8_t *)"0123456789\xC3\xA9",12)==NO);
+    
+    UNXAssert(CUIUTF8CharacterLength('a')==1);
+    UNXAssert(CUIUTF8CharacterLength(0xC3)==2);
+    UNXAssert(CUIUTF8CharacterLength(0xE3)==3);
+    UNXAssert(CUIUTF8CharacterLength(0xF0)==4);
+    
+    // e, U+00E9, U+3000, U+1F600 (surrogate pair)
+    
+    UNXAssert(CUIUTF8UTF16Length((const uint8_t *)"e\xC3\xA9\xE3\x80\x80\xF0\x9F\x98\x80",10)==5);
+    
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)" a",2)==1);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\t",1)==1);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\xC2\xA0",2)==2);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\xE2\x80\xAF",3)==3);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\xE3\x80\x80",3)==3);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\n",1)==0);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\xC3\xA9",2)==0);
+    UNXAssert(CUIUTF8WhitespaceLength((const uint8_t *)"\xE2\x80",2)==0);
+}
+
+static void UNXTestUTF8Ranges(void)
+{
+    const char * tString="\xC2\xA0 foo \xC3\xA9 \xE3\x80\x80";
+    const uint8_t * tBytes=(const uint8_t *)tString;
+    NSUInteger tLength=strlen(tString);
+    
+    NSRange tRange=CUIUTF8TrimmedRange(tBytes,NSMakeRange(0,tLength));
+    
+    UNXAssert(tRange.location==3 && tRange.length==6);
+    
+    UNXAssert(CUIUTF8LocationOfLastCharacter(tBytes,tRange)==7);
+    UNXAssert(CUIUTF8LocationOfLastWhitespace(tBytes,tRange)==6);
+    UNXAssert(CUIUTF8LocationOfLastWhitespace((const uint8_t *)"foo",NSMakeRange(0,3))==(NSUInteger)NSNotFound);
+    
+    tRange=CUIUTF8TrimmedRange((const uint8_t *)"   ",NSMakeRange(0,3));
+    
+    UNXAssert(tRange.length==0);
+    
+    const char * tLine="0x1 - 0x2 +com.example.Foo (1.0) <UUID>";
+    
+    UNXAssert(CUIUTF8LocationOfString((const uint8_t *)tLine,NSMakeRange(0,strlen(tLine)),"COM.EXAMPLE")==11);
+    UNXAssert(CUIUTF8LocationOfString((const uint8_t *)tLine,NSMakeRange(0,strlen(tLine)),"<")==33);
+    UNXAssert(CUIUTF8LocationOfString((const uint8_t *)tLine,NSMakeRange(0,10),"<")==(NSUInteger)NSNotFound);
+    UNXAssert(CUIUTF8LocationOfString((const uint8_t *)tLine,NSMakeRange(0,strlen(tLine)),"")==(NSUInteger)NSNotFound);
+    
+    UNXAssert(CUIUTF8IntegerValue((const uint8_t *)" -42abc",NSMakeRange(0,7))==-42);
+    UNXAssert(CUIUTF8IntegerValue((const uint8_t *)"abc",NSMakeRange(0,3))==0);
+}
+
+static void UNXTestUTF8ScannerScanInteger(void)
+{
+    CUIUTF8Scanner tScanner=UNXScannerWithString("  42 + 7 -x 99999999999999999999 -99999999999999999999");
+    NSInteger tValue=0;
+    
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==YES && tValue==42 && tScanner.location==4);
+    
+    // Whitespaces are allowed after the sign
+    
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==YES && tValue==7);
+    
+    // The location is not changed when no integer is found
+    
+    NSUInteger tLocation=tScanner.location;
+    
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==NO && tScanner.location==tLocation);
+    
+    CUIUTF8ScannerSkipWhitespaces(&tScanner);
+    CUIUTF8ScannerSkipCharacter(&tScanner,'-');
+    CUIUTF8ScannerSkipCharacter(&tScanner,'x');
+    
+    // The overflows are clamped
+    
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==YES && tValue==NSIntegerMax);
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==YES && tValue==NSIntegerMin);
+    UNXAssert(tScanner.location==tScanner.length);
+    UNXAssert(CUIUTF8ScannerScanInteger(&tScanner,&tValue)==NO);
+}
+
+static void UNXTestUTF8ScannerScanHexLongLong(void)
+{
+    CUIUTF8Scanner tScanner=UNXScannerWithString("0x00007fff2034a000 -    0X1aB ffffffffffffffffff 0xg");
+    unsigned long long tValue=0;
+    
+    UNXAssert(CUIUTF8ScannerScanHexLongLong(&tScanner,&tValue)==YES && tValue==0x7fff2034a000ULL);
+    
+    CUIUTF8ScannerSkipWhitespaces(&tScanner);
+    CUIUTF8ScannerSkipCharacter(&tScanner,'-');
+    
+    UNXAssert(CUIUTF8ScannerScanHexLongLong(&tScanner,&tValue)==YES && tValue==0x1AB);
+    UNXAssert(CUIUTF8ScannerScanHexLongLong(&tScanner,&tValue)==YES && tValue==ULLONG_MAX);
+    
+    // "0x" not followed by a hexadecimal digit: only the 0 is scanned
+    
+    UNXAssert(CUIUTF8ScannerScanHexLongLong(&tScanner,&tValue)==YES && tValue==0);
+    UNXAssert(CUIUTF8ScannerScanHexLongLong(&tScanner,&tValue)==NO);
+}
+
+static void UNXTestUTF8ScannerScanUpToString(void)
+{
+    CUIUTF8Scanner tScanner=UNXScannerWithString("foo (in Foo) + 12");
+    NSRange tRange;
+    
+    UNXAssert(CUIUTF8ScannerScanUpToString(&tScanner,"(IN ",&tRange)==YES && tRange.location==0 && tRange.length==4);
+    
+    // At the string
+    
+    UNXAssert(CUIUTF8ScannerScanUpToString(&tScanner,"(in ",&tRange)==NO && tScanner.location==4);
+    
+    // Not found: up to the end
+    
+    UNXAssert(CUIUTF8ScannerScanUpToString(&tScanner,"<",&tRange)==YES && tRange.location==4 && NSMaxRange(tRange)==tScanner.length);
+    
+    UNXAssert(CUIUTF8ScannerScanUpToString(&tScanner,"<",&tRange)==NO);
+}
+
+int main(void)
+{
+    UNXTestULEB128();
+    UNXTestLEB128();
+    UNXTestBoundedLEB128();
+    
+    UNXTestMachOHeader();
+    UNXTestMachOMalformedLoadCommands();
+    
+    UNXTestAranges();
+    
+    UNXTestLineProgramHeader();
+    UNXTestLineProgramRun();
+    
+    UNXTestCorruptedInputs();
+    
+    UNXTestUTF8Characters();
+    UNXTestUTF8Ranges();
+    UNXTestUTF8ScannerScanInteger();
+    UNXTestUTF8ScannerScanHexLongLong();
+    UNXTestUTF8ScannerScanUpToString();
+    
+    if (sNumberOfFailures>0)
+    {
+        fprintf(stderr,"%lu assertion(s) failed\n",sNumberOfFailures);
+        
+        return 1;
+    }
+    
+    return 0;
+}